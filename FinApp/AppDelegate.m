@@ -8,7 +8,10 @@
 
 #import "AppDelegate.h"
 #import "FADataController.h"
+#import "FADataStore.h"
+#import "FALaunchScheduler.h"
 #import "Reachability.h"
+#import "FATrace.h"
 #import <FBSDKCoreKit/FBSDKCoreKit.h>
 
 @interface AppDelegate ()
@@ -28,6 +31,10 @@
 // Check if there is internet connectivity
 - (BOOL) checkForInternetConnectivity;
 
+// Write changes that are still waiting in the data store to disk, before the app is suspended or terminated. Done in a background task so that the app
+// gets the time to finish writing.
+- (void)flushDataStoreForApplication:(UIApplication *)application;
+
 @end
 
 @implementation AppDelegate
@@ -35,6 +42,9 @@
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
     
+    // Turn on tracing of the hot paths if asked for e.g. by launching with -FATraceEnabled YES. It's dumped when the app goes into the background.
+    [FATrace enableIfRequested];
+    
     // Override point for customization after application launch.
     
     // Remove the 1 pixel bottom border line from navigation Controller top bar.
@@ -46,54 +56,65 @@
     [[FBSDKApplicationDelegate sharedInstance] application:application
                              didFinishLaunchingWithOptions:launchOptions];
 
-     
+
+    // Start loading the data store in the background, so that opening, migrating or seeding it doesn't hold up the first frame. The
+    // first screen's fetches wait for it to be loaded.
+    [[FADataStore sharedStore] loadPersistentStoreInBackgroundWithCompletion:nil];
+    
+    // Work done at launch is staged so that only showing the first screen is done before the first frame. The rest is done in the background
+    // after it has rendered, or once the app is idle.
+    FALaunchScheduler *launchScheduler = [FALaunchScheduler sharedScheduler];
+    
     // Check to see if application version 4.2 has been used by the user at least once. If not show tutorial and do the data updates. The format for key represents app store version 4_1 and the final internal build being shipped. Lagging build number by 1.
     // *****************IMPORTANT*********************************************************************** If you are changing this, also change applicationbecameactive and tutorialDonePressed button on FATutorialViewController as that makes more sense.
-    if (![[NSUserDefaults standardUserDefaults] boolForKey:@"V5_0_1_UsedOnce"])
-    {
-        // Show tutorial
-        [self configViewControllerWithName:@"FATutorialViewController"];
+    BOOL isFirstUse = ![[NSUserDefaults standardUserDefaults] boolForKey:@"V5_0_1_UsedOnce"];
+    
+    // Show the tutorial on first use, else the events list
+    [launchScheduler addTaskForStage:FALaunchStageFirstFrameCritical named:@"configFirstScreen" usingBlock:^{
+        if (isFirstUse) {
+            [self configViewControllerWithName:@"FATutorialViewController"];
+        } else {
+            [self configViewControllerWithName:@"FAEventsNavController"];
+        }
+    }];
+    
+    // Import the preseed snapshot, if needed, and run any one time data migrations that haven't been run yet e.g. cleaning up after the BBRY
+    // to BB ticker change. These used to run on the main thread before the first frame.
+    [launchScheduler addTaskForStage:FALaunchStageAfterFirstFrame named:@"importAndMigrateData" usingBlock:^{
         
-        FADataController *econEventDataController = [[FADataController alloc] init];
+        // Create a new FADataController so that this thread has its own MOC
+        FADataController *migrationDataController = [[FADataController alloc] init];
         
         // Delete all entries in the action table to reset state so that any user is starting with a clean slate for following.Don't need to do this reset anymore as most of the people who were going to upgrade have probably already done so and are using following which we don't want to wipeout.
-        //[econEventDataController deleteAllEventActions];
-        
-        // Sync the 2018 econ events
-        [econEventDataController getAllEconomicEventsFromLocalStorage];
-        
-        // Delete the FIFA 18 events as there are duplicates that have somehow got in. No longer need to do this as people are likely to have upgraded killing these anyway.
-        //[econEventDataController deleteAllFIFA18Events];
-        
-        // Delete all events from a past version that currently don't have any Ticker as the BBRY change to BB might have created some of these.
-        [econEventDataController deleteAllEmptyTickerEvents];
-        
-        // Delete all BBRY events as ticker has changed from BBRY to BB.
-        [econEventDataController deleteAllBBRYEvents];
+        //[migrationDataController deleteAllEventActions];
         
-        // Delete the BBRY ticker
-        [econEventDataController deleteCompanyWithTicker:@"BBRY"];
-        
-        // Add newer company tickers from hard code. This gets all the newer added prod event tickers as well.
-        [econEventDataController getAllTickersAndNamesFromLocalCode];
-        
-            // Add new tickers + Refresh existing events and get product events
-            // Async processing of non ui tasks should not be done on the main thread.
-            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT,0),^{
-                
-                // Create a new FADataController so that this thread has its own MOC
-                FADataController *eventDataController = [[FADataController alloc] init];
-                
-                // Add newer company tickers from hard code. This gets all the newer added prod event tickers as well.
-                // TO DO LATEST: Check if the newer tickers get in
-                //[eventDataController getAllTickersAndNamesFromLocalCode];
-                
-                if ([self checkForInternetConnectivity]) {
-                    // TO DO: Testing. Delete before shipping v4.3
-                    //NSLog(@"Kicking off refresh of events");
+        [migrationDataController performBlockAndWait:^{
+            
+            // Import the preseed snapshot, which has the econ events and the newer company tickers, including all the newer added prod event tickers, in a single transaction.
+            [migrationDataController importPreseedSnapshotIfNeeded];
+            
+            // Delete the FIFA 18 events as there are duplicates that have somehow got in. No longer need to do this as people are likely to have upgraded killing these anyway.
+            //[migrationDataController deleteAllFIFA18Events];
+            
+            [migrationDataController runPendingDataMigrations];
+        }];
+    }];
+    
+    if (isFirstUse)
+    {
+        // Refresh existing events and get product events, after the data has been imported and migrated above.
+        // Newer company tickers, including the newer added prod event tickers, are in the preseed snapshot imported above.
+        [launchScheduler addTaskForStage:FALaunchStageAfterFirstFrame named:@"refreshEvents" usingBlock:^{
+            
+            // Create a new FADataController so that this thread has its own MOC
+            FADataController *eventDataController = [[FADataController alloc] init];
+            
+            if ([self checkForInternetConnectivity]) {
+                // TO DO: Testing. Delete before shipping v4.3
+                //NSLog(@"Kicking off refresh of events");
                 [self refreshEventsIfNeededFromApiInBackgroundWithDataController:eventDataController];
-                }
-            });
+            }
+        }];
         
         // Update the list of companies in a background task. Don't need to do this anymore as we are getting most of the tickers in the updatefromlocalcode. See in the future if you want to bring this back.
        /* __block UIBackgroundTaskIdentifier backgroundFetchTask = [[UIApplication sharedApplication] beginBackgroundTaskWithName:@"backgroundIncrementalCompaniesFetch" expirationHandler:^{
@@ -123,10 +144,8 @@
             backgroundFetchTask = UIBackgroundTaskInvalid;
         }); */
     }
-    // If yes
-    else {
-        [self configViewControllerWithName:@"FAEventsNavController"];
-    }
+    
+    [launchScheduler start];
     
     // TO DO: Testing. Delete before shipping v4.3
     //NSLog(@"Did finish launching with options");
@@ -142,6 +161,12 @@
 - (void)applicationDidEnterBackground:(UIApplication *)application {
     // Use this method to release shared resources, save user data, invalidate timers, and store enough application state information to restore your application to its current state in case it is terminated later.
     // If your application supports background execution, this method is called instead of applicationWillTerminate: when the user quits.
+    
+    // Make sure saved changes get written to disk before the app is suspended
+    [self flushDataStoreForApplication:application];
+    
+    // Log the trace summary and write out the binary trace, if tracing is on
+    [FATrace dumpTrace];
 }
 
 - (void)applicationWillEnterForeground:(UIApplication *)application {
@@ -156,11 +181,11 @@
     if ([self checkForInternetConnectivity]) {
         
         // Refresh events, sync product events after upgrade is done
-        // Async processing of non ui tasks should not be done on the main thread.
+        // Async processing of non ui tasks should not be done on the main thread. At launch this waits till the first frame has rendered and the data has been migrated.
         // *****************IMPORTANT*********************************************************************** If you are changing this, also change applicationfinishedlaunching and tutorialDonePressed button on FATutorialViewController.
         if ([[NSUserDefaults standardUserDefaults] boolForKey:@"V5_0_1_UsedOnce"])
         {
-            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT,0),^{
+            [[FALaunchScheduler sharedScheduler] addTaskForStage:FALaunchStageAfterFirstFrame named:@"refreshEvents" usingBlock:^{
                 
                 // TO DO: Testing. Delete before shipping v4.3
                 //NSLog(@"Kicking of refresh of events");
@@ -169,7 +194,7 @@
                 FADataController *eventDataController = [[FADataController alloc] init];
                 
                 [self refreshEventsIfNeededFromApiInBackgroundWithDataController:eventDataController];
-            });
+            }];
         }
         
         // TO DO: Delete Later, Testing only
@@ -186,6 +211,7 @@
     // Called when the application is about to terminate. Save data if appropriate. See also applicationDidEnterBackground:.
     // Saves changes in the application's managed object context before the application terminates.
     // [self saveContext];
+    [self flushDataStoreForApplication:application];
     
     // Check to see if all the company data has been synced before terminating. This is done by checking if all pages of information
     // have been processed. Using the total number of company pages to sync from user data store.
@@ -226,12 +252,33 @@
 
 #pragma mark - State Setup Rfresh
 
+// Write changes that are still waiting in the data store to disk, before the app is suspended or terminated. Done in a background task so that the app
+// gets the time to finish writing.
+- (void)flushDataStoreForApplication:(UIApplication *)application
+{
+    __block UIBackgroundTaskIdentifier flushTask = [application beginBackgroundTaskWithName:@"flushDataStore" expirationHandler:^{
+        
+        // Stopped or ending the task outright.
+        [application endBackgroundTask:flushTask];
+        flushTask = UIBackgroundTaskInvalid;
+    }];
+    
+    [[FADataStore sharedStore] flushToDisk];
+    
+    if (flushTask != UIBackgroundTaskInvalid) {
+        [application endBackgroundTask:flushTask];
+        flushTask = UIBackgroundTaskInvalid;
+    }
+}
+
 // Refresh events that are likely to be updated, from API. Additionally also get the events for trending tickers initially. Check to see if product events need to be added or refreshed. If yes, do that. Currently product events are being fetched whole each time. Plus  Typically called in a background thread.
 - (void)refreshEventsIfNeededFromApiInBackgroundWithDataController:(FADataController *)existingDC
 {
-    // Add Trending events if people are not able to figure out how to add their own events.
-    //[existingDC addCurrentTrendingEarnings];
-    [existingDC updateEventsFromRemoteIfNeeded];
+    [existingDC performBlockAndWait:^{
+        // Add Trending events if people are not able to figure out how to add their own events.
+        //[existingDC addCurrentTrendingEarnings];
+        [existingDC updateEventsFromRemoteIfNeeded];
+    }];
 }
 
 // Kick off a background task to add any new companies that might have been added.
@@ -243,11 +290,15 @@
     // Get Today's Date
     NSDate *todaysDate = [NSDate date];
     
-    // Get the last company sync date
-    NSDate *lastCompanySyncDate = [companyUpdateDataController getCompanySyncDate];
-    
-    // Get the last event sync date
-    NSDate *lastEventSyncDate = [companyUpdateDataController getEventSyncDate];
+    // Get the last company and event sync dates and the company sync status
+    __block NSDate *lastCompanySyncDate = nil;
+    __block NSDate *lastEventSyncDate = nil;
+    __block NSString *companySyncStatus = nil;
+    [companyUpdateDataController performBlockAndWait:^{
+        lastCompanySyncDate = [companyUpdateDataController getCompanySyncDate];
+        lastEventSyncDate = [companyUpdateDataController getEventSyncDate];
+        companySyncStatus = [companyUpdateDataController getCompanySyncStatus];
+    }];
     
     // Get the number of days between the 2 company sync dates
     NSCalendar *gregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
@@ -259,7 +310,7 @@
     NSInteger daysBetweenEventSyncs = [eventComponents day];
     
     // TO DO: For testing, comment before shipping. Keeping it around for future pre seeding testing.
-    NSLog(@"Days since last company sync:%ld and syncstatus is:%@ and no of days since event sync are:%ld",(long)daysBetween,[companyUpdateDataController getCompanySyncStatus],(long)daysBetweenEventSyncs);
+    NSLog(@"Days since last company sync:%ld and syncstatus is:%@ and no of days since event sync are:%ld",(long)daysBetween,companySyncStatus,(long)daysBetweenEventSyncs);
     
     // If it's been 45 days since the last company sync, do an incremental sync, only if the event sync for the day is done
     if (((int)daysBetween >= 45)&&((int)daysBetweenEventSyncs <= 0))
@@ -281,7 +332,9 @@
             // Create a new FADataController so that this thread has its own MOC
             FADataController *companyBkgrndDataController = [[FADataController alloc] init];
             
-            [companyBkgrndDataController getIncrementalCompaniesFromApi];
+            [companyBkgrndDataController performBlockAndWait:^{
+                [companyBkgrndDataController getIncrementalCompaniesFromApi];
+            }];
             
             [[UIApplication sharedApplication] endBackgroundTask:backgroundFetchTask];
             backgroundFetchTask = UIBackgroundTaskInvalid;
@@ -295,7 +348,12 @@
     // Create a new FADataController so that this thread has its own MOC
     FADataController *companyDataController = [[FADataController alloc] init];
     
-    if ([[companyDataController getCompanySyncStatus] isEqualToString:@"SeedSyncDone"]||[[companyDataController getCompanySyncStatus] isEqualToString:@"FullSyncAttemptedButFailed"]) {
+    __block NSString *companySyncStatus = nil;
+    [companyDataController performBlockAndWait:^{
+        companySyncStatus = [companyDataController getCompanySyncStatus];
+    }];
+    
+    if ([companySyncStatus isEqualToString:@"SeedSyncDone"]||[companySyncStatus isEqualToString:@"FullSyncAttemptedButFailed"]) {
         
         // Get Companies
         // Creating a task that continues to process in the background.
@@ -304,10 +362,12 @@
             // Clean up any unfinished task business before it's about to be terminated
             // In our case, check if all pages of companies data has been synced. If not, mark status to failed
             // so that another thread can pick up the completion on restart. Currently this is hardcoded to 26 as 26 pages worth of companies (7517 companies at 300 per page) were available as of Sep 29, 2105. When you change this, change the hard coded value in getAllCompaniesFromApi(2 places) in FADataController. Also change in Search Bar Began Editing in the Events View Controller.
-            if ([[companyDataController getCompanySyncStatus] isEqualToString:@"FullSyncStarted"]&&[[companyDataController getCompanySyncedUptoPage] integerValue] < [[companyDataController getTotalNoOfCompanyPagesToSync] integerValue])
-            {
-                [companyDataController upsertUserWithCompanySyncStatus:@"FullSyncAttemptedButFailed" syncedPageNo:[companyDataController getCompanySyncedUptoPage]];
-            }
+            [companyDataController performBlockAndWait:^{
+                if ([[companyDataController getCompanySyncStatus] isEqualToString:@"FullSyncStarted"]&&[[companyDataController getCompanySyncedUptoPage] integerValue] < [[companyDataController getTotalNoOfCompanyPagesToSync] integerValue])
+                {
+                    [companyDataController upsertUserWithCompanySyncStatus:@"FullSyncAttemptedButFailed" syncedPageNo:[companyDataController getCompanySyncedUptoPage]];
+                }
+            }];
             
             // Stopped or ending the task outright.
             [[UIApplication sharedApplication] endBackgroundTask:backgroundFetchTask];
@@ -317,7 +377,9 @@
         // Start the long-running task and return immediately.
         dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
             
-            [companyDataController getAllCompaniesFromApi];
+            [companyDataController performBlockAndWait:^{
+                [companyDataController getAllCompaniesFromApi];
+            }];
             
             [[UIApplication sharedApplication] endBackgroundTask:backgroundFetchTask];
             backgroundFetchTask = UIBackgroundTaskInvalid;
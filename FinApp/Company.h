@@ -27,6 +27,13 @@
 // Set of events associated with the company
 @property (nonatomic, retain) NSSet *events;
 
+// Uppercased ticker, indexed, so that lookups by ticker can be an exact match instead of a case insensitive one. Kept in sync when the company is saved.
+@property (nonatomic, retain) NSString * tickerKey;
+
+// Is the company being followed i.e. does any of it's events have an "OSReminder" or "PriceChange" action. Indexed, and kept in sync by the data controller
+// as actions are inserted and deleted, so that fetches of followed events can filter on it instead of going through the actions of every event.
+@property (nonatomic, retain) NSNumber * isFollowed;
+
 @end
 
 @interface Company (CoreDataGeneratedAccessors)
@@ -25,4 +25,33 @@
 // Set of events associated with the company
 @dynamic events;
 
+// Uppercased ticker, indexed, so that lookups by ticker can be an exact match instead of a case insensitive one. Kept in sync when the company is saved.
+@dynamic tickerKey;
+
+// Is the company being followed i.e. does any of it's events have an "OSReminder" or "PriceChange" action. Indexed, and kept in sync by the data controller
+// as actions are inserted and deleted, so that fetches of followed events can filter on it instead of going through the actions of every event.
+@dynamic isFollowed;
+
+// Keep the ticker key in sync with the ticker every time the company is saved. Only a changed value is set so that this doesn't dirty the company again.
+// The ticker key and kind of the company's events depend on the ticker too, so when it changes they are brought in line, and saved, along with the company.
+- (void)willSave
+{
+    [super willSave];
+    
+    if ([self isDeleted]) {
+        return;
+    }
+    
+    NSString *currentTickerKey = [self.ticker uppercaseString];
+    if (!((currentTickerKey == nil && self.tickerKey == nil) || [currentTickerKey isEqualToString:self.tickerKey])) {
+        self.tickerKey = currentTickerKey;
+    }
+    
+    if (![self isInserted] && ([[self changedValues] objectForKey:@"ticker"] != nil)) {
+        for (Event *event in self.events) {
+            [event updateLookupKeys];
+        }
+    }
+}
+
 @end
@@ -10,8 +10,18 @@
 
 #import <Foundation/Foundation.h>
 #import <CoreData/CoreData.h>
+#import "FAEventClassification.h"
 @class Action, Company;
 
+// Impact of a product event, as rated by the data source e.g. "Very High". Stored on the event so that product events can be filtered on an indexed number.
+typedef NS_ENUM(int16_t, FAProductImpact) {
+    FAProductImpactUnknown = 0,
+    FAProductImpactLow = 1,
+    FAProductImpactMedium = 2,
+    FAProductImpactHigh = 3,
+    FAProductImpactVeryHigh = 4
+};
+
 // Note: Currently, the listed company ticker and event type, together represent the event uniquely.
 @interface Event : NSManagedObject
 
@@ -64,6 +74,66 @@
 // Event history related to this event
 @property (nonatomic, retain) NSManagedObject *relatedEventHistory;
 
+// Uppercased ticker of the listed company. Denormalized here, and indexed, so that lookups by ticker are an exact match on the event itself. Kept in sync when the event,
+// or it's listed company's ticker, is saved. It's only filled in at save time, so events that haven't been saved yet aren't found by tickerKey == %@ lookups.
+@property (nonatomic, retain) NSString * tickerKey;
+
+// Canonical kind of the event (FAEventKind), worked out from the type and listed company ticker. Indexed, along with tickerKey. Kept in sync when the event is saved.
+@property (nonatomic, retain) NSNumber * kind;
+
+// For Quarterly Earnings, the next date on which the remote source is likely to have changed information for the event. Used to pick the events to refresh. nil if not worked out yet.
+@property (nonatomic, retain) NSDate * nextRefreshDate;
+
+// For % up and % down events, the absolute percent change e.g. 5.12 for "-5.12% down today $30.12", parsed out of the type so that moves can be sorted and filtered by size as a number.
+// Indexed, along with kind. nil for all other events. Kept in sync when the event is saved.
+@property (nonatomic, retain) NSNumber * priceMovePercent;
+
+// For price change events, the price in dollars e.g. 30.12 for "-5.12% down today $30.12" or 120.00 for "52 Week High $120.00". nil for all other events. Kept in sync when the event is saved.
+@property (nonatomic, retain) NSNumber * priceMovePrice;
+
+// For price change events, the window over which the move is measured (FAPriceMoveWindow). nil for all other events. Kept in sync when the event is saved.
+@property (nonatomic, retain) NSNumber * priceMoveWindow;
+
+// For price change events, the direction of the move (FAPriceMoveDirection). Along with kind, this identifies a price change event for a ticker. nil for all other events. Kept in sync when the event is saved.
+@property (nonatomic, retain) NSNumber * priceMoveDirection;
+
+// For product events, the impact of the event (FAProductImpact) e.g. FAProductImpactVeryHigh for "Very High". Indexed, along with kind. nil for all other events.
+@property (nonatomic, retain) NSNumber * productImpact;
+
+// For product events, the description of the impact e.g. "About 62% of Apple's revenues.". nil for all other events.
+@property (nonatomic, retain) NSString * productImpactDescription;
+
+// For product events, the impact text as sent by the data source e.g. "Very High" or "Moderate", so that impacts that don't map to a FAProductImpact can still be shown. nil for all other events.
+@property (nonatomic, retain) NSString * productImpactText;
+
+// For product events, the title of the most relevant website for more info on the event e.g. "iPhone 7 Roundup on Mac Rumors". nil for all other events.
+@property (nonatomic, retain) NSString * productMoreInfoTitle;
+
+// For product events, the url of the most relevant website for more info on the event e.g. "http://www.macrumors.com/roundup/iphone-7/". nil for all other events.
+@property (nonatomic, retain) NSString * productMoreInfoUrl;
+
+// Work out the canonical kind of an event from it's type and the ticker of the company it's listed under.
++ (FAEventKind)kindForType:(NSString *)eventType ticker:(NSString *)companyTicker;
+
+// Get the product impact for the impact text from the data source e.g. FAProductImpactVeryHigh for "Very High". Matched ignoring case.
++ (FAProductImpact)productImpactForString:(NSString *)impactStr;
+
+// Get the impact text for a product impact e.g. "Very High" for FAProductImpactVeryHigh, or "Unknown".
++ (NSString *)stringForProductImpact:(FAProductImpact)productImpact;
+
+// Get the impact text to show for a product event e.g. "Very High". Falls back to the impact text from the data source, when it doesn't map to a known impact, and then to "Unknown".
+- (NSString *)productImpactString;
+
+// Classification of the type of this event into a kind and the price move parameters, if any. Parsed once and cached on the event till the type or listed company changes.
+- (FAEventClassification *)classification;
+
+// Set the tickerKey, kind and price move attributes to match the current type and listed company, if they don't already.
+- (void)updateLookupKeys;
+
+// Set the product impact, impact description and more info title and url from the string that older versions of the app stored for product events in the
+// previous1Status of the event history i.e. Impact_Impact Description_MoreInfoTitle_MoreInfoUrl. Used to backfill events synced by those versions.
+- (void)updateProductDetailsFromLegacyInfo:(NSString *)legacyInfo;
+
 @end
 
 @interface Event (CoreDataGeneratedAccessors)
@@ -13,7 +13,12 @@
 #import "Company.h"
 
 // Note: Currently, the listed company ticker and event type, together represent the event uniquely.
-@implementation Event
+@implementation Event {
+    // Cached classification of the type, along with the type and ticker it was worked out for
+    FAEventClassification *_classification;
+    NSString *_classifiedType;
+    NSString *_classifiedTicker;
+}
 
 // Date on which the event takes place
 // For Estimated product events, date is a best guess early, mid or late in a month. Early would be 5th of the month. Middle would be 15th. Late would be 25th.
@@ -64,5 +69,196 @@
 // Event history related to this event
 @dynamic relatedEventHistory;
 
+// Uppercased ticker of the listed company. Denormalized here, and indexed, so that lookups by ticker are an exact match on the event itself. Kept in sync when the event,
+// or it's listed company's ticker, is saved. It's only filled in at save time, so events that haven't been saved yet aren't found by tickerKey == %@ lookups.
+@dynamic tickerKey;
+
+// Canonical kind of the event (FAEventKind), worked out from the type and listed company ticker. Indexed, along with tickerKey. Kept in sync when the event is saved.
+@dynamic kind;
+
+// For Quarterly Earnings, the next date on which the remote source is likely to have changed information for the event. Used to pick the events to refresh. nil if not worked out yet.
+@dynamic nextRefreshDate;
+
+// For % up and % down events, the absolute percent change e.g. 5.12 for "-5.12% down today $30.12", parsed out of the type so that moves can be sorted and filtered by size as a number.
+// Indexed, along with kind. nil for all other events. Kept in sync when the event is saved.
+@dynamic priceMovePercent;
+
+// For price change events, the price in dollars e.g. 30.12 for "-5.12% down today $30.12" or 120.00 for "52 Week High $120.00". nil for all other events. Kept in sync when the event is saved.
+@dynamic priceMovePrice;
+
+// For price change events, the window over which the move is measured (FAPriceMoveWindow). nil for all other events. Kept in sync when the event is saved.
+@dynamic priceMoveWindow;
+
+// For price change events, the direction of the move (FAPriceMoveDirection). Along with kind, this identifies a price change event for a ticker. nil for all other events. Kept in sync when the event is saved.
+@dynamic priceMoveDirection;
+
+// For product events, the impact of the event (FAProductImpact) e.g. FAProductImpactVeryHigh for "Very High". Indexed, along with kind. nil for all other events.
+@dynamic productImpact;
+
+// For product events, the description of the impact e.g. "About 62% of Apple's revenues.". nil for all other events.
+@dynamic productImpactDescription;
+
+// For product events, the impact text as sent by the data source e.g. "Very High" or "Moderate", so that impacts that don't map to a FAProductImpact can still be shown. nil for all other events.
+@dynamic productImpactText;
+
+// For product events, the title of the most relevant website for more info on the event e.g. "iPhone 7 Roundup on Mac Rumors". nil for all other events.
+@dynamic productMoreInfoTitle;
+
+// For product events, the url of the most relevant website for more info on the event e.g. "http://www.macrumors.com/roundup/iphone-7/". nil for all other events.
+@dynamic productMoreInfoUrl;
+
+// Work out the canonical kind of an event from it's type and the ticker of the company it's listed under.
++ (FAEventKind)kindForType:(NSString *)eventType ticker:(NSString *)companyTicker
+{
+    return [FAEventClassification classificationForType:eventType ticker:companyTicker].kind;
+}
+
+// Get the product impact for the impact text from the data source e.g. FAProductImpactVeryHigh for "Very High". Matched ignoring case.
++ (FAProductImpact)productImpactForString:(NSString *)impactStr
+{
+    NSString *trimmedImpactStr = [impactStr stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    
+    if ([trimmedImpactStr caseInsensitiveCompare:@"Very High"] == NSOrderedSame) {
+        return FAProductImpactVeryHigh;
+    }
+    if ([trimmedImpactStr caseInsensitiveCompare:@"High"] == NSOrderedSame) {
+        return FAProductImpactHigh;
+    }
+    if ([trimmedImpactStr caseInsensitiveCompare:@"Medium"] == NSOrderedSame) {
+        return FAProductImpactMedium;
+    }
+    if ([trimmedImpactStr caseInsensitiveCompare:@"Low"] == NSOrderedSame) {
+        return FAProductImpactLow;
+    }
+    
+    return FAProductImpactUnknown;
+}
+
+// Get the impact text for a product impact e.g. "Very High" for FAProductImpactVeryHigh, or "Unknown".
++ (NSString *)stringForProductImpact:(FAProductImpact)productImpact
+{
+    switch (productImpact) {
+        case FAProductImpactVeryHigh:
+            return @"Very High";
+        case FAProductImpactHigh:
+            return @"High";
+        case FAProductImpactMedium:
+            return @"Medium";
+        case FAProductImpactLow:
+            return @"Low";
+        default:
+            return @"Unknown";
+    }
+}
+
+// Get the impact text to show for a product event e.g. "Very High". Falls back to the impact text from the data source, when it doesn't map to a known impact, and then to "Unknown".
+- (NSString *)productImpactString
+{
+    FAProductImpact impact = [self.productImpact shortValue];
+    if (impact != FAProductImpactUnknown) {
+        return [Event stringForProductImpact:impact];
+    }
+    
+    NSString *trimmedImpactText = [self.productImpactText stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    if (trimmedImpactText.length > 0) {
+        return trimmedImpactText;
+    }
+    
+    return [Event stringForProductImpact:FAProductImpactUnknown];
+}
+
+// Classification of the type of this event into a kind and the price move parameters, if any. Parsed once and cached on the event till the type or listed company changes.
+- (FAEventClassification *)classification
+{
+    NSString *currentType = self.type;
+    NSString *currentTicker = self.listedCompany.ticker;
+    if (!_classification || (_classifiedType != currentType) || (_classifiedTicker != currentTicker)) {
+        _classification = [FAEventClassification classificationForType:currentType ticker:currentTicker];
+        _classifiedType = currentType;
+        _classifiedTicker = currentTicker;
+    }
+    
+    return _classification;
+}
+
+// Drop the cached classification when the event is turned into a fault, since the type will be refetched.
+- (void)didTurnIntoFault
+{
+    _classification = nil;
+    _classifiedType = nil;
+    _classifiedTicker = nil;
+    
+    [super didTurnIntoFault];
+}
+
+// Set the tickerKey, kind and price move attributes to match the current type and listed company, if they don't already.
+- (void)updateLookupKeys
+{
+    NSString *currentTickerKey = [self.listedCompany.ticker uppercaseString];
+    if (!((currentTickerKey == nil && self.tickerKey == nil) || [currentTickerKey isEqualToString:self.tickerKey])) {
+        self.tickerKey = currentTickerKey;
+    }
+    
+    FAEventClassification *currentClassification = [self classification];
+    NSNumber *currentKind = [NSNumber numberWithShort:currentClassification.kind];
+    if (![currentKind isEqualToNumber:self.kind]) {
+        self.kind = currentKind;
+    }
+    
+    // Price move attributes, for price change events only
+    NSNumber *currentPercent = nil;
+    NSNumber *currentPrice = nil;
+    NSNumber *currentWindow = nil;
+    NSNumber *currentDirection = nil;
+    if ([currentClassification isPriceMove]) {
+        currentPercent = isnan(currentClassification.percent) ? nil : [NSNumber numberWithDouble:currentClassification.percent];
+        currentPrice = isnan(currentClassification.price) ? nil : [NSNumber numberWithDouble:currentClassification.price];
+        currentWindow = [NSNumber numberWithShort:(int16_t)currentClassification.window];
+        currentDirection = [NSNumber numberWithShort:(int16_t)currentClassification.direction];
+    }
+    if (!((currentPercent == nil && self.priceMovePercent == nil) || [currentPercent isEqualToNumber:self.priceMovePercent])) {
+        self.priceMovePercent = currentPercent;
+    }
+    if (!((currentPrice == nil && self.priceMovePrice == nil) || [currentPrice isEqualToNumber:self.priceMovePrice])) {
+        self.priceMovePrice = currentPrice;
+    }
+    if (!((currentWindow == nil && self.priceMoveWindow == nil) || [currentWindow isEqualToNumber:self.priceMoveWindow])) {
+        self.priceMoveWindow = currentWindow;
+    }
+    if (!((currentDirection == nil && self.priceMoveDirection == nil) || [currentDirection isEqualToNumber:self.priceMoveDirection])) {
+        self.priceMoveDirection = currentDirection;
+    }
+}
+
+// Set the product impact, impact description and more info title and url from the string that older versions of the app stored for product events in the
+// previous1Status of the event history i.e. Impact_Impact Description_MoreInfoTitle_MoreInfoUrl. Used to backfill events synced by those versions.
+- (void)updateProductDetailsFromLegacyInfo:(NSString *)legacyInfo
+{
+    NSArray *infoComponents = [legacyInfo componentsSeparatedByString:@"_"];
+    if (infoComponents.count < 4) {
+        NSLog(@"ERROR: Could not backfill the details of product event of type: %@ as the stored info is not in the expected format: %@",self.type,legacyInfo);
+        // Mark the impact as unknown so that this isn't tried again
+        self.productImpact = [NSNumber numberWithShort:FAProductImpactUnknown];
+        return;
+    }
+    
+    // The impact is always a single word or two, and the url and title are at the end, so any underscores in the text are taken to be part of the description
+    self.productImpact = [NSNumber numberWithShort:[Event productImpactForString:infoComponents.firstObject]];
+    self.productImpactText = infoComponents.firstObject;
+    self.productImpactDescription = [[infoComponents subarrayWithRange:NSMakeRange(1, (infoComponents.count - 3))] componentsJoinedByString:@"_"];
+    self.productMoreInfoTitle = [infoComponents objectAtIndex:(infoComponents.count - 2)];
+    self.productMoreInfoUrl = infoComponents.lastObject;
+}
+
+// Keep the lookup keys in sync with the type and listed company every time the event is saved. Only changed values are set so that this doesn't dirty the event again.
+- (void)willSave
+{
+    [super willSave];
+    
+    if (![self isDeleted]) {
+        [self updateLookupKeys];
+    }
+}
+
 @end
 
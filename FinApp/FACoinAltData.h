@@ -18,7 +18,7 @@
 // Create and/or return the single shared data store
 + (FACoinAltData *) singleAltDataBox;
 
-// Get profile information for a given coin i.e. Short Description,Real World Use Case,Backed By,Best Exchange,More Exchanges.
-- (NSMutableArray *)getProfileInfoForCoin:(NSString *)ticker;
+// Get profile information for a given entity i.e. Investor Site(for stock)/Agency home page, Best Earnings/Econ event outcome link. Fields that aren't known are "Not Available".
+- (NSArray *)getProfileInfoForCoin:(NSString *)ticker;
 
 @end
@@ -9,15 +9,13 @@
 //
 
 #import "FACompanyInfoStore.h"
+#import "FAEntityProfileStore.h"
 
 @implementation FACompanyInfoStore
 
 
 static FACompanyInfoStore *sharedInstance;
 
-// Dictionary that stores the companies investor site info
-static NSMutableDictionary *investorSiteStore;
-
 
 // Implement this class as a Singleton to create a single company info store accessible
 // from anywhere in the app.
@@ -31,7 +29,6 @@ static NSMutableDictionary *investorSiteStore;
     {
         exists = YES;
         sharedInstance = [[FACompanyInfoStore alloc] init];
-        investorSiteStore = [[NSMutableDictionary alloc] init];
         [self initInvestorSiteStore];
     }
 }
@@ -42,20 +39,19 @@ static NSMutableDictionary *investorSiteStore;
     return sharedInstance;
 }
 
-// Initialize the investor site store with all the companies and their investor sites
+// Initialize the investor site store with all the companies and their investor sites. These now come from the bundled entity profiles,
+// which are indexed the first time a site is asked for, so there's nothing to set up here.
 + (void)initInvestorSiteStore
 {
-    // Add Apple's info
-    [investorSiteStore setObject:@"http://investor.apple.com/" forKey:@"AAPL"];
 }
 
 // Get the investor site URL for a given ticker. Returns "Not_Found" if the info doesn't exist.
 + (NSString *)getInvestorSiteForTicker:(NSString *)ticker
 {
-    NSString *siteURL = [investorSiteStore valueForKey:ticker];
+    NSString *siteURL = [[[FAEntityProfileStore sharedStore] profileForTicker:ticker] objectAtIndex:FAEntityProfileInvestorSiteField];
     
     // If the site URL doesn't exist, set it to "Not_Found"
-    if(siteURL == nil) {
+    if((siteURL == nil)||([siteURL isEqualToString:@"Not Available"])) {
         siteURL = @"Not_Found";
     }
     
@@ -0,0 +1,44 @@
+//
+//  FACompanySearchIndex.h
+//  FinApp
+//
+//  Class that keeps an in memory index of the ticker and name of every company, so that
+//  search as you type doesn't have to scan the companies in the data store on every
+//  keystroke. Tickers and names are case and diacritic folded, kept in sorted arrays for
+//  prefix lookups and in a trigram index for substring lookups. The index is built from
+//  the data store the first time it's needed and kept up to date as companies are saved.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+
+@interface FACompanySearchIndex : NSObject
+
+// Create and/or return the single shared company search index
++ (FACompanySearchIndex *)sharedIndex;
+
+// Build the index from the companies in the data store, if it hasn't been built already. Can be called from any thread.
+- (void)buildIfNeeded;
+
+// Throw away the index and build it again from the companies in the data store of the given context, instead of the app's, e.g. a synthetic store
+// for benchmarks. Can be called from any thread.
+- (void)rebuildFromContext:(NSManagedObjectContext *)context;
+
+// Throw away the index, so that it's built again from the app's data store the next time it's needed.
+- (void)reset;
+
+// Get the ticker keys (uppercased tickers) of all companies whose ticker or name contains the search text, ignoring case and diacritics.
+// Companies whose ticker starts with the search text come first, followed by those whose name starts with it, followed by the rest.
+- (NSArray *)tickerKeysMatchingSearchText:(NSString *)searchText;
+
+// Update the index with the companies inserted, updated or deleted in a save, given the did save notification. Updated companies are only reindexed if their
+// ticker or name changed. Must be called on the saving context's queue.
+- (void)updateWithContextDidSaveNotification:(NSNotification *)notification;
+
+// Remove the companies with the given object ids from the index e.g. after they were bulk deleted in the store, which doesn't go through a save. Can be called from any thread.
+- (void)removeCompaniesWithObjectIDs:(NSArray *)objectIDs;
+
+@end
@@ -0,0 +1,439 @@
+//
+//  FACompanySearchIndex.m
+//  FinApp
+//
+//  Class that keeps an in memory index of the ticker and name of every company, so that
+//  search as you type doesn't have to scan the companies in the data store on every
+//  keystroke. Tickers and names are case and diacritic folded, kept in sorted arrays for
+//  prefix lookups and in a trigram index for substring lookups. The index is built from
+//  the data store the first time it's needed and kept up to date as companies are saved.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FACompanySearchIndex.h"
+#import "FADataStore.h"
+#import "Company.h"
+
+// Length of the grams that substring lookups go through. Search text shorter than this is matched by scanning the folded entries.
+static const NSUInteger FASearchGramLength = 3;
+
+@interface FACompanySearchIndex ()
+
+// Has the index been built from the data store yet
+@property (nonatomic) BOOL built;
+
+// Entries, one per company, at their slot. An entry is a dictionary with the slot for key "slot", the ticker key for "tickerKey",
+// the folded ticker for "ticker", the folded name for "name" and the company's ticker and name, as saved, for "companyTicker" and "companyName".
+// Removed entries leave an NSNull behind, so slots never move. A company whose ticker or name changes keeps it's slot.
+@property (strong, nonatomic) NSMutableArray *entries;
+
+// Slot for each company, keyed by the company's object id.
+@property (strong, nonatomic) NSMutableDictionary *slotsByObjectID;
+
+// Entries sorted by folded ticker, for prefix lookups on ticker.
+@property (strong, nonatomic) NSMutableArray *entriesByTicker;
+
+// Entries sorted by folded name, for prefix lookups on name.
+@property (strong, nonatomic) NSMutableArray *entriesByName;
+
+// Slots of the entries whose folded ticker or name contain a gram, keyed by gram.
+@property (strong, nonatomic) NSMutableDictionary *slotsByGram;
+
+// Fold the text so that it matches regardless of case and diacritics, the same way a contains[cd] predicate does.
+- (NSString *)foldedText:(NSString *)text;
+
+// Add all the companies in the data store of the context to the index and mark it built. Must be called with the index locked.
+- (void)addCompaniesInContext:(NSManagedObjectContext *)context;
+
+// Add a company to the index, replacing any entry it already has in the same slot, unless it's ticker and name are unchanged. Must be called with the index locked.
+- (void)addCompanyWithObjectID:(NSManagedObjectID *)objectID ticker:(NSString *)ticker name:(NSString *)name;
+
+// Remove a company from the index. Must be called with the index locked.
+- (void)removeCompanyWithObjectID:(NSManagedObjectID *)objectID;
+
+// Take an entry out of the sorted entries and the gram postings, leaving it's slot alone. Must be called with the index locked.
+- (void)removeEntryFromLookups:(NSDictionary *)entry;
+
+// Insert an entry into entries sorted on the given key.
+- (void)insertEntry:(NSDictionary *)entry intoSortedEntries:(NSMutableArray *)sortedEntries onKey:(NSString *)key;
+
+// Remove an entry from entries sorted on the given key, finding it by binary search instead of scanning them all.
+- (void)removeEntry:(NSDictionary *)entry fromSortedEntries:(NSMutableArray *)sortedEntries onKey:(NSString *)key;
+
+// Get the entries, from entries sorted on the given key, whose key starts with the prefix.
+- (NSArray *)entriesWithPrefix:(NSString *)prefix inSortedEntries:(NSArray *)sortedEntries onKey:(NSString *)key;
+
+// Add the slot to the postings of every gram in the text.
+- (void)addSlot:(NSUInteger)slot forGramsInText:(NSString *)text;
+
+// Remove the slot from the postings of every gram in the text, dropping postings left empty.
+- (void)removeSlot:(NSUInteger)slot forGramsInText:(NSString *)text;
+
+@end
+
+@implementation FACompanySearchIndex
+
+static FACompanySearchIndex *sharedInstance;
+
+// Implement this class as a Singleton so that there's a single index kept up to date for the whole app.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a company search index doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FACompanySearchIndex alloc] init];
+    }
+}
+
+// Create and/or return the single shared company search index
++ (FACompanySearchIndex *)sharedIndex {
+
+    return sharedInstance;
+}
+
+// Set up an empty index.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.entries = [[NSMutableArray alloc] init];
+        self.slotsByObjectID = [[NSMutableDictionary alloc] init];
+        self.entriesByTicker = [[NSMutableArray alloc] init];
+        self.entriesByName = [[NSMutableArray alloc] init];
+        self.slotsByGram = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Building and Updating
+
+// Build the index from the companies in the data store, if it hasn't been built already. Can be called from any thread.
+- (void)buildIfNeeded
+{
+    @synchronized(self) {
+
+        if (self.built) {
+            return;
+        }
+
+        NSManagedObjectContext *buildContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+        [buildContext setParentContext:[[FADataStore sharedStore] writerContext]];
+        [self addCompaniesInContext:buildContext];
+    }
+}
+
+// Throw away the index and build it again from the companies in the data store of the given context, instead of the app's. Can be called from any thread.
+- (void)rebuildFromContext:(NSManagedObjectContext *)context
+{
+    @synchronized(self) {
+        [self reset];
+        [self addCompaniesInContext:context];
+    }
+}
+
+// Throw away the index, so that it's built again from the app's data store the next time it's needed.
+- (void)reset
+{
+    @synchronized(self) {
+        [self.entries removeAllObjects];
+        [self.slotsByObjectID removeAllObjects];
+        [self.entriesByTicker removeAllObjects];
+        [self.entriesByName removeAllObjects];
+        [self.slotsByGram removeAllObjects];
+        self.built = NO;
+    }
+}
+
+// Add all the companies in the data store of the context to the index and mark it built. Must be called with the index locked.
+- (void)addCompaniesInContext:(NSManagedObjectContext *)context
+{
+    // Get just the ticker, name and object id of every company, without creating managed objects for them
+    [context performBlockAndWait:^{
+
+        NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+        NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:context];
+        [companyFetchRequest setEntity:companyEntity];
+        NSExpressionDescription *objectIDDescription = [[NSExpressionDescription alloc] init];
+        [objectIDDescription setName:@"objectID"];
+        [objectIDDescription setExpression:[NSExpression expressionForEvaluatedObject]];
+        [objectIDDescription setExpressionResultType:NSObjectIDAttributeType];
+        [companyFetchRequest setPropertiesToFetch:@[@"ticker", @"name", objectIDDescription]];
+        [companyFetchRequest setResultType:NSDictionaryResultType];
+        NSError *error;
+        NSArray *fetchedCompanies = [context executeFetchRequest:companyFetchRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting all companies from data store, to build the company search index, failed: %@",error.description);
+            return;
+        }
+
+        for (NSDictionary *fetchedCompany in fetchedCompanies) {
+            [self addCompanyWithObjectID:[fetchedCompany objectForKey:@"objectID"] ticker:[fetchedCompany objectForKey:@"ticker"] name:[fetchedCompany objectForKey:@"name"]];
+        }
+        self.built = YES;
+    }];
+}
+
+// Update the index with the companies inserted, updated or deleted in a save, given the did save notification. Updated companies are only reindexed if their
+// ticker or name changed. Must be called on the saving context's queue.
+- (void)updateWithContextDidSaveNotification:(NSNotification *)notification
+{
+    @synchronized(self) {
+
+        // If the index hasn't been built yet, these changes will be picked up when it is
+        if (!self.built) {
+            return;
+        }
+
+        for (NSManagedObject *deletedObject in [[notification userInfo] objectForKey:NSDeletedObjectsKey]) {
+            if ([deletedObject isKindOfClass:[Company class]]) {
+                [self removeCompanyWithObjectID:deletedObject.objectID];
+            }
+        }
+
+        // The changed values of the saved objects are already cleared by the time the save is posted, so the ticker and name are checked against the entry instead
+        NSMutableSet *savedObjects = [NSMutableSet setWithSet:[[notification userInfo] objectForKey:NSInsertedObjectsKey]];
+        [savedObjects unionSet:[[notification userInfo] objectForKey:NSUpdatedObjectsKey]];
+        for (NSManagedObject *savedObject in savedObjects) {
+            if ([savedObject isKindOfClass:[Company class]]) {
+                Company *savedCompany = (Company *)savedObject;
+                [self addCompanyWithObjectID:savedCompany.objectID ticker:savedCompany.ticker name:savedCompany.name];
+            }
+        }
+    }
+}
+
+// Remove the companies with the given object ids from the index e.g. after they were bulk deleted in the store, which doesn't go through a save. Can be called from any thread.
+- (void)removeCompaniesWithObjectIDs:(NSArray *)objectIDs
+{
+    @synchronized(self) {
+        for (NSManagedObjectID *objectID in objectIDs) {
+            [self removeCompanyWithObjectID:objectID];
+        }
+    }
+}
+
+// Add a company to the index, replacing any entry it already has in the same slot, unless it's ticker and name are unchanged. Must be called with the index locked.
+- (void)addCompanyWithObjectID:(NSManagedObjectID *)objectID ticker:(NSString *)ticker name:(NSString *)name
+{
+    if (objectID == nil || ticker == nil) {
+        return;
+    }
+    NSString *companyName = name ? name : @"";
+
+    NSUInteger slot;
+    NSNumber *slotNumber = [self.slotsByObjectID objectForKey:objectID];
+    if (slotNumber != nil) {
+        // Nothing to do if the save didn't change the ticker or name e.g. it only updated the company's sync details
+        slot = [slotNumber unsignedIntegerValue];
+        NSDictionary *existingEntry = [self.entries objectAtIndex:slot];
+        if ([[existingEntry objectForKey:@"companyTicker"] isEqualToString:ticker] && [[existingEntry objectForKey:@"companyName"] isEqualToString:companyName]) {
+            return;
+        }
+        [self removeEntryFromLookups:existingEntry];
+    } else {
+        slot = self.entries.count;
+        [self.entries addObject:[NSNull null]];
+        [self.slotsByObjectID setObject:@(slot) forKey:objectID];
+    }
+
+    NSString *foldedTicker = [self foldedText:ticker];
+    NSString *foldedName = [self foldedText:companyName];
+    NSDictionary *entry = @{@"slot": @(slot), @"tickerKey": [ticker uppercaseString], @"ticker": foldedTicker, @"name": foldedName, @"companyTicker": ticker, @"companyName": companyName};
+
+    [self.entries replaceObjectAtIndex:slot withObject:entry];
+    [self insertEntry:entry intoSortedEntries:self.entriesByTicker onKey:@"ticker"];
+    [self insertEntry:entry intoSortedEntries:self.entriesByName onKey:@"name"];
+    [self addSlot:slot forGramsInText:foldedTicker];
+    [self addSlot:slot forGramsInText:foldedName];
+}
+
+// Remove a company from the index. Must be called with the index locked.
+- (void)removeCompanyWithObjectID:(NSManagedObjectID *)objectID
+{
+    NSNumber *slotNumber = [self.slotsByObjectID objectForKey:objectID];
+    if (slotNumber == nil) {
+        return;
+    }
+
+    NSUInteger slot = [slotNumber unsignedIntegerValue];
+    [self removeEntryFromLookups:[self.entries objectAtIndex:slot]];
+    [self.entries replaceObjectAtIndex:slot withObject:[NSNull null]];
+    [self.slotsByObjectID removeObjectForKey:objectID];
+}
+
+// Take an entry out of the sorted entries and the gram postings, leaving it's slot alone. Must be called with the index locked.
+- (void)removeEntryFromLookups:(NSDictionary *)entry
+{
+    NSUInteger slot = [[entry objectForKey:@"slot"] unsignedIntegerValue];
+    [self removeEntry:entry fromSortedEntries:self.entriesByTicker onKey:@"ticker"];
+    [self removeEntry:entry fromSortedEntries:self.entriesByName onKey:@"name"];
+    [self removeSlot:slot forGramsInText:[entry objectForKey:@"ticker"]];
+    [self removeSlot:slot forGramsInText:[entry objectForKey:@"name"]];
+}
+
+// Insert an entry into entries sorted on the given key.
+- (void)insertEntry:(NSDictionary *)entry intoSortedEntries:(NSMutableArray *)sortedEntries onKey:(NSString *)key
+{
+    NSUInteger insertionIndex = [sortedEntries indexOfObject:entry inSortedRange:NSMakeRange(0, sortedEntries.count) options:NSBinarySearchingInsertionIndex usingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+        return [[entry1 objectForKey:key] compare:[entry2 objectForKey:key]];
+    }];
+    [sortedEntries insertObject:entry atIndex:insertionIndex];
+}
+
+// Remove an entry from entries sorted on the given key, finding it by binary search instead of scanning them all.
+- (void)removeEntry:(NSDictionary *)entry fromSortedEntries:(NSMutableArray *)sortedEntries onKey:(NSString *)key
+{
+    NSString *entryKey = [entry objectForKey:key];
+    NSUInteger index = [sortedEntries indexOfObject:entry inSortedRange:NSMakeRange(0, sortedEntries.count) options:NSBinarySearchingFirstEqual usingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+        return [[entry1 objectForKey:key] compare:[entry2 objectForKey:key]];
+    }];
+    if (index == NSNotFound) {
+        return;
+    }
+
+    // Companies can share a key e.g. the same name, so find this one among them
+    while ((index < sortedEntries.count) && [[[sortedEntries objectAtIndex:index] objectForKey:key] isEqualToString:entryKey]) {
+        if ([sortedEntries objectAtIndex:index] == entry) {
+            [sortedEntries removeObjectAtIndex:index];
+            return;
+        }
+        index++;
+    }
+}
+
+// Add the slot to the postings of every gram in the text.
+- (void)addSlot:(NSUInteger)slot forGramsInText:(NSString *)text
+{
+    if (text.length < FASearchGramLength) {
+        return;
+    }
+    for (NSUInteger i = 0; i <= (text.length - FASearchGramLength); i++) {
+        NSString *gram = [text substringWithRange:NSMakeRange(i, FASearchGramLength)];
+        NSMutableIndexSet *gramSlots = [self.slotsByGram objectForKey:gram];
+        if (gramSlots == nil) {
+            gramSlots = [[NSMutableIndexSet alloc] init];
+            [self.slotsByGram setObject:gramSlots forKey:gram];
+        }
+        [gramSlots addIndex:slot];
+    }
+}
+
+// Remove the slot from the postings of every gram in the text, dropping postings left empty.
+- (void)removeSlot:(NSUInteger)slot forGramsInText:(NSString *)text
+{
+    if (text.length < FASearchGramLength) {
+        return;
+    }
+    for (NSUInteger i = 0; i <= (text.length - FASearchGramLength); i++) {
+        NSString *gram = [text substringWithRange:NSMakeRange(i, FASearchGramLength)];
+        NSMutableIndexSet *gramSlots = [self.slotsByGram objectForKey:gram];
+        [gramSlots removeIndex:slot];
+        if ((gramSlots != nil) && (gramSlots.count == 0)) {
+            [self.slotsByGram removeObjectForKey:gram];
+        }
+    }
+}
+
+#pragma mark - Lookups
+
+// Get the ticker keys (uppercased tickers) of all companies whose ticker or name contains the search text, ignoring case and diacritics.
+// Companies whose ticker starts with the search text come first, followed by those whose name starts with it, followed by the rest.
+- (NSArray *)tickerKeysMatchingSearchText:(NSString *)searchText
+{
+    [self buildIfNeeded];
+
+    NSString *foldedSearchText = [self foldedText:searchText];
+    NSMutableArray *matchingTickerKeys = [[NSMutableArray alloc] init];
+    if (foldedSearchText.length == 0) {
+        return matchingTickerKeys;
+    }
+
+    @synchronized(self) {
+
+        NSMutableIndexSet *matchedSlots = [[NSMutableIndexSet alloc] init];
+
+        // Prefix matches on ticker, then name
+        for (NSString *key in @[@"ticker", @"name"]) {
+            NSArray *sortedEntries = [key isEqualToString:@"ticker"] ? self.entriesByTicker : self.entriesByName;
+            for (NSDictionary *entry in [self entriesWithPrefix:foldedSearchText inSortedEntries:sortedEntries onKey:key]) {
+                NSUInteger slot = [[entry objectForKey:@"slot"] unsignedIntegerValue];
+                if (![matchedSlots containsIndex:slot]) {
+                    [matchedSlots addIndex:slot];
+                    [matchingTickerKeys addObject:[entry objectForKey:@"tickerKey"]];
+                }
+            }
+        }
+
+        // Substring matches. Get the candidates that have every gram of the search text, rarest gram first, then check that they actually contain it.
+        // Search text shorter than a gram is checked against every entry.
+        NSMutableArray *candidateEntries = [[NSMutableArray alloc] init];
+        if (foldedSearchText.length < FASearchGramLength) {
+            [candidateEntries addObjectsFromArray:self.entriesByTicker];
+        } else {
+            NSMutableArray *gramSlotSets = [[NSMutableArray alloc] init];
+            for (NSUInteger i = 0; i <= (foldedSearchText.length - FASearchGramLength); i++) {
+                NSIndexSet *gramSlots = [self.slotsByGram objectForKey:[foldedSearchText substringWithRange:NSMakeRange(i, FASearchGramLength)]];
+                if (gramSlots == nil) {
+                    return matchingTickerKeys;
+                }
+                [gramSlotSets addObject:gramSlots];
+            }
+            [gramSlotSets sortUsingComparator:^NSComparisonResult(NSIndexSet *slots1, NSIndexSet *slots2) {
+                return [@(slots1.count) compare:@(slots2.count)];
+            }];
+            [[gramSlotSets firstObject] enumerateIndexesUsingBlock:^(NSUInteger slot, BOOL *stop) {
+                for (NSIndexSet *gramSlots in gramSlotSets) {
+                    if (![gramSlots containsIndex:slot]) {
+                        return;
+                    }
+                }
+                id entry = [self.entries objectAtIndex:slot];
+                if (entry != [NSNull null]) {
+                    [candidateEntries addObject:entry];
+                }
+            }];
+            [candidateEntries sortUsingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+                return [[entry1 objectForKey:@"ticker"] compare:[entry2 objectForKey:@"ticker"]];
+            }];
+        }
+        for (NSDictionary *entry in candidateEntries) {
+            NSUInteger slot = [[entry objectForKey:@"slot"] unsignedIntegerValue];
+            if ([matchedSlots containsIndex:slot]) {
+                continue;
+            }
+            if (([[entry objectForKey:@"ticker"] rangeOfString:foldedSearchText].location != NSNotFound)||([[entry objectForKey:@"name"] rangeOfString:foldedSearchText].location != NSNotFound)) {
+                [matchedSlots addIndex:slot];
+                [matchingTickerKeys addObject:[entry objectForKey:@"tickerKey"]];
+            }
+        }
+    }
+
+    return matchingTickerKeys;
+}
+
+// Get the entries, from entries sorted on the given key, whose key starts with the prefix.
+- (NSArray *)entriesWithPrefix:(NSString *)prefix inSortedEntries:(NSArray *)sortedEntries onKey:(NSString *)key
+{
+    // Find where the prefix would go, since everything starting with it sorts right after that
+    NSUInteger firstIndex = [sortedEntries indexOfObject:@{key: prefix} inSortedRange:NSMakeRange(0, sortedEntries.count) options:(NSBinarySearchingFirstEqual|NSBinarySearchingInsertionIndex) usingComparator:^NSComparisonResult(NSDictionary *entry1, NSDictionary *entry2) {
+        return [[entry1 objectForKey:key] compare:[entry2 objectForKey:key]];
+    }];
+    NSUInteger lastIndex = firstIndex;
+    while ((lastIndex < sortedEntries.count) && [[[sortedEntries objectAtIndex:lastIndex] objectForKey:key] hasPrefix:prefix]) {
+        lastIndex++;
+    }
+    return [sortedEntries subarrayWithRange:NSMakeRange(firstIndex, (lastIndex - firstIndex))];
+}
+
+// Fold the text so that it matches regardless of case and diacritics, the same way a contains[cd] predicate does.
+- (NSString *)foldedText:(NSString *)text
+{
+    return [text stringByFoldingWithOptions:(NSCaseInsensitiveSearch|NSDiacriticInsensitiveSearch) locale:nil];
+}
+
+@end
@@ -3,17 +3,19 @@
 //  FinApp
 //
 //  Class to interact with the core data store. Each thread should have it's own
-//  FADataController that creates a new managed object context that talks to the
-//  single data store.
+//  FADataController. On the main thread it uses the main queue context shared by the
+//  UI. On other threads it creates a new child context whose saves are merged into it.
 //
 //  Created by Sidd Singh on 3/2/15.
 //  Copyright (c) 2015 Sidd Singh. All rights reserved.
 //
 
 #import <Foundation/Foundation.h>
+#import "FAEventClassification.h"
 @class FADataStore;
 @class NSFetchedResultsController;
 @class NSManagedObjectContext;
+@class NSFetchRequest;
 @class EventHistory;
 @class Event;
 
@@ -24,12 +26,16 @@
 // A single persistent data store for this app.
 @property (strong,nonatomic) FADataStore *appDataStore;
 
-// Managed Object Context to interact with Data Store.
+// Managed Object Context to interact with Data Store. The shared main queue context on the main thread and a new background context otherwise.
 @property (strong, nonatomic) NSManagedObjectContext *managedObjectContext;
 
 // Controller containing results of queries to Core Data
 @property (strong, nonatomic) NSFetchedResultsController *resultsController;
 
+// Run the block on the queue of the data controller's context and wait till it's done. Off the main thread the context is a private queue
+// context, so do all the work with the data controller, including with the managed objects it returns, inside this.
+- (void)performBlockAndWait:(void (^)(void))block;
+
 #pragma mark - Company Data Related
 
 // Add company details to the company data store. Current design is that a company
@@ -37,6 +43,11 @@
 // it's details only if the ticker doesn't exist.
 - (void)insertUniqueCompanyWithTicker:(NSString *)companyTicker name:(NSString *)companyName;
 
+// Add a batch of companies to the company data store. Each company is described by a dictionary with keys @"ticker" and @"name".
+// Like insertUniqueCompanyWithTicker:name:, a company is only created if it's ticker doesn't already exist. Existing companies are
+// looked up with a single fetch and all inserts are committed with a single save.
+- (void)insertUniqueCompaniesWithDetails:(NSArray *)companyDetails;
+
 // Get all Companies. Returns a results controller with identities of all Companies recorded, but no more
 // than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
 - (NSFetchedResultsController *)getAllCompanies;
@@ -52,6 +63,13 @@
 // Upsert an Event along with a parent company to the Event Data Store i.e. If the specified event type for that particular company exists, update it. If not insert it.
 - (void)upsertEventWithDate:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails relatedDate:(NSDate *)eventRelatedDate type:(NSString *)eventType certainty:(NSString *)eventCertainty listedCompany:(NSString *)listedCompanyTicker estimatedEps:(NSNumber *)eventEstEps priorEndDate:(NSDate *)eventPriorEndDate actualEpsPrior:(NSNumber *)eventActualEpsPrior;
 
+// Get the details for an Event, in the form that upsertEventsWithDetails: takes, from the same fields that upsertEventWithDate takes. Any of the fields can be nil.
+- (NSDictionary *)eventDetailsWithDate:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails relatedDate:(NSDate *)eventRelatedDate type:(NSString *)eventType certainty:(NSString *)eventCertainty listedCompany:(NSString *)listedCompanyTicker estimatedEps:(NSNumber *)eventEstEps priorEndDate:(NSDate *)eventPriorEndDate actualEpsPrior:(NSNumber *)eventActualEpsPrior;
+
+// Upsert a batch of Events, created using eventDetailsWithDate, to the Event Data Store with the same matching rules as upsertEventWithDate.
+// Existing events and their parent companies are looked up with one fetch each and all changes are committed with a single save.
+- (void)upsertEventsWithDetails:(NSArray *)eventDetails;
+
 // Get all Events. Returns a results controller with identities of all Events recorded, but no more
 // than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
 - (NSFetchedResultsController *)getAllEvents;
@@ -115,15 +133,24 @@
 // Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
 - (NSFetchedResultsController *)searchEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType;
 
+// Build the fetch request for searchEventsFor:eventDisplayType: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchEventsFetchRequestFor:(NSString *)searchText eventDisplayType:(NSString *)eventType;
+
 // Search and return all following future events that match the search text dpending on the display event type. Note this is different from the type field on the event data object: 0. All (all eventTypes) 1. "Earnings" (Quarterly Earnings) 2. "Economic" (Economic Event) 3. "Product" (Product Event).NOTE: If there is a new type of product event like launch or conference added, add that here as well.
 // Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
 - (NSFetchedResultsController *)searchFollowingEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType;
 
-// Search and return all companies that match the search text on "ticker" and "name" fields for the Company.
+// Build the fetch request for searchFollowingEventsFor:eventDisplayType: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchFollowingEventsFetchRequestFor:(NSString *)searchText eventDisplayType:(NSString *)eventType;
+
+// Search and return all companies that match the search text on "ticker" and "name" fields for the Company. Matches come from the in memory company search index.
 // Returns a results controller with identities of all companies recorded, but no more than batchSize (currently set
 // to 15) objects’ data will be fetched from the data store at a time.
 - (NSFetchedResultsController *)searchCompaniesFor:(NSString *)searchText;
 
+// Build the fetch request for searchCompaniesFor: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchCompaniesFetchRequestFor:(NSString *)searchText;
+
 // Get the date for an Event given the Event Company Ticker and Event Type. Note: Currently, the listed company ticker and event type, together represent the event uniquely.
 - (NSDate *)getDateForEventOfType:(NSString *)eventType eventTicker:(NSString *)eventCompanyTicker;
 
@@ -183,6 +210,9 @@
 
 #pragma mark - Methods to call Company Data Source APIs
 
+// No of company pages to download concurrently when syncing company data from the API. Defaults to 4 if not set.
+@property (nonatomic) NSInteger companyPageSyncConcurrency;
+
 // Get a list of all companies and their tickers.
 - (void)getAllCompaniesFromApi;
 
@@ -191,6 +221,9 @@
 
 #pragma mark - Methods to call Company Event Data Source APIs
 
+// No of tickers whose earnings events are downloaded concurrently when refreshing events from the API. Defaults to 4 if not set.
+@property (nonatomic) NSInteger earningsRefreshConcurrency;
+
 // Get the event details for a company given it's ticker. NOTE: This is somewhat of a misnomer as this call only fetches the earnings event details not others like product events.
 - (void)getAllEventsFromApiWithTicker:(NSString *)companyTicker;
 
@@ -199,9 +232,14 @@
 // Get all company tickers and names from local files, which currently is a csv file and write them to the data store.
 - (void)getAllTickersAndNamesFromLocalStorage;
 
-// Get all company tickers and names from local code, which currently is hard coded here and write them to the data store. This is the one place you need add new tickers, including product ones.
-// NOTE!!!!!!!!Add a any new tickers here as we won't be syncing from file anymore.
-- (void)getAllTickersAndNamesFromLocalCode;
+// Import the bundled preseed snapshot of companies, including the newer ones with product events, economic events and the user's sync state
+// into the data store with a single save, if this version of it hasn't been imported already.
+// NOTE!!!!!!!!Add any new tickers to SeedCompanies.tsv, which is compiled into the snapshot, as we won't be syncing from file anymore.
+- (void)importPreseedSnapshotIfNeeded;
+
+// Run the one time data migrations e.g. cleaning up after a ticker change, that haven't been run on the data store yet, recording each one in it's metadata
+// as it's done so that they don't run on every launch. Typically called in a background thread after the first frame has rendered.
+- (void)runPendingDataMigrations;
 
 #pragma mark - Methods to call Economic Events Data Sources
 
@@ -223,6 +261,7 @@
 #pragma mark - Methods for Price Change Data
 
 // Get all the price change events and details from the data source APIs. This is the new version that uses the same data source as used for getting prices elsewhere.
+// Quotes for all the tracked tickers are fetched in URL length safe chunks, in parallel.
 - (void)getAllPriceChangeEventsFromApiNew;
 
 // Get all the price change events and details from the data source APIs
@@ -241,6 +280,10 @@
 // than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
 - (NSFetchedResultsController *)getAllPriceChangeEventsForFollowedStocks;
 
+// Get the biggest % up and % down moves over the given window (day, 30 days or year to date), biggest first, in the given direction or, for
+// FAPriceMoveDirectionNone, either direction. Sorts and filters on the numeric, indexed, percent of the move. A limit of 0 means no limit.
+- (NSFetchedResultsController *)getTopPriceMoveEventsForWindow:(FAPriceMoveWindow)moveWindow direction:(FAPriceMoveDirection)moveDirection limit:(NSUInteger)limit;
+
 // Get the date on which the events were last synced
 - (NSDate *)getDailyPriceEventSyncDate;
 
@@ -252,10 +295,11 @@
 
 #pragma mark - Methods to call Company Stock Data Source APIs
 
-// Get the historical and current stock prices for a company given it's ticker and the event type for which the historical data is being asked for. Currently only supported event type is Quarterly Earnings. Also, the listed company ticker and event type, together represent the event uniquely. Finally, the most current stock price that we have is yesterday.
+// Get the historical and current stock prices for a company given it's ticker and the event type for which the historical data is being asked for. Currently only supported event type is Quarterly Earnings. Also, the listed company ticker and event type, together represent the event uniquely. Finally, the most current stock price that we have is yesterday. Daily prices are kept in the local price bar store, so only the days after the last stored one are fetched, and no call is made if those are already in.
 - (void)getStockPricesFromApiForTicker:(NSString *)companyTicker companyEventType:(NSString *)eventType fromDateInclusive:(NSDate *)fromDate toDateInclusive:(NSDate *)toDate;
 
 // Get the current stock price and write that to the event history, along with the current date. Also return a string with the following format netchange_percentchange
+// Concurrent calls for different tickers are coalesced into a single multi symbol quote call.
 - (NSString *)getCurrentStockPriceFromApiForTicker:(NSString *)companyTicker companyEventType:(NSString *)eventType;
 
 #pragma mark - Data Syncing Related
@@ -280,6 +324,7 @@
 // 1. If the speculated date of an event is within 2 weeks of today, then we consider it likely that the event has been updated
 // in the remote source. The likely event also needs to have a certainty of either "Estimated" or "Unknown" to qualify for the update.
 // 2. If the confirmed date of the event is in the past.
+// Each earnings event keeps the next date on which it's likely to change, so only the events that are due are picked, with a single query, and refreshed.
 - (void)updateEventsFromRemoteIfNeeded;
 
 #pragma mark - User State Related
@@ -353,4 +398,12 @@
 // Delete all entries for a particular econ event type in the actions store that indicate that the ticker is being followed so basically entries of the following type: "OSReminder" which means creating a reminder native to iOS.
 - (void)deleteFollowingEventActionsForEconEvent:(NSString *)type;
 
+#pragma mark - Networking Related
+
+// Send an asynchronous request using NSURLSession. The completion handler is called on the session's delegate queue with the response data, response and error.
+- (void)sendAsynchronousRequest:(NSURLRequest *)request completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler;
+
+// Send a request and wait for it to complete. The calling thread is parked, not spinning, till the response arrives. Should never be called on the main thread.
+- (NSData *)sendSynchronousRequest:(NSURLRequest *)request returningResponse:(NSURLResponse **)response error:(NSError **)error;
+
 @end
@@ -17,10 +17,42 @@
 #import "User.h"
 #import "Action.h"
 #import "EventHistory.h"
+#import "FAJSONStreamReader.h"
+#import "FAQuoteBatcher.h"
+#import "FAPriceBarStore.h"
+#import "FADateCache.h"
+#import "FAMarketCalendar.h"
+#import "FACompanySearchIndex.h"
+#import "FAFollowIndex.h"
+#import "FAPreseedSnapshot.h"
+#import "FATrace.h"
 #import <FBSDKCoreKit/FBSDKCoreKit.h>
 
+// Most companies a search can match and still be looked up by ticker key. Search text matching more, typically a letter or two, falls back to a contains search.
+static const NSUInteger FAMaxTickerKeysPerSearch = 500;
+
+// Key, in the data store metadata, of the version of the last one time data migration that has been run on the data store. Kept with the store,
+// rather than in user defaults, so that a store that's recreated and seeded again has the migrations run on it again.
+static NSString * const FADataMigrationVersionKey = @"FADataMigrationVersion";
+
+// Number of days before the last locally stored daily price bar that price history fetches start from. The closes fetched for these days are checked
+// against the stored ones, to catch history that has since been adjusted for a split or dividend.
+static const NSInteger FAPriceBarOverlapDays = 7;
+
+// Version of the latest one time data migration. Bump this when adding a migration to runDataMigrationWithVersion:
+static const NSInteger FACurrentDataMigrationVersion = 1;
+
 @interface FADataController ()
 
+// Run the one time data migration with the given version.
+- (void)runDataMigrationWithVersion:(NSInteger)migrationVersion;
+
+// Download the requests, with up to window of them in flight at a time, and hand each response to the process block one at a time, in request order, on
+// the calling thread. Request at index is asked for the request with each index in turn, and returns nil if there isn't one yet. It's asked again for that
+// index after the next response is processed, since processing can reveal more requests e.g. the total no of pages. Downloading stops when there are no more
+// requests or the process block returns NO. Responses still in flight then are dropped. Should never be called on the main thread.
+- (void)fetchRequestsWithWindow:(NSInteger)window requestAtIndex:(NSURLRequest *(^)(NSInteger requestIndex))requestAtIndex processInOrder:(BOOL (^)(NSInteger requestIndex, NSData *data, NSError *error))processResponse;
+
 // Send a notification that the list of messages has changed (updated)
 - (void)sendEventsChangeNotification;
 
@@ -30,6 +62,37 @@
 // Send a notification that a queued reminder associated with an event should be created, since the event date has been confirmed. Send an array of information {eventType,companyTicker,eventDateText} that will be needed by receiver to complete this action.
 - (void)sendCreateReminderNotificationWithEventInformation:(NSArray *)eventInfo;
 
+// For price change events, return the generic part of the event type that identifies the event for a ticker e.g. "% up today" for "+1.25% up today $30.12". Return nil for all other events as they are identified by the exact type string.
+- (NSString *)genericTypeForPriceChangeEventType:(NSString *)eventType;
+
+// Return the normalized lookup keys (uppercased tickers) for the given tickers, to use in a tickerKey IN lookup.
+- (NSSet *)tickerLookupValuesForTickers:(NSArray *)tickers;
+
+// Parse the events API response for a ticker into the details of the Quarterly Earnings event, in the form that upsertEventsWithDetails: takes. Returns nil if the response doesn't have the event information.
+- (NSDictionary *)earningsEventDetailsFromResponse:(NSData *)response forTicker:(NSString *)ticker;
+
+// For an earnings event that was just upserted from the remote source, process any reminders associated with it, based on it's details.
+- (void)processRemindersForEarningsEventDetails:(NSDictionary *)eventDetail;
+
+// Get the events API endpoint, including auth token, for a company given it's ticker.
+- (NSString *)earningsEventsEndpointForTicker:(NSString *)companyTicker;
+
+// For an earnings event with the given date and certainty, work out the next date on which the remote source is likely to have changed information for it.
+- (NSDate *)nextLikelyChangeDateForEarningsEventWithDate:(NSDate *)eventDate certainty:(NSString *)eventCertainty asOf:(NSDate *)refreshDate;
+
+// Get the tickers whose earnings events are due to be refreshed from the remote source, using a single indexed query.
+- (NSArray *)tickersWithEarningsDueForRefreshAsOf:(NSDate *)refreshDate;
+
+// Refresh the earnings events for the given tickers from the remote source, with a bounded no of concurrent requests, and write them back in a single batch. Returns the no of tickers whose events were refreshed.
+- (NSInteger)refreshEarningsEventsForTickers:(NSArray *)tickers asOf:(NSDate *)refreshDate;
+
+// Get the 30 days ago and start of the year prices for the event history from the locally stored daily price bars, and write them to the event history.
+- (void)updateEventHistoryPricesFromLocalBarsForTicker:(NSString *)ticker eventType:(NSString *)type;
+
+// Get a predicate matching the companies whose ticker or name contains the search text, ignoring case and diacritics. Pass the key path to the company
+// e.g. listedCompany to match events of those companies, or nil to match the companies themselves.
+- (NSPredicate *)predicateMatchingCompaniesFor:(NSString *)searchText companyKeyPath:(NSString *)companyKeyPath;
+
 @end
 
 @implementation FADataController
@@ -49,14 +112,30 @@ bool eventsUpdated = NO;
     // Get the single persistent store for this application.
     self.appDataStore = [FADataStore sharedStore];
     
-    if ([self.appDataStore persistentStoreCoordinator] != nil) {
-        _managedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:0];
-        [_managedObjectContext setPersistentStoreCoordinator:[self.appDataStore persistentStoreCoordinator]];
+    // On the main thread share the main queue context that drives the UI. On any other thread get a new child context of the writer,
+    // whose saves are merged into the main queue context, so that the UI picks them up without refetching.
+    if ([NSThread isMainThread]) {
+        _managedObjectContext = [self.appDataStore mainContext];
+    } else {
+        _managedObjectContext = [self.appDataStore newBackgroundContext];
     }
     
     return _managedObjectContext;
 }
 
+// Run the block on the queue of the data controller's context and wait till it's done. Off the main thread the context is a private queue
+// context, so do all the work with the data controller, including with the managed objects it returns, inside this.
+- (void)performBlockAndWait:(void (^)(void))block
+{
+    NSManagedObjectContext *dataControllerContext = [self managedObjectContext];
+    if (dataControllerContext == nil) {
+        block();
+        return;
+    }
+    
+    [dataControllerContext performBlockAndWait:block];
+}
+
 #pragma mark - Company Data Related
 
 // Add company details to the company data store. Current design is that a company
@@ -69,7 +148,7 @@ bool eventsUpdated = NO;
     // Check to see if the Company exists by doing a case insensitive query on companyTicker
     NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
-    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"ticker =[c] %@",companyTicker];
+    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@",[companyTicker uppercaseString]];
     [companyFetchRequest setEntity:companyEntity];
     [companyFetchRequest setPredicate:companyPredicate];
     NSError *error;
@@ -103,6 +182,54 @@ bool eventsUpdated = NO;
     }
 }
 
+// Add a batch of companies to the company data store. Each company is described by a dictionary with keys @"ticker" and @"name".
+// Like insertUniqueCompanyWithTicker:name:, a company is only created if it's ticker doesn't already exist. Existing companies are
+// looked up with a single fetch and all inserts are committed with a single save.
+- (void)insertUniqueCompaniesWithDetails:(NSArray *)companyDetails
+{
+    if (companyDetails.count == 0) {
+        return;
+    }
+    
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    
+    // Get all the companies in the batch that already exist, in one fetch, and key them by uppercased ticker to match case insensitively
+    NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+    NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
+    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"tickerKey IN %@",[self tickerLookupValuesForTickers:[companyDetails valueForKey:@"ticker"]]];
+    [companyFetchRequest setEntity:companyEntity];
+    [companyFetchRequest setPredicate:companyPredicate];
+    NSError *error;
+    NSArray *fetchedCompanies = [dataStoreContext executeFetchRequest:companyFetchRequest error:&error];
+    if (error) {
+        NSLog(@"ERROR: Getting companies from data store, to check uniqueness when batch inserting, failed: %@",error.description);
+    }
+    NSMutableDictionary *companiesByTicker = [[NSMutableDictionary alloc] init];
+    for (Company *fetchedCompany in fetchedCompanies) {
+        if ([companiesByTicker objectForKey:[fetchedCompany.ticker uppercaseString]]) {
+            NSLog(@"SEVERE_WARNING: Found duplicate tickers for %@ when batch inserting companies to the Data Store",fetchedCompany.ticker);
+        }
+        [companiesByTicker setObject:fetchedCompany forKey:[fetchedCompany.ticker uppercaseString]];
+    }
+    
+    // Insert the companies that don't exist. Keep track of the inserted ones so that a ticker repeated in the batch is only inserted once.
+    for (NSDictionary *companyDetail in companyDetails) {
+        
+        NSString *companyTicker = [companyDetail objectForKey:@"ticker"];
+        if (companyTicker && ![companiesByTicker objectForKey:[companyTicker uppercaseString]]) {
+            Company *company = [NSEntityDescription insertNewObjectForEntityForName:@"Company" inManagedObjectContext:dataStoreContext];
+            company.ticker = companyTicker;
+            company.name = [companyDetail objectForKey:@"name"];
+            [companiesByTicker setObject:company forKey:[companyTicker uppercaseString]];
+        }
+    }
+    
+    // Insert
+    if ([dataStoreContext hasChanges] && ![dataStoreContext save:&error]) {
+        NSLog(@"ERROR: Saving a batch of unique companies, to the data store, failed: %@",error.description);
+    }
+}
+
 // Get all Companies. Returns a results controller with identities of all Companies recorded, but no more
 // than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
 - (NSFetchedResultsController *)getAllCompanies
@@ -165,7 +292,7 @@ bool eventsUpdated = NO;
     // Check to see if the Company exists by doing a case insensitive query on companyTicker
     NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
-    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"ticker =[c] %@",companyTicker];
+    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@",[companyTicker uppercaseString]];
     [companyFetchRequest setEntity:companyEntity];
     [companyFetchRequest setPredicate:companyPredicate];
     NSError *error;
@@ -204,44 +331,16 @@ bool eventsUpdated = NO;
     // TO DO: Current assumption is that an event is uniquely identified by the combination of above 2 fields. This might need to change in the future.
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    // If event is of type price change set type filter to be more generic depending on the type of price change event
+    // If event is of type price change match on the kind and direction of the move instead of the type, which has the move in it
     // "50.12% up today" "50.12% down today" "10.12% down 30 days" "30.12% down ytd"
     NSPredicate *eventPredicate = nil;
-    // For daily change event - % up today
-    if ([eventType containsString:@"% up today"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% up today"];
-    }
-    // For daily change event - % down today
-    if ([eventType containsString:@"% down today"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% down today"];
-    }
-    // For 30 days change event - % down 30 days
-    else if ([eventType containsString:@"% down 30 days"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% down 30 days"];
-    }
-    // For 30 days change event - % up 30 days
-    else if ([eventType containsString:@"% up 30 days"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% up 30 days"];
-    }
-    // For year to date change event - % down ytd
-    else if ([eventType containsString:@"% down ytd"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% down ytd"];
-    }
-    // For year to date change event - % up ytd
-    else if ([eventType containsString:@"% up ytd"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"% up ytd"];
-    }
-    // For 52 week High event
-    else if ([eventType containsString:@"52 Week High"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"52 Week High"];
-    }
-    // For 52 week Low event
-    else if ([eventType containsString:@"52 Week Low"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",listedCompanyTicker,@"52 Week Low"];
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:listedCompanyTicker];
+    if ([eventClassification isPriceMove]) {
+        eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND kind == %d AND priceMoveDirection == %d",[listedCompanyTicker uppercaseString],eventClassification.kind,(int)eventClassification.direction];
     }
     // If not a price change event, it's an exact match to the type string
     else {
-       eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",listedCompanyTicker,eventType];
+       eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[listedCompanyTicker uppercaseString],eventType];
     }
     
     [eventFetchRequest setEntity:eventEntity];
@@ -253,6 +352,12 @@ bool eventsUpdated = NO;
         NSLog(@"ERROR: Getting an event from data store, to check uniqueness when upserting, failed: %@",error.description);
     }
     
+    // Work out when an earnings event is next likely to change again, as that depends on it's date and certainty. Other events don't have one.
+    NSDate *nextRefreshDate = nil;
+    if ([FAEventClassification classificationForType:eventType ticker:listedCompanyTicker].kind == FAEventKindEarnings) {
+        nextRefreshDate = [self nextLikelyChangeDateForEarningsEventWithDate:eventDate certainty:eventCertainty asOf:[NSDate date]];
+    }
+    
     // If the event does not exist, insert it
     if (!existingEvent) {
         
@@ -260,7 +365,7 @@ bool eventsUpdated = NO;
         NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
         NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
         [companyFetchRequest setEntity:companyEntity];
-        NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"ticker =[c] %@",listedCompanyTicker];
+        NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@",[listedCompanyTicker uppercaseString]];
         [companyFetchRequest setPredicate:companyPredicate];
         Company *parentCompany = nil;
         parentCompany  = [[dataStoreContext executeFetchRequest:companyFetchRequest error:&error] lastObject];
@@ -279,6 +384,7 @@ bool eventsUpdated = NO;
         event.estimatedEps = eventEstEps;
         event.priorEndDate = eventPriorEndDate;
         event.actualEpsPrior = eventActualEpsPrior;
+        event.nextRefreshDate = nextRefreshDate;
     }
     
     // If the event exists update it
@@ -292,6 +398,7 @@ bool eventsUpdated = NO;
         existingEvent.estimatedEps = eventEstEps;
         existingEvent.priorEndDate = eventPriorEndDate;
         existingEvent.actualEpsPrior = eventActualEpsPrior;
+        existingEvent.nextRefreshDate = nextRefreshDate;
     }
     
     // Perform the insert
@@ -300,6 +407,153 @@ bool eventsUpdated = NO;
     }
 }
 
+// Get the details for an Event, in the form that upsertEventsWithDetails: takes, from the same fields that upsertEventWithDate takes. Any of the fields can be nil.
+- (NSDictionary *)eventDetailsWithDate:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails relatedDate:(NSDate *)eventRelatedDate type:(NSString *)eventType certainty:(NSString *)eventCertainty listedCompany:(NSString *)listedCompanyTicker estimatedEps:(NSNumber *)eventEstEps priorEndDate:(NSDate *)eventPriorEndDate actualEpsPrior:(NSNumber *)eventActualEpsPrior
+{
+    NSMutableDictionary *eventDetail = [[NSMutableDictionary alloc] init];
+    [eventDetail setValue:eventDate forKey:@"date"];
+    [eventDetail setValue:eventRelatedDetails forKey:@"relatedDetails"];
+    [eventDetail setValue:eventRelatedDate forKey:@"relatedDate"];
+    [eventDetail setValue:eventType forKey:@"type"];
+    [eventDetail setValue:eventCertainty forKey:@"certainty"];
+    [eventDetail setValue:listedCompanyTicker forKey:@"listedCompany"];
+    [eventDetail setValue:eventEstEps forKey:@"estimatedEps"];
+    [eventDetail setValue:eventPriorEndDate forKey:@"priorEndDate"];
+    [eventDetail setValue:eventActualEpsPrior forKey:@"actualEpsPrior"];
+    
+    return eventDetail;
+}
+
+// Upsert a batch of Events, created using eventDetailsWithDate, to the Event Data Store with the same matching rules as upsertEventWithDate.
+// Existing events and their parent companies are looked up with one fetch each and all changes are committed with a single save.
+- (void)upsertEventsWithDetails:(NSArray *)eventDetails
+{
+    if (eventDetails.count == 0) {
+        return;
+    }
+    
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    NSSet *tickerLookupValues = [self tickerLookupValuesForTickers:[eventDetails valueForKey:@"listedCompany"]];
+    NSError *error;
+    
+    // Get all existing events for the tickers in the batch, in one fetch, and group them by uppercased ticker to match case insensitively
+    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
+    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey IN %@",tickerLookupValues];
+    [eventFetchRequest setEntity:eventEntity];
+    [eventFetchRequest setPredicate:eventPredicate];
+    [eventFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"listedCompany"]];
+    NSArray *fetchedEvents = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
+    if (error) {
+        NSLog(@"ERROR: Getting events from data store, to check uniqueness when batch upserting, failed: %@",error.description);
+    }
+    NSMutableDictionary *eventsByTicker = [[NSMutableDictionary alloc] init];
+    for (Event *fetchedEvent in fetchedEvents) {
+        NSString *tickerKey = [fetchedEvent.listedCompany.ticker uppercaseString];
+        if (![eventsByTicker objectForKey:tickerKey]) {
+            [eventsByTicker setObject:[[NSMutableArray alloc] init] forKey:tickerKey];
+        }
+        [[eventsByTicker objectForKey:tickerKey] addObject:fetchedEvent];
+    }
+    
+    // Get the parent listed companies for the batch, in one fetch, keyed by uppercased ticker
+    NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+    NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
+    NSPredicate *companyPredicate = [NSPredicate predicateWithFormat:@"tickerKey IN %@",tickerLookupValues];
+    [companyFetchRequest setEntity:companyEntity];
+    [companyFetchRequest setPredicate:companyPredicate];
+    NSArray *fetchedCompanies = [dataStoreContext executeFetchRequest:companyFetchRequest error:&error];
+    if (error) {
+        NSLog(@"ERROR: Getting parent listed companies, for batch upserting associated events from data store failed: %@",error.description);
+    }
+    NSMutableDictionary *companiesByTicker = [[NSMutableDictionary alloc] init];
+    for (Company *fetchedCompany in fetchedCompanies) {
+        [companiesByTicker setObject:fetchedCompany forKey:[fetchedCompany.ticker uppercaseString]];
+    }
+    
+    for (NSDictionary *eventDetail in eventDetails) {
+        
+        NSString *eventType = [eventDetail objectForKey:@"type"];
+        NSString *listedCompanyTicker = [eventDetail objectForKey:@"listedCompany"];
+        NSString *tickerKey = [listedCompanyTicker uppercaseString];
+        if (!eventType || !tickerKey) {
+            NSLog(@"ERROR: Did not batch upsert event of type: %@ and with ticker:%@ as one of them is missing",eventType,listedCompanyTicker);
+            continue;
+        }
+        
+        // The date on which an earnings event is next likely to change depends on it's date and certainty, so work it out again on every upsert
+        // that doesn't come with it. Other events don't have one.
+        NSDate *nextRefreshDate = [eventDetail objectForKey:@"nextRefreshDate"];
+        if (!nextRefreshDate && ([FAEventClassification classificationForType:eventType ticker:listedCompanyTicker].kind == FAEventKindEarnings)) {
+            nextRefreshDate = [self nextLikelyChangeDateForEarningsEventWithDate:[eventDetail objectForKey:@"date"] certainty:[eventDetail objectForKey:@"certainty"] asOf:[NSDate date]];
+        }
+        
+        // Find the existing event for the company. Price change events are matched on the generic part of the type, others on the exact type.
+        NSString *genericEventType = [self genericTypeForPriceChangeEventType:eventType];
+        Event *existingEvent = nil;
+        for (Event *tickerEvent in [eventsByTicker objectForKey:tickerKey]) {
+            if (genericEventType ? [[tickerEvent classification].genericType isEqualToString:genericEventType] : ([tickerEvent.type caseInsensitiveCompare:eventType] == NSOrderedSame)) {
+                existingEvent = tickerEvent;
+            }
+        }
+        
+        // If the event does not exist, insert it with the parent listed company
+        if (!existingEvent) {
+            
+            Event *event = [NSEntityDescription insertNewObjectForEntityForName:@"Event" inManagedObjectContext:dataStoreContext];
+            event.type = eventType;
+            event.date = [eventDetail objectForKey:@"date"];
+            event.relatedDetails = [eventDetail objectForKey:@"relatedDetails"];
+            event.relatedDate = [eventDetail objectForKey:@"relatedDate"];
+            event.certainty = [eventDetail objectForKey:@"certainty"];
+            event.listedCompany = [companiesByTicker objectForKey:tickerKey];
+            event.estimatedEps = [eventDetail objectForKey:@"estimatedEps"];
+            event.priorEndDate = [eventDetail objectForKey:@"priorEndDate"];
+            event.actualEpsPrior = [eventDetail objectForKey:@"actualEpsPrior"];
+            event.nextRefreshDate = nextRefreshDate;
+            if ([eventDetail objectForKey:@"productImpact"]) {
+                event.productImpact = [eventDetail objectForKey:@"productImpact"];
+                event.productImpactText = [eventDetail objectForKey:@"productImpactText"];
+                event.productImpactDescription = [eventDetail objectForKey:@"productImpactDescription"];
+                event.productMoreInfoTitle = [eventDetail objectForKey:@"productMoreInfoTitle"];
+                event.productMoreInfoUrl = [eventDetail objectForKey:@"productMoreInfoUrl"];
+            }
+            
+            // Keep track of the inserted event so that a repeat of it in the batch updates it instead of inserting a duplicate
+            if (![eventsByTicker objectForKey:tickerKey]) {
+                [eventsByTicker setObject:[[NSMutableArray alloc] init] forKey:tickerKey];
+            }
+            [[eventsByTicker objectForKey:tickerKey] addObject:event];
+        }
+        
+        // If the event exists update it
+        else {
+            
+            // Don't need to update type and company as these are the unique identifiers
+            existingEvent.date = [eventDetail objectForKey:@"date"];
+            existingEvent.relatedDetails = [eventDetail objectForKey:@"relatedDetails"];
+            existingEvent.relatedDate = [eventDetail objectForKey:@"relatedDate"];
+            existingEvent.certainty = [eventDetail objectForKey:@"certainty"];
+            existingEvent.estimatedEps = [eventDetail objectForKey:@"estimatedEps"];
+            existingEvent.priorEndDate = [eventDetail objectForKey:@"priorEndDate"];
+            existingEvent.actualEpsPrior = [eventDetail objectForKey:@"actualEpsPrior"];
+            existingEvent.nextRefreshDate = nextRefreshDate;
+            if ([eventDetail objectForKey:@"productImpact"]) {
+                existingEvent.productImpact = [eventDetail objectForKey:@"productImpact"];
+                existingEvent.productImpactText = [eventDetail objectForKey:@"productImpactText"];
+                existingEvent.productImpactDescription = [eventDetail objectForKey:@"productImpactDescription"];
+                existingEvent.productMoreInfoTitle = [eventDetail objectForKey:@"productMoreInfoTitle"];
+                existingEvent.productMoreInfoUrl = [eventDetail objectForKey:@"productMoreInfoUrl"];
+            }
+        }
+    }
+    
+    // Perform the upserts
+    if ([dataStoreContext hasChanges] && ![dataStoreContext save:&error]) {
+        NSLog(@"ERROR: Saving a batch of %ld events to data store failed: %@",(long)eventDetails.count,error.description);
+    }
+}
+
 // Get all Events. Returns a results controller with identities of all Events recorded, but no more
 // than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
 - (NSFetchedResultsController *)getAllEvents
@@ -343,7 +597,7 @@ bool eventsUpdated = NO;
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type =[c] %@ OR listedCompany.ticker contains %@ OR type contains[cd] %@ OR type contains[cd] %@)", todaysDate, @"Quarterly Earnings", @"ECONOMY_", @"Launch", @"Conference"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (kind == %d OR kind == %d OR kind == %d)", todaysDate, FAEventKindEarnings, FAEventKindEcon, FAEventKindProduct];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -371,9 +625,9 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     [eventFetchRequest setEntity:eventEntity];
-    // Set the filter. Older filter had future product events of high impact.
-    //NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type =[c] %@ OR listedCompany.ticker contains %@ OR type contains[cd] %@ OR type contains[cd] %@) AND ((NOT ((relatedEventHistory.previous1Status contains[cd] %@) OR (relatedEventHistory.previous1Status contains[cd] %@) OR (relatedEventHistory.previous1Status contains[cd] %@))) OR (relatedEventHistory.previous1Status contains[cd] %@))", todaysDate, @"Quarterly Earnings", @"ECONOMY_", @"Launch", @"Conference", @"High_", @"Medium_", @"Low_", @"Very High_"];
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type =[c] %@ OR listedCompany.ticker contains %@)", todaysDate, @"Quarterly Earnings", @"ECONOMY_"];
+    // Set the filter. Older filter had future product events of very high impact, on the indexed product impact.
+    //NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (kind == %d OR kind == %d OR (kind == %d AND productImpact == %d))", todaysDate, FAEventKindEarnings, FAEventKindEcon, FAEventKindProduct, FAProductImpactVeryHigh];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (kind == %d OR kind == %d)", todaysDate, FAEventKindEarnings, FAEventKindEcon];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -408,7 +662,9 @@ bool eventsUpdated = NO;
     // Including price change events
     //NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND ((ANY actions.type == %@) OR (ANY actions.type == %@))", todaysDate, @"OSReminder", @"PriceChange"];
     // Excluding price change events
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (ANY actions.type == %@)", todaysDate, @"OSReminder"];
+    // Following a company follows all of it's events, so the indexed followed flag on the company is enough for them. Econ agencies are followed for
+    // only some of their event types, so econ events still need a reminder on them.
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND listedCompany.isFollowed == YES AND (NOT (kind IN %@)) AND ((kind != %d) OR (ANY actions.type == %@))", todaysDate, @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)], FAEventKindEcon, @"OSReminder"];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -424,32 +680,10 @@ bool eventsUpdated = NO;
     return self.resultsController;
 }
 
-// Check if the given ticker is being followed.
+// Check if the given ticker is being followed. Answered from the in memory follow index, instead of going through the actions of every event of the ticker.
 - (BOOL)isBeingFollowed:(NSString *)tickerToCheck
 {
-    BOOL beingFollowed = NO;
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get all future events with the upcoming ones first
-    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    [eventFetchRequest setEntity:eventEntity];
-    // Set the filter
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"(listedCompany.ticker =[c] %@) AND ((ANY actions.type == %@) OR (ANY actions.type == %@))", tickerToCheck, @"OSReminder", @"PriceChange"];
-    [eventFetchRequest setPredicate:datePredicate];
-    
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Checking for if a ticker is being followed, failed: %@",error.description);
-    }
-    // If any event exists that means this ticker is being followed, return true.
-    if (events.count >= 1) {
-        beingFollowed = YES;
-    }
-    
-    // else return false
-    return beingFollowed;
+    return [[FAFollowIndex sharedIndex] isTickerFollowed:tickerToCheck];
 }
 
 // Get all future earnings events including today. Returns a results controller with identities of all earnings Events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the persistent store at a time.
@@ -466,7 +700,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter for date and event type
     // Searching for events of type "Quarterly Earnings"
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND type =[c] %@", todaysDate, @"Quarterly Earnings"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d", todaysDate, FAEventKindEarnings];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -496,7 +730,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter for date and event type
     // Searching for events of type "Quarterly Earnings"
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND type =[c] %@ AND (ANY actions.type == %@)", todaysDate, @"Quarterly Earnings", @"OSReminder"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d AND listedCompany.isFollowed == YES", todaysDate, FAEventKindEarnings];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -525,7 +759,7 @@ bool eventsUpdated = NO;
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter for date and event type
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND listedCompany.ticker contains %@", todaysDate, @"ECONOMY_"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d", todaysDate, FAEventKindEcon];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -587,7 +821,8 @@ bool eventsUpdated = NO;
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter for date and event type
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND listedCompany.ticker contains %@ AND (ANY actions.type == %@)", todaysDate, @"ECONOMY_", @"OSReminder"];
+    // Econ agencies are followed for only some of their event types, so the followed flag on the agency isn't enough and the reminder on the event is checked as well.
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d AND listedCompany.isFollowed == YES AND (ANY actions.type == %@)", todaysDate, FAEventKindEcon, @"OSReminder"];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -618,7 +853,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the filter for date and event type
     // FOR BTC: Add any new cryptocurrencies here.
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (listedCompany.ticker =[c] %@ OR listedCompany.ticker =[c] %@ OR listedCompany.ticker =[c] %@ OR listedCompany.ticker =[c] %@) AND (ANY actions.type == %@)", todaysDate, @"BTC", @"ETHR", @"BCH$", @"XRP", @"OSReminder"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (tickerKey == %@ OR tickerKey == %@ OR tickerKey == %@ OR tickerKey == %@) AND listedCompany.isFollowed == YES AND (NOT (kind IN %@))", todaysDate, @"BTC", @"ETHR", @"BCH$", @"XRP", @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)]];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -655,7 +890,7 @@ bool eventsUpdated = NO;
     // New way does not include crypto.
     // NOTE: If there is a new type of product event like launch or conference added, add that here as well
     // FOR BTC - Add any new crypto currency here to make it show up in the Crypto section
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type contains[cd] %@ OR type contains[cd] %@) AND (listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@)", todaysDate, @"Launch", @"Conference", @"BTC", @"ETHR", @"BCH$", @"XRP"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d AND NOT (tickerKey IN %@)", todaysDate, FAEventKindProduct, @[@"BTC", @"ETHR", @"BCH$", @"XRP"]];
     
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
@@ -681,7 +916,7 @@ bool eventsUpdated = NO;
     NSDate *todaysDate = [self setTimeToMidnightLastNightOnDate:[NSDate date]];
     
     // Add 7 days
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *aGregorianCalendar = [FADateCache gregorianCalendar];
     NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
     differenceDayComponents.day = 7;
     NSDate *weekDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:todaysDate options:0];
@@ -692,7 +927,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the event and date filter
     // NOTE: If there is a new type of product event like launch or conference added, add that here as well
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date <= %@ AND (type contains[cd] %@ OR type contains[cd] %@)", weekDate, @"Launch", @"Conference"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date <= %@ AND kind == %d", weekDate, FAEventKindProduct];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:NO];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -754,7 +989,7 @@ bool eventsUpdated = NO;
     // NOTE: This includes conferences If there is a new type of product event like launch or conference added, add that here as well
     // NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type contains[cd] %@ OR type contains[cd] %@) AND (listedCompany.ticker =[c] %@)", sinceDate, @"Launch", @"Conference", parentTicker];
     // NOTE: This does not include conferences. If there is a new type of product event like launch or conference added, add that here as well
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type contains[cd] %@) AND (listedCompany.ticker =[c] %@)", sinceDate, @"Launch", parentTicker];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (tickerKey == %@ AND kind == %d) AND (type contains[cd] %@)", sinceDate, [parentTicker uppercaseString], FAEventKindProduct, @"Launch"];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -784,7 +1019,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the event and date filter
     // NOTE: If there is a new type of product event like launch or conference added, add that here as well
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type contains[cd] %@ OR type contains[cd] %@) AND (listedCompany.ticker =[c] %@)", todaysDate, @"Launch", @"Conference", parentTicker];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (tickerKey == %@ AND kind == %d)", todaysDate, [parentTicker uppercaseString], FAEventKindProduct];
     [eventFetchRequest setPredicate:datePredicate];
     
     NSError *error;
@@ -812,7 +1047,7 @@ bool eventsUpdated = NO;
     [eventFetchRequest setEntity:eventEntity];
     // Set the event and date filter
     // NOTE: If there is a new type of product event like launch or conference added, add that here as well
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (type contains[cd] %@ OR type contains[cd] %@) AND (ANY actions.type == %@)", todaysDate, @"Launch", @"Conference", @"OSReminder"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND kind == %d AND listedCompany.isFollowed == YES", todaysDate, FAEventKindProduct];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -828,9 +1063,8 @@ bool eventsUpdated = NO;
     return self.resultsController;
 }
 
-// Search and return all future events that match the search text dpending on the display event type. Note this is different from the type field on the event data object: 0. All (all eventTypes) 1. "Earnings" (Quarterly Earnings) 2. "Economic" (Economic Event) 3. "Product" (Product Event).NOTE: If there is a new type of product event like launch or conference added, add that here as well. 4. "Crypto" (Crypto Currency event)
-// Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
-- (NSFetchedResultsController *)searchEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
+// Build the fetch request for searchEventsFor:eventDisplayType: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchEventsFetchRequestFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
 {
     NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
     
@@ -856,10 +1090,14 @@ bool eventsUpdated = NO;
     // Setup the filtering based on the event type
     NSPredicate *searchPredicate = nil;
     
+    // Match the ticker or name of the listed company using the in memory company search index, and the type on the event
+    NSPredicate *companyMatchPredicate = [self predicateMatchingCompaniesFor:searchText companyKeyPath:@"listedCompany"];
+    NSPredicate *typeMatchPredicate = [NSPredicate predicateWithFormat:@"type contains[cd] %@", searchText];
+    
     // Check to see if the event type is "All". Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all events
     if ([eventType caseInsensitiveCompare:@"All"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND (NOT ((type contains[cd] %@) OR (type contains[cd] %@)))", searchText, searchText, searchText, todaysDate, @"% up", @"% down"];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(date >= %@) AND (NOT (kind IN %@))", todaysDate, @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove)]]]];
         //searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@)", searchText, searchText, searchText, todaysDate];
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
@@ -867,22 +1105,22 @@ bool eventsUpdated = NO;
     // Check to see if the event display type is "Home". Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all events, Exclude product events with impact other than Very High. No longer including product events.
     if ([eventType caseInsensitiveCompare:@"Home"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        //searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND (NOT ((type contains[cd] %@) OR (type contains[cd] %@) OR (type contains[cd] %@))) AND ((NOT ((relatedEventHistory.previous1Status contains[cd] %@) OR (relatedEventHistory.previous1Status contains[cd] %@) OR (relatedEventHistory.previous1Status contains[cd] %@))) OR (relatedEventHistory.previous1Status contains[cd] %@))", searchText, searchText, searchText, todaysDate, @"% up", @"% down", @"52 Week", @"High_", @"Medium_", @"Low_", @"Very High_"];
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND (NOT ((type contains[cd] %@) OR (type contains[cd] %@) OR (type contains[cd] %@) OR (type contains[cd] %@) OR (type contains[cd] %@)))", searchText, searchText, searchText, todaysDate, @"% up", @"% down", @"52 Week", @"Launch", @"Conference"];
+        //searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(date >= %@) AND (NOT (kind IN %@)) AND ((kind != %d) OR (productImpact == %d))", todaysDate, @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)], FAEventKindProduct, FAProductImpactVeryHigh]]];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(date >= %@) AND (NOT (kind IN %@))", todaysDate, @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow), @(FAEventKindProduct)]]]];
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
     
     // Check to see if the event type is "Earnings". Search on "ticker" or "name" fields for the listed Company for earnings events
     if ([eventType caseInsensitiveCompare:@"Earnings"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@) AND (type =[c] %@) AND (date >= %@)", searchText, searchText, @"Quarterly Earnings", todaysDate];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[companyMatchPredicate, [NSPredicate predicateWithFormat:@"(kind == %d) AND (date >= %@)", FAEventKindEarnings, todaysDate]]];
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
     
     // Check to see if the event type is "Economic". Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all economic events
     if ([eventType caseInsensitiveCompare:@"Economic"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (listedCompany.ticker contains %@) AND (date >= %@)", searchText, searchText, searchText, @"ECONOMY_", todaysDate];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(kind == %d) AND (date >= %@)", FAEventKindEcon, todaysDate]]];
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
     
@@ -905,13 +1143,23 @@ bool eventsUpdated = NO;
         
         // New way does not include crypto events and only allows future events.
         // FOR BTC - Add any new crypto currency here to make it show up in the Crypto section
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (type contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND (listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@ AND listedCompany.ticker !=[c] %@)", searchText, searchText, searchText, @"Launch", @"Conference", todaysDate, @"BTC", @"ETHR", @"BCH$", @"XRP"];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(kind == %d) AND (date >= %@) AND NOT (tickerKey IN %@)", FAEventKindProduct, todaysDate, @[@"BTC", @"ETHR", @"BCH$", @"XRP"]]]];
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
     
     [eventFetchRequest setPredicate:searchPredicate];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
     
+    return eventFetchRequest;
+}
+
+// Search and return all future events that match the search text dpending on the display event type. Note this is different from the type field on the event data object: 0. All (all eventTypes) 1. "Earnings" (Quarterly Earnings) 2. "Economic" (Economic Event) 3. "Product" (Product Event).NOTE: If there is a new type of product event like launch or conference added, add that here as well. 4. "Crypto" (Crypto Currency event)
+// Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
+- (NSFetchedResultsController *)searchEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
+{
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    NSFetchRequest *eventFetchRequest = [self searchEventsFetchRequestFor:searchText eventDisplayType:eventType];
+    
     self.resultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:eventFetchRequest
                                                                  managedObjectContext:dataStoreContext sectionNameKeyPath:nil
                                                                             cacheName:nil];
@@ -924,9 +1172,8 @@ bool eventsUpdated = NO;
     return self.resultsController;
 }
 
-// Search and return all following future events that match the search text depending on the display event type. Note this is different from the type field on the event data object: 0. All (all eventTypes) 1. "Earnings" (Quarterly Earnings) 2. "Economic" (Economic Event) 3. "Product" (Product Event).NOTE: If there is a new type of product event like launch or conference added, add that here as well.
-// Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
-- (NSFetchedResultsController *)searchFollowingEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
+// Build the fetch request for searchFollowingEventsFor:eventDisplayType: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchFollowingEventsFetchRequestFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
 {
     NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
     // Sort with the closest event first
@@ -943,13 +1190,17 @@ bool eventsUpdated = NO;
     // Setup the filtering based on the event type
     NSPredicate *searchPredicate = nil;
     
+    // Match the ticker or name of the listed company using the in memory company search index, and the type on the event
+    NSPredicate *companyMatchPredicate = [self predicateMatchingCompaniesFor:searchText companyKeyPath:@"listedCompany"];
+    NSPredicate *typeMatchPredicate = [NSPredicate predicateWithFormat:@"type contains[cd] %@", searchText];
+    
     // Check to see if the event type is "All". Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all events
     if ([eventType caseInsensitiveCompare:@"All"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
         // Price change events included
         //searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND ((ANY actions.type == %@) OR (ANY actions.type == %@))", searchText, searchText, searchText, todaysDate, @"OSReminder", @"PriceChange"];
-        // Price change events excluded
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (date >= %@) AND (ANY actions.type == %@)", searchText, searchText, searchText, todaysDate, @"OSReminder"];
+        // Price change events excluded. Econ agencies are followed for only some of their event types, so econ events still need a reminder on them.
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(date >= %@) AND listedCompany.isFollowed == YES AND (NOT (kind IN %@)) AND ((kind != %d) OR (ANY actions.type == %@))", todaysDate, @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)], FAEventKindEcon, @"OSReminder"]]];
         // Sort with the closest event first
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
@@ -957,7 +1208,7 @@ bool eventsUpdated = NO;
     // Check to see if the event type is "Earnings". Search on "ticker" or "name" fields for the listed Company for earnings events
     if ([eventType caseInsensitiveCompare:@"Earnings"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@) AND (type =[c] %@) AND (date >= %@) AND (ANY actions.type == %@)", searchText, searchText, @"Quarterly Earnings", todaysDate, @"OSReminder"];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[companyMatchPredicate, [NSPredicate predicateWithFormat:@"(kind == %d) AND (date >= %@) AND listedCompany.isFollowed == YES", FAEventKindEarnings, todaysDate]]];
         // Sort with the closest event first
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
@@ -965,7 +1216,8 @@ bool eventsUpdated = NO;
     // Check to see if the event type is "Economic". Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all economic events
     if ([eventType caseInsensitiveCompare:@"Economic"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (listedCompany.ticker contains %@) AND (date >= %@) AND (ANY actions.type == %@)", searchText, searchText, searchText, @"ECONOMY_", todaysDate, @"OSReminder"];
+        // Econ agencies are followed for only some of their event types, so the reminder on the event is checked as well as the followed flag.
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"(kind == %d) AND (date >= %@) AND listedCompany.isFollowed == YES AND (ANY actions.type == %@)", FAEventKindEcon, todaysDate, @"OSReminder"]]];
         // Sort with the closest event first
         sortField = [[NSSortDescriptor alloc] initWithKey:@"date" ascending:YES];
     }
@@ -974,7 +1226,7 @@ bool eventsUpdated = NO;
     if ([eventType caseInsensitiveCompare:@"Price"] == NSOrderedSame) {
         // Case and Diacractic Insensitive Filtering
         // Price change events including 52 week
-        searchPredicate = [NSPredicate predicateWithFormat:@"(listedCompany.name contains[cd] %@ OR listedCompany.ticker contains[cd] %@ OR type contains[cd] %@) AND (ANY actions.type == %@)", searchText, searchText, searchText, @"PriceChange"];
+        searchPredicate = [NSCompoundPredicate andPredicateWithSubpredicates:@[[NSCompoundPredicate orPredicateWithSubpredicates:@[companyMatchPredicate, typeMatchPredicate]], [NSPredicate predicateWithFormat:@"listedCompany.isFollowed == YES AND (kind IN %@)", @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)]]]];
         // Sort with the closest event first
         sortField = [[NSSortDescriptor alloc] initWithKey:@"listedCompany.ticker" ascending:YES];
     }
@@ -985,6 +1237,16 @@ bool eventsUpdated = NO;
     
     [eventFetchRequest setFetchBatchSize:15];
     
+    return eventFetchRequest;
+}
+
+// Search and return all following future events that match the search text depending on the display event type. Note this is different from the type field on the event data object: 0. All (all eventTypes) 1. "Earnings" (Quarterly Earnings) 2. "Economic" (Economic Event) 3. "Product" (Product Event).NOTE: If there is a new type of product event like launch or conference added, add that here as well.
+// Returns a results controller with identities of all events recorded, but no more than batchSize (currently set to 15) objects’ data will be fetched from the data store at a time.
+- (NSFetchedResultsController *)searchFollowingEventsFor:(NSString *)searchText eventDisplayType:(NSString *)eventType
+{
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    NSFetchRequest *eventFetchRequest = [self searchFollowingEventsFetchRequestFor:searchText eventDisplayType:eventType];
+    
     self.resultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:eventFetchRequest
                                                                  managedObjectContext:dataStoreContext sectionNameKeyPath:nil
                                                                             cacheName:nil];
@@ -997,10 +1259,8 @@ bool eventsUpdated = NO;
     return self.resultsController;
 }
 
-// Search and return all companies that match the search text on "ticker" and "name" fields for the Company.
-// Returns a results controller with identities of all companies recorded, but no more than batchSize (currently set
-// to 15) objects’ data will be fetched from the data store at a time.
-- (NSFetchedResultsController *)searchCompaniesFor:(NSString *)searchText
+// Build the fetch request for searchCompaniesFor: without running it, so that the same search can also be run in the background.
+- (NSFetchRequest *)searchCompaniesFetchRequestFor:(NSString *)searchText
 {
     NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
     
@@ -1009,8 +1269,8 @@ bool eventsUpdated = NO;
     NSEntityDescription *companyEntity = [NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext];
     [companyFetchRequest setEntity:companyEntity];
     
-    // Case and Diacractic Insensitive Filtering
-    NSPredicate *searchPredicate = [NSPredicate predicateWithFormat:@"name contains[cd] %@ OR ticker contains[cd] %@", searchText, searchText];
+    // Case and Diacractic Insensitive Filtering, using the in memory company search index
+    NSPredicate *searchPredicate = [self predicateMatchingCompaniesFor:searchText companyKeyPath:nil];
     [companyFetchRequest setPredicate:searchPredicate];
     
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"name" ascending:YES];
@@ -1018,6 +1278,17 @@ bool eventsUpdated = NO;
     
     [companyFetchRequest setFetchBatchSize:15];
     
+    return companyFetchRequest;
+}
+
+// Search and return all companies that match the search text on "ticker" and "name" fields for the Company.
+// Returns a results controller with identities of all companies recorded, but no more than batchSize (currently set
+// to 15) objects’ data will be fetched from the data store at a time.
+- (NSFetchedResultsController *)searchCompaniesFor:(NSString *)searchText
+{
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    NSFetchRequest *companyFetchRequest = [self searchCompaniesFetchRequestFor:searchText];
+    
     self.resultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:companyFetchRequest
                                                                  managedObjectContext:dataStoreContext sectionNameKeyPath:nil
                                                                             cacheName:nil];
@@ -1030,6 +1301,22 @@ bool eventsUpdated = NO;
     return self.resultsController;
 }
 
+// Get a predicate matching the companies whose ticker or name contains the search text, ignoring case and diacritics. Pass the key path to the company
+// e.g. listedCompany to match events of those companies, or nil to match the companies themselves. The matching companies come from the in memory
+// company search index and are looked up by ticker key, which is indexed, instead of scanning the names and tickers of all companies in the data store.
+- (NSPredicate *)predicateMatchingCompaniesFor:(NSString *)searchText companyKeyPath:(NSString *)companyKeyPath
+{
+    NSArray *matchingTickerKeys = [[FACompanySearchIndex sharedIndex] tickerKeysMatchingSearchText:searchText];
+    if (matchingTickerKeys.count <= FAMaxTickerKeysPerSearch) {
+        return [NSPredicate predicateWithFormat:@"tickerKey IN %@", matchingTickerKeys];
+    }
+    
+    // Too many companies match to look them up by ticker key, so search the names and tickers instead
+    NSString *nameKeyPath = companyKeyPath ? [NSString stringWithFormat:@"%@.name",companyKeyPath] : @"name";
+    NSString *tickerKeyPath = companyKeyPath ? [NSString stringWithFormat:@"%@.ticker",companyKeyPath] : @"ticker";
+    return [NSPredicate predicateWithFormat:@"%K contains[cd] %@ OR %K contains[cd] %@", nameKeyPath, searchText, tickerKeyPath, searchText];
+}
+
 // Get the date for an Event given the Event Company Ticker and Event Type. Note: Currently, the listed company ticker and event type, together represent the event uniquely.
 - (NSDate *)getDateForEventOfType:(NSString *)eventType eventTicker:(NSString *)eventCompanyTicker
 {
@@ -1040,7 +1327,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventCompanyTicker, eventType];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventCompanyTicker uppercaseString], eventType];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1074,7 +1361,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventCompanyTicker, eventType];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventCompanyTicker uppercaseString], eventType];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1109,7 +1396,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventsFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventsPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@",eventCompanyTicker];
+    NSPredicate *eventsPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@",[eventCompanyTicker uppercaseString]];
     [eventsFetchRequest setEntity:eventEntity];
     [eventsFetchRequest setPredicate:eventsPredicate];
     NSError *error;
@@ -1131,7 +1418,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventsFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    eventsPredicate = [NSPredicate predicateWithFormat:@"type contains[cd] %@",eventType];
+    eventsPredicate = [NSPredicate predicateWithFormat:@"kind == %d AND type contains[cd] %@",FAEventKindEcon,eventType];
     [eventsFetchRequest setEntity:eventEntity];
     [eventsFetchRequest setPredicate:eventsPredicate];
     NSError *error;
@@ -1154,7 +1441,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventCompanyTicker, eventType];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventCompanyTicker uppercaseString], eventType];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1184,7 +1471,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Searching for ticker of type "ECONOMY_FOMC" that identifies the agency that puts out the fed meeting
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@",@"ECONOMY_FOMC"];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@",@"ECONOMY_FOMC"];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1208,7 +1495,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Searching for events of type "Quarterly Earnings"
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@",@"Quarterly Earnings"];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"kind == %d",FAEventKindEarnings];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1232,62 +1519,15 @@ bool eventsUpdated = NO;
 // Delete all events that contain "FIFA 18" as these have somehow gotten into a bad state in the DB. This is a one time thing.
 - (void)deleteAllFIFA18Events
 {
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get the event by doing a case insensitive query on parent company Ticker and event type.
-    // For price change events the event type is a fuzzy match.
-    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    
-    // Filter for daily events
-    NSPredicate *eventPredicate = nil;
-    eventPredicate = [NSPredicate predicateWithFormat:@"type contains %@",@"FIFA 18"];
-    
-    // Fetch all the specific events
-    [eventFetchRequest setEntity:eventEntity];
-    [eventFetchRequest setPredicate:eventPredicate];
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting the FIFA 18 events, while trying to delete all of them, from data store failed: %@",error.description);
-    }
-    
-    // Delete all the FIFA events
-    for (NSManagedObject *fifaEvent in events) {
-        
-        [dataStoreContext deleteObject:fifaEvent];
-    }
-    
-    // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    // Delete all the FIFA events, along with their actions and history, in the store in one go
+    [[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"type contains %@",@"FIFA 18"] fromContext:[self managedObjectContext]];
 }
 
 // Delete all BBRY events since ticker has changed from BBRY to BB
 - (void)deleteAllBBRYEvents {
     
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get the events by doing a case insensitive query on parent company Ticker.
-    NSFetchRequest *eventsFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventsPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@",@"BBRY"];
-    [eventsFetchRequest setEntity:eventEntity];
-    [eventsFetchRequest setPredicate:eventsPredicate];
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventsFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting all BBRY events for deletion from data store failed: %@",error.description);
-    }
-    
-    // Delete all the FIFA events
-    for (NSManagedObject *bbryEvent in events) {
-        
-        [dataStoreContext deleteObject:bbryEvent];
-    }
-    
-    // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    // Delete all the BBRY events, along with their actions and history, in the store in one go
+    [[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"tickerKey == %@",@"BBRY"] fromContext:[self managedObjectContext]];
     
     // Delete before shipping v4.3
     //NSLog(@"DONE COMITTING DELETE OF BBRY EVENTS");
@@ -1296,30 +1536,8 @@ bool eventsUpdated = NO;
 // Delete all events where parent event ticker is empty. Need this to clear out some BBRY events since ticker has changed from BBRY to BB
 - (void)deleteAllEmptyTickerEvents {
     
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get the events by doing a case insensitive query on parent company Ticker.
-    NSFetchRequest *eventsFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventsPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker == NULL"];
-    [eventsFetchRequest setEntity:eventEntity];
-    [eventsFetchRequest setPredicate:eventsPredicate];
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventsFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting all events with empty ticker for deletion from data store failed: %@",error.description);
-    }
-    
-    // Delete all the FIFA events
-    for (NSManagedObject *noTickerEvent in events) {
-        // Delete before shipping v4.3
-        //NSLog(@"KILLING A NO TICKER EVENT:%@",noTickerEvent.description);
-        [dataStoreContext deleteObject:noTickerEvent];
-    }
-    
-    // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    // Delete all the events with no parent ticker, along with their actions and history, in the store in one go
+    [[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"listedCompany.ticker == NULL"] fromContext:[self managedObjectContext]];
     
     // Delete before shipping v4.3
     //NSLog(@"DONE COMITTING DELETE OF NULL EVENTS");
@@ -1338,7 +1556,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventTicker, eventType];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventTicker uppercaseString], eventType];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -1388,7 +1606,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1432,7 +1650,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1476,7 +1694,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1519,7 +1737,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1560,7 +1778,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1601,7 +1819,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1631,7 +1849,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *historyFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *historyEntity = [NSEntityDescription entityForName:@"EventHistory" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",eventTicker, eventType];
+    NSPredicate *historyPredicate = [NSPredicate predicateWithFormat:@"parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",[eventTicker uppercaseString], eventType];
     [historyFetchRequest setEntity:historyEntity];
     [historyFetchRequest setPredicate:historyPredicate];
     NSError *error;
@@ -1665,11 +1883,11 @@ bool eventsUpdated = NO;
     // Set no of messages being returned per page to 100
     NSInteger noOfCompaniesPerPage = 100;
     // Set no of results pages to 1
-    NSInteger noOfPages = 1;
+    __block NSInteger noOfPages = 1;
     //  Temporary Storage for noOfPages
-    NSInteger noOfPagesTemp = 1;
+    __block NSInteger noOfPagesTemp = 1;
     // Set page no to 1
-    NSInteger pageNo = 1;
+    __block NSInteger pageNo = 1;
     
     // Check to see if No Sync or a Seed Data Sync has been performed for company information.
     // In either of these scenarios, attempt a full sync from page 1 of the company API response.
@@ -1689,30 +1907,30 @@ bool eventsUpdated = NO;
         //NSLog(@"**************Entered the get all companies background thread with page No to start from:%ld", (long)pageNo);
     }
     
-    // Retrieve first page to get no of pages and then keep retrieving till you get all pages.
-    while (pageNo <= noOfPages) {
-        
-        // Append no of messages per page to the endpoint URL &per_page=300&page=1
-        endpointURL = [NSString stringWithFormat:@"%@&per_page=%ld",endpointURL,(long)noOfCompaniesPerPage];
-        
-        // Append the &sort_by=id
-        endpointURL = [NSString stringWithFormat:@"%@&sort_by=id",endpointURL];
-        
-        // Append page number to the API endpoint URL
-        endpointURL = [NSString stringWithFormat:@"%@&page=%ld",endpointURL,(long)pageNo];
+    // No of company pages that are downloaded concurrently. Processing of the pages still happens one at a time, in page order, on this thread so that the synced page checkpoint stays correct.
+    NSInteger concurrencyWindow = (self.companyPageSyncConcurrency > 0) ? self.companyPageSyncConcurrency : 4;
+    // Page no of the first page requested
+    NSInteger firstPageNo = pageNo;
+    // Flag to see if the total no of pages has been written to the user data store during this sync
+    __block BOOL totalPagesRecorded = NO;
+    
+    // Retrieve first page to get no of pages and then keep retrieving till you get all pages. Once the no of pages is known, the pages after the one being processed are requested concurrently, up to the concurrency window.
+    [self fetchRequestsWithWindow:concurrencyWindow requestAtIndex:^NSURLRequest *(NSInteger requestIndex) {
         
-        // Append auth token to the call
-        endpointURL = [NSString stringWithFormat:@"%@&auth_token=Mq-sCZjPwiJNcsTkUyoQ",endpointURL];
+        // No more pages to request till the no of pages is known to be more
+        NSInteger requestedPageNo = firstPageNo + requestIndex;
+        if (requestedPageNo > noOfPages) {
+            return nil;
+        }
         
-        NSError * error = nil;
-        NSURLResponse *response = nil;
+        // Append no of messages per page, &sort_by=id, page number and auth token to the endpoint URL e.g. &per_page=100&sort_by=id&page=1&auth_token=
+        NSString *pageURL = [NSString stringWithFormat:@"%@&per_page=%ld&sort_by=id&page=%ld&auth_token=Mq-sCZjPwiJNcsTkUyoQ",endpointURL,(long)noOfCompaniesPerPage,(long)requestedPageNo];
         
-        // Make the call synchronously
-        NSMutableURLRequest *companiesRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:endpointURL]];
-        NSData *responseData = [self sendSynchronousRequest:companiesRequest returningResponse:&response error:&error];
-
         // TO DO: For testing, comment before shipping
-        //NSLog(@"******************************************Made request to get company data with page number:%@**************",endpointURL);
+        //NSLog(@"******************************************Made request to get company data with page number:%@**************",pageURL);
+        return [NSMutableURLRequest requestWithURL:[NSURL URLWithString:pageURL]];
+        
+    } processInOrder:^BOOL(NSInteger requestIndex, NSData *responseData, NSError *error) {
         
         // Process the response
         if (error == nil)
@@ -1726,13 +1944,13 @@ bool eventsUpdated = NO;
                 [self updateUserWithTotalNoOfCompanyPagesToSync:[NSNumber numberWithInteger: noOfPagesTemp]];
             }*/
             // TO DO: COMMENT FOR PRE SEEDING DB:
-            // Enter the total no of pages of companies to sync, each time a page response is processed.
+            // Enter the total no of pages of companies to sync, the first time a page response is processed and whenever it changes after that. No need to read it back from the db.
             noOfPagesTemp = [self processCompaniesResponse:responseData];
-            [self updateUserWithTotalNoOfCompanyPagesToSync:[NSNumber numberWithInteger: noOfPagesTemp]];
-            
-            // TO DO: Optimize to not hit the db everytime.
-            // Get back total no of pages of companies in the response.
-            noOfPages = [[self getTotalNoOfCompanyPagesToSync] integerValue];
+            if (!totalPagesRecorded || (noOfPagesTemp != noOfPages)) {
+                [self updateUserWithTotalNoOfCompanyPagesToSync:[NSNumber numberWithInteger: noOfPagesTemp]];
+                totalPagesRecorded = YES;
+            }
+            noOfPages = noOfPagesTemp;
             
             // Keep the company sync status to "FullSyncStarted" but update the page number of the API response to the page that just finished.
             [self upsertUserWithCompanySyncStatus:@"FullSyncStarted" syncedPageNo:[NSNumber numberWithInteger: pageNo]];
@@ -1747,17 +1965,19 @@ bool eventsUpdated = NO;
             // Show message to user to retry
             [self sendUserMessageCreatedNotificationWithMessage:@"Oops! Click Home button then Knotifi to refresh Tickers."];
             
-            // TO DO: Test this, break out of this loop if say the connection timed out.
-            break;
+            // TO DO: Test this, break out of this loop if say the connection timed out. Any pages still in flight are dropped, the next sync restarts after the last page that was committed.
+            return NO;
         }
         // TO DO: Solidify later when implementing incremental company sync: Checking if the call for a page of company data has failed (currently indicated by no of pages = 0)
         if (noOfPagesTemp != 0) {
             ++pageNo;
         }
-        endpointURL = @"https://www.quandl.com/api/v3/datasets.json?database_code=ZEA";
         // TO DO: For testing, comment before shipping
         //NSLog(@"Page Number is:%ld and NoOfPages is:%ld",(long)pageNo,(long)noOfPages);
-    }
+        
+        // Keep going till all the pages are processed
+        return (pageNo <= noOfPages);
+    }];
     
     // Add or Update the Company Data Sync status to SeedSyncDone. Check that all pages have been processed before doing so.
     if ([[self getCompanySyncStatus] isEqualToString:@"FullSyncStarted"]&&((pageNo-1) >= [[self getTotalNoOfCompanyPagesToSync] integerValue]))
@@ -1824,25 +2044,31 @@ bool eventsUpdated = NO;
      }
     */
     
-    // Get the response into a parsed object
-    NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:response
-                                                                   options:kNilOptions
-                                                                     error:&error];
+    // Stream through the response, pulling out just the ticker and name string of each company and the total no of pages
+    NSMutableArray *parsedCompanies = [[NSMutableArray alloc] init];
+    NSDictionary *metaInformation = nil;
+    FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:response];
+    if (![responseReader enumerateRecordsAtPath:@"datasets" fields:@[@"dataset_code",@"name"] valuesAtPaths:@[@"meta.total_pages"] foundValues:&metaInformation error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {
+        [parsedCompanies addObject:record];
+    }]) {
+        // Don't add a partial page of companies. No of pages being 0 marks the call for the page as failed.
+        NSLog(@"ERROR: Could not parse the companies API response. Error description: %@",error.description);
+        return 0;
+    }
     
     // Call on to formatting and adding companies data to the core data store.
-    [self formatAddCompanies:parsedResponse];
+    [self formatAddCompanies:parsedCompanies];
     
     // Get total no of pages of company data
-    NSDictionary *metaInformation = [parsedResponse objectForKey:@"meta"];
-    noOfPages = [[metaInformation objectForKey:@"total_pages"] integerValue];
+    noOfPages = [[metaInformation objectForKey:@"meta.total_pages"] integerValue];
     
     // TO DO: For testing, comment before shipping
     //NSLog(@"Total Number of pages dynamically computed: %ld ", (long)noOfPages);
     return noOfPages;
 }
 
-// Parse the list of companies and their tickers, format them and add them to the core data message store.
-- (void)formatAddCompanies:(NSDictionary *)parsedResponse {
+// Format the list of companies and their tickers, parsed from the companies API response, and add them to the core data message store.
+- (void)formatAddCompanies:(NSArray *)parsedCompanies {
     
     /* Here's the format of the v3 API response
      {
@@ -1869,10 +2095,8 @@ bool eventsUpdated = NO;
      }
     */
     
-    // Get the list of companies first from the overall response
-    NSArray *parsedCompanies = [parsedResponse objectForKey:@"datasets"];
-    
-    // Then loop through the companies, get the appropriate fields and insert them into the data store
+    // Loop through the companies, get the appropriate fields and insert them into the data store as a single batch
+    NSMutableArray *companyDetails = [[NSMutableArray alloc] init];
     for (NSDictionary *company in parsedCompanies) {
         
         // Get the company ticker and company name string
@@ -1899,9 +2123,12 @@ bool eventsUpdated = NO;
         // TO DO: For testing, comment before shipping
         //NSLog(@"Company Name to be entered in db is: %@", companyName);
         
-        // Add company ticker and name into the data store
-        [self insertUniqueCompanyWithTicker:companyTicker name:companyName];
+        // Add company ticker and name to the batch
+        [companyDetails addObject:@{@"ticker":companyTicker, @"name":companyName}];
     }
+    
+    // Add the batch of company tickers and names into the data store
+    [self insertUniqueCompaniesWithDetails:companyDetails];
 }
 
 #pragma mark - Methods to call Company Event Data Source APIs
@@ -1909,27 +2136,16 @@ bool eventsUpdated = NO;
 // Get the event details for a company given it's ticker. NOTE: This is somewhat of a misnomer as this call only fetches the earnings event details not others like product events.
 - (void)getAllEventsFromApiWithTicker:(NSString *)companyTicker
 {
-    // Get the event details for a company given it's ticker. Call the following API:
-    // www.quandl.com/api/v3/datasets/ZEA/AAPL.json?auth_token=Mq-sCZjPwiJNcsTkUyoQ
+    // Get the event details for a company given it's ticker.
+    NSString *endpointURL = [self earningsEventsEndpointForTicker:companyTicker];
     
-    // The API endpoint URL
-    NSString *endpointURL = @"https://www.quandl.com/api/v3/datasets/ZEA";
-        
-    // Append ticker for the company to the API endpoint URL
-    // Format the ticker e.g. for V.HSR replace with V_HSR as this is how the API expects it
-    NSString *formattedCompanyTicker  = [companyTicker stringByReplacingOccurrencesOfString:@"." withString:@"_"];
-    endpointURL = [NSString stringWithFormat:@"%@/%@.json",endpointURL,formattedCompanyTicker];
-        
-    // Append auth token to the call
-    endpointURL = [NSString stringWithFormat:@"%@?auth_token=Mq-sCZjPwiJNcsTkUyoQ",endpointURL];
-    
-    // TO DO: DELETE: Use this endpoint for testing an incorrect API response.
-    // NSString *endpointURL = @"https://www.quandl.com/api/v2/datasets.json?query=*&source_code=ZEA&per_page=300&page=1&auth_token=Mq-sCZjPwiJNcsTkUyoQ";
-    
-    // For the ticker HSBC use a custom URL where you are manually updating the json, since ZEA doesn't really track HSBC. No longer needed.
-    /*if ([companyTicker caseInsensitiveCompare:@"HSBC"] == NSOrderedSame) {
-        endpointURL = @"https://gist.github.com/siddsingh/714f8c3897d644a66e116b633202b73e/raw/HSBC_Earnings.json";
-    }*/
+    // TO DO: DELETE: Use this endpoint for testing an incorrect API response.
+    // NSString *endpointURL = @"https://www.quandl.com/api/v2/datasets.json?query=*&source_code=ZEA&per_page=300&page=1&auth_token=Mq-sCZjPwiJNcsTkUyoQ";
+    
+    // For the ticker HSBC use a custom URL where you are manually updating the json, since ZEA doesn't really track HSBC. No longer needed.
+    /*if ([companyTicker caseInsensitiveCompare:@"HSBC"] == NSOrderedSame) {
+        endpointURL = @"https://gist.github.com/siddsingh/714f8c3897d644a66e116b633202b73e/raw/HSBC_Earnings.json";
+    }*/
         
     NSError * error = nil;
     NSURLResponse *response = nil;
@@ -1952,10 +2168,50 @@ bool eventsUpdated = NO;
     }
 }
 
+// Get the events API endpoint, including auth token, for a company given it's ticker. Call the following API:
+// www.quandl.com/api/v3/datasets/ZEA/AAPL.json?auth_token=Mq-sCZjPwiJNcsTkUyoQ
+- (NSString *)earningsEventsEndpointForTicker:(NSString *)companyTicker
+{
+    // The API endpoint URL
+    NSString *endpointURL = @"https://www.quandl.com/api/v3/datasets/ZEA";
+    
+    // Append ticker for the company to the API endpoint URL
+    // Format the ticker e.g. for V.HSR replace with V_HSR as this is how the API expects it
+    NSString *formattedCompanyTicker  = [companyTicker stringByReplacingOccurrencesOfString:@"." withString:@"_"];
+    endpointURL = [NSString stringWithFormat:@"%@/%@.json",endpointURL,formattedCompanyTicker];
+    
+    // Append auth token to the call
+    endpointURL = [NSString stringWithFormat:@"%@?auth_token=Mq-sCZjPwiJNcsTkUyoQ",endpointURL];
+    
+    return endpointURL;
+}
+
 // Parse the events API response and add the following events information to the data store:
 // 1. Quarterly Earnings
 - (void)processEventsResponse:(NSData *)response forTicker:(NSString *)ticker {
     
+    NSDictionary *eventDetail = [self earningsEventDetailsFromResponse:response forTicker:ticker];
+    
+    // If response is not correct, show the user an error message
+    if (eventDetail == nil)
+    {
+        [self sendUserMessageCreatedNotificationWithMessage:@"Unable to fetch. Try again later."];
+    }
+    // Else enter the event and process any reminders for it
+    else
+    {
+        // Upsert events data into the data store
+        [self upsertEventsWithDetails:@[eventDetail]];
+        
+        [self processRemindersForEarningsEventDetails:eventDetail];
+    }
+}
+
+// Parse the events API response for a ticker into the details of the following event, in the form that upsertEventsWithDetails: takes:
+// 1. Quarterly Earnings
+// Returns nil if the response doesn't have the event information e.g. if it's an error message.
+- (NSDictionary *)earningsEventDetailsFromResponse:(NSData *)response forTicker:(NSString *)ticker {
+    
     NSError *error;
     
     // For Quarterly Earnings event, we get the following pieces of information from the API response:
@@ -1996,32 +2252,27 @@ bool eventsUpdated = NO;
     //         ]
     // }
     
-    // Get the response into a parsed object
-    NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:response
-                                                                   options:kNilOptions
-                                                                     error:&error];
-    
-    // Get the overall Data Set from the response
-    NSDictionary *parsedDataSet = [parsedResponse objectForKey:@"dataset"];
-    
-    // Get the list of data slices from the overall data set
-    NSArray *parsedDataSets = [parsedDataSet objectForKey:@"data"];
-    
-    // TO DO: Delete Later. For testing purposes
-    //NSLog(@"The parsed data set is:%@",parsedDataSets.description);
+    // Stream through the response, pulling out just the items needed from the list and details of events, which is essentially the first and only
+    // data set from the list of data sets. Items are keyed by their position in the list.
+    __block NSDictionary *parsedEventsList = nil;
+    FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:response];
+    if (![responseReader enumerateRecordsAtPath:@"dataset.data" fields:@[@2,@3,@4,@8,@9,@10,@11] error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {
+        parsedEventsList = record;
+        *stop = YES;
+    }]) {
+        NSLog(@"ERROR: Could not parse the events API response for ticker:%@. Error description: %@",ticker,error.description);
+        parsedEventsList = nil;
+    }
     
     // Check to make sure that the correct response has come back. e.g. If you get an error message response from the API,
     // then you don't want to process the data and enter as events.
-    // If response is not correct, show the user an error message
-    if (parsedDataSets == NULL)
+    if (parsedEventsList == nil)
     {
-        [self sendUserMessageCreatedNotificationWithMessage:@"Unable to fetch. Try again later."];
+        return nil;
     }
-    // Else process response to enter event
+    // Else process response to get the event details
     else
     {
-        // Get the list and details of events which is essentially the first and only data set from the list of data sets
-        NSArray *parsedEventsList = [parsedDataSets objectAtIndex:0];
         
         // Next get the different pices of information for the events depending on their position in the list and details of events
         
@@ -2031,19 +2282,17 @@ bool eventsUpdated = NO;
         //NSLog(@"The event type is: %@",eventType);
         
         // Get the date on which the event takes place which is the 5th item
-        //NSLog(@"The date on which the event takes place: %@",[parsedEventsList objectAtIndex:4]);
-        NSString *eventDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:4]];
-        // Convert from string to Date
-        NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-        [eventDateFormatter setDateFormat:@"yyyyMMdd"];
-        NSDate *eventDate = [eventDateFormatter dateFromString:eventDateStr];
+        //NSLog(@"The date on which the event takes place: %@",[parsedEventsList objectForKey:@4]);
+        NSString *eventDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@4]];
+        // Convert from string to Date, directly from the yyyyMMdd day number, which is the same as going through a yyyyMMdd formatter
+        NSDate *eventDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:eventDateStr]];
         //NSLog(@"The date on which the event takes place formatted as a Date: %@",eventDate);
         
         
         // Get Details related to the event which is the 10th item
         // For Quarterly Earnings: 1 (After Market Close), 2 (Before Market Open), 3 (During Market Trading) or 4 (Unknown)
-        //NSLog(@"The timing details related to the event: %@",[parsedEventsList objectAtIndex:9]);
-        NSString *eventDetails = [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:9]];
+        //NSLog(@"The timing details related to the event: %@",[parsedEventsList objectForKey:@9]);
+        NSString *eventDetails = [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@9]];
         // Convert to human understandable string
         if ([eventDetails isEqualToString:@"1"]) {
             eventDetails = [NSString stringWithFormat:@"After Market Close"];
@@ -2063,34 +2312,31 @@ bool eventsUpdated = NO;
         // Get the Date related to the event which is the 3rd item
         // 1. "Quarterly Earnings" would have the end date of the next fiscal quarter
         // to be reported
-        // TO DO: For optimizing later: Can't I just reuse the event date formatter
-        //NSLog(@"The quarter end date related to the event: %@",[parsedEventsList objectAtIndex:2]);
-        NSString *relatedDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:2]];
+        //NSLog(@"The quarter end date related to the event: %@",[parsedEventsList objectForKey:@2]);
+        NSString *relatedDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@2]];
         // Convert from string to Date
-        NSDateFormatter *relatedDateFormatter = [[NSDateFormatter alloc] init];
-        [relatedDateFormatter setDateFormat:@"yyyyMMdd"];
-        NSDate *relatedDate = [relatedDateFormatter dateFromString:relatedDateStr];
+        NSDate *relatedDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:relatedDateStr]];
         //NSLog(@"The quarter end date related to the event formatted as a Date: %@",relatedDate);
         
         // Get the end date of the previously reported quarter which is the 12th item
-        NSString *priorEndDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:11]];
-        NSDate *priorEndDate = [relatedDateFormatter dateFromString:priorEndDateStr];
+        NSString *priorEndDateStr =  [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@11]];
+        NSDate *priorEndDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:priorEndDateStr]];
         
         // Get the Estimated EPS for the event, which is the 4th item
-        NSString *estimatedEps=  [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:3]];
+        NSString *estimatedEps=  [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@3]];
         // Convert from string to number
         NSNumberFormatter *epsFormatter = [[NSNumberFormatter alloc] init];
         epsFormatter.numberStyle = NSNumberFormatterDecimalStyle;
         NSNumber *estEpsNumber = [epsFormatter numberFromString:estimatedEps];
         
         // Get Actual EPS for previously reported quarter which is the 11th item
-        NSString *actualPriorEps=  [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:10]];
+        NSString *actualPriorEps=  [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@10]];
         NSNumber *actualPriorEpsNumber = [epsFormatter numberFromString:actualPriorEps];
         
         // Get Indicator if this event is "Confirmed" or "Estimated" or "Unknown" which is the 9th item
         // 1 (Company confirmed), 2 (Estimated based on algorithm) or 3 (Unknown)
-        //NSLog(@"The confirmation indicator for this event: %@",[parsedEventsList objectAtIndex:8]);
-        NSString *certaintyStr = [NSString stringWithFormat: @"%@", [parsedEventsList objectAtIndex:8]];
+        //NSLog(@"The confirmation indicator for this event: %@",[parsedEventsList objectForKey:@8]);
+        NSString *certaintyStr = [NSString stringWithFormat: @"%@", [parsedEventsList objectForKey:@8]];
         // Convert to human understandable string
         if ([certaintyStr isEqualToString:@"1"]) {
             certaintyStr = [NSString stringWithFormat:@"Confirmed"];
@@ -2102,151 +2348,117 @@ bool eventsUpdated = NO;
             certaintyStr = [NSString stringWithFormat:@"Unknown"];
         }
         
-        // Upsert events data into the data store
-        [self upsertEventWithDate:eventDate relatedDetails:eventDetails relatedDate:relatedDate type:eventType certainty:certaintyStr listedCompany:ticker estimatedEps:estEpsNumber priorEndDate:priorEndDate actualEpsPrior:actualPriorEpsNumber];
-        //NSLog(@"After updating event for ticker:%@ the event current quarter end date is:%@ and prior quarter end date is:%@",ticker, relatedDate,priorEndDate);
-        
-        // If this event just went from estimated to confirmed and there is a queued reminder to be created for it, fire a notification to create the reminder.
-        // Similarly if this event just went from confirmed to confirmed and there is a created reminder that exists for it, fire a notification to create a new reminder.
-        // TO DO: Optimize to not make this datastore call, when the user gets events for a ticker for the first time.
-        if (([certaintyStr isEqualToString:@"Confirmed"]&&[self doesQueuedReminderActionExistForEventWithTicker:ticker eventType:eventType])||([certaintyStr isEqualToString:@"Confirmed"]&&[self doesReminderActionExistForEventWithTicker:ticker eventType:eventType])) {
-            
-            // Create array that contains {eventType,companyTicker,eventDateText} to pass on to the notification
-            NSString *notifEventType = [NSString stringWithFormat: @"%@", eventType];
-            NSString *notifCompanyTicker = [NSString stringWithFormat: @"%@", ticker];
-            // Format the eventDateText to include the timing details
-            // Show the event date
-            NSDateFormatter *notifEventDateFormatter = [[NSDateFormatter alloc] init];
-            [notifEventDateFormatter setDateFormat:@"EEEE MMMM dd"];
-            NSString *notifEventDateTxt = [notifEventDateFormatter stringFromDate:eventDate];
-            NSString *notifEventTimeString = eventDetails;
-            // Append related details (timing information) to the event date if it's known
-            if (![notifEventTimeString isEqualToString:@"Unknown"]) {
-                //Format "After Market Close","Before Market Open", "During Market Trading" to be "After Close" & "Before Open" & "During Open"
-                if ([notifEventTimeString isEqualToString:@"After Market Close"]) {
-                    notifEventTimeString = [NSString stringWithFormat:@"After Close"];
-                }
-                if ([notifEventTimeString isEqualToString:@"Before Market Open"]) {
-                    notifEventTimeString = [NSString stringWithFormat:@"Before Open"];
-                }
-                if ([notifEventTimeString isEqualToString:@"During Market Trading"]) {
-                    notifEventTimeString = [NSString stringWithFormat:@"While Open"];
-                }
-                notifEventDateTxt = [NSString stringWithFormat:@"%@ %@ ",notifEventDateTxt,notifEventTimeString];
+        return [self eventDetailsWithDate:eventDate relatedDetails:eventDetails relatedDate:relatedDate type:eventType certainty:certaintyStr listedCompany:ticker estimatedEps:estEpsNumber priorEndDate:priorEndDate actualEpsPrior:actualPriorEpsNumber];
+    }
+}
+
+// For an earnings event that was just upserted from the remote source, process any reminders associated with it, based on it's details.
+- (void)processRemindersForEarningsEventDetails:(NSDictionary *)eventDetail {
+    
+    NSString *eventType = [eventDetail objectForKey:@"type"];
+    NSString *ticker = [eventDetail objectForKey:@"listedCompany"];
+    NSDate *eventDate = [eventDetail objectForKey:@"date"];
+    NSString *eventDetails = [eventDetail objectForKey:@"relatedDetails"];
+    NSString *certaintyStr = [eventDetail objectForKey:@"certainty"];
+    
+    // If this event just went from estimated to confirmed and there is a queued reminder to be created for it, fire a notification to create the reminder.
+    // Similarly if this event just went from confirmed to confirmed and there is a created reminder that exists for it, fire a notification to create a new reminder.
+    // TO DO: Optimize to not make this datastore call, when the user gets events for a ticker for the first time.
+    if (([certaintyStr isEqualToString:@"Confirmed"]&&[self doesQueuedReminderActionExistForEventWithTicker:ticker eventType:eventType])||([certaintyStr isEqualToString:@"Confirmed"]&&[self doesReminderActionExistForEventWithTicker:ticker eventType:eventType])) {
+        
+        // Create array that contains {eventType,companyTicker,eventDateText} to pass on to the notification
+        NSString *notifEventType = [NSString stringWithFormat: @"%@", eventType];
+        NSString *notifCompanyTicker = [NSString stringWithFormat: @"%@", ticker];
+        // Format the eventDateText to include the timing details
+        // Show the event date
+        NSDateFormatter *notifEventDateFormatter = [FADateCache formatterWithFormat:@"EEEE MMMM dd"];
+        NSString *notifEventDateTxt = [notifEventDateFormatter stringFromDate:eventDate];
+        NSString *notifEventTimeString = eventDetails;
+        // Append related details (timing information) to the event date if it's known
+        if (![notifEventTimeString isEqualToString:@"Unknown"]) {
+            //Format "After Market Close","Before Market Open", "During Market Trading" to be "After Close" & "Before Open" & "During Open"
+            if ([notifEventTimeString isEqualToString:@"After Market Close"]) {
+                notifEventTimeString = [NSString stringWithFormat:@"After Close"];
             }
-            
-            // Fire the notification, passing on the necessary information
-            [self sendCreateReminderNotificationWithEventInformation:@[notifEventType, notifCompanyTicker, notifEventDateTxt]];
+            if ([notifEventTimeString isEqualToString:@"Before Market Open"]) {
+                notifEventTimeString = [NSString stringWithFormat:@"Before Open"];
+            }
+            if ([notifEventTimeString isEqualToString:@"During Market Trading"]) {
+                notifEventTimeString = [NSString stringWithFormat:@"While Open"];
+            }
+            notifEventDateTxt = [NSString stringWithFormat:@"%@ %@ ",notifEventDateTxt,notifEventTimeString];
         }
         
-        // If this event just went from confirmed to estimated and there is a created reminder that exists for it, set it's status to
-        // Queued to indicate that a new rimder needs to be created for the next earnings call, when it gets confirmed.
-        if ([certaintyStr isEqualToString:@"Estimated"]&&[self doesReminderActionExistForEventWithTicker:ticker eventType:eventType]) {
-            
-            [self updateActionWithStatus:@"Queued" type:@"OSReminder" eventTicker:ticker eventType:eventType];
-        }
+        // Fire the notification, passing on the necessary information
+        [self sendCreateReminderNotificationWithEventInformation:@[notifEventType, notifCompanyTicker, notifEventDateTxt]];
+    }
+    
+    // If this event just went from confirmed to estimated and there is a created reminder that exists for it, set it's status to
+    // Queued to indicate that a new rimder needs to be created for the next earnings call, when it gets confirmed.
+    if ([certaintyStr isEqualToString:@"Estimated"]&&[self doesReminderActionExistForEventWithTicker:ticker eventType:eventType]) {
+        
+        [self updateActionWithStatus:@"Queued" type:@"OSReminder" eventTicker:ticker eventType:eventType];
     }
 }
 
 #pragma mark - Methods to call Company names and tickers from local files
 
-// Get all company tickers and names from local code, which currently is hard coded here and write them to the data store. This is the one place you need add new tickers, including product ones.
-// NOTE!!!!!!!!Add a any new tickers here as we won't be syncing from file anymore.
-- (void)getAllTickersAndNamesFromLocalCode {
-    
-    // Please make sure to add any new cryptocurrencies or newer tickers with product events to FADataController->updateEventsFromRemoteIfNeeded as well to make sure they are always present before prod events are synced.
-    // FOR BTC: First add all the tickers for cryptocurrencies just to be sure these are in the db.
-    [self insertUniqueCompanyWithTicker:@"BTC" name:@"Bitcoin"];
-    [self insertUniqueCompanyWithTicker:@"ETHR" name:@"Ethereum"];
-    [self insertUniqueCompanyWithTicker:@"BCH$" name:@"Bitcoin Cash"];
-    [self insertUniqueCompanyWithTicker:@"XRP" name:@"Ripple"];
-    
-    // Also add newer ones with product events first
-    [self insertUniqueCompanyWithTicker:@"BB" name:@"Blackberry"];
-    [self insertUniqueCompanyWithTicker:@"FIT" name:@"Fitbit"];
-    [self insertUniqueCompanyWithTicker:@"GOOGL" name:@"Google"];
-    [self insertUniqueCompanyWithTicker:@"GPRO" name:@"Go Pro"];
-    [self insertUniqueCompanyWithTicker:@"NTDOY" name:@"Nintendo"];
-    [self insertUniqueCompanyWithTicker:@"SNAP" name:@"Snap Inc"];
-    [self insertUniqueCompanyWithTicker:@"ROKU" name:@"Roku"];
-    
-    // First add the new tickers since 11/19/2016 manually
-    [self insertUniqueCompanyWithTicker:@"MULE" name:@"MuleSoft Inc"];
-    [self insertUniqueCompanyWithTicker:@"NTNX" name:@"Nutanix Inc"];
-    [self insertUniqueCompanyWithTicker:@"GOOS" name:@"Canada Goose Holdings"];
-    [self insertUniqueCompanyWithTicker:@"JILL" name:@"J.Jill"];
-    [self insertUniqueCompanyWithTicker:@"AYX" name:@"Alteryx"];
-    [self insertUniqueCompanyWithTicker:@"OKTA" name:@"Okta"];
-    [self insertUniqueCompanyWithTicker:@"YEXT" name:@"Yext"];
-    [self insertUniqueCompanyWithTicker:@"CLDR" name:@"Cloudera"];
-    [self insertUniqueCompanyWithTicker:@"APRN" name:@"Blue Apron Holdings"];
-    
-    // Added these on 10/06/2017
-    [self insertUniqueCompanyWithTicker:@"SWCH" name:@"Switch"];
-    [self insertUniqueCompanyWithTicker:@"DCPH" name:@"Deciphera Pharmaceuticals"];
-    [self insertUniqueCompanyWithTicker:@"RDFN" name:@"Redfin"];
-    
-    
-    // Added these starting 11/09
-    [self insertUniqueCompanyWithTicker:@"SNCR" name:@"Synchronoss Technologies"];
-    [self insertUniqueCompanyWithTicker:@"SFIX" name:@"Stitch Fix"];
-    
-    // Missing
-    [self insertUniqueCompanyWithTicker:@"TWLO" name:@"Twilio"];
-    
-    // Added these starting 04/10
-    [self insertUniqueCompanyWithTicker:@"SPOT" name:@"Spotify"];
-    [self insertUniqueCompanyWithTicker:@"DBX" name:@"Dropbox"];
-    [self insertUniqueCompanyWithTicker:@"SEND" name:@"SendGrid"];
-    [self insertUniqueCompanyWithTicker:@"ZUO" name:@"Zuora"];
-    
-    // Added these starting 03/17/2019
-    [self insertUniqueCompanyWithTicker:@"PVTL" name:@"Pivotal Software"];
-    [self insertUniqueCompanyWithTicker:@"DOCU" name:@"Docusign"];
-    [self insertUniqueCompanyWithTicker:@"BJ" name:@"BJ's Wholesale Club Holdings"];
-    [self insertUniqueCompanyWithTicker:@"NIO" name:@"NIO Inc"];
-    [self insertUniqueCompanyWithTicker:@"ADT" name:@"ADT Inc"];
-    [self insertUniqueCompanyWithTicker:@"PDD" name:@"Pinduoduo"];
-    [self insertUniqueCompanyWithTicker:@"PAGS" name:@"Pagseguro Digital"];
-    [self insertUniqueCompanyWithTicker:@"PLAN" name:@"Anaplan"];
-    [self insertUniqueCompanyWithTicker:@"SWI" name:@"SolarWinds"];
-    [self insertUniqueCompanyWithTicker:@"ESTC" name:@"Elastic"];
-    [self insertUniqueCompanyWithTicker:@"UPWK" name:@"Upwork"];
-    [self insertUniqueCompanyWithTicker:@"SVMK" name:@"SurveyMonkey"];
-    [self insertUniqueCompanyWithTicker:@"EB" name:@"Eventbrite"];
-    [self insertUniqueCompanyWithTicker:@"QTT" name:@"Qutoutiao"];
-    [self insertUniqueCompanyWithTicker:@"ARLO" name:@"Arlo Technologies"];
-    [self insertUniqueCompanyWithTicker:@"SONO" name:@"Sonos"];
-    [self insertUniqueCompanyWithTicker:@"DAVA" name:@"Endava"];
-    [self insertUniqueCompanyWithTicker:@"OPRA" name:@"Opera"];
-    [self insertUniqueCompanyWithTicker:@"JG" name:@"Aurora Mobile"];
-    [self insertUniqueCompanyWithTicker:@"CANG" name:@"Cango"];
-    [self insertUniqueCompanyWithTicker:@"TENB" name:@"Tenable Holdings"];
-    [self insertUniqueCompanyWithTicker:@"DOMO" name:@"Domo"];
-    [self insertUniqueCompanyWithTicker:@"EVER" name:@"EverQuote"];
-    [self insertUniqueCompanyWithTicker:@"ZS" name:@"Zscaler"];
-    [self insertUniqueCompanyWithTicker:@"CBLK" name:@"Carbon Black"];
-    
-    // Added these starting 05/17/2019
-    [self insertUniqueCompanyWithTicker:@"UBER" name:@"Uber Technologies"];
-    [self insertUniqueCompanyWithTicker:@"BYND" name:@"Beyond Meat"];
-    [self insertUniqueCompanyWithTicker:@"PINS" name:@"Pinterest"];
-    [self insertUniqueCompanyWithTicker:@"ZM" name:@"Zoom Video Communications"];
-    [self insertUniqueCompanyWithTicker:@"JMIA" name:@"Jumia"];
-    [self insertUniqueCompanyWithTicker:@"PD" name:@"PagerDuty"];
-    [self insertUniqueCompanyWithTicker:@"TUFN" name:@"Tufin Software Technologies"];
-    [self insertUniqueCompanyWithTicker:@"LYFT" name:@"Lyft"];
-    [self insertUniqueCompanyWithTicker:@"LEVI" name:@"Levi Strauss & Co"];
-    [self insertUniqueCompanyWithTicker:@"YETI" name:@"YETI Holdings"];
-    [self insertUniqueCompanyWithTicker:@"FSLY" name:@"Fastly"];
-    [self insertUniqueCompanyWithTicker:@"WORK" name:@"Slack"];
-    [self insertUniqueCompanyWithTicker:@"CRWD" name:@"CrowdStrike"];
-    [self insertUniqueCompanyWithTicker:@"PINS" name:@"Pinterest"];
-    [self insertUniqueCompanyWithTicker:@"LK" name:@"Luckin Coffee"];
-    
-    // TO DO: For testing, comment before shipping.Keeping it around for future pre seeding testing.
-    // Delete before shipping v4.3
-    //NSLog(@"Ended the background get incremental companies from local HARD CODE");
+// Import the bundled preseed snapshot of companies, including the newer ones with product events from SeedCompanies.tsv, economic events
+// and the user's sync state into the data store, if it hasn't been imported already. All of it is written with a single save.
+// NOTE!!!!!!!!Add any new tickers to SeedCompanies.tsv, which is compiled into the snapshot at build time, as we won't be syncing from file anymore.
+- (void)importPreseedSnapshotIfNeeded
+{
+    FAPreseedSnapshot *snapshot = [FAPreseedSnapshot bundledSnapshot];
+    if (snapshot == nil) {
+        return;
+    }
+    
+    // A new data store is seeded with the snapshot when it's created, so only import it if this seed data hasn't been imported before
+    if ([[NSUserDefaults standardUserDefaults] integerForKey:FAPreseedSnapshotVersionKey] == snapshot.seedVersion) {
+        return;
+    }
+    
+    NSError *error = nil;
+    if ([snapshot importIntoContext:[self managedObjectContext] error:&error]) {
+        [[NSUserDefaults standardUserDefaults] setInteger:snapshot.seedVersion forKey:FAPreseedSnapshotVersionKey];
+    } else {
+        NSLog(@"ERROR: Importing the preseed snapshot of %ld companies and %ld events failed: %@",(long)snapshot.companyCount,(long)snapshot.eventCount,error.description);
+    }
+}
+
+// Run the one time data migrations that haven't been run on the data store yet, in order, recording each one in it's metadata as it's done, so that
+// they don't run on every launch. Typically called in a background thread after the first frame has rendered.
+- (void)runPendingDataMigrations
+{
+    FADataStore *dataStore = [FADataStore sharedStore];
+    NSInteger migratedVersion = [[dataStore metadataValueForKey:FADataMigrationVersionKey] integerValue];
+    
+    // The migrations can be run again safely, so if the app quits before the version is written to disk, they are just run again next time
+    for (NSInteger migrationVersion = migratedVersion + 1; migrationVersion <= FACurrentDataMigrationVersion; migrationVersion++) {
+        [self runDataMigrationWithVersion:migrationVersion];
+        [dataStore setMetadataValue:[NSNumber numberWithInteger:migrationVersion] forKey:FADataMigrationVersionKey];
+    }
+}
+
+// Run the one time data migration with the given version.
+- (void)runDataMigrationWithVersion:(NSInteger)migrationVersion
+{
+    switch (migrationVersion) {
+        
+        // Ticker change from BBRY to BB
+        case 1:
+            // Delete all events from a past version that currently don't have any Ticker as the BBRY change to BB might have created some of these.
+            [self deleteAllEmptyTickerEvents];
+            // Delete all BBRY events as ticker has changed from BBRY to BB.
+            [self deleteAllBBRYEvents];
+            // Delete the BBRY ticker
+            [self deleteCompanyWithTicker:@"BBRY"];
+            break;
+            
+        default:
+            NSLog(@"ERROR: There is no data migration with version %ld",(long)migrationVersion);
+            break;
+    }
 }
 
 // Get all company tickers and names from local files, which currently is a csv file and write them to the data store.
@@ -2286,6 +2498,7 @@ bool eventsUpdated = NO;
     NSRange endTicker;
     NSRange companyNameRange;
     NSString *companyName = nil;
+    NSMutableArray *companyDetails = [[NSMutableArray alloc] init];
     
     for (NSString *tickerStr in tickerStrs) {
         
@@ -2312,12 +2525,15 @@ bool eventsUpdated = NO;
             }
         }
         
-        // Add company ticker and name into the data store
-        [self insertUniqueCompanyWithTicker:companyTicker name:companyName];
+        // Add company ticker and name to the batch
+        [companyDetails addObject:@{@"ticker":companyTicker, @"name":companyName}];
         
         ++tickerIndex;
     }
     
+    // Add the batch of company tickers and names into the data store
+    [self insertUniqueCompaniesWithDetails:companyDetails];
+    
     // Some cleanup
     // There are two tickers with the same company name T.BB and BBRY -> Blackberry Ltd This is messing up the app, so setting T.BB to say Blackberry Ltd Old
     [self deleteCompanyWithTicker:@"T.BB"];
@@ -2336,16 +2552,15 @@ bool eventsUpdated = NO;
     
     // Parse the economic events file contents
     
-    // Get the contents into a parsed object
+    // Stream through the memory mapped file to get the various economic events and just the details of them that are needed
     NSError *error;
-    NSString *eventsJsonStr = [[NSString alloc] initWithContentsOfFile:eventsFilePath encoding:NSUTF8StringEncoding error:&error];
-    NSDictionary *parsedContents = [NSJSONSerialization JSONObjectWithData:[eventsJsonStr dataUsingEncoding:NSUTF8StringEncoding] options:kNilOptions error:&error];
+    FAJSONStreamReader *eventsReader = [FAJSONStreamReader readerWithContentsOfFile:eventsFilePath error:&error];
     
-    // Loop through the parsed object to get the various economic events and their details
-    // Get the list of events first
-    NSArray *parsedEvents = [parsedContents objectForKey:@"eventSets"];
+    // Batches of the companies and events to add to the data store
+    NSMutableArray *companyDetails = [[NSMutableArray alloc] init];
+    NSMutableArray *eventDetails = [[NSMutableArray alloc] init];
     
-    for (NSDictionary *event in parsedEvents) {
+    if (![eventsReader enumerateRecordsAtPath:@"eventSets" fields:@[@"name",@"identifier",@"agency",@"moreInfoUrl",@"instances"] error:&error usingBlock:^(NSDictionary *event, BOOL *stop) {
         
         // Get the event name
         NSString *eventName = [event objectForKey:@"name"];
@@ -2362,8 +2577,8 @@ bool eventsUpdated = NO;
         // TO DO: Delete Later
         //NSLog(@"The event agency: %@", eventAgency);
         
-        // Insert the ticker and name for the event in the company data store
-        [self insertUniqueCompanyWithTicker:eventId name:eventAgency];
+        // Add the ticker and name for the event to the company batch
+        [companyDetails addObject:@{@"ticker":eventId, @"name":eventAgency}];
         
         // Get the short description for the event. Currently hardcoded. Use it later.
         //NSString *eventDesc = [event objectForKey:@"shortDescription"];
@@ -2392,17 +2607,23 @@ bool eventsUpdated = NO;
             NSNumber *eventDateAsNum = [eventInstance objectForKey:@"date"];
             // TO DO: Delete Later
             //NSLog(@"The date on which the event takes place: %@", eventDateAsNum);
-            NSString *eventDateStr =  [NSString stringWithFormat: @"%@", eventDateAsNum];
-            NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-            [eventDateFormatter setDateFormat:@"yyyyMMdd"];
-            NSDate *eventDate = [eventDateFormatter dateFromString:eventDateStr];
+            // Event dates are formatted as numbers e.g. 20190130, so convert straight from the number
+            NSDate *eventDate = [FADateCache dateForDayNumber:([eventDateAsNum respondsToSelector:@selector(intValue)] ? [eventDateAsNum intValue] : 0)];
             // TO DO: Delete Later
             //NSLog(@"The date on which the event takes place formatted as a Date: %@",eventDate);
             
-            // Insert each instance into the events datastore
-            [self upsertEventWithDate:eventDate relatedDetails:eventMoreInfoUrl relatedDate:nil type:uniqueName certainty:eventRelatedInfo listedCompany:eventId estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
+            // Add each instance to the events batch
+            [eventDetails addObject:[self eventDetailsWithDate:eventDate relatedDetails:eventMoreInfoUrl relatedDate:nil type:uniqueName certainty:eventRelatedInfo listedCompany:eventId estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
         }
+    }]) {
+        // Don't add a partial set of events from a file that can't be read in full
+        NSLog(@"ERROR: Could not read the economic events file at %@. Error description: %@",eventsFilePath,error.description);
+        return;
     }
+    
+    // Insert the companies first so that the events can be attached to them, then upsert the events
+    [self insertUniqueCompaniesWithDetails:companyDetails];
+    [self upsertEventsWithDetails:eventDetails];
 }
 
 #pragma mark - Methods for Product Events Data
@@ -2479,16 +2700,14 @@ bool eventsUpdated = NO;
         //NSLog(@"The API response for getting product events information is:%@",[[NSString alloc]initWithData:responseData encoding:NSUTF8StringEncoding]);
         
         // Process the response that contains the events for the company.
-        // Get the response into a parsed object
-        NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:responseData
-                                                                       options:kNilOptions
-                                                                         error:&error];
+        // Batch of approved events to upsert, along with their impact and more info details
+        NSMutableArray *eventDetails = [[NSMutableArray alloc] init];
         
-        // Loop through the parsed object to get the various product events and their details
-        // Get the list of events first
-        NSArray *parsedEvents = [parsedResponse objectForKey:@"responseData"];
+        // Event and updated on dates are formatted as e.g. 2016-09-15. They are converted straight from the day number, which is the same as going through a yyyy-MM-dd formatter.
         
-        for (NSDictionary *event in parsedEvents) {
+        // Stream through the response to get the various product events and just the details of them that are needed
+        FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:responseData];
+        if (![responseReader enumerateRecordsAtPath:@"responseData" fields:@[@"ticker",@"name",@"type",@"date",@"exactTimeLabel",@"impact",@"impactDescription",@"moreInfoTitle",@"moreInfoUrl",@"updated",@"confidence",@"approved"] error:&error usingBlock:^(NSDictionary *event, BOOL *stop) {
             
             // Get the ticker for the event's parent company
             NSString *parentTicker = [event objectForKey:@"ticker"];
@@ -2514,9 +2733,7 @@ bool eventsUpdated = NO;
             
             // Get the event date
             NSString *eventDateStr =  [event objectForKey:@"date"];
-            NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-            [eventDateFormatter setDateFormat:@"yyyy-MM-dd"];
-            NSDate *eventDate = [eventDateFormatter dateFromString:eventDateStr];
+            NSDate *eventDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:eventDateStr]];
             // TO DO: Delete Later
             //NSLog(@"The date on which the event takes place formatted as a Date: %@",eventDate);
             
@@ -2525,15 +2742,14 @@ bool eventsUpdated = NO;
             // TO DO: Delete Later
             //NSLog(@"The event time label is: %@", timeLabel);
             
-            // TO DO: Fix when you add a new table in the data model for event characteristics.
-            // For Product Events, we overload a field in Event History called previous1Status to store a string representing Impact, Impact Description, More Info Title and More Info Url i.e. (Impact_Impact Description_MoreInfoTitle_MoreInfoUrl)
-            NSString *eventAddtlInfo = [NSString stringWithFormat:@"%@_%@_%@_%@", [event objectForKey:@"impact"], [event objectForKey:@"impactDescription"], [event objectForKey:@"moreInfoTitle"], [event objectForKey:@"moreInfoUrl"]];
+            // Get the impact e.g. Very High
+            NSNumber *productImpact = [NSNumber numberWithShort:[Event productImpactForString:[event objectForKey:@"impact"]]];
             // TO DO: Delete Later
-            //NSLog(@"The event addtl info with Impact, Impact Description, More Info Title and More Info Url is: %@", eventAddtlInfo);
+            //NSLog(@"The event impact is: %@", productImpact);
             
             // Get the updated on date
             NSString *updatedOnDateStr = [event objectForKey:@"updated"];
-            NSDate *updatedOnDate = [eventDateFormatter dateFromString:updatedOnDateStr];
+            NSDate *updatedOnDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:updatedOnDateStr]];
             // TO DO: Delete Later
             //NSLog(@"The updated on date formatted as a Date: %@",updatedOnDate);
             
@@ -2566,42 +2782,61 @@ bool eventsUpdated = NO;
                         [self getAllEventsFromApiWithTicker:parentTicker];
                     }
                 }
-                // Insert each instance into the events datastore
-                [self upsertEventWithDate:eventDate relatedDetails:timeLabel relatedDate:updatedOnDate type:eventName certainty:confidenceStr listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
-                
-                // TO DO: Fix when you add a new table in the data model for event characteristics.
-                // For Product Events, we overload a field in Event History called previous1Status to store a string representing Impact, Impact Description, More Info Title and More Info Url i.e. (Impact_Impact Description_MoreInfoTitle_MoreInfoUrl)
-                [self insertHistoryWithPreviousEvent1Date:nil previousEvent1Status:eventAddtlInfo previousEvent1RelatedDate:nil currentDate:nil previousEvent1Price:nil previousEvent1RelatedPrice:nil currentPrice:nil parentEventTicker:parentTicker parentEventType:eventName];
-                
-                // If the ticker is being followed and there is no queued reminder for this event, it means it's a new event. Create a queued reminder for it even if it's confirmed, since in the very next step it will create the reminder. Also this ensures that the event is added to the following list.
-                if ([self isBeingFollowed:parentTicker]&&(![self doesReminderActionExistForSpecificEvent:eventName])) {
-                    [self insertActionOfType:@"OSReminder" status:@"Queued" eventTicker:parentTicker eventType:eventName];
-                }
-                
-                // If this product event just went from estimated to confirmed and there is a queued reminder to be created for it, and the event is not in the past, fire a notification to create the reminder.
-                if ([confidenceStr isEqualToString:@"Confirmed"]&&[self doesQueuedReminderActionExistForEventWithTicker:parentTicker eventType:eventName]&&([self calculateDistanceFromEventDate:eventDate] <= 0)) {
-                    //TO DO: For testing, delete before shipping v 2.5
-                    //NSLog(@"This product event just went from estimated to confirmed:%@ %@ with status string:%@",parentTicker,eventName,confidenceStr);
-                    // Create array that contains {eventType,companyTicker,eventDateText} to pass on to the notification
-                    NSString *notifEventType = [NSString stringWithFormat: @"%@", eventName];
-                    NSString *notifCompanyTicker = [NSString stringWithFormat: @"%@", parentTicker];
-                    // Format the eventDateText to include the timing details
-                    // Show the event date
-                    NSDateFormatter *notifEventDateFormatter = [[NSDateFormatter alloc] init];
-                    [notifEventDateFormatter setDateFormat:@"EEEE MMMM dd"];
-                    NSString *notifEventDateTxt = [notifEventDateFormatter stringFromDate:eventDate];
-                    NSString *notifEventTimeString = timeLabel;
-                    // Append timing information to the event date if it's known
-                    notifEventDateTxt = [NSString stringWithFormat:@"%@ %@ ",notifEventDateTxt,notifEventTimeString];
-                    
-                    // Fire the notification, passing on the necessary information
-                    [self sendCreateReminderNotificationWithEventInformation:@[notifEventType, notifCompanyTicker, notifEventDateTxt]];
-                }
+                // Add each instance to the events batch, with the impact, impact description and more info title and url stored as is on the event
+                NSMutableDictionary *eventDetail = [[self eventDetailsWithDate:eventDate relatedDetails:timeLabel relatedDate:updatedOnDate type:eventName certainty:confidenceStr listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil] mutableCopy];
+                [eventDetail setValue:productImpact forKey:@"productImpact"];
+                [eventDetail setValue:[event objectForKey:@"impact"] forKey:@"productImpactText"];
+                [eventDetail setValue:[event objectForKey:@"impactDescription"] forKey:@"productImpactDescription"];
+                [eventDetail setValue:[event objectForKey:@"moreInfoTitle"] forKey:@"productMoreInfoTitle"];
+                [eventDetail setValue:[event objectForKey:@"moreInfoUrl"] forKey:@"productMoreInfoUrl"];
+                [eventDetails addObject:eventDetail];
                 
             } else {
                 // TO DO: Delete Later
                 //NSLog(@"This entry is NOT APPROVED");
             }
+        }]) {
+            // Don't upsert a partial batch of events from a response that can't be read in full
+            NSLog(@"ERROR: Could not parse the product events API response. Error description: %@",error.description);
+            [eventDetails removeAllObjects];
+        }
+        
+        // Insert or update all the approved events in a single batch
+        [self upsertEventsWithDetails:eventDetails];
+        
+        // Then add the actions for each of them, as these need the event to exist
+        for (NSUInteger eventIndex = 0; eventIndex < eventDetails.count; eventIndex++) {
+            
+            NSDictionary *eventDetail = [eventDetails objectAtIndex:eventIndex];
+            NSString *parentTicker = [eventDetail objectForKey:@"listedCompany"];
+            NSString *eventName = [eventDetail objectForKey:@"type"];
+            NSDate *eventDate = [eventDetail objectForKey:@"date"];
+            NSString *timeLabel = [eventDetail objectForKey:@"relatedDetails"];
+            NSString *confidenceStr = [eventDetail objectForKey:@"certainty"];
+            
+            // If the ticker is being followed and there is no queued reminder for this event, it means it's a new event. Create a queued reminder for it even if it's confirmed, since in the very next step it will create the reminder. Also this ensures that the event is added to the following list.
+            if ([self isBeingFollowed:parentTicker]&&(![self doesReminderActionExistForSpecificEvent:eventName])) {
+                [self insertActionOfType:@"OSReminder" status:@"Queued" eventTicker:parentTicker eventType:eventName];
+            }
+            
+            // If this product event just went from estimated to confirmed and there is a queued reminder to be created for it, and the event is not in the past, fire a notification to create the reminder.
+            if ([confidenceStr isEqualToString:@"Confirmed"]&&[self doesQueuedReminderActionExistForEventWithTicker:parentTicker eventType:eventName]&&([self calculateDistanceFromEventDate:eventDate] <= 0)) {
+                //TO DO: For testing, delete before shipping v 2.5
+                //NSLog(@"This product event just went from estimated to confirmed:%@ %@ with status string:%@",parentTicker,eventName,confidenceStr);
+                // Create array that contains {eventType,companyTicker,eventDateText} to pass on to the notification
+                NSString *notifEventType = [NSString stringWithFormat: @"%@", eventName];
+                NSString *notifCompanyTicker = [NSString stringWithFormat: @"%@", parentTicker];
+                // Format the eventDateText to include the timing details
+                // Show the event date
+                NSDateFormatter *notifEventDateFormatter = [FADateCache formatterWithFormat:@"EEEE MMMM dd"];
+                NSString *notifEventDateTxt = [notifEventDateFormatter stringFromDate:eventDate];
+                NSString *notifEventTimeString = timeLabel;
+                // Append timing information to the event date if it's known
+                notifEventDateTxt = [NSString stringWithFormat:@"%@ %@ ",notifEventDateTxt,notifEventTimeString];
+                
+                // Fire the notification, passing on the necessary information
+                [self sendCreateReminderNotificationWithEventInformation:@[notifEventType, notifCompanyTicker, notifEventDateTxt]];
+            }
         }
     } else {
         // Log error to console
@@ -2664,7 +2899,6 @@ bool eventsUpdated = NO;
     dispatch_async(dispatch_get_main_queue(), ^{
         // TO DO: Delete Later.
         //NSLog(@"About to stop busy spinner");
-        [self sendEventsChangeNotification];
         [[NSNotificationCenter defaultCenter]postNotificationName:@"StopBusySpinner" object:self];
     });
 }
@@ -2678,28 +2912,18 @@ bool eventsUpdated = NO;
     // Call the Price change data source API to get the price change events. The API is:
     // marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809&symbols=UA,FB,GPRO
     
-    // First construct the string for all the tickers that are being tracked. This is basically all the tickers for whom we have quarterly earnings events, since earnings events is the superset of tickers that have events.
+    // First get all the tickers that are being tracked. This is basically all the tickers for whom we have quarterly earnings events, since earnings events is the superset of tickers that have events.
     NSFetchedResultsController *eventsController = [self getAllFutureEarningsEvents];
     NSArray *fetchedEvents = [eventsController fetchedObjects];
-    NSMutableString *tickersToFetch = [NSMutableString stringWithString:@""];
+    NSMutableArray *tickersToFetch = [[NSMutableArray alloc] init];
     for (Event *fetchedEvent in fetchedEvents) {
         
-        [tickersToFetch appendString:fetchedEvent.listedCompany.ticker];
-        [tickersToFetch appendString:@","];
+        [tickersToFetch addObject:fetchedEvent.listedCompany.ticker];
     }
-    [tickersToFetch deleteCharactersInRange:NSMakeRange([tickersToFetch length]-1, 1)];
-    
-    // Construct the API URL to call
-    NSString *endpointURL = @"http://marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809&symbols=";
-    NSString *addtlFields = @"&fields=fiftyTwoWkHigh,fiftyTwoWkHighDate,fiftyTwoWkLow,fiftyTwoWkLowDate";
-    endpointURL = [NSString stringWithFormat:@"%@%@%@",endpointURL,tickersToFetch,addtlFields];
     
-    NSURLResponse *response = nil;
-    
-    // Make the call synchronously
+    // Get the quotes for all of them through the quote batcher, which splits them into calls of a safe URL length, fetched in parallel, and waits for them all.
     NSError *error;
-    NSMutableURLRequest *eventsRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:endpointURL]];
-    NSData *responseData = [self sendSynchronousRequest:eventsRequest returningResponse:&response error:&error];
+    NSDictionary *quotes = [[FAQuoteBatcher sharedBatcher] quotesForSymbols:tickersToFetch error:&error];
     
     // This is the API response
     /* {
@@ -2728,143 +2952,127 @@ bool eventsUpdated = NO;
      "volume":0
      },*/
     
-    // Process the response
-    if (error == nil)
+    // Process the quotes that came back. If some of the calls failed, still process the quotes from the ones that didn't.
+    if (error != nil)
     {
-        // Process the response that contains the price information for the company
-        NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:responseData
-                                                                       options:kNilOptions
-                                                                         error:&error];
-        
-        // Get the list of data slices from the overall data set
-        NSArray *parsedDataSets = [parsedResponse objectForKey:@"results"];
+        // Log error to console
+        NSLog(@"ERROR: Could not get price events data from the API Data Source in the new way as used in the client. Error description: %@",error.description);
+    }
+    if (quotes.count > 0)
+    {
+        // Batch of price change events to upsert and the {ticker,event type} of the ones that are being followed
+        NSMutableArray *eventDetails = [[NSMutableArray alloc] init];
+        NSMutableArray *followedEventTypes = [[NSMutableArray alloc] init];
         
-        // TO DO: Delete Later before shipping v2.7
-        //NSLog(@"The parsed quote response data set is:%@",parsedDataSets.description);
+        // Trade and 52 week dates are formatted as e.g. 2016-09-15. They are converted straight from the day number, which is the same as going through a yyyy-MM-dd formatter.
+        // TO DO: Use later when you want to work with times as well
+        //[eventDateFormatter setDateFormat:@"yyyy-MM-dd'T'HH:mm:ss-HH:mm"];
         
-        // Check to make sure that the correct response has come back. e.g. If you get an error message response from the API,
-        // then you don't want to process the data and enter as historical prices.
-        // If response is not correct, show the user an error message
-        if ([parsedDataSets.description isEqualToString:@"<null>"])
-        {
-            // TO DO: Ideally show user an error message but currently for simplicity we want to keep this transparent to the user.
-            // TO DO: Delete Later before shipping v2.7
-            //NSLog(@"Trapping the current price error");
+        // Iterate through the price details for each ticker, adding it's price change events to the batch.
+        for (NSString *quoteTicker in tickersToFetch) {
             
-        }
-        // Else process response to enter historical prices
-        else
-        {
-            NSNumber *percentChangeSinceYest = [[NSNumber alloc] initWithFloat:0.0];
-            NSNumber *currPrice = [[NSNumber alloc] initWithFloat:0.0];
-            NSString *currPriceStr = nil;
+            NSDictionary *parsedDetailsList = [quotes objectForKey:quoteTicker];
+            if (parsedDetailsList == nil) {
+                continue;
+            }
+            
+            // Check if that ticker price is not null. If it is continue without processing it.The commented line might be a better way but couldn't test it hence going with the old way.
+            // if ([parsedDetailsList objectForKey:@"netChange"] == (id)[NSNull null])
+            if ([[NSString stringWithFormat:@"%@",[parsedDetailsList objectForKey:@"mode"]] containsString:@"null"])
+            {
+                continue;
+            }
+            ////// Get daily price change
+            
+            // Get the company ticker
+            NSString *companySymbol = [parsedDetailsList objectForKey:@"symbol"];
+            
+            // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed.
+            // TO DO: Hardcoding this for now to be quarterly earnings
+            BOOL tickerFollowed = [self doesReminderActionExistForEventWithTicker:companySymbol eventType:@"Quarterly Earnings"];
+            
+            // Get the last trade date
+            NSArray *dateComponents = [[parsedDetailsList objectForKey:@"tradeTimestamp"] componentsSeparatedByString:@"T"];
+            NSString *eventDateStr =  [NSString stringWithFormat: @"%@", dateComponents[0]];
+            // Convert from string to Date
+            NSDate *eventDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:eventDateStr]];
+            //NSLog(@"The date on which the event takes place formatted as a Date: %@",eventDate);
+            
+            // Get percentage changed since yesterday
+            NSNumber *percentChangeSinceYest = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"percentChange"] doubleValue]];
+            
+            // Get a string representation for the change
+            NSString *percentChangeSinceYestStr = [NSString stringWithFormat:@"%.02f",[percentChangeSinceYest doubleValue]];
+            
+            // Get current price
+            NSNumber *currPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"lastPrice"] doubleValue]];
+            // Format the current price string
+            NSString *currPriceStr = [NSString stringWithFormat:@"%.02f",[currPrice doubleValue]];
+            
+            // Get whatever the daily price change is
             NSString *specificEventType = nil;
-            NSString *companySymbol = nil;
-            NSString *percentChangeSinceYestStr = nil;
-            // Set the event date to today by default
-            NSDate *eventDate = [NSDate date];
-            NSString *eventDateStr = nil;
-            NSArray *dateComponents;
-            NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-            [eventDateFormatter setDateFormat:@"yyyy-MM-dd"];
-            // TO DO: Use later when you want to work with times as well
-            //[eventDateFormatter setDateFormat:@"yyyy-MM-dd'T'HH:mm:ss-HH:mm"];
+            if([percentChangeSinceYest doubleValue] >= 0.0) {
             
-            // Iterate through price array within the parsed data set, which only contains one dictionary.
-            for (NSDictionary *parsedDetailsList in parsedDataSets) {
-                
-                // Check if that ticker price is not null. If it is continue without processing it.The commented line might be a better way but couldn't test it hence going with the old way.
-                // if ([parsedDetailsList objectForKey:@"netChange"] == (id)[NSNull null])
-                if ([[NSString stringWithFormat:@"%@",[parsedDetailsList objectForKey:@"mode"]] containsString:@"null"])
-                {
-                    continue;
+                specificEventType = [NSString stringWithFormat:@"+%@%% up today $%@",percentChangeSinceYestStr,currPriceStr];
+                // Add to the events batch
+                // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
+                [eventDetails addObject:[self eventDetailsWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
+                // If the ticker is already being followed, add a "PriceChange" action type, after the upsert, to indicate this is a followed event.
+                if (tickerFollowed) {
+                    [followedEventTypes addObject:@[companySymbol, specificEventType]];
                 }
-                ////// Get daily price change
-                
-                // Get the company ticker
-                companySymbol = [parsedDetailsList objectForKey:@"symbol"];
-                
-                // Get the last trade date
-                dateComponents = [[parsedDetailsList objectForKey:@"tradeTimestamp"] componentsSeparatedByString:@"T"];
-                eventDateStr =  [NSString stringWithFormat: @"%@", dateComponents[0]];
-                // Convert from string to Date
-                eventDate = [eventDateFormatter dateFromString:eventDateStr];
-                //NSLog(@"The date on which the event takes place formatted as a Date: %@",eventDate);
+            }
+            if([percentChangeSinceYest doubleValue] < 0.0) {
             
-                // Get percentage changed since yesterday
-                percentChangeSinceYest = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"percentChange"] doubleValue]];
-                
-                // Get a string representation for the change
-                percentChangeSinceYestStr = [NSString stringWithFormat:@"%.02f",[percentChangeSinceYest doubleValue]];
-                
-                // Get current price
-                currPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"lastPrice"] doubleValue]];
-                // Format the current price string
-                currPriceStr = [NSString stringWithFormat:@"%.02f",[currPrice doubleValue]];
-                
-                // Get whatever the daily price change is
-                if([percentChangeSinceYest doubleValue] >= 0.0) {
-                    
-                    specificEventType = [NSString stringWithFormat:@"+%@%% up today $%@",percentChangeSinceYestStr,currPriceStr];
-                    // Insert into the events datastore
-                    // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
-                    [self upsertEventWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
-                    // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed. In which case add a "PriceChange" action type to indicate this is a followed event.
-                    // TO DO: Hardcoding this for now to be quarterly earnings
-                    if ([self doesReminderActionExistForEventWithTicker:companySymbol eventType:@"Quarterly Earnings"]){
-                        [self insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:companySymbol eventType:specificEventType];
-                    }
-                }
-                if([percentChangeSinceYest doubleValue] < 0.0) {
-                    
-                    percentChangeSinceYestStr = [percentChangeSinceYestStr substringFromIndex:1];
-                    specificEventType = [NSString stringWithFormat:@"-%@%% down today $%@",percentChangeSinceYestStr,currPriceStr];
-                    // Insert into the events datastore
-                    // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
-                    [self upsertEventWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
-                    // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed. In which case add a "PriceChange" action type to indicate this is a followed event.
-                    // TO DO: Hardcoding this for now to be quarterly earnings
-                    if ([self doesReminderActionExistForEventWithTicker:companySymbol eventType:@"Quarterly Earnings"]){
-                        [self insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:companySymbol eventType:specificEventType];
-                    }
-                }
-                
-                ////// Get 52 week highs
-                NSString *hiLoEventStr = nil;
-                NSNumber *hiLoPrice = [[NSNumber alloc] initWithFloat:0.0];
-                
-                eventDateStr = [parsedDetailsList objectForKey:@"fiftyTwoWkHighDate"];
-                eventDate = [eventDateFormatter dateFromString:eventDateStr];
-                hiLoPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"fiftyTwoWkHigh"] doubleValue]];
-                hiLoEventStr = [NSString stringWithFormat:@"%.02f",[hiLoPrice doubleValue]];
-                
-                specificEventType = [NSString stringWithFormat:@"52 Week High $%@",hiLoEventStr];
-                [self upsertEventWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
-                // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed. In which case add a "PriceChange" action type to indicate this is a followed event.
-                // TO DO: Hardcoding this for now to be quarterly earnings
-                if ([self doesReminderActionExistForEventWithTicker:companySymbol eventType:@"Quarterly Earnings"]){
-                    [self insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:companySymbol eventType:specificEventType];
-                }
-                
-                ////// Get 52 week lows
-                
-                eventDateStr = [parsedDetailsList objectForKey:@"fiftyTwoWkLowDate"];
-                eventDate = [eventDateFormatter dateFromString:eventDateStr];
-                hiLoPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"fiftyTwoWkLow"] doubleValue]];
-                hiLoEventStr = [NSString stringWithFormat:@"%.02f",[hiLoPrice doubleValue]];
-                
-                specificEventType = [NSString stringWithFormat:@"52 Week Low $%@",hiLoEventStr];
-                [self upsertEventWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
-                // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed. In which case add a "PriceChange" action type to indicate this is a followed event.
-                // TO DO: Hardcoding this for now to be quarterly earnings
-                if ([self doesReminderActionExistForEventWithTicker:companySymbol eventType:@"Quarterly Earnings"]){
-                    [self insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:companySymbol eventType:specificEventType];
+                percentChangeSinceYestStr = [percentChangeSinceYestStr substringFromIndex:1];
+                specificEventType = [NSString stringWithFormat:@"-%@%% down today $%@",percentChangeSinceYestStr,currPriceStr];
+                // Add to the events batch
+                // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
+                [eventDetails addObject:[self eventDetailsWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
+                // If the ticker is already being followed, add a "PriceChange" action type, after the upsert, to indicate this is a followed event.
+                if (tickerFollowed) {
+                    [followedEventTypes addObject:@[companySymbol, specificEventType]];
                 }
             }
+            
+            ////// Get 52 week highs
+            NSString *hiLoEventStr = nil;
+            NSNumber *hiLoPrice = [[NSNumber alloc] initWithFloat:0.0];
+            
+            eventDateStr = [parsedDetailsList objectForKey:@"fiftyTwoWkHighDate"];
+            eventDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:eventDateStr]];
+            hiLoPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"fiftyTwoWkHigh"] doubleValue]];
+            hiLoEventStr = [NSString stringWithFormat:@"%.02f",[hiLoPrice doubleValue]];
+            
+            specificEventType = [NSString stringWithFormat:@"52 Week High $%@",hiLoEventStr];
+            [eventDetails addObject:[self eventDetailsWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
+            // If the ticker is already being followed, add a "PriceChange" action type, after the upsert, to indicate this is a followed event.
+            if (tickerFollowed) {
+                [followedEventTypes addObject:@[companySymbol, specificEventType]];
+            }
+            
+            ////// Get 52 week lows
+            
+            eventDateStr = [parsedDetailsList objectForKey:@"fiftyTwoWkLowDate"];
+            eventDate = [FADateCache dateForDayNumber:[FADateCache dayNumberForDateString:eventDateStr]];
+            hiLoPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"fiftyTwoWkLow"] doubleValue]];
+            hiLoEventStr = [NSString stringWithFormat:@"%.02f",[hiLoPrice doubleValue]];
+            
+            specificEventType = [NSString stringWithFormat:@"52 Week Low $%@",hiLoEventStr];
+            [eventDetails addObject:[self eventDetailsWithDate:eventDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:companySymbol estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
+            // If the ticker is already being followed, add a "PriceChange" action type, after the upsert, to indicate this is a followed event.
+            if (tickerFollowed) {
+                [followedEventTypes addObject:@[companySymbol, specificEventType]];
+            }
+        }
+            
+        // Insert or update all the price change events in a single batch
+        [self upsertEventsWithDetails:eventDetails];
+        
+        // Add a "PriceChange" action for the ones that are being followed, now that the events exist
+        for (NSArray *followedEventType in followedEventTypes) {
+            [self insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:[followedEventType objectAtIndex:0] eventType:[followedEventType objectAtIndex:1]];
         }
-    } else {
-        // Log error to console
-        NSLog(@"ERROR: Could not get price events data from the API Data Source in the new way as used in the client. Error description: %@",error.description);
     }
 }
 
@@ -2939,11 +3147,16 @@ bool eventsUpdated = NO;
         
         // Process the response that contains the events for the company.
         // Get the response into a parsed object
+        uint64_t parseSpanStart = FATraceBegin();
         NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:responseData
                                                                        options:kNilOptions
                                                                          error:&error];
+        FATraceEnd(FATraceSpanJSONParse, parseSpanStart);
         NSDictionary *parsedEvents = [parsedResponse objectForKey:@"responseData"];
         
+        // Batch of price change events to upsert
+        NSMutableArray *eventDetails = [[NSMutableArray alloc] init];
+        
         // Loop through the parsed events
         NSDictionary *event = nil;
         for(id key in parsedEvents) {
@@ -2998,9 +3211,9 @@ bool eventsUpdated = NO;
                     specificEventType = [NSString stringWithFormat:@"%@%% up today",dailyChangeStr];
                 }
                 
-                // Insert into the events datastore
+                // Add to the events batch
                 // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
-                [self upsertEventWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
+                [eventDetails addObject:[self eventDetailsWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
             }
             
             // If 30 days alarm is true, add it to the db if the following conditions are met: a) There hasn't been a 30 days alarm of the same type in the last 7 days. This is to ensure we are only triggering the 30 days price change a max of 4 times in a month.
@@ -3016,9 +3229,9 @@ bool eventsUpdated = NO;
                 }
                       
                 if (![self doesPriceChangeEventExistFor:parentTicker parentEventType:specificEventType]) {
-                    // Insert into the events datastore
+                    // Add to the events batch
                     // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
-                    [self upsertEventWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
+                    [eventDetails addObject:[self eventDetailsWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
                 }
             }
 
@@ -3035,12 +3248,15 @@ bool eventsUpdated = NO;
                 }
                 
                 if (![self doesPriceChangeEventExistFor:parentTicker parentEventType:specificEventType]) {
-                    // Insert into the events datastore
+                    // Add to the events batch
                     // Note the upsert logic takes care of matching the generic piece of the event type to uniquely identify this event ensuring there's only one instance of this.
-                    [self upsertEventWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil];
+                    [eventDetails addObject:[self eventDetailsWithDate:todaysDate relatedDetails:nil relatedDate:nil type:specificEventType certainty:nil listedCompany:parentTicker estimatedEps:nil priorEndDate:nil actualEpsPrior:nil]];
                 }
             }
         }
+        
+        // Insert or update all the price change events in a single batch
+        [self upsertEventsWithDetails:eventDetails];
     } else {
         // Log error to console
         NSLog(@"ERROR: Could not get price events data from the API Data Source. Error description: %@",error.description);
@@ -3060,25 +3276,14 @@ bool eventsUpdated = NO;
     
     // Case and Diacractic Insensitive Filtering
     NSPredicate *eventPredicate = nil;
-    // For 30 days change event - % down 30 days
-    if ([eventType containsString:@"% down 30 days"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",eventTicker,@"% down 30 days"];
-    }
-    // For 30 days change event - % up 30 days
-    else if ([eventType containsString:@"% up 30 days"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",eventTicker,@"% up 30 days"];
-    }
-    // For year to date change event - % down ytd
-    else if ([eventType containsString:@"% down ytd"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",eventTicker,@"% down ytd"];
-    }
-    // For year to date change event - % up ytd
-    else if ([eventType containsString:@"% up ytd"]) {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type contains %@",eventTicker,@"% up ytd"];
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:eventTicker];
+    // For 30 days change events (% up 30 days, % down 30 days) and year to date change events (% up ytd, % down ytd) match on the kind and direction of the move
+    if ((eventClassification.window == FAPriceMoveWindowThirtyDays)||(eventClassification.window == FAPriceMoveWindowYearToDate)) {
+        eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND kind == %d AND priceMoveDirection == %d",[eventTicker uppercaseString],eventClassification.kind,(int)eventClassification.direction];
     }
     // If not a price change event, it's an exact match to the type string
     else {
-        eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventTicker,eventType];
+        eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventTicker uppercaseString],eventType];
     }
 
     [eventFetchRequest setEntity:eventEntity];
@@ -3098,7 +3303,7 @@ bool eventsUpdated = NO;
         existingEvent  = events[0];
         
         // For 30 days change events check to see if this event was under 7 days ago and if yes return true
-        if ([eventType containsString:@"30 days"]) {
+        if (eventClassification.window == FAPriceMoveWindowThirtyDays) {
             
             if([self calculateDistanceFromEventDate:existingEvent.date] < 7) {
                 exists = YES;
@@ -3106,7 +3311,7 @@ bool eventsUpdated = NO;
         }
         
         // For ytd change events check to see if this event was under 15 days ago and if yes return true
-        if ([eventType containsString:@"ytd"]) {
+        if (eventClassification.window == FAPriceMoveWindowYearToDate) {
                    
             if([self calculateDistanceFromEventDate:existingEvent.date] < 15) {
                 exists = YES;
@@ -3121,67 +3326,15 @@ bool eventsUpdated = NO;
 // Delete all daily change events from the db
 - (void)deleteAllDailyPriceChangeEvents
 {
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get the event by doing a case insensitive query on parent company Ticker and event type.
-    // For price change events the event type is a fuzzy match.
-    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    
-    // Filter for daily events
-    NSPredicate *eventPredicate = nil;
-    eventPredicate = [NSPredicate predicateWithFormat:@"type contains %@ AND type contains %@",@"%",@"today"];
-    
-    // Fetch all the daily events
-    [eventFetchRequest setEntity:eventEntity];
-    [eventFetchRequest setPredicate:eventPredicate];
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting a daily price change event, while trying to delete all of them, from data store failed: %@",error.description);
-    }
-    
-    // Delete all the daily events
-    for (NSManagedObject *dailyEvent in events) {
-        
-        [dataStoreContext deleteObject:dailyEvent];
-    }
-    
-    // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    // Delete all the daily events, along with their actions and history, in the store in one go, on the indexed kind
+    [[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"kind == %d",FAEventKindDailyMove] fromContext:[self managedObjectContext]];
 }
 
 // Delete all 52 wk events from the db
 - (void)deleteAll52WkEvents
 {
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    
-    // Get the event by doing a case insensitive query on parent company Ticker and event type.
-    // For price change events the event type is a fuzzy match.
-    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
-    
-    // Filter for daily events
-    NSPredicate *eventPredicate = nil;
-    eventPredicate = [NSPredicate predicateWithFormat:@"(type contains %@) OR (type contains %@)",@"52 Week High",@"52 Week Low"];
-    
-    // Fetch all the daily events
-    [eventFetchRequest setEntity:eventEntity];
-    [eventFetchRequest setPredicate:eventPredicate];
-    NSError *error;
-    NSArray *events = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting a daily price change event, while trying to delete all of them, from data store failed: %@",error.description);
-    }
-    
-    // Delete all the daily events
-    for (NSManagedObject *dailyEvent in events) {
-        
-        [dataStoreContext deleteObject:dailyEvent];
-    }
-    
-    // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    // Delete all the 52 week events, along with their actions and history, in the store in one go, on the indexed kind
+    [[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"kind == %d",FAEventKind52WeekHighLow] fromContext:[self managedObjectContext]];
 }
 
 // Get all price change events. Returns a results controller with identities of all Events recorded, but no more
@@ -3200,7 +3353,7 @@ bool eventsUpdated = NO;
     // Set the filter. Get price change events with date clause
     //NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"date >= %@ AND (ANY actions.type == %@)", todaysDate, @"PriceChange"];
     // Set the filter. Get price change events with no date clause
-    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"(ANY actions.type == %@)", @"PriceChange"];
+    NSPredicate *datePredicate = [NSPredicate predicateWithFormat:@"listedCompany.isFollowed == YES AND (kind IN %@)", @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)]];
     [eventFetchRequest setPredicate:datePredicate];
     NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"listedCompany.ticker" ascending:YES];
     [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
@@ -3210,7 +3363,48 @@ bool eventsUpdated = NO;
                                                                             cacheName:nil];
     NSError *error;
     if (![self.resultsController performFetch:&error]) {
-        NSLog(@"ERROR: Getting all price change events from data store failed: %@",error.description);
+        NSLog(@"ERROR: Getting all price change events from data store failed: %@",error.description);
+    }
+    
+    return self.resultsController;
+}
+
+// Get the biggest % up and % down moves over the given window (day, 30 days or year to date), biggest first, in the given direction or, for
+// FAPriceMoveDirectionNone, either direction. Sorts and filters on the numeric, indexed, percent of the move. A limit of 0 means no limit.
+- (NSFetchedResultsController *)getTopPriceMoveEventsForWindow:(FAPriceMoveWindow)moveWindow direction:(FAPriceMoveDirection)moveDirection limit:(NSUInteger)limit
+{
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    
+    // Kind of % move event for the window
+    FAEventKind moveKind = FAEventKindDailyMove;
+    if (moveWindow == FAPriceMoveWindowThirtyDays) {
+        moveKind = FAEventKindThirtyDayMove;
+    }
+    if (moveWindow == FAPriceMoveWindowYearToDate) {
+        moveKind = FAEventKindYtdMove;
+    }
+    
+    // Get the moves with the biggest first
+    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
+    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
+    [eventFetchRequest setEntity:eventEntity];
+    NSPredicate *movePredicate = nil;
+    if (moveDirection == FAPriceMoveDirectionNone) {
+        movePredicate = [NSPredicate predicateWithFormat:@"kind == %d AND priceMovePercent != nil", moveKind];
+    } else {
+        movePredicate = [NSPredicate predicateWithFormat:@"kind == %d AND priceMovePercent != nil AND priceMoveDirection == %d", moveKind, (int)moveDirection];
+    }
+    [eventFetchRequest setPredicate:movePredicate];
+    NSSortDescriptor *sortField = [[NSSortDescriptor alloc] initWithKey:@"priceMovePercent" ascending:NO];
+    [eventFetchRequest setSortDescriptors:[NSArray arrayWithObject:sortField]];
+    [eventFetchRequest setFetchLimit:limit];
+    [eventFetchRequest setFetchBatchSize:15];
+    self.resultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:eventFetchRequest
+                                                                 managedObjectContext:dataStoreContext sectionNameKeyPath:nil
+                                                                            cacheName:nil];
+    NSError *error;
+    if (![self.resultsController performFetch:&error]) {
+        NSLog(@"ERROR: Getting the top price move events from data store failed: %@",error.description);
     }
     
     return self.resultsController;
@@ -3226,7 +3420,7 @@ bool eventsUpdated = NO;
     NSDate *todaysDate = [NSDate date];
     
     // Subtract 7 days
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *aGregorianCalendar = [FADateCache gregorianCalendar];
     NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
     differenceDayComponents.day = -7;
     NSDate *weekAgoDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:todaysDate options:0];
@@ -3238,7 +3432,7 @@ bool eventsUpdated = NO;
     
     // Filter for daily events
     NSPredicate *eventPredicate = nil;
-    eventPredicate = [NSPredicate predicateWithFormat:@"type contains %@ AND type contains %@",@"%",@"today"];
+    eventPredicate = [NSPredicate predicateWithFormat:@"kind == %d",FAEventKindDailyMove];
     
     // Fetch all the daily events
     [eventFetchRequest setEntity:eventEntity];
@@ -3275,7 +3469,6 @@ bool eventsUpdated = NO;
     dispatch_async(dispatch_get_main_queue(), ^{
         // TO DO: Delete Later.
         //NSLog(@"About to stop busy spinner");
-        [self sendEventsChangeNotification];
         [[NSNotificationCenter defaultCenter]postNotificationName:@"StopBusySpinner" object:self];
     });
     
@@ -3303,7 +3496,8 @@ bool eventsUpdated = NO;
     
     // If Quarterly Earnings or price change event or product event get the historical data for display in the details
     // We basically use the quarterly earnings event history to keep track of the stock prices for price change events since there cannot be a price change event for a ticker that we don't have the quarterly earnings for. Same with product event
-    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventType containsString:@"% up"]||[eventType containsString:@"% down"]||[eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:cellCompanyTicker];
+    if ((eventClassification.kind == FAEventKindEarnings)||[eventClassification isPercentMove]||(eventClassification.kind == FAEventKindProduct)) {
         
         // Get the ticker for the Quarterly Earnings
         NSString *eventTicker = cellCompanyTicker;
@@ -3322,13 +3516,13 @@ bool eventsUpdated = NO;
             // NOTE: 999999.9 is a placeholder for empty prices, meaning we don't have the value.
             NSNumber *emptyPlaceholder = [[NSNumber alloc] initWithFloat:999999.9];
             // To Do: Delete when shipping v2.9
-            //NSLog(@"The 30 days ago date when inserting history is:%@",[self scrubDateToNotBeWeekendOrHoliday:[self computeDate30DaysAgoFrom:todaysDate]]);
-            [self insertHistoryWithPreviousEvent1Date:[self scrubDateToNotBeWeekendOrHoliday:[self computeDate30DaysAgoFrom:todaysDate]] previousEvent1Status:@"Estimated" previousEvent1RelatedDate:[self computeMarketStartDateOfTheYearFrom:todaysDate] currentDate:todaysDate previousEvent1Price:emptyPlaceholder previousEvent1RelatedPrice:emptyPlaceholder currentPrice:emptyPlaceholder parentEventTicker:eventTicker parentEventType:eventType];
+            //NSLog(@"The 30 days ago date when inserting history is:%@",[FAMarketCalendar tradingDayForDate:[FAMarketCalendar dateThirtyDaysBeforeDate:todaysDate]]);
+            [self insertHistoryWithPreviousEvent1Date:[FAMarketCalendar tradingDayForDate:[FAMarketCalendar dateThirtyDaysBeforeDate:todaysDate]] previousEvent1Status:@"Estimated" previousEvent1RelatedDate:[FAMarketCalendar firstTradingDayOfYearForDate:todaysDate] currentDate:todaysDate previousEvent1Price:emptyPlaceholder previousEvent1RelatedPrice:emptyPlaceholder currentPrice:emptyPlaceholder parentEventTicker:eventTicker parentEventType:eventType];
         }
         // Else update the non price related data, not including current date, on the event history from the event. We don't include the current date as current date is set only once a day which is when the user first accesses the event.
         else
         {
-            [self updateEventHistoryWithPreviousEvent1Date:[self scrubDateToNotBeWeekendOrHoliday:[self computeDate30DaysAgoFrom:todaysDate]] previousEvent1Status:@"Estimated" previousEvent1RelatedDate:[self computeMarketStartDateOfTheYearFrom:todaysDate] parentEventTicker:eventTicker parentEventType:eventType];
+            [self updateEventHistoryWithPreviousEvent1Date:[FAMarketCalendar tradingDayForDate:[FAMarketCalendar dateThirtyDaysBeforeDate:todaysDate]] previousEvent1Status:@"Estimated" previousEvent1RelatedDate:[FAMarketCalendar firstTradingDayOfYearForDate:todaysDate] parentEventTicker:eventTicker parentEventType:eventType];
         }
         
         // Call price API, in the main thread, to refresh the price history
@@ -3340,8 +3534,7 @@ bool eventsUpdated = NO;
         double prev1PriceDbl = [[selectedEventHistory previous1Price] doubleValue];
         double prev1RelatedPriceDbl = [[selectedEventHistory previous1RelatedPrice] doubleValue];
         double currentPriceDbl = [[selectedEventHistory currentPrice] doubleValue];
-        NSDateFormatter *checkDateFormatter = [[NSDateFormatter alloc] init];
-        [checkDateFormatter setDateFormat:@"yyyy-MM-dd"];
+        NSDateFormatter *checkDateFormatter = [FADateCache formatterWithFormat:@"yyyy-MM-dd"];
         // Format historical and now current dates to local time zone comparison
         NSString *currentDateInHistory = [checkDateFormatter stringFromDate:selectedEventHistory.currentDate];
         NSString *currentDateNow = [checkDateFormatter stringFromDate:todaysDate];
@@ -3359,7 +3552,6 @@ bool eventsUpdated = NO;
     dispatch_async(dispatch_get_main_queue(), ^{
         // TO DO: Delete Later.
         //NSLog(@"About to stop busy spinner");
-        [self sendEventsChangeNotification];
         [[NSNotificationCenter defaultCenter]postNotificationName:@"StopBusySpinner" object:self];
     });
     
@@ -3408,7 +3600,7 @@ bool eventsUpdated = NO;
 
 #pragma mark - Methods to call Company Stock Data Source APIs
 
-// Get the historical stock prices for a company given it's ticker and the event type for which the historical data is being asked for. Currently only supported event type is Quarterly Earnings. Also, the listed company ticker and event type, together represent the event uniquely. Finally, the most current stock price that we have is yesterday.
+// Get the historical stock prices for a company given it's ticker and the event type for which the historical data is being asked for. Currently only supported event type is Quarterly Earnings. Also, the listed company ticker and event type, together represent the event uniquely. Finally, the most current stock price that we have is yesterday. Only the daily bars after the last one in the local price bar store are fetched.
 - (void)getStockPricesFromApiForTicker:(NSString *)companyTicker companyEventType:(NSString *)eventType fromDateInclusive:(NSDate *)fromDate toDateInclusive:(NSDate *)toDate {
     
     // Get the event details for a company given it's ticker. Call the following API:
@@ -3448,12 +3640,30 @@ bool eventsUpdated = NO;
     endpointURL = [NSString stringWithFormat:@"%@&symbol=%@",endpointURL,formattedCompanyTicker];
     
     // Append the formatted Start Date minus 7 days just to be safe
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = -7;
-    NSDate *fromDateMinus1Day = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:fromDate options:0];
-    NSDateFormatter *priceDateFormatter = [[NSDateFormatter alloc] init];
-    [priceDateFormatter setDateFormat:@"yyyyMMdd"];
+    NSDate *fromDateMinus1Day = [FADateCache dateByAddingDays:-7 toDate:fromDate];
+    
+    // Daily bars are kept locally, so only ask for the ones from a few days before the last bar stored, the overlap being used to check that
+    // the stored closes haven't since been adjusted. If the last bar is already the last completed trading day, there's nothing new to fetch
+    // and the prices can be answered locally.
+    NSDate *lastBarDate = [[FAPriceBarStore sharedStore] lastBarDateForTicker:companyTicker];
+    if (lastBarDate != nil) {
+        
+        // Get the last completed trading day, which is the last day the market was open before the to date. Bar dates are GMT.
+        int32_t lastTradingDay = [FAMarketCalendar tradingEpochDayOnOrBefore:([FADateCache gmtEpochDayForDate:(toDate ? toDate : [NSDate date])] - 1)];
+        if ([FAPriceBarStore dayNumberForDate:lastBarDate] >= [FADateCache dayNumberForEpochDay:lastTradingDay]) {
+            [self updateEventHistoryPricesFromLocalBarsForTicker:companyTicker eventType:eventType];
+            return;
+        }
+        
+        // Otherwise start from a few days before the last bar, if that's later than the from date
+        NSDate *overlapStartDate = [FADateCache dateByAddingDays:-FAPriceBarOverlapDays toDate:lastBarDate];
+        if ([overlapStartDate compare:fromDateMinus1Day] == NSOrderedDescending) {
+            fromDateMinus1Day = overlapStartDate;
+        }
+    }
+    
+    // Use a GMT formatter since bar dates are always GMT and formatters are defaulted to local timezone.
+    NSDateFormatter *priceDateFormatter = [FADateCache gmtFormatterWithFormat:@"yyyyMMdd"];
     NSString *fromDateInclusiveString = [priceDateFormatter stringFromDate:fromDateMinus1Day];
     endpointURL = [NSString stringWithFormat:@"%@&type=daily&startDate=%@000000",endpointURL,fromDateInclusiveString];
     
@@ -3467,8 +3677,11 @@ bool eventsUpdated = NO;
     // Process the response
     if (error == nil)
     {
-        // Process the response that contains the events for the company.
-        [self processStockPricesResponse:responseData forTicker:companyTicker forEventType:eventType];
+        // Process the response that contains the events for the company. If the stored bars turned out to have been adjusted since, for a split
+        // or dividend, they have been dropped, so fetch the full history again.
+        if (![self processStockPricesResponse:responseData forTicker:companyTicker forEventType:eventType]) {
+            [self getStockPricesFromApiForTicker:companyTicker companyEventType:eventType fromDateInclusive:fromDate toDateInclusive:toDate];
+        }
         
     } else {
         // Log error to console
@@ -3479,7 +3692,8 @@ bool eventsUpdated = NO;
 }
 
 // Parse the stock prices API response and add the historical prices to the event history.Currently recording only previous event 1 (prior quarterly earnings) date closing stock price, previous related event 1 (prior quarter end date closing price and current price (yesterday's closing price).NOTE: Yesterday's closing price is based on what the current date is on the history object.
-- (void)processStockPricesResponse:(NSData *)response forTicker:(NSString *)ticker forEventType:(NSString *)type {
+// Returns NO if the locally stored bars disagreed with the ones in the response, and were dropped to be fetched again.
+- (BOOL)processStockPricesResponse:(NSData *)response forTicker:(NSString *)ticker forEventType:(NSString *)type {
     
     NSError *error;
     
@@ -3685,66 +3899,52 @@ bool eventsUpdated = NO;
                       },
      */
     
-    // Get the response into a parsed object
-    NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:response
-                                                                   options:kNilOptions
-                                                                     error:&error];
-    
-    // Get the list of data slices from the overall data set
-    NSArray *parsedDataSets = [parsedResponse objectForKey:@"results"];
+    // Stream through the price details in the response, pulling out just the trading day and close price of each, and append them to the local daily price bars
+    NSMutableArray *priceBars = [[NSMutableArray alloc] init];
+    FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:response];
+    BOOL responseRead = [responseReader enumerateRecordsAtPath:@"results" fields:@[@"tradingDay",@"close"] error:&error usingBlock:^(NSDictionary *parsedDetailsList, BOOL *stop) {
+        [priceBars addObject:parsedDetailsList];
+    }];
+    if (!responseRead) {
+        NSLog(@"ERROR: Could not parse the historical prices API response for ticker:%@. Error description: %@",ticker,error.description);
+    }
     
     // Check to make sure that the correct response has come back. e.g. If you get an error message response from the API,
-    // then you don't want to process the data and enter as historical prices.
-    // If response is not correct, show the user an error message
-    if ([parsedDataSets.description isEqualToString:@"<null>"])
+    // then you don't want to enter historical prices. A response that can't be read in full isn't stored either, so the bars don't end partway.
+    if (!responseRead || !responseReader.recordsFound)
     {
         // TO DO: Ideally show user an error message but currently for simplicity we want to keep this transparent to the user.
         // TO DO: Delete Later before shipping v2.7
         //NSLog(@"Trapping the historical price error");
         
     }
-    // Else process response to enter historical prices
+    // Else store the bars and enter the historical prices to the database, from the stored bars
     else
     {
-        EventHistory *historyForDates = nil;
-        NSString *prevEvent1Date = nil;
-        NSString *prevRelatedEvent1Date = nil;
-        
-        // NOTE: 999999.9 is a placeholder for empty prices, meaning we don't have the value.
-        NSNumber *emptyPlaceholder = [[NSNumber alloc] initWithFloat:999999.9];
-        NSNumber *prevEvent1Price = emptyPlaceholder;
-        NSNumber *prevRelatedEvent1Price = emptyPlaceholder;
-        
-        NSDateFormatter *priceDateFormatter = [[NSDateFormatter alloc] init];
-        // Set the formatter to be GMT since dates are always GMT and formatters are defaulted to local timezone.
-        [priceDateFormatter setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
-        [priceDateFormatter setDateFormat:@"yyyy-MM-dd"];
-        
-        // Iterate through price/details arrays within the parsed data set
-        for (NSDictionary *parsedDetailsList in parsedDataSets) {
-            
-            // Get the event history dates for which we want to record the stock prices
-            // Currently recording only previous event 1 (30 days ago) date closing stock price, previous related event 1 (start of the year).
-            historyForDates = [self getEventHistoryForParentEventTicker:ticker parentEventType:type];
-            prevEvent1Date = [priceDateFormatter stringFromDate:historyForDates.previous1Date];
-            prevRelatedEvent1Date = [priceDateFormatter stringFromDate:historyForDates.previous1RelatedDate];
-            
-            // Get the prices for the various dates and write them to the history data store
-            
-            // If the price details dictionary is for the previousRelatedEvent1 (start of year) date, get the price
-            if ([[parsedDetailsList objectForKey:@"tradingDay"] caseInsensitiveCompare:prevRelatedEvent1Date] == NSOrderedSame) {
-                prevRelatedEvent1Price = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"close"] doubleValue]];
-            }
-            
-            // If the price details dictionary is for the previousEvent1 (30 days ago) date, get the price
-            if ([[parsedDetailsList objectForKey:@"tradingDay"] caseInsensitiveCompare:prevEvent1Date] == NSOrderedSame) {
-                prevEvent1Price = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"close"] doubleValue]];
-            }
+        if (![[FAPriceBarStore sharedStore] appendBars:priceBars forTicker:ticker]) {
+            return NO;
         }
-        
-        // Enter the historical prices to the database
-        [self updateEventHistoryWithPreviousEvent1Price:prevEvent1Price previousEvent1RelatedPrice:prevRelatedEvent1Price parentEventTicker:ticker parentEventType:type];
+        [self updateEventHistoryPricesFromLocalBarsForTicker:ticker eventType:type];
     }
+    
+    return YES;
+}
+
+// Get the 30 days ago and start of the year prices for the event history from the locally stored daily price bars, and write them to the event history.
+// If either date wasn't a trading day, the price for the closest trading day before it is used.
+- (void)updateEventHistoryPricesFromLocalBarsForTicker:(NSString *)ticker eventType:(NSString *)type {
+    
+    // Get the event history dates for which we want to record the stock prices
+    // Currently recording only previous event 1 (30 days ago) date closing stock price, previous related event 1 (start of the year).
+    EventHistory *historyForDates = [self getEventHistoryForParentEventTicker:ticker parentEventType:type];
+    
+    // NOTE: 999999.9 is a placeholder for empty prices, meaning we don't have the value.
+    NSNumber *emptyPlaceholder = [[NSNumber alloc] initWithFloat:999999.9];
+    NSNumber *prevEvent1Price = [[FAPriceBarStore sharedStore] closePriceForTicker:ticker onOrBeforeDate:historyForDates.previous1Date];
+    NSNumber *prevRelatedEvent1Price = [[FAPriceBarStore sharedStore] closePriceForTicker:ticker onOrBeforeDate:historyForDates.previous1RelatedDate];
+    
+    // Enter the historical prices to the database
+    [self updateEventHistoryWithPreviousEvent1Price:(prevEvent1Price ? prevEvent1Price : emptyPlaceholder) previousEvent1RelatedPrice:(prevRelatedEvent1Price ? prevRelatedEvent1Price : emptyPlaceholder) parentEventTicker:ticker parentEventType:type];
 }
 
 // Get the current stock price and write that to the event history. Also return a string with the following format currentprice_netchange_percentchange
@@ -3752,40 +3952,22 @@ bool eventsUpdated = NO;
     
     NSString *changeString = @"NA";
     
-    // The API endpoint URL
+    // Get the quote through the quote batcher, which coalesces it with any other quote requests made around the same time, e.g. from other cells
+    // as the user scrolls, into a single multi symbol call to the following API:
     // marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809&symbols=AMD
-    NSString *endpointURL = @"http://marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809";
-    
-    // Append Ticker
-    // Format the ticker e.g. for V.HSR replace with V_HSR as this is how the API expects it
-    NSString *formattedCompanyTicker  = [companyTicker stringByReplacingOccurrencesOfString:@"." withString:@"_"];
-    endpointURL = [NSString stringWithFormat:@"%@&symbols=%@",endpointURL,formattedCompanyTicker];
-    
     NSError * error = nil;
-    NSURLResponse *response = nil;
-    
-    // Make the call synchronously
-    NSMutableURLRequest *eventsRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:endpointURL]];
-    NSData *responseData = [self sendSynchronousRequest:eventsRequest returningResponse:&response error:&error];
+    NSDictionary *quotes = [[FAQuoteBatcher sharedBatcher] quotesForSymbols:@[companyTicker] error:&error];
     
     // Process the response
     if (error == nil)
     {
-        // Process the response that contains the price information for the company
-        NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:responseData
-                                                                       options:kNilOptions
-                                                                         error:&error];
-        
-        // Get the list of data slices from the overall data set
-        NSArray *parsedDataSets = [parsedResponse objectForKey:@"results"];
-        
-        // TO DO: Delete Later before shipping v2.7
-        //NSLog(@"The parsed quote response data set is:%@",parsedDataSets.description);
+        // Get the price details for the company
+        NSDictionary *parsedDetailsList = [quotes objectForKey:companyTicker];
         
         // Check to make sure that the correct response has come back. e.g. If you get an error message response from the API,
         // then you don't want to process the data and enter as historical prices.
         // If response is not correct, show the user an error message
-        if ([parsedDataSets.description isEqualToString:@"<null>"])
+        if (parsedDetailsList == nil)
         {
             // TO DO: Ideally show user an error message but currently for simplicity we want to keep this transparent to the user.
             // TO DO: Delete Later before shipping v2.7
@@ -3795,23 +3977,14 @@ bool eventsUpdated = NO;
         // Else process response to enter historical prices
         else
         {
+            // Get the current price
+            NSNumber *currentPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"lastPrice"] doubleValue]];
             
-            // NOTE: 999999.9 is a placeholder for empty prices, meaning we don't have the value.
-            NSNumber *emptyPlaceholder = [[NSNumber alloc] initWithFloat:999999.9];
-            NSNumber *currentPrice = emptyPlaceholder;
-            
-            // Iterate through price array within the parsed data set, which only contains one dictionary.
-            for (NSDictionary *parsedDetailsList in parsedDataSets) {
-                
-                // Get the current price
-                currentPrice = [NSNumber numberWithDouble:[[parsedDetailsList objectForKey:@"lastPrice"] doubleValue]];
-                
-                // Construct the change string i.e. netchange_percentchange
-                NSString *currPrice = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"lastPrice"] floatValue]];
-                NSString *netChange = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"netChange"] floatValue]];
-                NSString *percentChange = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"percentChange"] floatValue]];
-                changeString = [NSString stringWithFormat:@"%@_%@_%@",currPrice,netChange,percentChange];
-            }
+            // Construct the change string i.e. netchange_percentchange
+            NSString *currPrice = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"lastPrice"] floatValue]];
+            NSString *netChange = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"netChange"] floatValue]];
+            NSString *percentChange = [NSString stringWithFormat:@"%.02f",[[parsedDetailsList objectForKey:@"percentChange"] floatValue]];
+            changeString = [NSString stringWithFormat:@"%@_%@_%@",currPrice,netChange,percentChange];
             
             // Enter the current price into the event history table
             [self updateEventHistoryWithCurrentPrice:currentPrice parentEventTicker:companyTicker parentEventType:eventType];
@@ -4104,16 +4277,17 @@ bool eventsUpdated = NO;
 - (void)performTrendingEventSyncRemotely {
     
     // Add 5 trending company tickers and name to the company database.
-    [self insertUniqueCompanyWithTicker:@"TSLA" name:@"Tesla Motors"];
-    //[self insertUniqueCompanyWithTicker:@"GPRO" name:@"Go Pro"];
-    [self insertUniqueCompanyWithTicker:@"BABA" name:@"Alibaba"];
-    //[self insertUniqueCompanyWithTicker:@"ANET" name:@"Arista Networks"];
-    [self insertUniqueCompanyWithTicker:@"LULU" name:@"Lululemon Athletica"];
-    //[self insertUniqueCompanyWithTicker:@"BOX" name:@"Box,Inc"];
-    [self insertUniqueCompanyWithTicker:@"SQ" name:@"Square"];
-    //[self insertUniqueCompanyWithTicker:@"ORCL" name:@"Oracle"];
-    [self insertUniqueCompanyWithTicker:@"NKE" name:@"Nike"];
-    //[self insertUniqueCompanyWithTicker:@"UA" name:@"Under Armour Inc"];
+    [self insertUniqueCompaniesWithDetails:@[@{@"ticker":@"TSLA", @"name":@"Tesla Motors"},
+                                             //@{@"ticker":@"GPRO", @"name":@"Go Pro"},
+                                             @{@"ticker":@"BABA", @"name":@"Alibaba"},
+                                             //@{@"ticker":@"ANET", @"name":@"Arista Networks"},
+                                             @{@"ticker":@"LULU", @"name":@"Lululemon Athletica"},
+                                             //@{@"ticker":@"BOX", @"name":@"Box,Inc"},
+                                             @{@"ticker":@"SQ", @"name":@"Square"},
+                                             //@{@"ticker":@"ORCL", @"name":@"Oracle"},
+                                             @{@"ticker":@"NKE", @"name":@"Nike"}
+                                             //@{@"ticker":@"UA", @"name":@"Under Armour Inc"}
+                                             ]];
     
     // Get events for these trending companies from the remote data source
     [self getAllEventsFromApiWithTicker:@"TSLA"];
@@ -4139,6 +4313,114 @@ bool eventsUpdated = NO;
     [self getAllEventsFromApiWithTicker:@"PD"];
 }
 
+// For an earnings event with the given date and certainty, work out the next date on which the remote source is likely to have changed information for it:
+// 1. An "Estimated" or "Unknown" event is likely to be updated from 31 days before it's date. Inside that window check at every sync (6 hours).
+// 2. A "Confirmed" event is likely to be updated with the next quarter's information the day after it's reported. If that's already passed check at every sync.
+- (NSDate *)nextLikelyChangeDateForEarningsEventWithDate:(NSDate *)eventDate certainty:(NSString *)eventCertainty asOf:(NSDate *)refreshDate
+{
+    // Interval between syncs
+    NSTimeInterval syncInterval = 6*60*60;
+    NSDate *nextSyncDate = [refreshDate dateByAddingTimeInterval:syncInterval];
+    
+    if (eventDate == nil) {
+        return nextSyncDate;
+    }
+    
+    NSDate *likelyChangeDate = nil;
+    if ([eventCertainty isEqualToString:@"Confirmed"]) {
+        likelyChangeDate = [eventDate dateByAddingTimeInterval:(24*60*60)];
+    } else {
+        likelyChangeDate = [eventDate dateByAddingTimeInterval:-(31*24*60*60)];
+    }
+    
+    return [likelyChangeDate laterDate:nextSyncDate];
+}
+
+// Get the tickers whose earnings events are due to be refreshed from the remote source, using a single indexed query. An event is due if it's next likely change
+// date has arrived. Events for which that date hasn't been worked out yet are due based on their date and certainty, in the same way as nextLikelyChangeDate works it out.
+- (NSArray *)tickersWithEarningsDueForRefreshAsOf:(NSDate *)refreshDate
+{
+    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
+    NSError *error;
+    
+    NSDate *likelyUpdateWindowEnd = [refreshDate dateByAddingTimeInterval:(31*24*60*60)];
+    NSDate *reportedBefore = [refreshDate dateByAddingTimeInterval:-(24*60*60)];
+    
+    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
+    NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"kind == %d AND ((nextRefreshDate != nil AND nextRefreshDate <= %@) OR (nextRefreshDate == nil AND (((certainty == %@ OR certainty == %@) AND date <= %@) OR (certainty == %@ AND date < %@))))",FAEventKindEarnings,refreshDate,@"Estimated",@"Unknown",likelyUpdateWindowEnd,@"Confirmed",reportedBefore];
+    [eventFetchRequest setEntity:eventEntity];
+    [eventFetchRequest setPredicate:eventPredicate];
+    [eventFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"listedCompany"]];
+    NSArray *dueEvents = [dataStoreContext executeFetchRequest:eventFetchRequest error:&error];
+    if (error) {
+        NSLog(@"ERROR: Getting earnings events that are due for a refresh, from data store failed: %@",error.description);
+    }
+    
+    NSMutableOrderedSet *dueTickers = [[NSMutableOrderedSet alloc] init];
+    for (Event *dueEvent in dueEvents) {
+        if (dueEvent.listedCompany.ticker) {
+            [dueTickers addObject:dueEvent.listedCompany.ticker];
+        }
+    }
+    
+    return [dueTickers array];
+}
+
+// Refresh the earnings events for the given tickers from the remote source, with a bounded no of concurrent requests, and write them back in a single batch.
+// Each refreshed event gets it's next likely change date, so it's not picked again till then. Returns the no of tickers whose events were refreshed.
+- (NSInteger)refreshEarningsEventsForTickers:(NSArray *)tickers asOf:(NSDate *)refreshDate
+{
+    if (tickers.count == 0) {
+        return 0;
+    }
+    
+    // No of tickers whose events are downloaded concurrently. Responses are still parsed one at a time on this thread.
+    NSInteger concurrencyWindow = (self.earningsRefreshConcurrency > 0) ? self.earningsRefreshConcurrency : 4;
+    
+    // Details of the refreshed events, to write back in a single batch
+    NSMutableArray *refreshedEventDetails = [[NSMutableArray alloc] init];
+    __block NSInteger noOfFailedRequests = 0;
+    
+    [self fetchRequestsWithWindow:concurrencyWindow requestAtIndex:^NSURLRequest *(NSInteger tickerIndex) {
+        if (tickerIndex >= (NSInteger)tickers.count) {
+            return nil;
+        }
+        return [NSMutableURLRequest requestWithURL:[NSURL URLWithString:[self earningsEventsEndpointForTicker:[tickers objectAtIndex:tickerIndex]]]];
+        
+    } processInOrder:^BOOL(NSInteger tickerIndex, NSData *responseData, NSError *error) {
+        
+        if ((error == nil)&&(responseData != nil)) {
+            
+            NSDictionary *eventDetail = [self earningsEventDetailsFromResponse:responseData forTicker:[tickers objectAtIndex:tickerIndex]];
+            if (eventDetail != nil) {
+                NSMutableDictionary *refreshedEventDetail = [eventDetail mutableCopy];
+                [refreshedEventDetail setObject:[self nextLikelyChangeDateForEarningsEventWithDate:[eventDetail objectForKey:@"date"] certainty:[eventDetail objectForKey:@"certainty"] asOf:refreshDate] forKey:@"nextRefreshDate"];
+                [refreshedEventDetails addObject:refreshedEventDetail];
+            } else {
+                NSLog(@"ERROR: Events data from the API Data Source for ticker:%@ did not have the earnings event",[tickers objectAtIndex:tickerIndex]);
+            }
+        } else {
+            ++noOfFailedRequests;
+            NSLog(@"ERROR: Could not get events data from the API Data Source for ticker:%@. Error description: %@",[tickers objectAtIndex:tickerIndex],error.description);
+        }
+        return YES;
+    }];
+    
+    // Write all the refreshed events back in a single batch, then process any reminders for them
+    [self upsertEventsWithDetails:refreshedEventDetails];
+    for (NSDictionary *refreshedEventDetail in refreshedEventDetails) {
+        [self processRemindersForEarningsEventDetails:refreshedEventDetail];
+    }
+    
+    // Show user an error message, once, if some of the tickers couldn't be fetched
+    if (noOfFailedRequests > 0) {
+        [self sendUserMessageCreatedNotificationWithMessage:@"Unable to fetch. Check Connection."];
+    }
+    
+    return refreshedEventDetails.count;
+}
+
 // Update the existing events in the local data store, with latest information from the remote data source, if it's
 // likely that the remote source has been updated. There are 2 scenarios where it's likely:
 // 1. If the speculated date of an event is within 2 weeks of today, then we consider it likely that the event has been updated
@@ -4159,7 +4441,7 @@ bool eventsUpdated = NO;
     //NSLog(@"LAST EVENT SYNCED DATE AND TIME IS:%@",lastSyncDate);
     //NSLog(@"TODAY DATE AND TIME IS:%@",todaysDate);
     // Get the number of days between the 2 dates
-    NSCalendar *gregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *gregorianCalendar = [FADateCache gregorianCalendar];
     NSDateComponents *components = [gregorianCalendar components:NSCalendarUnitDay fromDate:lastSyncDate toDate:todaysDate options:0];
     NSInteger daysBetween = [components day];
     // Get the number of hours between the 2 dates
@@ -4174,47 +4456,15 @@ bool eventsUpdated = NO;
     // TO DO: Sync every 6 hours
     if((int)hoursBetween >= 6) {
         
-        // Get all events in the local data store.
-        NSFetchedResultsController *eventResultsController = [self getAllEvents];
+        // Start the busy spinner on the UI to indicate that a fetch is in progress. Any async UI element update has to happen in the main thread.
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [[NSNotificationCenter defaultCenter]postNotificationName:@"StartBusySpinner" object:self];
+        });
         
-        // For every earnings event check if it's likely that the remote source has been updated. There are 2 scenarios where it's likely:
-        // 1. If the speculated date of an event is within 31 days from today, then we consider it likely that the event has been updated
-        // in the remote source. The likely event also needs to have a certainty of either "Estimated" or "Unknown" to qualify for the update.
-        // 2. If the confirmed date of the event is in the past.
-        // An earnings event that overall qualifies will be refetched from the remote data source and updated in the local data store.
-        for (Event *localEvent in eventResultsController.fetchedObjects)
-        {
-            // Get the event's date
-            NSDate *eventDate = localEvent.date;
-            // Get the number of days between the 2 dates
-            components = [gregorianCalendar components:NSCalendarUnitDay fromDate:todaysDate toDate:eventDate options:0];
-            daysBetween = [components day];
-            
-            // Start the busy spinner at every iteration as we don't know which when will register.
-            //if (!eventsUpdated) {
-             // Start the busy spinner on the UI to indicate that a fetch is in progress. Any async UI element update has to happen in the main thread.
-             dispatch_async(dispatch_get_main_queue(), ^{
-             // TO DO: Delete before shipping v4.3
-             //NSLog(@"About to start busy spinner");
-             [[NSNotificationCenter defaultCenter]postNotificationName:@"StartBusySpinner" object:self];
-             });
-             //}
-            
-            // See if the event is Quarterly Earnings
-            if ([localEvent.type isEqualToString:@"Quarterly Earnings"]) {
-                
-                // See if the event qualifies for the update. If it does, call the remote data source to update it.
-                if ((([localEvent.certainty isEqualToString:@"Estimated"]||[localEvent.certainty isEqualToString:@"Unknown"])&&((int)daysBetween <= 31))||([localEvent.certainty isEqualToString:@"Confirmed"]&&((int)daysBetween < 0))){
-                    
-                    // TO DO: Delete before shipping v4.3
-                    //NSLog(@"About to fetch earnings from initial non product sync for ticker:%@",localEvent.listedCompany.ticker);
-                    
-                    [self getAllEventsFromApiWithTicker:localEvent.listedCompany.ticker];
-                    
-                    //eventsUpdated = YES;
-                }
-            }
-            
+        // Pick the tickers whose earnings events are likely to have been updated in the remote source, with a single indexed query on their next likely change date, and refresh just those.
+        // See nextLikelyChangeDateForEarningsEventWithDate for when that is.
+        NSArray *dueTickers = [self tickersWithEarningsDueForRefreshAsOf:todaysDate];
+        if ([self refreshEarningsEventsForTickers:dueTickers asOf:todaysDate] > 0) {
             eventsUpdated = YES;
         }
         
@@ -4253,12 +4503,11 @@ bool eventsUpdated = NO;
         // Set events sync status to "RefreshCheckDone" means a check to see if refreshed events data is available is done. This also sets the event sync date to today.
         [self updateUserWithEventSyncStatus:@"RefreshCheckDone"];
         
-        // Fire events change notification if any event was updated. Plus Stop the busy spinner on the UI to indicate that the fetch is complete.
+        // Stop the busy spinner on the UI to indicate that the fetch is complete. Updated events are merged into the main queue context, which updates the UI, so there's no need to fire an events change notification.
         if (eventsUpdated) {
             
             // Any async UI element update has to happen in the main thread.
             dispatch_async(dispatch_get_main_queue(), ^{
-                [self sendEventsChangeNotification];
                 // TO DO: Delete before shipping v4.3
                 //NSLog(@"About to stop busy spinner");
                 [[NSNotificationCenter defaultCenter]postNotificationName:@"StopBusySpinner" object:self];
@@ -4611,7 +4860,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *eventEntity = [NSEntityDescription entityForName:@"Event" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"listedCompany.ticker =[c] %@ AND type =[c] %@",eventCompanyTicker, associatedEventType];
+    NSPredicate *eventPredicate = [NSPredicate predicateWithFormat:@"tickerKey == %@ AND type =[c] %@",[eventCompanyTicker uppercaseString], associatedEventType];
     [eventFetchRequest setEntity:eventEntity];
     [eventFetchRequest setPredicate:eventPredicate];
     NSError *error;
@@ -4630,9 +4879,17 @@ bool eventsUpdated = NO;
         action.status = actionStatus;
         action.parentEvent = existingEvent;
         
+        // Following actions mark the company as followed
+        BOOL followAction = ([actionType caseInsensitiveCompare:@"OSReminder"] == NSOrderedSame)||([actionType caseInsensitiveCompare:@"PriceChange"] == NSOrderedSame);
+        if (followAction && ![existingEvent.listedCompany.isFollowed boolValue]) {
+            existingEvent.listedCompany.isFollowed = [NSNumber numberWithBool:YES];
+        }
+        
         // Perform the insert
         if (![dataStoreContext save:&error]) {
             NSLog(@"ERROR: Saving action to data store failed: %@",error.description);
+        } else {
+            [[FAFollowIndex sharedIndex] addActionOfType:actionType eventTicker:eventCompanyTicker eventType:existingEvent.type];
         }
     }
     
@@ -4652,7 +4909,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",actionType, eventCompanyTicker, associatedEventType];
+    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@",actionType, [eventCompanyTicker uppercaseString], associatedEventType];
     [actionFetchRequest setEntity:actionEntity];
     [actionFetchRequest setPredicate:actionPredicate];
     NSError *error;
@@ -4683,66 +4940,18 @@ bool eventsUpdated = NO;
 }
 
 // Check to see if an Action associated with an event is present, in the Action Data Store, given the Event Company Ticker and Event Type. Note: Currently, the listed company ticker and event type, together represent the event uniquely.
+// Answered from the in memory follow index, since this is checked for every symbol in the sync loops.
 // TO DO: Refactor here to add multiple types of actions.
 - (BOOL)doesReminderActionExistForEventWithTicker:(NSString *)eventCompanyTicker eventType:(NSString *)associatedEventType
 {
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    BOOL exists = NO;
-    
-    // Check to see if the action exists by doing a case insensitive query on Action Type, Event Company Ticker and Event Type.
-    NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:dataStoreContext];
-    // Case and Diacractic Insensitive Filtering
-    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@",@"OSReminder", eventCompanyTicker, associatedEventType];
-    [actionFetchRequest setEntity:actionEntity];
-    [actionFetchRequest setPredicate:actionPredicate];
-    NSError *error;
-    NSArray *fetchedActions = [dataStoreContext executeFetchRequest:actionFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting an action from data store, to check if it exists for an associated event, failed: %@",error.description);
-    }
-    if (fetchedActions.count > 1) {
-        NSLog(@"MEDIUM_WARNING: Found more than 1 action of the same type for a unique event in the Action Data Store");
-        exists = YES;
-    }
-    if (fetchedActions.count == 1) {
-        exists = YES;
-    }
-    
-    return exists;
+    return [[FAFollowIndex sharedIndex] hasReminderForEventWithTicker:eventCompanyTicker eventType:associatedEventType];
 }
 
 // Check to see if an Action associated with an event is present, in the Action Data Store, given the full event type (e.g. Feb US Jobs Report).
+// Answered from the in memory follow index.
 - (BOOL)doesReminderActionExistForSpecificEvent:(NSString *)eventType
 {
-    NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
-    BOOL exists = NO;
-    Action *action1 = nil;
-    Action *action2 = nil;
-    
-    // Check to see if the action exists by doing a case insensitive query on Action Type and Event Type.
-    NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:dataStoreContext];
-    // Case and Diacractic Insensitive Filtering
-    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND parentEvent.type =[c] %@",@"OSReminder", eventType];
-    [actionFetchRequest setEntity:actionEntity];
-    [actionFetchRequest setPredicate:actionPredicate];
-    NSError *error;
-    NSArray *fetchedActions = [dataStoreContext executeFetchRequest:actionFetchRequest error:&error];
-    if (error) {
-        NSLog(@"ERROR: Getting an action from data store, to check if it exists for an associated event, failed: %@",error.description);
-    }
-    if (fetchedActions.count > 1) {
-        action1 = fetchedActions[0];
-        action2 = fetchedActions[1];
-        NSLog(@"MEDIUM_WARNING: Found more than 1 action of event type %@ action type 1 %@ action type 2 %@ ticker1 %@ ticker2 %@ for a unique event in the Action Data Store. Ignore for Econ events.", eventType, action1.type, action2.type, action1.parentEvent.listedCompany.ticker,action2.parentEvent.listedCompany.ticker);
-        exists = YES;
-    }
-    if (fetchedActions.count == 1) {
-        exists = YES;
-    }
-    
-    return exists;
+    return [[FAFollowIndex sharedIndex] hasReminderForEventType:eventType];
 }
 
 // Check to see if a Queued Action associated with an event is present, in the Action Data Store, given the Event Company Ticker and Event Type. Note: Currently, the listed company ticker and event type, together represent the event uniquely.
@@ -4756,7 +4965,7 @@ bool eventsUpdated = NO;
     NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:dataStoreContext];
     // Case and Diacractic Insensitive Filtering
-    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND status =[c] %@ AND parentEvent.listedCompany.ticker =[c] %@ AND parentEvent.type =[c] %@", @"OSReminder", @"Queued", eventCompanyTicker, associatedEventType];
+    NSPredicate *actionPredicate = [NSPredicate predicateWithFormat:@"type =[c] %@ AND status =[c] %@ AND parentEvent.tickerKey == %@ AND parentEvent.type =[c] %@", @"OSReminder", @"Queued", [eventCompanyTicker uppercaseString], associatedEventType];
     [actionFetchRequest setEntity:actionEntity];
     [actionFetchRequest setPredicate:actionPredicate];
     NSError *error;
@@ -4780,26 +4989,26 @@ bool eventsUpdated = NO;
 {
     NSManagedObjectContext *dataStoreContext = [self managedObjectContext];
     
-    // Get the event by doing a case insensitive query on parent company Ticker and event type.
-    // For price change events the event type is a fuzzy match.
-    NSFetchRequest *actionsFetchRequest = [[NSFetchRequest alloc] init];
-    NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:dataStoreContext];
+    // Delete all actions in the store in one go
+    if (![[FADataStore sharedStore] batchDeleteObjectsOfEntity:@"Action" matchingPredicate:nil fromContext:dataStoreContext]) {
+        return;
+    }
+    [[FAFollowIndex sharedIndex] removeAllActions];
     
-    // Fetch all actions
-    [actionsFetchRequest setEntity:actionEntity];
+    // No company is followed anymore
+    NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+    [companyFetchRequest setEntity:[NSEntityDescription entityForName:@"Company" inManagedObjectContext:dataStoreContext]];
+    [companyFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"isFollowed == YES"]];
     NSError *error;
-    NSArray *actions = [dataStoreContext executeFetchRequest:actionsFetchRequest error:&error];
+    NSArray *followedCompanies = [dataStoreContext executeFetchRequest:companyFetchRequest error:&error];
     if (error) {
-        NSLog(@"ERROR: Getting all reminder actions, while trying to delete all of them, from data store failed: %@",error.description);
+        NSLog(@"ERROR: Getting all followed companies, while trying to delete all actions, from data store failed: %@",error.description);
     }
-    
-    // Delete all actions
-    for (NSManagedObject *action in actions) {
-        
-        [dataStoreContext deleteObject:action];
+    for (Company *followedCompany in followedCompanies) {
+        followedCompany.isFollowed = [NSNumber numberWithBool:NO];
     }
     
-    // Save managed object context to persist the delete.
+    // Save managed object context to persist the followed flags.
     [dataStoreContext save:&error];
 }
 
@@ -4816,7 +5025,7 @@ bool eventsUpdated = NO;
     // Filter based on ticker
     
     // Fetch all actions
-    NSPredicate *actionsPredicate = [NSPredicate predicateWithFormat:@"(type =[c] %@ OR type =[c] %@) AND parentEvent.listedCompany.ticker =[c] %@", @"OSReminder", @"PriceChange", ticker];
+    NSPredicate *actionsPredicate = [NSPredicate predicateWithFormat:@"(type =[c] %@ OR type =[c] %@) AND parentEvent.tickerKey == %@", @"OSReminder", @"PriceChange", [ticker uppercaseString]];
     [actionsFetchRequest setEntity:actionEntity];
     [actionsFetchRequest setPredicate:actionsPredicate];
     NSError *error;
@@ -4825,14 +5034,23 @@ bool eventsUpdated = NO;
         NSLog(@"ERROR: Getting all following related event actions, while trying to delete all of them, from data store failed: %@",error.description);
     }
     
-    // Delete all following actions
-    for (NSManagedObject *action in actions) {
+    // Delete all following actions, after which the company is no longer followed
+    NSMutableArray *deletedActions = [NSMutableArray arrayWithCapacity:actions.count];
+    for (Action *action in actions) {
         
+        if (action.type != nil && action.parentEvent.type != nil) {
+            [deletedActions addObject:@[action.type, action.parentEvent.type]];
+        }
+        action.parentEvent.listedCompany.isFollowed = [NSNumber numberWithBool:NO];
         [dataStoreContext deleteObject:action];
     }
     
     // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    if ([dataStoreContext save:&error]) {
+        for (NSArray *deletedAction in deletedActions) {
+            [[FAFollowIndex sharedIndex] removeActionOfType:[deletedAction objectAtIndex:0] eventTicker:ticker eventType:[deletedAction objectAtIndex:1]];
+        }
+    }
 }
 
 // Delete all entries for a particular econ event type in the actions store that indicate that the ticker is being followed so basically entries of the following type: "OSReminder" which means creating a reminder native to iOS.
@@ -4884,13 +5102,36 @@ bool eventsUpdated = NO;
     }
     
     // Delete all following actions
-    for (NSManagedObject *action in actions) {
-        
+    NSMutableArray *deletedActions = [NSMutableArray arrayWithCapacity:actions.count];
+    NSMutableSet *affectedCompanies = [NSMutableSet set];
+    for (Action *action in actions) {
+        
+        Company *eventCompany = action.parentEvent.listedCompany;
+        if (action.type != nil && eventCompany.ticker != nil && action.parentEvent.type != nil) {
+            [deletedActions addObject:@[action.type, eventCompany.ticker, action.parentEvent.type]];
+            [affectedCompanies addObject:eventCompany];
+        }
         [dataStoreContext deleteObject:action];
     }
     
     // Save managed object context to persist the delete.
-    [dataStoreContext save:&error];
+    if (![dataStoreContext save:&error]) {
+        return;
+    }
+    
+    // The agency putting out the event might still be followed for it's other event types, so check before clearing it's followed flag
+    FAFollowIndex *followIndex = [FAFollowIndex sharedIndex];
+    for (NSArray *deletedAction in deletedActions) {
+        [followIndex removeActionOfType:[deletedAction objectAtIndex:0] eventTicker:[deletedAction objectAtIndex:1] eventType:[deletedAction objectAtIndex:2]];
+    }
+    for (Company *affectedCompany in affectedCompanies) {
+        if (![followIndex isTickerFollowed:affectedCompany.ticker]) {
+            affectedCompany.isFollowed = [NSNumber numberWithBool:NO];
+        }
+    }
+    if ([dataStoreContext hasChanges] && ![dataStoreContext save:&error]) {
+        NSLog(@"ERROR: Saving the followed flag for companies whose econ event actions were deleted, to data store failed: %@",error.description);
+    }
 }
 
 #pragma mark - Notifications
@@ -4923,18 +5164,14 @@ bool eventsUpdated = NO;
 // Format the given date to set the time on it to midnight last night. e.g. 03/21/2016 9:00 pm becomes 03/21/2016 12:00 am.
 - (NSDate *)setTimeToMidnightLastNightOnDate:(NSDate *)dateToFormat
 {
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *dateComponents = [aGregorianCalendar components:(NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay) fromDate:dateToFormat];
-    NSDate *formattedDate = [aGregorianCalendar dateFromComponents:dateComponents];
-    
-    return formattedDate;
+    return [FADateCache dateForEpochDay:[FADateCache localEpochDayForDate:dateToFormat]];
 }
 
 // Calculate how many days is it from the given event date to today.
 - (NSInteger)calculateDistanceFromEventDate:(NSDate *)eventDate
 {
     // Calculate the number of days between event date and today's date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *aGregorianCalendar = [FADateCache gregorianCalendar];
     NSUInteger unitFlags =  NSCalendarUnitDay;
     NSDateComponents *diffDateComponents = [aGregorianCalendar components:unitFlags fromDate:eventDate toDate:[NSDate date] options:0];
     NSInteger difference = [diffDateComponents day];
@@ -4942,90 +5179,126 @@ bool eventsUpdated = NO;
     return difference;
 }
 
+// Send an asynchronous request using NSURLSession. The completion handler is called on the session's delegate queue with the response data, response and error.
+// Every API call goes through here, so this is where they are timed for tracing.
+- (void)sendAsynchronousRequest:(NSURLRequest *)request completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler
+{
+    uint64_t spanStart = FATraceBegin();
+    [[[NSURLSession sharedSession] dataTaskWithRequest:request completionHandler:^(NSData * _Nullable _data, NSURLResponse * _Nullable _response, NSError * _Nullable _error) {
+        FATraceEnd(FATraceSpanApiCall, spanStart);
+        FATraceCount(FATraceCounterApiBytes, (int64_t)_data.length);
+        FATraceCount(FATraceCounterApiFailures, (_error != nil) ? 1 : 0);
+        if (completionHandler) {
+            completionHandler(_data, _response, _error);
+        }
+    }] resume];
+}
+
+// Download the requests, with up to window of them in flight at a time, and hand each response to the process block one at a time, in request order, on
+// the calling thread. Request at index is asked for the request with each index in turn, and returns nil if there isn't one yet. It's asked again for that
+// index after the next response is processed, since processing can reveal more requests e.g. the total no of pages. Downloading stops when there are no more
+// requests or the process block returns NO. Responses still in flight then are dropped. Should never be called on the main thread.
+- (void)fetchRequestsWithWindow:(NSInteger)window requestAtIndex:(NSURLRequest *(^)(NSInteger requestIndex))requestAtIndex processInOrder:(BOOL (^)(NSInteger requestIndex, NSData *data, NSError *error))processResponse
+{
+    // Downloaded responses {data, error} and the semaphores that are signalled when they arrive, keyed by index of the request
+    NSMutableDictionary *responses = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary *arrivals = [[NSMutableDictionary alloc] init];
+    // Index of the last request that has been sent
+    NSInteger lastRequestedIndex = -1;
+    
+    for (NSInteger requestIndex = 0; ; requestIndex++) {
+        
+        // Keep the window full with the upcoming requests
+        while (lastRequestedIndex < (requestIndex + window - 1)) {
+            
+            NSURLRequest *request = requestAtIndex(lastRequestedIndex + 1);
+            if (request == nil) {
+                break;
+            }
+            ++lastRequestedIndex;
+            
+            NSNumber *requestedKey = [NSNumber numberWithInteger:lastRequestedIndex];
+            dispatch_semaphore_t responseArrived = dispatch_semaphore_create(0);
+            [arrivals setObject:responseArrived forKey:requestedKey];
+            
+            // Make the call asynchronously
+            [self sendAsynchronousRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+                @synchronized (responses) {
+                    [responses setObject:@[(data ? data : [NSNull null]), (error ? error : [NSNull null])] forKey:requestedKey];
+                }
+                dispatch_semaphore_signal(responseArrived);
+            }];
+        }
+        
+        // Nothing left to process
+        if (requestIndex > lastRequestedIndex) {
+            break;
+        }
+        
+        // Wait for the response that's next in order to arrive
+        NSNumber *responseKey = [NSNumber numberWithInteger:requestIndex];
+        dispatch_semaphore_wait([arrivals objectForKey:responseKey], DISPATCH_TIME_FOREVER);
+        [arrivals removeObjectForKey:responseKey];
+        NSArray *response = nil;
+        @synchronized (responses) {
+            response = [responses objectForKey:responseKey];
+            [responses removeObjectForKey:responseKey];
+        }
+        NSData *responseData = ([[response objectAtIndex:0] isKindOfClass:[NSData class]]) ? [response objectAtIndex:0] : nil;
+        NSError *error = ([[response objectAtIndex:1] isKindOfClass:[NSError class]]) ? [response objectAtIndex:1] : nil;
+        
+        if (!processResponse(requestIndex, responseData, error)) {
+            break;
+        }
+    }
+}
+
 // Simulating a Synchronous Request using NSURLSession that doesn't support synchronous requests. Need this since NSURLRequest has been deprecated.
+// The calling thread is parked on a semaphore until the request completes, so it doesn't use any CPU while waiting. Should never be called on the main thread.
 - (NSData *)sendSynchronousRequest:(NSURLRequest *)request returningResponse:(NSURLResponse **)response error:(NSError **)error
 {
     
     NSError __block *err = NULL;
     NSData __block *data;
-    BOOL __block reqProcessed = false;
     NSURLResponse __block *resp;
+    dispatch_semaphore_t reqProcessed = dispatch_semaphore_create(0);
     
-    [[[NSURLSession sharedSession] dataTaskWithRequest:request completionHandler:^(NSData * _Nullable _data, NSURLResponse * _Nullable _response, NSError * _Nullable _error) {
+    [self sendAsynchronousRequest:request completionHandler:^(NSData *_data, NSURLResponse *_response, NSError *_error) {
         resp = _response;
         err = _error;
         data = _data;
-        reqProcessed = true;
-    }] resume];
+        dispatch_semaphore_signal(reqProcessed);
+    }];
     
-    while (!reqProcessed) {
-        [NSThread sleepForTimeInterval:0];
-    }
+    dispatch_semaphore_wait(reqProcessed, DISPATCH_TIME_FOREVER);
     
-    *response = resp;
-    *error = err;
+    if (response) {
+        *response = resp;
+    }
+    if (error) {
+        *error = err;
+    }
     return data;
 }
 
-// Compute the unscrubbed date 30 days ago from today. Unscrubbed means it could be a weekend or a holiday.
-- (NSDate *)computeDate30DaysAgoFrom:(NSDate *)startingDate
+// For price change events, return the generic part of the event type that identifies the event for a ticker e.g. "% up today" for "+1.25% up today $30.12". Return nil for all other events as they are identified by the exact type string.
+- (NSString *)genericTypeForPriceChangeEventType:(NSString *)eventType
 {
-    // Subtract 30 days from start date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = -30;
-    NSDate *returnDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:startingDate options:0];
-    
-    return returnDate;
+    return [FAEventClassification classificationForType:eventType ticker:nil].genericType;
 }
 
-// Make sure the date doesn't fall on a Friday, Saturday, Sunday. In these cases move it to the previous Friday for Saturday and following Monday for Sunday. TO DO LATER: Factor in holidays here.
-- (NSDate *)scrubDateToNotBeWeekendOrHoliday:(NSDate *)dateToScrub
+// Return the normalized lookup keys (uppercased tickers) for the given tickers, to use in a tickerKey IN lookup.
+- (NSSet *)tickerLookupValuesForTickers:(NSArray *)tickers
 {
-    // Make sure the date doesn't fall on a Friday, Saturday, Sunday. In these cases move it to the previous Friday for Saturday and following Monday for Sunday. TO DO LATER: Factor in holidays here.
-    // Convert from string to Date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateFormatter *dayFormatter = [[NSDateFormatter alloc] init];
-    [dayFormatter setDateFormat:@"EEE"];
-    // Set the formatter to be GMT since dates are always GMT and formatters are defaulted to local timezone
-    [dayFormatter setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    NSDate *scrubbedDate = dateToScrub;
-    NSString *dayString = [dayFormatter stringFromDate:dateToScrub];
+    NSMutableSet *lookupValues = [[NSMutableSet alloc] init];
     
-    if ([dayString isEqualToString:@"Sat"]) {
-        differenceDayComponents.day = -1;
-        scrubbedDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:dateToScrub options:0];
-    }
-    
-    if ([dayString isEqualToString:@"Sun"]) {
-        differenceDayComponents.day = 1;
-        scrubbedDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:dateToScrub options:0];
+    for (id ticker in tickers) {
+        if ([ticker isKindOfClass:[NSString class]]) {
+            [lookupValues addObject:[ticker uppercaseString]];
+        }
     }
     
-    return scrubbedDate;
-}
-
-// Compute the scrubbed first market day of the year for the given date. Currently it works only for 2016.
-// TO DO: Change this for 2017 and so on and so forth
-// TO DO Change for beginning of the year 2019: For 2017, the first market day will be 2 days later on Jan 3. So add 2 instead of 3 here. That's it. www.timeanddate.com/calendar/?year=2017&country=1
-// FOR 2018: the first day the market is open is Tue Jan 2nd. So add 1 instead of 2.
-- (NSDate *)computeMarketStartDateOfTheYearFrom:(NSDate *)givenDate
-{
-    // Compute the first date of the year from the given date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents * aCalComponents = [aGregorianCalendar components: NSCalendarUnitYear fromDate:givenDate];
-    [aCalComponents setYear:[aCalComponents year]];
-    NSDate *returnDate = [aGregorianCalendar dateFromComponents:aCalComponents];
-    
-    // For 2016, the first market open day was 3 days after, Jan 1 putting it at Jan 4.
-    // TO DO: For 2017, the first market day will be 2 days later on Jan 3. So add 2 instead of 3 here. That's it. www.timeanddate.com/calendar/?year=2017&country=1
-    // FOR 2018: the first day the market is open is Tue Jan 2nd. So add 1 instead of 2.
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = 1;
-    returnDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:returnDate options:0];
-    
-    return returnDate;
+    return lookupValues;
 }
 
 @end
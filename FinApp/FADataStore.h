@@ -2,9 +2,11 @@
 //  FADataStore.h
 //  FinApp
 //
-//  Class that sets up a single data store. Each thread should have it's own
-//  FADataController that creates a new managed object context that talks to a
-//  single persistent store coordinator in this single persistent store.
+//  Class that sets up a single data store. A private queue writer context owns the
+//  single persistent store coordinator and writes to disk. The main thread shares a
+//  single main queue context, a child of the writer, for all UI fetches. Every other
+//  thread gets it's own private queue child context of the writer, the saves from
+//  which are merged into the main queue context.
 //
 //  Created by Sidd Singh on 2/25/15.
 //  Copyright (c) 2015 Sidd Singh. All rights reserved.
@@ -13,17 +15,63 @@
 #import <Foundation/Foundation.h>
 #import <CoreData/CoreData.h>
 
+// Posted, on the thread that ran the delete, after a bulk delete removed objects from the store, since it bypasses the contexts' saves. The user info
+// has the ids of the deleted objects under NSDeletedObjectsKey and of the objects updated to match under NSUpdatedObjectsKey.
+extern NSString * const FADataStoreDidBatchDeleteNotification;
+
 @interface FADataStore : NSObject
 
 // Create and/or return the single shared data store
 + (FADataStore *) sharedStore;
 
+// Set up a data store on the given store coordinator, with it's store already added, instead of the application's store e.g. a temporary
+// store for tests. It doesn't feed the shared company search index, which is of the application's store.
+- (id)initWithPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)storeCoordinator;
+
 // Core Data Store object model
 @property (strong, nonatomic) NSManagedObjectModel *managedObjectModel;
 
 // Store Coordinator for Core Data Store
 @property (strong, nonatomic) NSPersistentStoreCoordinator *persistentStoreCoordinator;
 
+// Error that loading the persistent store ran into, if any. If the store couldn't be opened it's moved aside and a new one, seeded from the preseed snapshot, is used instead.
+@property (strong, nonatomic, readonly) NSError *storeLoadError;
+
+// Has the persistent store been loaded, migrated and seeded, if needed. Check this on the main thread before using the store, to avoid waiting for it to load.
+@property (atomic, readonly, getter=isStoreLoaded) BOOL storeLoaded;
+
+// Load the persistent store, migrating and seeding it if needed, on a background queue so that launch doesn't wait for it. Anything
+// that needs the store before it's loaded waits for it. The completion block, if any, is called on the main queue once it's loaded.
+- (void)loadPersistentStoreInBackgroundWithCompletion:(void (^)(void))completion;
+
+// Private queue context, on the persistent store coordinator, that all other contexts save into. Changes pushed into it are written to disk in the background.
+@property (strong, nonatomic, readonly) NSManagedObjectContext *writerContext;
+
+// Main queue context, child of the writer context, that is shared by everything on the main thread, including the fetched results controllers driving the UI.
+// Saves from background contexts are merged into it, so fetched results controllers on it update incrementally.
+@property (strong, nonatomic, readonly) NSManagedObjectContext *mainContext;
+
+// Create a new private queue context, child of the writer context, for use off the main thread. Saving it pushes the changes into the writer context,
+// which writes them to disk, and merges them into the main queue context. Work with it inside performBlockAndWait:
+- (NSManagedObjectContext *)newBackgroundContext;
+
+// Delete all objects of the entity that match the predicate with set based deletes in the store, instead of fetching each one into a context and deleting it.
+// Objects that the cascade relationships of the deleted objects point to are deleted the same way. Any unsaved changes in the calling context are saved
+// first, and the deleted object ids are merged into the writer, main queue and calling contexts afterwards. Deleted companies are removed from the company
+// search index, and companies that lost all their following actions are no longer flagged as followed. Returns NO if the delete failed.
+- (BOOL)batchDeleteObjectsOfEntity:(NSString *)entityName matchingPredicate:(NSPredicate *)predicate fromContext:(NSManagedObjectContext *)callingContext;
+
+// Write any unsaved changes in the main queue context and any saved changes still waiting in the writer context to disk, waiting till
+// they are written. Call on the main thread before the app is suspended or terminated.
+- (void)flushToDisk;
+
+// Get the value stored under the key in the persistent store's metadata, which lives and dies with the store e.g. the version of the last one time
+// data migration run on it. nil if there's none.
+- (id)metadataValueForKey:(NSString *)key;
+
+// Store the value under the key in the persistent store's metadata. It's written to disk with the next save of the writer context.
+- (void)setMetadataValue:(id)value forKey:(NSString *)key;
+
 // Returns the URL to the application's Documents directory.
 - (NSURL *)applicationDocumentsDirectory;
 
@@ -2,15 +2,75 @@
 //  FADataStore.m
 //  FinApp
 //
-//  Class that sets up a single data store. Each thread should have it's own
-//  FADataController that creates a new managed object context that talks to a
-//  single persistent store coordinator in this single persistent store.
+//  Class that sets up a single data store. A private queue writer context owns the
+//  single persistent store coordinator and writes to disk. The main thread shares a
+//  single main queue context, a child of the writer, for all UI fetches. Every other
+//  thread gets it's own child context of the writer, the saves from which are merged
+//  into the main queue context.
 //
 //  Created by Sidd Singh on 2/25/15.
 //  Copyright (c) 2015 Sidd Singh. All rights reserved.
 //
 
 #import "FADataStore.h"
+#import "Company.h"
+#import "Event.h"
+#import "Action.h"
+#import "EventHistory.h"
+#import "FACompanySearchIndex.h"
+#import "FAFollowIndex.h"
+#import "FAPreseedSnapshot.h"
+#import "FATracedManagedObjectContext.h"
+
+NSString * const FADataStoreDidBatchDeleteNotification = @"FADataStoreDidBatchDeleteNotification";
+
+@interface FADataStore ()
+
+// Serial queue the persistent store is loaded on, so that it's only loaded once, and anything that needs it waits till it's loaded.
+@property (strong, nonatomic) dispatch_queue_t storeLoadQueue;
+
+// Has the persistent store been loaded, migrated and seeded, if needed. Only set on the store load queue.
+@property (atomic, readwrite, getter=isStoreLoaded) BOOL storeLoaded;
+
+// Error that loading the persistent store ran into, if any, even if it then recovered from it.
+@property (strong, nonatomic, readwrite) NSError *storeLoadError;
+
+// Create the persistent store coordinator and add the application's store to it, migrating it and seeding it if needed. Must be called on the store load queue.
+- (void)loadPersistentStoreIfNeeded;
+
+// Move a store that can't be opened, along with it's journal files, out of the way, keeping it around for diagnosis.
+- (void)moveAsideStoreAtURL:(NSURL *)storeURL;
+
+// Seed a newly created store from the bundled preseed snapshot, in a single transaction straight to disk, before any other context uses it.
+- (void)importPreseedSnapshotIntoNewStore;
+
+// Fill in the normalized lookup keys, followed flag and product event details for companies and events that were created before these existed in the model.
+- (void)backfillLookupKeys;
+
+// Private queue context, on the persistent store coordinator, that all other contexts save into.
+@property (strong, nonatomic, readwrite) NSManagedObjectContext *writerContext;
+
+// Main queue context, child of the writer context, shared by everything on the main thread.
+@property (strong, nonatomic, readwrite) NSManagedObjectContext *mainContext;
+
+// Before a child of the writer context saves, get permanent ids for the objects it inserted, so that they can be matched up when merged into other contexts.
+- (void)childContextWillSave:(NSNotification *)notification;
+
+// After a child of the writer context saves, merge background saves into the main queue context, update the company search index and write the changes to disk.
+- (void)childContextDidSave:(NSNotification *)notification;
+
+// Write any changes pushed into the writer context to disk, in the background.
+- (void)saveWriterContext;
+
+// Delete the objects of the entity that match the predicate, and whatever their cascade relationships point to, with batch delete requests run in the given
+// context on the store coordinator. The relationship through which the entity is being cascaded to, if any, is skipped. Ids of deleted objects are added to deletedObjectIDs.
+- (BOOL)batchDeleteObjectsOfEntity:(NSEntityDescription *)entity matchingPredicate:(NSPredicate *)predicate cascadedThrough:(NSRelationshipDescription *)parentRelationship inContext:(NSManagedObjectContext *)deleteContext deletedObjectIDs:(NSMutableArray *)deletedObjectIDs error:(NSError **)error;
+
+// Clear the followed flag of companies that no longer have any following actions on their events, after a bulk delete took them away, saving the context.
+// Returns the ids of the companies updated. Must be called on the context's queue.
+- (NSArray *)unfollowCompaniesWithoutFollowingActionsInContext:(NSManagedObjectContext *)deleteContext;
+
+@end
 
 @implementation FADataStore
 
@@ -37,6 +97,41 @@ static FADataStore *sharedInstance;
     return sharedInstance;
 }
 
+// Set up the context stack and start listening for saves from the child contexts.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(childContextWillSave:)
+                                                     name:NSManagedObjectContextWillSaveNotification object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(childContextDidSave:)
+                                                     name:NSManagedObjectContextDidSaveNotification object:nil];
+        self.storeLoadQueue = dispatch_queue_create("com.siddsingh.FinApp.storeLoad", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+// Set up a data store on the given store coordinator, with it's store already added, instead of the application's store e.g. a temporary
+// store for tests. It doesn't feed the shared company search index, which is of the application's store.
+- (id)initWithPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)storeCoordinator
+{
+    self = [self init];
+    if (self) {
+        _managedObjectModel = storeCoordinator.managedObjectModel;
+        _persistentStoreCoordinator = storeCoordinator;
+        self.storeLoaded = YES;
+    }
+    return self;
+}
+
+// Stop listening for saves, for data stores other than the shared one.
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 // Returns the managed object model for the application.
 // If the model doesn't already exist, it is created from the application's model.
 - (NSManagedObjectModel *)managedObjectModel
@@ -50,61 +145,572 @@ static FADataStore *sharedInstance;
 }
 
 // Returns the persistent store coordinator for the application.
-// If the coordinator doesn't already exist, it is created and the application's store added to it.
+// If the store hasn't been loaded, it's loaded on the calling thread, and if it's being loaded in the background this waits till it's done.
 - (NSPersistentStoreCoordinator *)persistentStoreCoordinator
 {
-    if (_persistentStoreCoordinator != nil) {
-        return _persistentStoreCoordinator;
+    dispatch_sync(self.storeLoadQueue, ^{
+        [self loadPersistentStoreIfNeeded];
+    });
+    
+    return _persistentStoreCoordinator;
+}
+
+// Load the persistent store, migrating and seeding it if needed, on a background queue so that launch doesn't wait for it. Anything
+// that needs the store before it's loaded waits for it. The completion block, if any, is called on the main queue once it's loaded.
+- (void)loadPersistentStoreInBackgroundWithCompletion:(void (^)(void))completion
+{
+    dispatch_async(self.storeLoadQueue, ^{
+        [self loadPersistentStoreIfNeeded];
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), completion);
+        }
+    });
+}
+
+// Create the persistent store coordinator and add the application's store to it, migrating it and seeding it if needed. Must be called on the store load queue.
+- (void)loadPersistentStoreIfNeeded
+{
+    if (self.storeLoaded) {
+        return;
     }
     
     NSURL *storeURL = [[self applicationDocumentsDirectory] URLByAppendingPathComponent:@"FinApp.sqlite"];
     
-    // TO DO: COMMENT FOR PRE SEEDING DB: When preseeding we don't want to use the existing db. We want a new one created.
-    // Check to see if a sqlite db already exists. If not, find the path to the preloaded DB and use that.
-    // Post ios7 you need to add the code for copying the sqlite-wal and sqlite-shm files as well if you decide to generate the preseeded file with wal journalling on. Currently we switch that off while generating the preseeded db.
-    if (![[NSFileManager defaultManager] fileExistsAtPath:[storeURL path]]) {
-        // Copy the .sqlite file
-        NSURL *preloadURL = [NSURL fileURLWithPath:[[NSBundle mainBundle] pathForResource:@"FinApp" ofType:@"sqlite"]];
-        NSError* err = nil;
-        if (![[NSFileManager defaultManager] copyItemAtURL:preloadURL toURL:storeURL error:&err]) {
-            NSLog(@"ERROR: Could not copy the Preloaded SQL Database .sqlite file for use because:%@",err.description);
-        }
-    }
+    // Check to see if a sqlite db already exists. If not, a new one is created and seeded from the bundled preseed snapshot, which is compiled
+    // at build time from the preseeded FinApp.sqlite and the other seed data files, instead of copying the preseeded db and adding to it.
+    BOOL isNewStore = ![[NSFileManager defaultManager] fileExistsAtPath:[storeURL path]];
     
     NSError *error = nil;
     _persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:[self managedObjectModel]];
     // TO DO: UNCOMMENT FOR PRE SEEDING DB: Setting WAL off for SQLite so that we don't have to worry about copying the WAL and SHM files. note: you need to set the options in the next instruction from nil to walOffOptions.
     //NSDictionary *walOffOptions = @{ NSSQLitePragmasOption : @{@"journal_mode" : @"DELETE"} };
     
-    if (![_persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:nil error:&error]) {
-        /*
-         Replace this implementation with code to handle the error appropriately.
-         
-         abort() causes the application to generate a crash log and terminate. You should not use this function in a shipping application, although it may be useful during development.
-         
-         Typical reasons for an error here include:
-         * The persistent store is not accessible;
-         * The schema for the persistent store is incompatible with current managed object model.
-         Check the error message to determine what the actual problem was.
-         
-         
-         If the persistent store is not accessible, there is typically something wrong with the file path. Often, a file URL is pointing into the application's resources directory instead of a writeable directory.
-         
-         If you encounter schema incompatibility errors during development, you can reduce their frequency by:
-         * Simply deleting the existing store:
-         [[NSFileManager defaultManager] removeItemAtURL:storeURL error:nil]
-         
-         * Performing automatic lightweight migration by passing the following dictionary as the options parameter:
-         @{NSMigratePersistentStoresAutomaticallyOption:@YES, NSInferMappingModelAutomaticallyOption:@YES}
-         
-         Lightweight migration will only work for a limited set of schema changes; consult "Core Data Model Versioning and Data Migration Programming Guide" for details.
-         
-         */
-        NSLog(@"Unresolved error %@, %@", error, [error userInfo]);
-        abort();
+    // Lightweight migration of an existing store, including the preseeded one, to the current version of the model.
+    NSDictionary *migrationOptions = @{NSMigratePersistentStoresAutomaticallyOption:@YES, NSInferMappingModelAutomaticallyOption:@YES};
+    
+    if (![_persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:migrationOptions error:&error]) {
+        
+        // The store can't be opened or migrated e.g. it's corrupt or the schema is incompatible. Rather than crashing, move it aside and start over with
+        // a new store seeded from the preseed snapshot. The events are synced again from the remote data sources.
+        NSLog(@"ERROR: Loading the data store failed, so moving it aside and creating a new one: %@, %@",error,[error userInfo]);
+        self.storeLoadError = error;
+        [self moveAsideStoreAtURL:storeURL];
+        isNewStore = YES;
+        error = nil;
+        
+        if (![_persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:migrationOptions error:&error]) {
+            
+            // As a last resort keep the app usable for this session with an in memory store
+            NSLog(@"ERROR: Creating a new data store failed, so falling back to an in memory store: %@, %@",error,[error userInfo]);
+            error = nil;
+            if (![_persistentStoreCoordinator addPersistentStoreWithType:NSInMemoryStoreType configuration:nil URL:nil options:nil error:&error]) {
+                NSLog(@"ERROR: Creating an in memory data store failed: %@, %@",error,[error userInfo]);
+            }
+        }
     }
     
-    return _persistentStoreCoordinator;
+    // TO DO: COMMENT FOR PRE SEEDING DB: When preseeding we don't want the snapshot imported. We want a new, empty, one created.
+    if (isNewStore) {
+        [self importPreseedSnapshotIntoNewStore];
+    }
+    
+    // Lightweight migration adds the lookup keys empty, so fill them in for any existing rows.
+    [self backfillLookupKeys];
+    
+    self.storeLoaded = YES;
+}
+
+// Move a store that can't be opened, along with it's journal files, out of the way, keeping it around for diagnosis.
+- (void)moveAsideStoreAtURL:(NSURL *)storeURL
+{
+    NSString *brokenSuffix = [NSString stringWithFormat:@"broken-%ld",(long)[[NSDate date] timeIntervalSince1970]];
+    
+    for (NSString *fileSuffix in @[@"", @"-wal", @"-shm"]) {
+        NSURL *fileURL = [NSURL fileURLWithPath:[[storeURL path] stringByAppendingString:fileSuffix]];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:[fileURL path]]) {
+            continue;
+        }
+        NSURL *brokenFileURL = [NSURL fileURLWithPath:[NSString stringWithFormat:@"%@-%@%@",[storeURL path],brokenSuffix,fileSuffix]];
+        NSError *error = nil;
+        if (![[NSFileManager defaultManager] moveItemAtURL:fileURL toURL:brokenFileURL error:&error]) {
+            NSLog(@"ERROR: Moving aside the data store file %@ failed, so removing it instead: %@",[fileURL lastPathComponent],error.description);
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        }
+    }
+}
+
+// Seed a newly created store from the bundled preseed snapshot, in a single transaction straight to disk, before any other context uses it.
+- (void)importPreseedSnapshotIntoNewStore
+{
+    FAPreseedSnapshot *snapshot = [FAPreseedSnapshot bundledSnapshot];
+    if (snapshot == nil) {
+        return;
+    }
+    
+    NSManagedObjectContext *importContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [importContext setPersistentStoreCoordinator:_persistentStoreCoordinator];
+    [importContext setUndoManager:nil];
+    
+    [importContext performBlockAndWait:^{
+        NSError *error = nil;
+        if ([snapshot importIntoContext:importContext error:&error]) {
+            // Record the version of the seed data in the store so that it's not imported again
+            [[NSUserDefaults standardUserDefaults] setInteger:snapshot.seedVersion forKey:FAPreseedSnapshotVersionKey];
+        } else {
+            NSLog(@"ERROR: Importing the preseed snapshot of %ld companies and %ld events into the new data store failed: %@",(long)snapshot.companyCount,(long)snapshot.eventCount,error.description);
+        }
+    }];
+}
+
+// Fill in the normalized lookup keys (Company tickerKey, Event tickerKey, kind and price move attributes) for companies and events that were created before
+// these keys existed in the model e.g. in the preseeded db or by an older version of the app. Only rows that are missing the key are
+// fetched, so once this has been done it's a cheap indexed lookup that finds nothing. Same for the followed flag on Company, going by
+// the following actions, of which there are only a few, and the product event details that older versions kept in the event history.
+- (void)backfillLookupKeys
+{
+    NSManagedObjectContext *backfillContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [backfillContext setPersistentStoreCoordinator:_persistentStoreCoordinator];
+    
+    [backfillContext performBlockAndWait:^{
+        
+        NSError *error;
+        
+        // Companies missing the ticker key
+        NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+        [companyFetchRequest setEntity:[NSEntityDescription entityForName:@"Company" inManagedObjectContext:backfillContext]];
+        [companyFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"tickerKey == nil AND ticker != nil"]];
+        NSArray *companies = [backfillContext executeFetchRequest:companyFetchRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting companies to backfill lookup keys, from data store failed: %@",error.description);
+        }
+        for (Company *company in companies) {
+            company.tickerKey = [company.ticker uppercaseString];
+        }
+        
+        // Events missing the ticker key and kind, and price change events missing the price move attributes
+        NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] init];
+        [eventFetchRequest setEntity:[NSEntityDescription entityForName:@"Event" inManagedObjectContext:backfillContext]];
+        NSArray *priceMoveKinds = @[@(FAEventKindDailyMove), @(FAEventKindThirtyDayMove), @(FAEventKindYtdMove), @(FAEventKind52WeekHighLow)];
+        [eventFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"(tickerKey == nil AND listedCompany != nil) OR (kind IN %@ AND priceMoveWindow == nil)", priceMoveKinds]];
+        [eventFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"listedCompany"]];
+        NSArray *events = [backfillContext executeFetchRequest:eventFetchRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting events to backfill lookup keys, from data store failed: %@",error.description);
+        }
+        for (Event *event in events) {
+            [event updateLookupKeys];
+        }
+        
+        // Product events, synced by older versions, that have their impact and more info details packed into the event history instead of on the event
+        NSFetchRequest *productFetchRequest = [[NSFetchRequest alloc] init];
+        [productFetchRequest setEntity:[NSEntityDescription entityForName:@"Event" inManagedObjectContext:backfillContext]];
+        [productFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"kind == %d AND productImpact == nil AND relatedEventHistory.previous1Status != nil", FAEventKindProduct]];
+        [productFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"relatedEventHistory"]];
+        NSArray *productEvents = [backfillContext executeFetchRequest:productFetchRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting product events to backfill impact and more info details, from data store failed: %@",error.description);
+        }
+        for (Event *productEvent in productEvents) {
+            [productEvent updateProductDetailsFromLegacyInfo:[(EventHistory *)productEvent.relatedEventHistory previous1Status]];
+        }
+        
+        // Companies being followed, going by the following actions on their events, that are missing the followed flag
+        NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
+        [actionFetchRequest setEntity:[NSEntityDescription entityForName:@"Action" inManagedObjectContext:backfillContext]];
+        [actionFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"(type =[c] %@ OR type =[c] %@) AND parentEvent.listedCompany.isFollowed != YES", @"OSReminder", @"PriceChange"]];
+        [actionFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"parentEvent.listedCompany"]];
+        NSArray *actions = [backfillContext executeFetchRequest:actionFetchRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting following actions to backfill the followed flag, from data store failed: %@",error.description);
+        }
+        for (Action *action in actions) {
+            action.parentEvent.listedCompany.isFollowed = [NSNumber numberWithBool:YES];
+        }
+        
+        if ([backfillContext hasChanges] && ![backfillContext save:&error]) {
+            NSLog(@"ERROR: Saving backfilled lookup keys for %ld companies and %ld events to data store failed: %@",(long)companies.count,(long)events.count,error.description);
+        }
+    }];
+}
+
+#pragma mark - Bulk Deletes
+
+// Delete all objects of the entity that match the predicate with set based deletes in the store, instead of fetching each one into a context and deleting it.
+// Objects that the cascade relationships of the deleted objects point to are deleted the same way. Any unsaved changes in the calling context are saved
+// first, and the deleted object ids are merged into the writer, main queue and calling contexts afterwards. Returns NO if the delete failed.
+// NOTE: Call this on the calling context's queue e.g. inside the data controller's performBlockAndWait:
+- (BOOL)batchDeleteObjectsOfEntity:(NSString *)entityName matchingPredicate:(NSPredicate *)predicate fromContext:(NSManagedObjectContext *)callingContext
+{
+    NSManagedObjectContext *parentContext = [self writerContext];
+    if (parentContext == nil) {
+        return NO;
+    }
+    
+    // Get any pending changes on disk first, so that the delete sees them and they don't bring deleted rows back when they are written later
+    NSError *error = nil;
+    if ([callingContext hasChanges] && ![callingContext save:&error]) {
+        NSLog(@"ERROR: Saving pending changes, before bulk deleting %@ objects, to data store failed: %@",entityName,error.description);
+        return NO;
+    }
+    [parentContext performBlockAndWait:^{
+        NSError *saveError = nil;
+        if ([parentContext hasChanges] && ![parentContext save:&saveError]) {
+            NSLog(@"ERROR: Writing saved changes to disk, before bulk deleting %@ objects, failed: %@",entityName,saveError.description);
+        }
+    }];
+    
+    // Run the deletes in their own context on the store coordinator, so that none of the deleted objects are faulted into memory
+    NSManagedObjectContext *deleteContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [deleteContext setPersistentStoreCoordinator:[self persistentStoreCoordinator]];
+    NSMutableArray *deletedObjectIDs = [[NSMutableArray alloc] init];
+    __block BOOL deleted = NO;
+    [deleteContext performBlockAndWait:^{
+        NSError *deleteError = nil;
+        NSEntityDescription *entity = [NSEntityDescription entityForName:entityName inManagedObjectContext:deleteContext];
+        deleted = [self batchDeleteObjectsOfEntity:entity matchingPredicate:predicate cascadedThrough:nil inContext:deleteContext deletedObjectIDs:deletedObjectIDs error:&deleteError];
+        if (!deleted) {
+            NSLog(@"ERROR: Bulk deleting %@ objects matching %@ from data store failed: %@",entityName,predicate,deleteError.description);
+        }
+    }];
+    
+    // Even if a later step failed, the objects deleted so far are gone from the store
+    if (deletedObjectIDs.count == 0) {
+        return deleted;
+    }
+    
+    // Let the live contexts know which objects are gone, so that they are turned into deletes there and the fetched results controllers update
+    NSDictionary *deletedChanges = @{NSDeletedObjectsKey : deletedObjectIDs};
+    [parentContext performBlockAndWait:^{
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:deletedChanges intoContexts:@[parentContext]];
+    }];
+    NSManagedObjectContext *uiContext = [self mainContext];
+    if ((callingContext != nil) && (callingContext != uiContext) && (callingContext != parentContext)) {
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:deletedChanges intoContexts:@[callingContext]];
+    }
+    if ([NSThread isMainThread]) {
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:deletedChanges intoContexts:@[uiContext]];
+    } else {
+        [uiContext performBlock:^{
+            [NSManagedObjectContext mergeChangesFromRemoteContextSave:deletedChanges intoContexts:@[uiContext]];
+        }];
+    }
+    
+    // Deleted actions and companies don't go through the data controller or a save, so update what's kept off them here
+    NSEntityDescription *actionEntity = [[[self managedObjectModel] entitiesByName] objectForKey:@"Action"];
+    NSEntityDescription *companyEntity = [[[self managedObjectModel] entitiesByName] objectForKey:@"Company"];
+    BOOL actionsDeleted = NO;
+    NSMutableArray *deletedCompanyIDs = [[NSMutableArray alloc] init];
+    for (NSManagedObjectID *deletedObjectID in deletedObjectIDs) {
+        if ([deletedObjectID.entity isKindOfEntity:actionEntity]) {
+            actionsDeleted = YES;
+        } else if ([deletedObjectID.entity isKindOfEntity:companyEntity]) {
+            [deletedCompanyIDs addObject:deletedObjectID];
+        }
+    }
+    if ((deletedCompanyIDs.count > 0) && (self == sharedInstance)) {
+        [[FACompanySearchIndex sharedIndex] removeCompaniesWithObjectIDs:deletedCompanyIDs];
+    }
+    
+    // Companies that lost their last following action aren't followed anymore. Have the follow index built again from what's left in the store.
+    NSArray *unfollowedCompanyIDs = @[];
+    if (actionsDeleted) {
+        __block NSArray *updatedCompanyIDs = nil;
+        [deleteContext performBlockAndWait:^{
+            updatedCompanyIDs = [self unfollowCompaniesWithoutFollowingActionsInContext:deleteContext];
+        }];
+        unfollowedCompanyIDs = updatedCompanyIDs;
+        [[FAFollowIndex sharedIndex] reset];
+    }
+    if (unfollowedCompanyIDs.count > 0) {
+        NSDictionary *updatedChanges = @{NSUpdatedObjectsKey : unfollowedCompanyIDs};
+        [parentContext performBlockAndWait:^{
+            [NSManagedObjectContext mergeChangesFromRemoteContextSave:updatedChanges intoContexts:@[parentContext]];
+        }];
+        if ((callingContext != nil) && (callingContext != uiContext) && (callingContext != parentContext)) {
+            [NSManagedObjectContext mergeChangesFromRemoteContextSave:updatedChanges intoContexts:@[callingContext]];
+        }
+        if ([NSThread isMainThread]) {
+            [NSManagedObjectContext mergeChangesFromRemoteContextSave:updatedChanges intoContexts:@[uiContext]];
+        } else {
+            [uiContext performBlock:^{
+                [NSManagedObjectContext mergeChangesFromRemoteContextSave:updatedChanges intoContexts:@[uiContext]];
+            }];
+        }
+    }
+    
+    // Let anything holding on to results from the store e.g. the search pipeline, know that they may be stale
+    [[NSNotificationCenter defaultCenter] postNotificationName:FADataStoreDidBatchDeleteNotification object:self userInfo:@{NSDeletedObjectsKey : deletedObjectIDs, NSUpdatedObjectsKey : unfollowedCompanyIDs}];
+    
+    return deleted;
+}
+
+// Delete the objects of the entity that match the predicate, and whatever their cascade relationships point to, with batch delete requests run in the given
+// context on the store coordinator. The relationship through which the entity is being cascaded to, if any, is skipped. Ids of deleted objects are added to deletedObjectIDs.
+- (BOOL)batchDeleteObjectsOfEntity:(NSEntityDescription *)entity matchingPredicate:(NSPredicate *)predicate cascadedThrough:(NSRelationshipDescription *)parentRelationship inContext:(NSManagedObjectContext *)deleteContext deletedObjectIDs:(NSMutableArray *)deletedObjectIDs error:(NSError **)error
+{
+    // Get just the ids of the objects to delete
+    NSFetchRequest *idFetchRequest = [[NSFetchRequest alloc] init];
+    [idFetchRequest setEntity:entity];
+    [idFetchRequest setPredicate:predicate];
+    [idFetchRequest setResultType:NSManagedObjectIDResultType];
+    NSArray *objectIDs = [deleteContext executeFetchRequest:idFetchRequest error:error];
+    if (objectIDs == nil) {
+        return NO;
+    }
+    if (objectIDs.count == 0) {
+        return YES;
+    }
+    
+    // Batch deletes don't apply the delete rules, so take care of them here. Cascade relationships are deleted first, the same way. Nullify needs nothing
+    // when the other side is to many, since the link is stored on the rows being deleted, but a one to one would be left pointing at a deleted row.
+    for (NSRelationshipDescription *relationship in [[entity relationshipsByName] allValues]) {
+        
+        NSRelationshipDescription *inverseRelationship = [relationship inverseRelationship];
+        if ((parentRelationship != nil) && [inverseRelationship isEqual:parentRelationship]) {
+            continue;
+        }
+        
+        if ((relationship.deleteRule == NSCascadeDeleteRule) && (inverseRelationship != nil)) {
+            NSPredicate *cascadePredicate = [NSPredicate predicateWithFormat:@"%K IN %@", inverseRelationship.name, objectIDs];
+            if (![self batchDeleteObjectsOfEntity:relationship.destinationEntity matchingPredicate:cascadePredicate cascadedThrough:relationship inContext:deleteContext deletedObjectIDs:deletedObjectIDs error:error]) {
+                return NO;
+            }
+        } else if ((relationship.deleteRule == NSCascadeDeleteRule) || ((relationship.deleteRule == NSNullifyDeleteRule) && (inverseRelationship != nil) && ![inverseRelationship isToMany])) {
+            if (error) {
+                *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSValidationRelationshipDeniedDeleteError userInfo:@{NSLocalizedDescriptionKey : [NSString stringWithFormat:@"Can't bulk delete %@ objects as the %@ relationship can't be handled in the store",entity.name,relationship.name]}];
+            }
+            return NO;
+        }
+    }
+    
+    NSFetchRequest *deleteFetchRequest = [[NSFetchRequest alloc] init];
+    [deleteFetchRequest setEntity:entity];
+    [deleteFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"self IN %@", objectIDs]];
+    NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:deleteFetchRequest];
+    [deleteRequest setResultType:NSBatchDeleteResultTypeObjectIDs];
+    NSBatchDeleteResult *deleteResult = (NSBatchDeleteResult *)[deleteContext executeRequest:deleteRequest error:error];
+    if (deleteResult == nil) {
+        return NO;
+    }
+    [deletedObjectIDs addObjectsFromArray:deleteResult.result];
+    
+    return YES;
+}
+
+// Clear the followed flag of companies that no longer have any following actions on their events, after a bulk delete took them away, saving the context.
+// Returns the ids of the companies updated. Must be called on the context's queue.
+- (NSArray *)unfollowCompaniesWithoutFollowingActionsInContext:(NSManagedObjectContext *)deleteContext
+{
+    NSError *error = nil;
+    NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] init];
+    [companyFetchRequest setEntity:[NSEntityDescription entityForName:@"Company" inManagedObjectContext:deleteContext]];
+    [companyFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"isFollowed == YES"]];
+    NSArray *followedCompanies = [deleteContext executeFetchRequest:companyFetchRequest error:&error];
+    if (followedCompanies == nil) {
+        NSLog(@"ERROR: Getting followed companies, to update their followed flag after a bulk delete, from data store failed: %@",error.description);
+        return @[];
+    }
+    if (followedCompanies.count == 0) {
+        return @[];
+    }
+    
+    // Companies that still have following actions, going by what's left in the store
+    NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
+    [actionFetchRequest setEntity:[NSEntityDescription entityForName:@"Action" inManagedObjectContext:deleteContext]];
+    [actionFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"(type =[c] %@ OR type =[c] %@) AND parentEvent.listedCompany.isFollowed == YES", @"OSReminder", @"PriceChange"]];
+    [actionFetchRequest setRelationshipKeyPathsForPrefetching:[NSArray arrayWithObject:@"parentEvent.listedCompany"]];
+    NSArray *actions = [deleteContext executeFetchRequest:actionFetchRequest error:&error];
+    if (actions == nil) {
+        NSLog(@"ERROR: Getting following actions, to update the followed flag after a bulk delete, from data store failed: %@",error.description);
+        return @[];
+    }
+    NSMutableSet *stillFollowedCompanyIDs = [[NSMutableSet alloc] init];
+    for (Action *action in actions) {
+        [stillFollowedCompanyIDs addObject:action.parentEvent.listedCompany.objectID];
+    }
+    
+    NSMutableArray *unfollowedCompanyIDs = [[NSMutableArray alloc] init];
+    for (Company *company in followedCompanies) {
+        if (![stillFollowedCompanyIDs containsObject:company.objectID]) {
+            company.isFollowed = [NSNumber numberWithBool:NO];
+            [unfollowedCompanyIDs addObject:company.objectID];
+        }
+    }
+    if ([deleteContext hasChanges] && ![deleteContext save:&error]) {
+        NSLog(@"ERROR: Saving the followed flag of %ld companies, that lost their following actions in a bulk delete, to data store failed: %@",(long)unfollowedCompanyIDs.count,error.description);
+        return @[];
+    }
+    
+    return unfollowedCompanyIDs;
+}
+
+#pragma mark - Context Stack
+
+// Private queue context, on the persistent store coordinator, that all other contexts save into. Changes pushed into it are written to disk in the background.
+- (NSManagedObjectContext *)writerContext
+{
+    // Set up on first use from whichever thread gets here first
+    @synchronized(self) {
+        if (_writerContext == nil) {
+            NSPersistentStoreCoordinator *storeCoordinator = [self persistentStoreCoordinator];
+            if (storeCoordinator != nil) {
+                _writerContext = [[FATracedManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+                [_writerContext setPersistentStoreCoordinator:storeCoordinator];
+                // The in memory changes from the children win over what's on disk
+                [_writerContext setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+            }
+        }
+    }
+    
+    return _writerContext;
+}
+
+// Main queue context, child of the writer context, that is shared by everything on the main thread, including the fetched results controllers driving the UI.
+// Saves from background contexts are merged into it, so fetched results controllers on it update incrementally.
+- (NSManagedObjectContext *)mainContext
+{
+    @synchronized(self) {
+        if (_mainContext == nil) {
+            NSManagedObjectContext *parentContext = [self writerContext];
+            if (parentContext != nil) {
+                _mainContext = [[FATracedManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+                [_mainContext setParentContext:parentContext];
+                [_mainContext setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+            }
+        }
+    }
+    
+    return _mainContext;
+}
+
+// Create a new private queue context, child of the writer context, for use off the main thread. Saving it pushes the changes into the writer context,
+// which writes them to disk, and merges them into the main queue context.
+// NOTE: Work with it, and the objects fetched into it, inside performBlockAndWait: e.g. through the data controller's performBlockAndWait:
+- (NSManagedObjectContext *)newBackgroundContext
+{
+    NSManagedObjectContext *parentContext = [self writerContext];
+    if (parentContext == nil) {
+        return nil;
+    }
+    
+    NSManagedObjectContext *backgroundContext = [[FATracedManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [backgroundContext setParentContext:parentContext];
+    [backgroundContext setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+    
+    return backgroundContext;
+}
+
+// Before a child of the writer context saves, get permanent ids for the objects it inserted, so that they can be matched up when merged into other contexts.
+- (void)childContextWillSave:(NSNotification *)notification
+{
+    NSManagedObjectContext *savingContext = [notification object];
+    if ((_writerContext == nil) || (savingContext.parentContext != _writerContext)) {
+        return;
+    }
+    
+    NSArray *insertedObjects = [[savingContext insertedObjects] allObjects];
+    if (insertedObjects.count > 0) {
+        NSError *error = nil;
+        if (![savingContext obtainPermanentIDsForObjects:insertedObjects error:&error]) {
+            NSLog(@"ERROR: Getting permanent ids for %ld inserted objects, before saving to the writer context, failed: %@",(long)insertedObjects.count,error.description);
+        }
+    }
+}
+
+// After a child of the writer context saves, merge background saves into the main queue context, update the company search index and write the changes to disk.
+- (void)childContextDidSave:(NSNotification *)notification
+{
+    NSManagedObjectContext *savingContext = [notification object];
+    if ((_writerContext == nil) || (savingContext.parentContext != _writerContext)) {
+        return;
+    }
+    
+    // The main queue context already has it's own changes
+    if (savingContext != _mainContext) {
+        NSManagedObjectContext *uiContext = [self mainContext];
+        [uiContext performBlock:^{
+            [uiContext mergeChangesFromContextDidSaveNotification:notification];
+        }];
+    }
+    
+    // Keep the company search index in step with companies being added or removed. It's only of the application's store.
+    if (self == sharedInstance) {
+        [[FACompanySearchIndex sharedIndex] updateWithContextDidSaveNotification:notification];
+    }
+    
+    [self saveWriterContext];
+}
+
+// Write any changes pushed into the writer context to disk, in the background.
+- (void)saveWriterContext
+{
+    NSManagedObjectContext *parentContext = [self writerContext];
+    [parentContext performBlock:^{
+        NSError *error = nil;
+        if ([parentContext hasChanges] && ![parentContext save:&error]) {
+            NSLog(@"ERROR: Writing saved changes from the writer context to disk failed: %@",error.description);
+        }
+    }];
+}
+
+// Write any unsaved changes in the main queue context and any saved changes still waiting in the writer context to disk, waiting till
+// they are written. Call on the main thread before the app is suspended or terminated.
+- (void)flushToDisk
+{
+    // Nothing to write if the data store hasn't been used yet
+    if (_writerContext == nil) {
+        return;
+    }
+    
+    NSManagedObjectContext *uiContext = _mainContext;
+    [uiContext performBlockAndWait:^{
+        NSError *error = nil;
+        if ([uiContext hasChanges] && ![uiContext save:&error]) {
+            NSLog(@"ERROR: Saving the main queue context before writing to disk failed: %@",error.description);
+        }
+    }];
+    
+    NSManagedObjectContext *parentContext = _writerContext;
+    [parentContext performBlockAndWait:^{
+        NSError *error = nil;
+        if ([parentContext hasChanges] && ![parentContext save:&error]) {
+            NSLog(@"ERROR: Writing saved changes from the writer context to disk failed: %@",error.description);
+        }
+    }];
+}
+
+// Get the value stored under the key in the persistent store's metadata, which lives and dies with the store e.g. the version of the last one time
+// data migration run on it. nil if there's none.
+- (id)metadataValueForKey:(NSString *)key
+{
+    NSManagedObjectContext *parentContext = [self writerContext];
+    __block id value = nil;
+    [parentContext performBlockAndWait:^{
+        NSPersistentStoreCoordinator *storeCoordinator = parentContext.persistentStoreCoordinator;
+        NSPersistentStore *store = storeCoordinator.persistentStores.firstObject;
+        if (store != nil) {
+            value = [[storeCoordinator metadataForPersistentStore:store] objectForKey:key];
+        }
+    }];
+    
+    return value;
+}
+
+// Store the value under the key in the persistent store's metadata. It's written to disk with the next save of the writer context.
+- (void)setMetadataValue:(id)value forKey:(NSString *)key
+{
+    NSManagedObjectContext *parentContext = [self writerContext];
+    [parentContext performBlockAndWait:^{
+        NSPersistentStoreCoordinator *storeCoordinator = parentContext.persistentStoreCoordinator;
+        NSPersistentStore *store = storeCoordinator.persistentStores.firstObject;
+        if (store == nil) {
+            NSLog(@"ERROR: Could not store %@ in the data store metadata as there's no data store",key);
+            return;
+        }
+        NSMutableDictionary *metadata = [[storeCoordinator metadataForPersistentStore:store] mutableCopy];
+        [metadata setValue:value forKey:key];
+        [storeCoordinator setMetadata:metadata forPersistentStore:store];
+    }];
 }
 
 // Returns the URL to the application's Documents directory.
@@ -0,0 +1,61 @@
+//
+//  FADateCache.h
+//  FinApp
+//
+//  Class that hands out configured Gregorian calendars and date formatters, kept per
+//  thread so that they are created once and never shared across threads. Also has fast
+//  paths that parse the yyyyMMdd and yyyy-MM-dd dates used by the data sources straight
+//  into day numbers e.g. 20160331 and dates, without going through a formatter.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@interface FADateCache : NSObject
+
+// Get the Gregorian calendar, in the local time zone, for the current thread. Don't change it's settings as it's shared by all callers on the thread.
++ (NSCalendar *)gregorianCalendar;
+
+// Get the Gregorian calendar, in GMT, for the current thread. Don't change it's settings as it's shared by all callers on the thread.
++ (NSCalendar *)gmtGregorianCalendar;
+
+// Get the date formatter for the format e.g. yyyyMMdd, in the local time zone, for the current thread. Don't change it's settings as it's shared by all callers on the thread.
++ (NSDateFormatter *)formatterWithFormat:(NSString *)dateFormat;
+
+// Get the date formatter for the format e.g. EEE, in GMT, for the current thread. Don't change it's settings as it's shared by all callers on the thread.
++ (NSDateFormatter *)gmtFormatterWithFormat:(NSString *)dateFormat;
+
+// Get the day number e.g. 20160331 for a "yyyyMMdd" or "yyyy-MM-dd" string e.g. 20160331 or 2016-03-31. Anything after the date e.g. a time is ignored.
+// Returns 0 if the string doesn't start with a valid date in one of these formats.
++ (int32_t)dayNumberForDateString:(NSString *)dateString;
+
+// Get the date at midnight, in the local time zone, for a day number e.g. 20160331. Same as parsing it with a yyyyMMdd formatter. Returns nil if it's not a valid date.
++ (NSDate *)dateForDayNumber:(int32_t)dayNumber;
+
+// Get the date at midnight GMT for a day number e.g. 20160331. Returns nil if it's not a valid date.
++ (NSDate *)gmtDateForDayNumber:(int32_t)dayNumber;
+
+// Get the day number e.g. 20160331 for a date, in GMT.
++ (int32_t)gmtDayNumberForDate:(NSDate *)date;
+
+// Get the number of days from 1970-01-01, referred to as the epoch day, for a day number e.g. 20160331. The day number must be a valid date.
++ (int32_t)epochDayForDayNumber:(int32_t)dayNumber;
+
+// Get the day number e.g. 20160331 for an epoch day, a number of days from 1970-01-01.
++ (int32_t)dayNumberForEpochDay:(int32_t)epochDay;
+
+// Get the epoch day that the date falls on, in the local time zone.
++ (int32_t)localEpochDayForDate:(NSDate *)date;
+
+// Get the epoch day that the date falls on, in GMT.
++ (int32_t)gmtEpochDayForDate:(NSDate *)date;
+
+// Get the date at midnight, in the local time zone, for an epoch day.
++ (NSDate *)dateForEpochDay:(int32_t)epochDay;
+
+// Add a number of days to a date, keeping the same time of day in the local time zone. Same as adding a day component with a Gregorian calendar.
++ (NSDate *)dateByAddingDays:(int32_t)days toDate:(NSDate *)date;
+
+@end
@@ -0,0 +1,306 @@
+//
+//  FADateCache.m
+//  FinApp
+//
+//  Class that hands out configured Gregorian calendars and date formatters, kept per
+//  thread so that they are created once and never shared across threads. Also has fast
+//  paths that parse the yyyyMMdd and yyyy-MM-dd dates used by the data sources straight
+//  into day numbers e.g. 20160331 and dates, without going through a formatter.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FADateCache.h"
+#import <stdatomic.h>
+
+// Key for the calendars and formatters in each thread's dictionary
+static NSString * const FADateCacheThreadKey = @"FADateCache";
+
+// Key, in a thread's cache, for the generation the cache was created in
+static NSString * const FADateCacheGenerationKey = @"Generation";
+
+// Incremented when the time zone or locale changes. Each thread's cache is thrown away, the next time it's used, if it was created in an earlier generation.
+static atomic_uint FADateCacheGeneration;
+
+// Number of days from 1970-01-01 to the given Gregorian year, month and day.
+static int32_t FADaysFromCivil(int32_t year, int32_t month, int32_t day)
+{
+    year -= (month <= 2) ? 1 : 0;
+    int32_t era = ((year >= 0) ? year : (year - 399)) / 400;
+    int32_t yearOfEra = year - (era * 400);
+    int32_t dayOfYear = (((153 * (month + ((month > 2) ? -3 : 9))) + 2) / 5) + day - 1;
+    int32_t dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+    return (era * 146097) + dayOfEra - 719468;
+}
+
+// Gregorian year, month and day, as a day number e.g. 20160331, for the given number of days from 1970-01-01.
+static int32_t FADayNumberFromDays(int32_t days)
+{
+    days += 719468;
+    int32_t era = ((days >= 0) ? days : (days - 146096)) / 146097;
+    int32_t dayOfEra = days - (era * 146097);
+    int32_t yearOfEra = (dayOfEra - (dayOfEra / 1460) + (dayOfEra / 36524) - (dayOfEra / 146096)) / 365;
+    int32_t dayOfYear = dayOfEra - ((365 * yearOfEra) + (yearOfEra / 4) - (yearOfEra / 100));
+    int32_t shiftedMonth = ((5 * dayOfYear) + 2) / 153;
+    int32_t day = dayOfYear - (((153 * shiftedMonth) + 2) / 5) + 1;
+    int32_t month = (shiftedMonth < 10) ? (shiftedMonth + 3) : (shiftedMonth - 9);
+    int32_t year = yearOfEra + (era * 400) + ((month <= 2) ? 1 : 0);
+    return (year * 10000) + (month * 100) + day;
+}
+
+// Check that the day number e.g. 20160331 is a real date. Returns the number of days from 1970-01-01 for it in days.
+static BOOL FADaysForDayNumber(int32_t dayNumber, int32_t *days)
+{
+    int32_t year = dayNumber / 10000;
+    int32_t month = (dayNumber / 100) % 100;
+    int32_t day = dayNumber % 100;
+    if ((year < 1)||(month < 1)||(month > 12)||(day < 1)) {
+        return NO;
+    }
+    static const int32_t daysInMonth[12] = {31,29,31,30,31,30,31,31,30,31,30,31};
+    BOOL leapYear = (((year % 4) == 0) && ((year % 100) != 0)) || ((year % 400) == 0);
+    if ((day > daysInMonth[month - 1]) || ((month == 2) && !leapYear && (day > 28))) {
+        return NO;
+    }
+    *days = FADaysFromCivil(year, month, day);
+    return YES;
+}
+
+@interface FADateCache ()
+
+// Get the current thread's cache of calendars and formatters, starting a new one if the time zone or locale has changed since it was created.
++ (NSMutableDictionary *)threadCache;
+
+@end
+
+@implementation FADateCache
+
+// Throw away the calendars and formatters on all threads when the time zone or locale changes, since they were configured for the old ones.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    if(!exists)
+    {
+        exists = YES;
+        void (^invalidateCaches)(NSNotification *) = ^(NSNotification *notification) {
+            atomic_fetch_add(&FADateCacheGeneration, 1);
+        };
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSSystemTimeZoneDidChangeNotification object:nil queue:nil usingBlock:invalidateCaches];
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSCurrentLocaleDidChangeNotification object:nil queue:nil usingBlock:invalidateCaches];
+    }
+}
+
+#pragma mark - Calendars and Formatters
+
+// Get the Gregorian calendar, in the local time zone, for the current thread.
++ (NSCalendar *)gregorianCalendar
+{
+    NSMutableDictionary *threadCache = [self threadCache];
+    NSCalendar *calendar = [threadCache objectForKey:@"Calendar"];
+
+    if (calendar == nil) {
+        calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+        [threadCache setObject:calendar forKey:@"Calendar"];
+    }
+
+    return calendar;
+}
+
+// Get the Gregorian calendar, in GMT, for the current thread.
++ (NSCalendar *)gmtGregorianCalendar
+{
+    NSMutableDictionary *threadCache = [self threadCache];
+    NSCalendar *calendar = [threadCache objectForKey:@"GMTCalendar"];
+
+    if (calendar == nil) {
+        calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+        [calendar setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
+        [threadCache setObject:calendar forKey:@"GMTCalendar"];
+    }
+
+    return calendar;
+}
+
+// Get the date formatter for the format, in the local time zone, for the current thread.
++ (NSDateFormatter *)formatterWithFormat:(NSString *)dateFormat
+{
+    NSMutableDictionary *threadCache = [self threadCache];
+    NSString *formatterKey = [NSString stringWithFormat:@"Formatter %@",dateFormat];
+    NSDateFormatter *formatter = [threadCache objectForKey:formatterKey];
+
+    if (formatter == nil) {
+        formatter = [[NSDateFormatter alloc] init];
+        [formatter setDateFormat:dateFormat];
+        [threadCache setObject:formatter forKey:formatterKey];
+    }
+
+    return formatter;
+}
+
+// Get the date formatter for the format, in GMT, for the current thread.
++ (NSDateFormatter *)gmtFormatterWithFormat:(NSString *)dateFormat
+{
+    NSMutableDictionary *threadCache = [self threadCache];
+    NSString *formatterKey = [NSString stringWithFormat:@"GMTFormatter %@",dateFormat];
+    NSDateFormatter *formatter = [threadCache objectForKey:formatterKey];
+
+    if (formatter == nil) {
+        formatter = [[NSDateFormatter alloc] init];
+        [formatter setDateFormat:dateFormat];
+        [formatter setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
+        [threadCache setObject:formatter forKey:formatterKey];
+    }
+
+    return formatter;
+}
+
+// Get the current thread's cache of calendars and formatters, starting a new one if the time zone or locale has changed since it was created.
++ (NSMutableDictionary *)threadCache
+{
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary *threadCache = [threadDictionary objectForKey:FADateCacheThreadKey];
+    unsigned int generation = atomic_load(&FADateCacheGeneration);
+
+    if ((threadCache == nil)||([[threadCache objectForKey:FADateCacheGenerationKey] unsignedIntValue] != generation)) {
+        threadCache = [NSMutableDictionary dictionary];
+        [threadCache setObject:[NSNumber numberWithUnsignedInt:generation] forKey:FADateCacheGenerationKey];
+        [threadDictionary setObject:threadCache forKey:FADateCacheThreadKey];
+    }
+
+    return threadCache;
+}
+
+#pragma mark - Day Numbers
+
+// Get the day number e.g. 20160331 for a "yyyyMMdd" or "yyyy-MM-dd" string. Returns 0 if the string doesn't start with a valid date in one of these formats.
++ (int32_t)dayNumberForDateString:(NSString *)dateString
+{
+    if (![dateString isKindOfClass:[NSString class]]) {
+        return 0;
+    }
+
+    // Copy out just the characters needed, on the stack
+    NSUInteger length = dateString.length;
+    unichar characters[11];
+    NSUInteger charactersToCopy = MIN(length, (NSUInteger)11);
+    [dateString getCharacters:characters range:NSMakeRange(0, charactersToCopy)];
+
+    // Work out the format from where the first separator is, if any
+    BOOL separated = (charactersToCopy >= 5) && (characters[4] == '-');
+    NSUInteger dateLength = separated ? 10 : 8;
+    if (charactersToCopy < dateLength) {
+        return 0;
+    }
+    if ((charactersToCopy > dateLength) && (characters[dateLength] >= '0') && (characters[dateLength] <= '9')) {
+        return 0;
+    }
+
+    int32_t dayNumber = 0;
+    for (NSUInteger i = 0; i < dateLength; i++) {
+        unichar character = characters[i];
+        if (separated && ((i == 4)||(i == 7))) {
+            if (character != '-') {
+                return 0;
+            }
+            continue;
+        }
+        if ((character < '0')||(character > '9')) {
+            return 0;
+        }
+        dayNumber = (dayNumber * 10) + (character - '0');
+    }
+
+    int32_t days = 0;
+    if (!FADaysForDayNumber(dayNumber, &days)) {
+        return 0;
+    }
+
+    return dayNumber;
+}
+
+// Get the date at midnight, in the local time zone, for a day number e.g. 20160331. Same as parsing it with a yyyyMMdd formatter.
++ (NSDate *)dateForDayNumber:(int32_t)dayNumber
+{
+    int32_t days = 0;
+    if (!FADaysForDayNumber(dayNumber, &days)) {
+        return nil;
+    }
+
+    return [self dateForEpochDay:days];
+}
+
+// Get the date at midnight GMT for a day number e.g. 20160331.
++ (NSDate *)gmtDateForDayNumber:(int32_t)dayNumber
+{
+    int32_t days = 0;
+    if (!FADaysForDayNumber(dayNumber, &days)) {
+        return nil;
+    }
+
+    return [NSDate dateWithTimeIntervalSince1970:((NSTimeInterval)days * 86400.0)];
+}
+
+// Get the day number e.g. 20160331 for a date, in GMT.
++ (int32_t)gmtDayNumberForDate:(NSDate *)date
+{
+    return FADayNumberFromDays([self gmtEpochDayForDate:date]);
+}
+
+#pragma mark - Epoch Days
+
+// Get the number of days from 1970-01-01 for a day number e.g. 20160331.
++ (int32_t)epochDayForDayNumber:(int32_t)dayNumber
+{
+    return FADaysFromCivil(dayNumber / 10000, (dayNumber / 100) % 100, dayNumber % 100);
+}
+
+// Get the day number e.g. 20160331 for a number of days from 1970-01-01.
++ (int32_t)dayNumberForEpochDay:(int32_t)epochDay
+{
+    return FADayNumberFromDays(epochDay);
+}
+
+// Get the number of days from 1970-01-01 to the day the date falls on, in the local time zone.
++ (int32_t)localEpochDayForDate:(NSDate *)date
+{
+    NSTimeInterval localInterval = [date timeIntervalSince1970] + [[NSTimeZone defaultTimeZone] secondsFromGMTForDate:date];
+
+    return (int32_t)floor(localInterval / 86400.0);
+}
+
+// Get the number of days from 1970-01-01 to the day the date falls on, in GMT.
++ (int32_t)gmtEpochDayForDate:(NSDate *)date
+{
+    return (int32_t)floor([date timeIntervalSince1970] / 86400.0);
+}
+
+// Get the date at midnight, in the local time zone, for a number of days from 1970-01-01.
++ (NSDate *)dateForEpochDay:(int32_t)epochDay
+{
+    // Move midnight GMT to midnight in the local time zone, using the offset in effect at local midnight, in case it's a daylight saving change day
+    NSTimeInterval gmtMidnight = (NSTimeInterval)epochDay * 86400.0;
+    NSTimeZone *localTimeZone = [NSTimeZone defaultTimeZone];
+    NSInteger offset = [localTimeZone secondsFromGMTForDate:[NSDate dateWithTimeIntervalSince1970:gmtMidnight]];
+    offset = [localTimeZone secondsFromGMTForDate:[NSDate dateWithTimeIntervalSince1970:(gmtMidnight - offset)]];
+
+    return [NSDate dateWithTimeIntervalSince1970:(gmtMidnight - offset)];
+}
+
+// Add a number of days to a date, keeping the same time of day in the local time zone. Same as adding a day component with a Gregorian calendar.
++ (NSDate *)dateByAddingDays:(int32_t)days toDate:(NSDate *)date
+{
+    if (days == 0) {
+        return date;
+    }
+
+    // Move by whole days, then make up for any change in the offset from GMT e.g. across a daylight saving change
+    NSTimeZone *localTimeZone = [NSTimeZone defaultTimeZone];
+    NSDate *movedDate = [date dateByAddingTimeInterval:((NSTimeInterval)days * 86400.0)];
+    NSInteger offsetChange = [localTimeZone secondsFromGMTForDate:date] - [localTimeZone secondsFromGMTForDate:movedDate];
+
+    return (offsetChange == 0) ? movedDate : [movedDate dateByAddingTimeInterval:offsetChange];
+}
+
+@end
@@ -0,0 +1,35 @@
+//
+//  FAEntityProfileStore.h
+//  FinApp
+//
+//  Single Instance class that looks up mostly static profile information for entities
+//  (stocks, fed) e.g. the investor site for a ticker. Profiles come from the bundled
+//  EntityProfiles.tsv file, which is memory mapped and indexed by ticker the first time
+//  a profile is asked for, so it costs nothing at launch however many entities it covers.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Position of each field in a profile
+typedef NS_ENUM(NSUInteger, FAEntityProfileField) {
+    // 1. Investor Site(for stock)/Agency home page
+    FAEntityProfileInvestorSiteField = 0,
+    // 2. Best Earnings/Econ event outcome link (typically on the site from 1)
+    FAEntityProfileOutcomeLinkField = 1,
+    // Number of fields in a profile
+    FAEntityProfileFieldCount = 2
+};
+
+@interface FAEntityProfileStore : NSObject
+
+// Create and/or return the single shared profile store
++ (FAEntityProfileStore *)sharedStore;
+
+// Get the profile for a ticker, in any case, as an array of FAEntityProfileFieldCount strings in FAEntityProfileField order. Fields that aren't
+// known are "Not Available". Profiles are immutable and shared, so the same array is returned every time. Returns nil if there's no profile for the ticker.
+- (NSArray *)profileForTicker:(NSString *)ticker;
+
+@end
@@ -0,0 +1,256 @@
+//
+//  FAEntityProfileStore.m
+//  FinApp
+//
+//  Single Instance class that looks up mostly static profile information for entities
+//  (stocks, fed) e.g. the investor site for a ticker. Profiles come from the bundled
+//  EntityProfiles.tsv file, which is memory mapped and indexed by ticker the first time
+//  a profile is asked for, so it costs nothing at launch however many entities it covers.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAEntityProfileStore.h"
+
+// Longest ticker, in bytes, that can be looked up. Longer ones in the profiles file are skipped.
+static const NSUInteger FAEntityProfileMaxTickerLength = 31;
+
+@interface FAEntityProfileStore ()
+
+// Contents of the profiles file, memory mapped so only the pages that are looked at are read in
+@property (strong, nonatomic) NSData *profilesData;
+
+// Hash table, with open addressing, of uint32_t slots. Each slot holds 1 + the offset in the profiles file of the line for a ticker or 0 if it's empty.
+@property (strong, nonatomic) NSMutableData *tickerSlots;
+
+// Profiles that have been asked for, as immutable arrays, keyed by slot number so that each is only created once
+@property (strong, nonatomic) NSMutableDictionary *loadedProfiles;
+
+// Has the profiles file been mapped and indexed
+@property (assign, nonatomic) BOOL profilesIndexed;
+
+// Map the bundled profiles file and index it by ticker. Must be called with the store locked.
+- (void)indexProfiles;
+
+// Get the slot for a ticker, given as uppercase bytes, or the empty slot it would go in if it's not in the table.
+- (NSUInteger)slotForTickerBytes:(const char *)tickerBytes length:(NSUInteger)tickerLength;
+
+// Get the profile, as an immutable array of fields, for the line starting at the given offset in the profiles file.
+- (NSArray *)profileForLineAtOffset:(NSUInteger)lineOffset;
+
+@end
+
+@implementation FAEntityProfileStore
+
+static FAEntityProfileStore *sharedInstance;
+
+// Implement this class as a Singleton to create a single profile store accessible
+// from anywhere in the app.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a profile store doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FAEntityProfileStore alloc] init];
+    }
+}
+
+// Create and/or return the single shared profile store
++ (FAEntityProfileStore *)sharedStore {
+
+    return sharedInstance;
+}
+
+#pragma mark - Looking Up Profiles
+
+// Get the profile for a ticker, in any case. Returns nil if there's no profile for the ticker.
+- (NSArray *)profileForTicker:(NSString *)ticker
+{
+    // Get the ticker as uppercase bytes, without creating a new string
+    char tickerBytes[FAEntityProfileMaxTickerLength + 1];
+    if (![ticker getCString:tickerBytes maxLength:sizeof(tickerBytes) encoding:NSUTF8StringEncoding]) {
+        return nil;
+    }
+    NSUInteger tickerLength = strlen(tickerBytes);
+    if (tickerLength == 0) {
+        return nil;
+    }
+    for (NSUInteger i = 0; i < tickerLength; i++) {
+        if ((tickerBytes[i] >= 'a') && (tickerBytes[i] <= 'z')) {
+            tickerBytes[i] = tickerBytes[i] - 'a' + 'A';
+        }
+    }
+
+    @synchronized(self) {
+
+        if (!self.profilesIndexed) {
+            [self indexProfiles];
+        }
+        if (self.tickerSlots.length == 0) {
+            return nil;
+        }
+
+        NSUInteger slot = [self slotForTickerBytes:tickerBytes length:tickerLength];
+        uint32_t lineOffset = ((const uint32_t *)self.tickerSlots.bytes)[slot];
+        if (lineOffset == 0) {
+            return nil;
+        }
+
+        NSArray *profile = [self.loadedProfiles objectForKey:@(slot)];
+        if (profile == nil) {
+            profile = [self profileForLineAtOffset:(lineOffset - 1)];
+            [self.loadedProfiles setObject:profile forKey:@(slot)];
+        }
+
+        return profile;
+    }
+}
+
+#pragma mark - Profiles File
+
+// Map the bundled profiles file and index it by ticker. Lines are "Ticker<tab>Field 1<tab>Field 2...". Blank lines and lines starting with # are skipped.
+// If a ticker is listed more than once, the first line for it is used.
+- (void)indexProfiles
+{
+    self.profilesIndexed = YES;
+    self.loadedProfiles = [[NSMutableDictionary alloc] init];
+    self.tickerSlots = [[NSMutableData alloc] init];
+
+    NSError *error = nil;
+    NSString *profilesFilePath = [[NSBundle mainBundle] pathForResource:@"EntityProfiles" ofType:@"tsv"];
+    self.profilesData = profilesFilePath ? [NSData dataWithContentsOfFile:profilesFilePath options:NSDataReadingMappedIfSafe error:&error] : nil;
+    if (self.profilesData == nil) {
+        NSLog(@"ERROR: Mapping the entity profiles file from the bundle failed: %@",error.description);
+        return;
+    }
+
+    const char *fileBytes = self.profilesData.bytes;
+    NSUInteger fileLength = self.profilesData.length;
+    if (fileLength >= UINT32_MAX) {
+        NSLog(@"ERROR: Entity profiles file is too big to index: %lu bytes",(unsigned long)fileLength);
+        return;
+    }
+
+    // Size the table at a power of two at least twice the number of lines, so it stays at most half full and probes stay short
+    NSUInteger noOfLines = 1;
+    for (NSUInteger i = 0; i < fileLength; i++) {
+        if (fileBytes[i] == '\n') {
+            noOfLines++;
+        }
+    }
+    NSUInteger noOfSlots = 16;
+    while (noOfSlots < (noOfLines * 2)) {
+        noOfSlots = noOfSlots * 2;
+    }
+    [self.tickerSlots setLength:(noOfSlots * sizeof(uint32_t))];
+    uint32_t *slots = self.tickerSlots.mutableBytes;
+
+    NSUInteger lineStart = 0;
+    while (lineStart < fileLength) {
+
+        NSUInteger lineEnd = lineStart;
+        while ((lineEnd < fileLength) && (fileBytes[lineEnd] != '\n')) {
+            lineEnd++;
+        }
+
+        if ((lineEnd > lineStart) && (fileBytes[lineStart] != '#') && (fileBytes[lineStart] != '\r')) {
+
+            // Get the ticker, uppercased, from the start of the line up to the first tab
+            char tickerBytes[FAEntityProfileMaxTickerLength + 1];
+            NSUInteger tickerLength = 0;
+            while ((lineStart + tickerLength < lineEnd) && (fileBytes[lineStart + tickerLength] != '\t') && (fileBytes[lineStart + tickerLength] != '\r')) {
+                if (tickerLength < FAEntityProfileMaxTickerLength) {
+                    char tickerByte = fileBytes[lineStart + tickerLength];
+                    tickerBytes[tickerLength] = ((tickerByte >= 'a') && (tickerByte <= 'z')) ? (tickerByte - 'a' + 'A') : tickerByte;
+                }
+                tickerLength++;
+            }
+
+            if (tickerLength > FAEntityProfileMaxTickerLength) {
+                NSLog(@"ERROR: Ticker in the entity profiles file at byte %lu is too long to look up",(unsigned long)lineStart);
+            } else {
+                NSUInteger slot = [self slotForTickerBytes:tickerBytes length:tickerLength];
+                if (slots[slot] == 0) {
+                    slots[slot] = (uint32_t)(lineStart + 1);
+                }
+            }
+        }
+
+        lineStart = lineEnd + 1;
+    }
+}
+
+// Get the slot for a ticker, given as uppercase bytes, or the empty slot it would go in if it's not in the table. Uses an FNV-1a hash and linear probing.
+- (NSUInteger)slotForTickerBytes:(const char *)tickerBytes length:(NSUInteger)tickerLength
+{
+    const char *fileBytes = self.profilesData.bytes;
+    NSUInteger fileLength = self.profilesData.length;
+    const uint32_t *slots = self.tickerSlots.bytes;
+    NSUInteger slotMask = (self.tickerSlots.length / sizeof(uint32_t)) - 1;
+
+    uint32_t hash = 2166136261u;
+    for (NSUInteger i = 0; i < tickerLength; i++) {
+        hash = (hash ^ (uint8_t)tickerBytes[i]) * 16777619u;
+    }
+
+    NSUInteger slot = hash & slotMask;
+    while (slots[slot] != 0) {
+
+        // Compare, ignoring case, with the ticker on the line in this slot
+        NSUInteger lineStart = slots[slot] - 1;
+        BOOL sameTicker = YES;
+        for (NSUInteger i = 0; i <= tickerLength; i++) {
+            char lineByte = (lineStart + i < fileLength) ? fileBytes[lineStart + i] : '\n';
+            if (i == tickerLength) {
+                sameTicker = ((lineByte == '\t')||(lineByte == '\n')||(lineByte == '\r'));
+                break;
+            }
+            if ((lineByte >= 'a') && (lineByte <= 'z')) {
+                lineByte = lineByte - 'a' + 'A';
+            }
+            if (lineByte != tickerBytes[i]) {
+                sameTicker = NO;
+                break;
+            }
+        }
+        if (sameTicker) {
+            break;
+        }
+
+        slot = (slot + 1) & slotMask;
+    }
+
+    return slot;
+}
+
+// Get the profile, as an immutable array of fields, for the line starting at the given offset in the profiles file. Missing or empty fields are "Not Available".
+- (NSArray *)profileForLineAtOffset:(NSUInteger)lineOffset
+{
+    const char *fileBytes = self.profilesData.bytes;
+    NSUInteger fileLength = self.profilesData.length;
+
+    NSUInteger lineEnd = lineOffset;
+    while ((lineEnd < fileLength) && (fileBytes[lineEnd] != '\n') && (fileBytes[lineEnd] != '\r')) {
+        lineEnd++;
+    }
+    NSString *line = [[NSString alloc] initWithBytes:(fileBytes + lineOffset) length:(lineEnd - lineOffset) encoding:NSUTF8StringEncoding];
+    NSArray *lineFields = [line componentsSeparatedByString:@"\t"];
+
+    // The first field on the line is the ticker
+    NSMutableArray *profile = [NSMutableArray arrayWithCapacity:FAEntityProfileFieldCount];
+    for (NSUInteger field = 0; field < FAEntityProfileFieldCount; field++) {
+        NSString *fieldValue = (field + 1 < lineFields.count) ? lineFields[field + 1] : @"";
+        if (fieldValue.length == 0) {
+            fieldValue = @"Not Available";
+        }
+        [profile addObject:fieldValue];
+    }
+
+    return [profile copy];
+}
+
+@end
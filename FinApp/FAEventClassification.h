@@ -0,0 +1,84 @@
+//
+//  FAEventClassification.h
+//  FinApp
+//
+//  Class that parses the free text type of an event, once, into a canonical kind
+//  and the parameters encoded in it (percent, price, direction and window of a price move).
+//  Parsed results are cached by type string so repeated lookups, like the ones made
+//  when rendering cells, don't redo the substring matching.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Canonical kinds of events. This is stored on the event so that fetches can match on an indexed key instead of substrings of the free text type.
+typedef NS_ENUM(int16_t, FAEventKind) {
+    FAEventKindUnknown = 0,
+    // "Quarterly Earnings"
+    FAEventKindEarnings = 1,
+    // Economic events, listed under an ECONOMY_ ticker e.g. "Jan US Fed Meeting"
+    FAEventKindEcon = 2,
+    // Product events e.g. "iPhone 7 Launch", "WWDC 2016 Conference"
+    FAEventKindProduct = 3,
+    // "+5.12% up today $30.12"
+    FAEventKindDailyMove = 4,
+    // "10.12% down 30 days"
+    FAEventKindThirtyDayMove = 5,
+    // "30.12% up ytd"
+    FAEventKindYtdMove = 6,
+    // "52 Week High $120.00", "52 Week Low $80.00"
+    FAEventKind52WeekHighLow = 7
+};
+
+// Direction of a price change event. "% up" and "52 Week High" are up, "% down" and "52 Week Low" are down.
+typedef NS_ENUM(NSInteger, FAPriceMoveDirection) {
+    FAPriceMoveDirectionNone = 0,
+    FAPriceMoveDirectionUp = 1,
+    FAPriceMoveDirectionDown = 2
+};
+
+// Window over which the price change of a price change event is measured.
+typedef NS_ENUM(NSInteger, FAPriceMoveWindow) {
+    FAPriceMoveWindowNone = 0,
+    // "today"
+    FAPriceMoveWindowDay = 1,
+    // "30 days"
+    FAPriceMoveWindowThirtyDays = 2,
+    // "ytd"
+    FAPriceMoveWindowYearToDate = 3,
+    // "52 Week"
+    FAPriceMoveWindowFiftyTwoWeeks = 4
+};
+
+@interface FAEventClassification : NSObject
+
+// Canonical kind of the event
+@property (nonatomic, readonly) FAEventKind kind;
+
+// For price change events, the direction of the move. FAPriceMoveDirectionNone for all other events.
+@property (nonatomic, readonly) FAPriceMoveDirection direction;
+
+// For price change events, the window over which the move is measured. FAPriceMoveWindowNone for all other events.
+@property (nonatomic, readonly) FAPriceMoveWindow window;
+
+// For % up and % down events, the absolute percent change e.g. 5.12 for "-5.12% down today $30.12". NAN for all other events.
+@property (nonatomic, readonly) double percent;
+
+// For price change events that carry a price, the price in dollars e.g. 30.12 for "-5.12% down today $30.12" or 120.00 for "52 Week High $120.00". NAN for all other events.
+@property (nonatomic, readonly) double price;
+
+// For price change events, the generic part of the type that identifies the event for a ticker e.g. "% up today" for "+1.25% up today $30.12". nil for all other events.
+@property (nonatomic, readonly) NSString *genericType;
+
+// Return the classification for an event type, listed under the given ticker. The ticker is only needed to tell economic events apart and can be nil otherwise. Results are cached by type.
++ (FAEventClassification *)classificationForType:(NSString *)eventType ticker:(NSString *)companyTicker;
+
+// Is this a % up or % down event, meaning a daily, 30 days or year to date price change event.
+- (BOOL)isPercentMove;
+
+// Is this any price change event, including 52 week high and low events.
+- (BOOL)isPriceMove;
+
+@end
@@ -0,0 +1,182 @@
+//
+//  FAEventClassification.m
+//  FinApp
+//
+//  Class that parses the free text type of an event, once, into a canonical kind
+//  and the parameters encoded in it (percent, price, direction and window of a price move).
+//  Parsed results are cached by type string so repeated lookups, like the ones made
+//  when rendering cells, don't redo the substring matching.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAEventClassification.h"
+
+@interface FAEventClassification ()
+
+@property (nonatomic, readwrite) FAEventKind kind;
+@property (nonatomic, readwrite) FAPriceMoveDirection direction;
+@property (nonatomic, readwrite) FAPriceMoveWindow window;
+@property (nonatomic, readwrite) double percent;
+@property (nonatomic, readwrite) double price;
+@property (nonatomic, readwrite) NSString *genericType;
+
+// Parse the event type, listed under a ticker that is or isn't an economy ticker, into a new classification.
++ (FAEventClassification *)parseType:(NSString *)eventType isEconomyTicker:(BOOL)economyTicker;
+
+// Get the dollar price at the end of a price change event type e.g. 30.12 for "+5.12% up today $30.12", or NAN if there isn't one.
++ (double)priceInType:(NSString *)eventType;
+
+@end
+
+@implementation FAEventClassification
+
+// Return the classification for an event type, listed under the given ticker. The ticker is only needed to tell economic events apart and can be nil otherwise. Results are cached by type.
++ (FAEventClassification *)classificationForType:(NSString *)eventType ticker:(NSString *)companyTicker
+{
+    // Economic events are listed under an ECONOMY_ ticker e.g. ECONOMY_FOMC. Since the same type string can classify differently based on this, keep a separate cache for these.
+    static NSCache *classificationCache = nil;
+    static NSCache *economyClassificationCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classificationCache = [[NSCache alloc] init];
+        economyClassificationCache = [[NSCache alloc] init];
+    });
+
+    if (!eventType) {
+        eventType = @"";
+    }
+
+    BOOL economyTicker = [companyTicker containsString:@"ECONOMY_"];
+    NSCache *cache = economyTicker ? economyClassificationCache : classificationCache;
+
+    FAEventClassification *classification = [cache objectForKey:eventType];
+    if (!classification) {
+        classification = [self parseType:eventType isEconomyTicker:economyTicker];
+        [cache setObject:classification forKey:eventType];
+    }
+
+    return classification;
+}
+
+// Parse the event type, listed under a ticker that is or isn't an economy ticker, into a new classification.
++ (FAEventClassification *)parseType:(NSString *)eventType isEconomyTicker:(BOOL)economyTicker
+{
+    FAEventClassification *classification = [[FAEventClassification alloc] init];
+    classification.kind = FAEventKindUnknown;
+    classification.direction = FAPriceMoveDirectionNone;
+    classification.window = FAPriceMoveWindowNone;
+    classification.percent = NAN;
+    classification.price = NAN;
+    classification.genericType = nil;
+
+    // Price change events are the most specific so check these first.
+    // % up and % down events e.g. "+5.12% up today $30.12", "10.12% down 30 days", "30.12% up ytd"
+    NSRange percentRange = [eventType rangeOfString:@"% "];
+    if (percentRange.location != NSNotFound) {
+
+        NSString *afterPercent = [eventType substringFromIndex:percentRange.location];
+        FAPriceMoveDirection direction = FAPriceMoveDirectionNone;
+        if ([afterPercent hasPrefix:@"% up "]) {
+            direction = FAPriceMoveDirectionUp;
+        } else if ([afterPercent hasPrefix:@"% down "]) {
+            direction = FAPriceMoveDirectionDown;
+        }
+
+        if (direction != FAPriceMoveDirectionNone) {
+
+            NSString *windowStr = [afterPercent substringFromIndex:((direction == FAPriceMoveDirectionUp) ? 5 : 7)];
+            if ([windowStr hasPrefix:@"today"]) {
+                classification.kind = FAEventKindDailyMove;
+                classification.window = FAPriceMoveWindowDay;
+                classification.genericType = (direction == FAPriceMoveDirectionUp) ? @"% up today" : @"% down today";
+            } else if ([windowStr hasPrefix:@"30 days"]) {
+                classification.kind = FAEventKindThirtyDayMove;
+                classification.window = FAPriceMoveWindowThirtyDays;
+                classification.genericType = (direction == FAPriceMoveDirectionUp) ? @"% up 30 days" : @"% down 30 days";
+            } else if ([windowStr hasPrefix:@"ytd"]) {
+                classification.kind = FAEventKindYtdMove;
+                classification.window = FAPriceMoveWindowYearToDate;
+                classification.genericType = (direction == FAPriceMoveDirectionUp) ? @"% up ytd" : @"% down ytd";
+            }
+
+            if (classification.kind != FAEventKindUnknown) {
+                classification.direction = direction;
+                // The percent is everything before the % sign, less the sign of the change.
+                NSString *percentStr = [[eventType substringToIndex:percentRange.location] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"+- "]];
+                classification.percent = [percentStr doubleValue];
+                classification.price = [self priceInType:eventType];
+                return classification;
+            }
+        }
+    }
+
+    // 52 week high and low events e.g. "52 Week High $120.00"
+    if ([eventType containsString:@"52 Week High"]) {
+        classification.kind = FAEventKind52WeekHighLow;
+        classification.direction = FAPriceMoveDirectionUp;
+        classification.window = FAPriceMoveWindowFiftyTwoWeeks;
+        classification.genericType = @"52 Week High";
+        classification.price = [self priceInType:eventType];
+        return classification;
+    }
+    if ([eventType containsString:@"52 Week Low"]) {
+        classification.kind = FAEventKind52WeekHighLow;
+        classification.direction = FAPriceMoveDirectionDown;
+        classification.window = FAPriceMoveWindowFiftyTwoWeeks;
+        classification.genericType = @"52 Week Low";
+        classification.price = [self priceInType:eventType];
+        return classification;
+    }
+
+    // Earnings events
+    if ([eventType caseInsensitiveCompare:@"Quarterly Earnings"] == NSOrderedSame) {
+        classification.kind = FAEventKindEarnings;
+        return classification;
+    }
+
+    // Economic events
+    if (economyTicker) {
+        classification.kind = FAEventKindEcon;
+        return classification;
+    }
+
+    // Product events
+    if (([eventType rangeOfString:@"Launch" options:(NSCaseInsensitiveSearch|NSDiacriticInsensitiveSearch)].location != NSNotFound)||([eventType rangeOfString:@"Conference" options:(NSCaseInsensitiveSearch|NSDiacriticInsensitiveSearch)].location != NSNotFound)) {
+        classification.kind = FAEventKindProduct;
+    }
+
+    return classification;
+}
+
+// Get the dollar price at the end of a price change event type e.g. 30.12 for "+5.12% up today $30.12", or NAN if there isn't one.
++ (double)priceInType:(NSString *)eventType
+{
+    NSRange dollarRange = [eventType rangeOfString:@"$" options:NSBackwardsSearch];
+    if (dollarRange.location == NSNotFound) {
+        return NAN;
+    }
+
+    NSScanner *priceScanner = [NSScanner scannerWithString:[eventType substringFromIndex:(dollarRange.location + 1)]];
+    double price = NAN;
+    if (![priceScanner scanDouble:&price]) {
+        return NAN;
+    }
+
+    return price;
+}
+
+// Is this a % up or % down event, meaning a daily, 30 days or year to date price change event.
+- (BOOL)isPercentMove
+{
+    return ((self.kind == FAEventKindDailyMove)||(self.kind == FAEventKindThirtyDayMove)||(self.kind == FAEventKindYtdMove));
+}
+
+// Is this any price change event, including 52 week high and low events.
+- (BOOL)isPriceMove
+{
+    return ([self isPercentMove]||(self.kind == FAEventKind52WeekHighLow));
+}
+
+@end
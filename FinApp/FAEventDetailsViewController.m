@@ -18,6 +18,7 @@
 #import "FACompanyInfoStore.h"
 #import "FASnapShot.h"
 #import "FACoinAltData.h"
+#import "FADateCache.h"
 #import <FBSDKCoreKit/FBSDKCoreKit.h>
 #import <SafariServices/SafariServices.h>
 #import <QuartzCore/QuartzCore.h>
@@ -31,6 +32,15 @@
 // User's calendar events and reminders data store
 @property (strong, nonatomic) EKEventStore *userEventStore;
 
+// Classification of the type of the event being shown into a kind and price move parameters
+- (FAEventClassification *)eventTypeClassification;
+
+// Event being shown, fetched once from the data store and reused by the cells and helpers that need it's stored details
+@property (strong, nonatomic) Event *shownEvent;
+
+// Get the event for the given ticker and type, reusing the event being shown when it's the one asked for instead of fetching it again
+- (Event *)eventForParentTicker:(NSString *)parentTicker eventType:(NSString *)eventType;
+
 @end
 
 @implementation FAEventDetailsViewController
@@ -53,10 +63,10 @@
     self.primaryDetailsDataController = [[FADataController alloc] init];
     
     // Get the one data snapshot
-    self.dataSnapShot2 = [[FASnapShot alloc] init];
+    self.dataSnapShot2 = [FASnapShot sharedSnapShot];
     
     // Get the one alt data snapshot
-    self.altDataSnapShot = [[FACoinAltData alloc] init];
+    self.altDataSnapShot = [FACoinAltData singleAltDataBox];
 
     // Hide the company name in the navigation bar header
     //[self.navigationController.navigationBar setTitleTextAttributes:regularHeaderAttributes];
@@ -604,7 +614,7 @@
 {
     // Get a custom cell to display details and reset states/colors of cell elements to avoid carryover
     FAEventDetailsTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"EventDetailsCell" forIndexPath:indexPath];
-    Event *eventData = [self.primaryDetailsDataController getEventForParentEventTicker:self.parentTicker andEventType:self.eventType];
+    Event *eventData = [self eventForParentTicker:self.parentTicker eventType:self.eventType];
     
     // NEW WAY
     // Assign a row no to the type of event detail row.
@@ -2157,7 +2167,7 @@
     searchTerm = [NSString stringWithFormat:@"%@",@"cryptocurrency news"];
     
     // If price change event this button label is <TICKER> News and links out to Ticker cryptocurrency.
-    if ([self.eventType containsString:@"% up"]||[self.eventType containsString:@"% down"]) {
+    if ([[self eventTypeClassification] isPercentMove]) {
         searchTerm = [NSString stringWithFormat:@"%@ %@",self.parentCompany,@"cryptocurrency"];
         // Remove any spaces in the URL query string params
         searchTerm = [searchTerm stringByReplacingOccurrencesOfString:@" " withString:@"+"];
@@ -2289,16 +2299,13 @@
 - (NSString *)getBestInfoUrlWithEventType:(NSString *)eventType eventParentTicker:(NSString *)parentTicker
 {
     NSString *moreInfoURL = @"NA";
-    EventHistory *eventHistoryData = nil;
-    NSArray *infoComponents = nil;
     
-    if ([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
-        // Get event history that stores the following string for product events in it's previous1Status field: Impact_Impact Description_MoreInfoTitle_MoreInfoUrl
-        eventHistoryData = [self.primaryDetailsDataController getEventHistoryForParentEventTicker:parentTicker parentEventType:eventType];
-        
-        // Parse out the MoreInfoUrl
-        infoComponents = [eventHistoryData.previous1Status componentsSeparatedByString:@"_"];
-        moreInfoURL = infoComponents[3];
+    if ([self eventTypeClassification].kind == FAEventKindProduct) {
+        // Get the more info url that's stored on product events
+        Event *productEvent = [self eventForParentTicker:parentTicker eventType:eventType];
+        if (productEvent.productMoreInfoUrl) {
+            moreInfoURL = productEvent.productMoreInfoUrl;
+        }
     }
     
     return moreInfoURL;
@@ -2429,7 +2436,7 @@
         }
     }
     // Product Event.
-    if ([cellEventType containsString:@"Launch"]||[cellEventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:cellEventType ticker:nil].kind == FAEventKindProduct) {
         
         // Check to see if the event represented by the cell is estimated or confirmed ?
         // If confirmed create and save to action data store
@@ -2452,7 +2459,7 @@
         }
     }
     // Price Change event. Do nothing currently
-    if ([cellEventType containsString:@"% up"]||[cellEventType containsString:@"% down"])
+    if ([[FAEventClassification classificationForType:cellEventType ticker:nil] isPercentMove])
     {
         
     }
@@ -2481,7 +2488,7 @@
         if ([self isEventFollowable:cellEventType]) {
             
             // For a price change event create a "PriceChange" action, which is only used for determining if this event ticker is being followed.
-            if ([cellEventType containsString:@"% up"]||[cellEventType containsString:@"% down"])
+            if ([[FAEventClassification classificationForType:cellEventType ticker:nil] isPercentMove])
             {
                 [appropriateDataController insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:ticker eventType:cellEventType];
             }
@@ -2605,7 +2612,7 @@
     if ([eventType containsString:@"GDP Release"]) {
         reminderText = [NSString stringWithFormat:@"Knotifi ▶︎ GDP Release tomorrow %@", eventDateText];
     }
-    if ([eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:eventType ticker:nil].kind == FAEventKindProduct) {
         reminderText = [NSString stringWithFormat:@"Knotifi ▶︎ %@ tomorrow %@",eventType,eventDateText];
     }
     
@@ -2619,7 +2626,7 @@
     
     // Subtract a day as we want to remind the user a day prior and then set the reminder time to noon of the previous day
     // and set reminder due date to that.
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *aGregorianCalendar = [FADateCache gregorianCalendar];
     NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
     differenceDayComponents.day = -1;
     NSDate *reminderDateTime = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:eventDate options:0];
@@ -2652,7 +2659,12 @@
         
         // Get all future product events with the given ticker
         FADataController *tickerDataController = [[FADataController alloc] init];
-        NSArray *tickerFutureProductEvents = [tickerDataController getAllFutureProductEventsForTicker:ticker];
+        NSMutableArray *tickerFutureProductEventTypes = [NSMutableArray array];
+        [tickerDataController performBlockAndWait:^{
+            for (Event *tickerEvent in [tickerDataController getAllFutureProductEventsForTicker:ticker]) {
+                [tickerFutureProductEventTypes addObject:tickerEvent.type];
+            }
+        }];
         
         for (EKReminder *eventReminder in eventReminders) {
             
@@ -2662,8 +2674,8 @@
             }
             
             // See if a matching product event for that ticker is found, if so add to batch to be deleted
-            for(Event *listEvent in tickerFutureProductEvents) {
-                if([eventReminder.title containsString:listEvent.type]) {
+            for(NSString *listEventType in tickerFutureProductEventTypes) {
+                if([eventReminder.title containsString:listEventType]) {
                     [self.userEventStore removeReminder:eventReminder commit:NO error:&error];
                 }
             }
@@ -2846,7 +2858,7 @@
     }
     // End new econ events types
     
-    if ([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
+    if ([self eventTypeClassification].kind == FAEventKindProduct) {
         if(sectionNo == 0) {
             numberOfPieces = 6;
         }
@@ -2931,7 +2943,7 @@
     }
     // End new econ events types
     
-    if ([eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:eventType ticker:nil].kind == FAEventKindProduct) {
         description = [NSString stringWithFormat:@"Related to products or services offered by %@",companyName];
     }
     
@@ -2969,7 +2981,7 @@
         eventImage = [UIImage imageNamed:@"EconDetailCircle"];
     }
     
-    if ([eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:eventType ticker:nil].kind == FAEventKindProduct) {
         
         eventImage = [UIImage imageNamed:@"ProdDetailCircle"];
     }
@@ -3059,16 +3071,13 @@
     }
     // End new econ events types
     
-    // If event type is Product, the impact is stored in the event history data store, so fetch it from there.
+    // If event type is Product, the impact is stored on the event in the data store, so fetch it from there.
     // If new product event types are added, add them here as well.
-    if ([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
-        
-        // Get event history that stores the following string for product events in it's previous1Status field: Impact_Impact Description_MoreInfoTitle_MoreInfoUrl
-        EventHistory *eventHistoryData1 = [self.primaryDetailsDataController getEventHistoryForParentEventTicker:parentTicker parentEventType:eventType];
+    if ([self eventTypeClassification].kind == FAEventKindProduct) {
         
-        // Parse out to construct the Impact Text.
-        NSArray *impactComponents = [eventHistoryData1.previous1Status componentsSeparatedByString:@"_"];
-        description = [NSString stringWithFormat:@"%@ Impact.%@",impactComponents[0],impactComponents[1]];
+        // Get the impact and impact description that's stored on product events, to construct the Impact Text.
+        Event *productEvent = [self eventForParentTicker:parentTicker eventType:eventType];
+        description = [NSString stringWithFormat:@"%@ Impact.%@",[productEvent productImpactString],(productEvent.productImpactDescription ? productEvent.productImpactDescription : @"")];
     }
     
     return description;
@@ -3116,16 +3125,13 @@
     }
     // End new econ events types
     
-    // If event type is Product, the impact is stored in the event history data store, so fetch it from there.
+    // If event type is Product, the impact is stored on the event in the data store, so fetch it from there.
     // If new product event types are added, add them here as well.
-    if ([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
-        
-        // Get event history that stores the following string for product events in it's previous1Status field: Impact_Impact Description_MoreInfoTitle_MoreInfoUrl
-        EventHistory *eventHistoryData1 = [self.primaryDetailsDataController getEventHistoryForParentEventTicker:parentTicker parentEventType:eventType];
+    if ([self eventTypeClassification].kind == FAEventKindProduct) {
         
-        // Parse out to construct the Impact Text.
-        NSArray *impactComponents = [eventHistoryData1.previous1Status componentsSeparatedByString:@"_"];
-        description = [NSString stringWithFormat:@"%@ Impact",impactComponents[0]];
+        // Get the impact that's stored on product events, to construct the Impact Text.
+        Event *productEvent = [self eventForParentTicker:parentTicker eventType:eventType];
+        description = [NSString stringWithFormat:@"%@ Impact",[productEvent productImpactString]];
     }
     
     return description;
@@ -3174,16 +3180,15 @@
     }
     // End new econ events types
     
-    // If event type is Product, the impact is stored in the event history data store, so fetch it from there.
+    // If event type is Product, the impact is stored on the event in the data store, so fetch it from there.
     // If new product event types are added, add them here as well.
-    if ([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"]) {
-        
-        // Get event history that stores the following string for product events in it's previous1Status field: Impact_Impact Description_MoreInfoTitle_MoreInfoUrl
-        EventHistory *eventHistoryData1 = [self.primaryDetailsDataController getEventHistoryForParentEventTicker:parentTicker parentEventType:eventType];
+    if ([self eventTypeClassification].kind == FAEventKindProduct) {
         
-        // Parse out to construct the Impact Text.
-        NSArray *impactComponents = [eventHistoryData1.previous1Status componentsSeparatedByString:@"_"];
-        description = [NSString stringWithFormat:@"%@",impactComponents[1]];
+        // Get the impact description that's stored on product events.
+        Event *productEvent = [self eventForParentTicker:parentTicker eventType:eventType];
+        if (productEvent.productImpactDescription) {
+            description = [NSString stringWithFormat:@"%@",productEvent.productImpactDescription];
+        }
     }
     
     return description;
@@ -3196,18 +3201,18 @@
     NSString *moreInfoTitle = nil;
     NSString *moreInfoURL = nil;
     NSString *searchTerm = nil;
-    EventHistory *eventHistoryData = nil;
-    NSArray *infoComponents = nil;
     
     // For "Most Relevant Website" construct link pointing to an external website for product events
-    if ([infoType isEqualToString:@"Most Relevant Website"]&&([self.eventType containsString:@"Launch"]||[self.eventType containsString:@"Conference"])) {
-        // Get event history that stores the following string for product events in it's previous1Status field: Impact_Impact Description_MoreInfoTitle_MoreInfoUrl
-        eventHistoryData = [self.primaryDetailsDataController getEventHistoryForParentEventTicker:parentTicker parentEventType:eventType];
-        
-        // Parse out the MoreInfoTitle and MoreInfoUrl
-        infoComponents = [eventHistoryData.previous1Status componentsSeparatedByString:@"_"];
-        moreInfoTitle = [NSString stringWithFormat:@"%@ %@",infoComponents[2],@"▶︎"];
-        moreInfoURL = infoComponents[3];
+    if ([infoType isEqualToString:@"Most Relevant Website"]&&([self eventTypeClassification].kind == FAEventKindProduct)) {
+        // Get the more info title and url that's stored on product events
+        Event *productEvent = [self eventForParentTicker:parentTicker eventType:eventType];
+        // If the title or url isn't stored, fall back to the search engine link below instead of showing a broken link
+        if ((productEvent.productMoreInfoTitle.length > 0) && (productEvent.productMoreInfoUrl.length > 0)) {
+            moreInfoTitle = [NSString stringWithFormat:@"%@ %@",productEvent.productMoreInfoTitle,@"▶︎"];
+            moreInfoURL = productEvent.productMoreInfoUrl;
+        } else {
+            infoType = @"Latest On Search Engine";
+        }
     }
     
     // For "Latest On Search Engine" construct link pointing to an external search engine with a preset query.
@@ -3250,6 +3255,11 @@
             moreInfoURL = @"https://www.google.com/search?q=";
         }
         
+        // For any other event, search for the event type as is
+        if (!searchTerm) {
+            searchTerm = eventType;
+        }
+        
         // Remove any spaces in the URL query string params
         searchTerm = [searchTerm stringByReplacingOccurrencesOfString:@" " withString:@"+"];
         moreInfoURL = [moreInfoURL stringByAppendingString:searchTerm];
@@ -3295,7 +3305,8 @@
 {
     NSString *description = @"Data Not Available";
     
-    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventType containsString:@"% up"]||[eventType containsString:@"% down"]||[eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:nil];
+    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventClassification isPercentMove]||(eventClassification.kind == FAEventKindProduct)) {
         // More detailed formatting if needed for the future
         //description = [NSString stringWithFormat:@"1 month price change(%@).",infoString];
         description = [NSString stringWithFormat:@"1 month price change"];
@@ -3337,7 +3348,8 @@
 {
     NSString *description = @"Data Not Available";
     
-    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventType containsString:@"% up"]||[eventType containsString:@"% down"]||[eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:nil];
+    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventClassification isPercentMove]||(eventClassification.kind == FAEventKindProduct)) {
         // More detailed formatting in case you need it later
         //description = [NSString stringWithFormat:@"Year to date price change(%@).",infoString];
         description = [NSString stringWithFormat:@"Year to date price change"];
@@ -3365,12 +3377,35 @@
 
 #pragma mark - utility methods
 
+// Classification of the type of the event being shown into a kind and price move parameters
+- (FAEventClassification *)eventTypeClassification
+{
+    return [FAEventClassification classificationForType:self.eventType ticker:self.parentTicker];
+}
+
+// Get the event for the given ticker and type, reusing the event being shown when it's the one asked for instead of fetching it again
+- (Event *)eventForParentTicker:(NSString *)parentTicker eventType:(NSString *)eventType
+{
+    BOOL isShownEvent = [parentTicker isEqualToString:self.parentTicker] && [eventType isEqualToString:self.eventType];
+    if (!isShownEvent) {
+        return [self.primaryDetailsDataController getEventForParentEventTicker:parentTicker andEventType:eventType];
+    }
+    
+    // Fetch the event being shown the first time, or again if it's been deleted from the data store since
+    if (!self.shownEvent || [self.shownEvent isDeleted] || !self.shownEvent.managedObjectContext) {
+        self.shownEvent = [self.primaryDetailsDataController getEventForParentEventTicker:parentTicker andEventType:eventType];
+    }
+    
+    return self.shownEvent;
+}
+
 // Check to see if the event is of a type that it is followable. Currently price change events, or a product event or an earnings event, are followable. Econ events are not.
 - (BOOL)isEventFollowable:(NSString *)eventType
 {
     BOOL returnVal = NO;
     
-    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventType containsString:@"% up"]||[eventType containsString:@"% down"]||[eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:nil];
+    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventClassification isPercentMove]||(eventClassification.kind == FAEventKindProduct)) {
         returnVal = YES;
     }
     
@@ -3422,13 +3457,13 @@
         // Return the brand color
         colorToReturn = [self.dataSnapShot2 getBrandBkgrndColorForCompany:self.parentTicker];
     }
-    if ([self.eventType containsString:@"% up"])
+    if ([[self eventTypeClassification] isPercentMove]&&([self eventTypeClassification].direction == FAPriceMoveDirectionUp))
     {
         // Kinda Green
         //colorToReturn = [UIColor colorWithRed:56.0f/255.0f green:197.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
         colorToReturn = [UIColor colorWithRed:52.0f/255.0f green:181.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
     }
-    if ([self.eventType containsString:@"% down"])
+    if ([[self eventTypeClassification] isPercentMove]&&([self eventTypeClassification].direction == FAPriceMoveDirectionDown))
     {
         // Kinda Red
         colorToReturn = [UIColor colorWithRed:255.0f/255.0f green:63.0f/255.0f blue:61.0f/255.0f alpha:1.0f];
@@ -3503,17 +3538,17 @@
     }
     // End new econ events types
     
-    if ([eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:eventType ticker:nil].kind == FAEventKindProduct) {
         // Dark Yellow
         colorToReturn = [UIColor colorWithRed:240.0f/255.0f green:142.0f/255.0f blue:51.0f/255.0f alpha:1.0f];
     }
-    if ([self.eventType containsString:@"% up"])
+    if ([[self eventTypeClassification] isPercentMove]&&([self eventTypeClassification].direction == FAPriceMoveDirectionUp))
     {
         // Kinda Green
         //colorToReturn = [UIColor colorWithRed:56.0f/255.0f green:197.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
         colorToReturn = [UIColor colorWithRed:52.0f/255.0f green:181.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
     }
-    if ([self.eventType containsString:@"% down"])
+    if ([[self eventTypeClassification] isPercentMove]&&([self eventTypeClassification].direction == FAPriceMoveDirectionDown))
     {
         // Kinda Red
         colorToReturn = [UIColor colorWithRed:255.0f/255.0f green:63.0f/255.0f blue:61.0f/255.0f alpha:1.0f];
@@ -3527,8 +3562,7 @@
 - (NSString *)formatDateBasedOnEventType:(NSString *)rawEventType withDate:(NSDate *)eventDate withRelatedDetails:(NSString *)eventRelatedDetails withStatus:(NSString *)eventStatus
 {
     
-    NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-    [eventDateFormatter setDateFormat:@"EEE MMMM dd"];
+    NSDateFormatter *eventDateFormatter = [FADateCache formatterWithFormat:@"EEE MMMM dd"];
     NSString *eventDateString = [eventDateFormatter stringFromDate:eventDate];
     NSString *eventTimeString = eventRelatedDetails;
     
@@ -3589,7 +3623,7 @@
     }
     // End new econ events types
     
-    if ([rawEventType containsString:@"Launch"]||[rawEventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:rawEventType ticker:nil].kind == FAEventKindProduct) {
         
         if ([eventStatus isEqualToString:@"Confirmed"]) {
             eventDateString = [NSString stringWithFormat:@"%@ %@",eventDateString,eventTimeString];
@@ -3598,8 +3632,7 @@
         if ([eventStatus isEqualToString:@"Estimated"]) {
             
             // Get the year in the event date as rumored product events could well be in the next year
-            [eventDateFormatter setDateFormat:@"EEE MMMM dd y"];
-            eventDateString = [eventDateFormatter stringFromDate:eventDate];
+            eventDateString = [[FADateCache formatterWithFormat:@"EEE MMMM dd y"] stringFromDate:eventDate];
             NSArray *eventDateComponents = [eventDateString componentsSeparatedByString:@" "];
             NSString *eventDayString = eventDateComponents[2];
             int eventDay = [eventDayString intValue];
@@ -3615,7 +3648,7 @@
     }
     
     // For price change events, there's no schedule
-    if ([rawEventType containsString:@"% up"]||[rawEventType containsString:@"% down"]) {
+    if ([[FAEventClassification classificationForType:rawEventType ticker:nil] isPercentMove]) {
         eventDateString = @" ";
     }
     
@@ -3625,11 +3658,7 @@
 // Format the given date to set the time on it to midnight last night. e.g. 03/21/2016 9:00 pm becomes 03/21/2016 12:00 am.
 - (NSDate *)setTimeToMidnightLastNightOnDate:(NSDate *)dateToFormat
 {
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *dateComponents = [aGregorianCalendar components:(NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay) fromDate:dateToFormat];
-    NSDate *formattedDate = [aGregorianCalendar dateFromComponents:dateComponents];
-    
-    return formattedDate;
+    return [FADateCache dateForEpochDay:[FADateCache localEpochDayForDate:dateToFormat]];
 }
 
 // Format the event type for appropriate display. Currently the formatting looks like the following: Quarterly Earnings -> Earnings. Jan US Fed Meeting -> US Fed Meeting. Jan US Jobs Report -> US Jobs Report and so on. For product events strip out conference keyword WWDC 2016 Conference -> WWDC 2016
@@ -3640,12 +3669,8 @@
     //NSMutableString *tempString = [NSMutableString stringWithFormat:@"%@",formattedEventType];
     NSArray *typeComponents = nil;
     
-    // For price events strip out the up and down
-    if ([rawEventType containsString:@"% up"])
-    {
-        
-    }
-    else if ([rawEventType containsString:@"% down"])
+    // For price events strip out the up and down. Only % up and % down events have a price move percent.
+    if (rawEvent.priceMovePercent != nil)
     {
         
     }
@@ -3667,10 +3692,7 @@
     NSString *formattedDistance = @" ";
     
     // Calculate the number of days between event date and today's date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSUInteger unitFlags =  NSCalendarUnitDay;
-    NSDateComponents *diffDateComponents = [aGregorianCalendar components:unitFlags fromDate:[self setTimeToMidnightLastNightOnDate:[NSDate date]] toDate:[self setTimeToMidnightLastNightOnDate:eventDate] options:0];
-    NSInteger difference = [diffDateComponents day];
+    NSInteger difference = [FADateCache localEpochDayForDate:eventDate] - [FADateCache localEpochDayForDate:[NSDate date]];
     
     if ((difference < 0)&&(difference > -2)) {
         formattedDistance = @"Yesterday";
@@ -0,0 +1,54 @@
+//
+//  FAEventRowViewModel.h
+//  FinApp
+//
+//  Class that holds everything an event row in the events list shows, already formatted:
+//  the text, colors and flags worked out from the event's type, date, details and company.
+//  It's immutable, so it can be built off the main thread and used to configure a cell
+//  without any further formatting.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+@interface FAEventRowViewModel : NSObject
+
+// Ticker formatted for display e.g. ECON for economic events, shown on the news button
+@property (strong, nonatomic, readonly) NSString *tickerText;
+
+// Name of the listed company
+@property (strong, nonatomic, readonly) NSString *companyName;
+
+// Brand background and text colors for the listed company
+@property (strong, nonatomic, readonly) UIColor *brandBackgroundColor;
+@property (strong, nonatomic, readonly) UIColor *brandTextColor;
+
+// Event type formatted for display e.g. Earnings, and it's color
+@property (strong, nonatomic, readonly) NSString *descriptionText;
+@property (strong, nonatomic, readonly) UIColor *descriptionColor;
+
+// Event date formatted for display e.g. Wed January 27 Before Open
+@property (strong, nonatomic, readonly) NSString *dateText;
+
+// How far the event is from today e.g. Tomorrow, and it's color. These depend on today's date.
+@property (strong, nonatomic, readonly) NSString *distanceText;
+@property (strong, nonatomic, readonly) UIColor *distanceColor;
+
+// Color for the timeline label, based on how far the event is from today
+@property (strong, nonatomic, readonly) UIColor *timelineColor;
+
+// Event certainty, not shown but needed for reminder creation
+@property (strong, nonatomic, readonly) NSString *certainty;
+
+// Should the high impact label be shown
+@property (nonatomic, readonly) BOOL highImpact;
+
+// Can the row be interacted with. Not for 52 week high/low events.
+@property (nonatomic, readonly) BOOL interactionEnabled;
+
+// Create a row view model with all it's values.
+- (id)initWithTickerText:(NSString *)tickerText companyName:(NSString *)companyName brandBackgroundColor:(UIColor *)brandBackgroundColor brandTextColor:(UIColor *)brandTextColor descriptionText:(NSString *)descriptionText descriptionColor:(UIColor *)descriptionColor dateText:(NSString *)dateText distanceText:(NSString *)distanceText distanceColor:(UIColor *)distanceColor timelineColor:(UIColor *)timelineColor certainty:(NSString *)certainty highImpact:(BOOL)highImpact interactionEnabled:(BOOL)interactionEnabled;
+
+@end
@@ -0,0 +1,40 @@
+//
+//  FAEventRowViewModel.m
+//  FinApp
+//
+//  Class that holds everything an event row in the events list shows, already formatted:
+//  the text, colors and flags worked out from the event's type, date, details and company.
+//  It's immutable, so it can be built off the main thread and used to configure a cell
+//  without any further formatting.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAEventRowViewModel.h"
+
+@implementation FAEventRowViewModel
+
+// Create a row view model with all it's values.
+- (id)initWithTickerText:(NSString *)tickerText companyName:(NSString *)companyName brandBackgroundColor:(UIColor *)brandBackgroundColor brandTextColor:(UIColor *)brandTextColor descriptionText:(NSString *)descriptionText descriptionColor:(UIColor *)descriptionColor dateText:(NSString *)dateText distanceText:(NSString *)distanceText distanceColor:(UIColor *)distanceColor timelineColor:(UIColor *)timelineColor certainty:(NSString *)certainty highImpact:(BOOL)highImpact interactionEnabled:(BOOL)interactionEnabled
+{
+    self = [super init];
+    if (self) {
+        _tickerText = [tickerText copy];
+        _companyName = [companyName copy];
+        _brandBackgroundColor = brandBackgroundColor;
+        _brandTextColor = brandTextColor;
+        _descriptionText = [descriptionText copy];
+        _descriptionColor = descriptionColor;
+        _dateText = [dateText copy];
+        _distanceText = [distanceText copy];
+        _distanceColor = distanceColor;
+        _timelineColor = timelineColor;
+        _certainty = [certainty copy];
+        _highImpact = highImpact;
+        _interactionEnabled = interactionEnabled;
+    }
+    return self;
+}
+
+@end
@@ -13,7 +13,7 @@
 @class FADataController;
 @class FASnapShot;
 
-@interface FAEventsViewController : UIViewController <UITableViewDataSource, UITableViewDelegate>
+@interface FAEventsViewController : UIViewController <UITableViewDataSource, UITableViewDelegate, NSFetchedResultsControllerDelegate>
 
 // Primary Data Controller to add/access data in the data store
 @property (strong, nonatomic) FADataController *primaryDataController;
@@ -22,8 +22,20 @@
 #import "FASnapShot.h"
 #import <SafariServices/SafariServices.h>
 #import "FACoinAltData.h"
+#import "FACompanySearchIndex.h"
+#import "FAFollowIndex.h"
+#import "FASearchPipeline.h"
+#import "FADataStore.h"
+#import "FAEventRowViewModel.h"
+#import "FADateCache.h"
+#import "FAMarketCalendar.h"
+#import "FATrace.h"
+#import "FALaunchScheduler.h"
 @import EventKit;
 
+// Number of rows, from the top of the events list, to precompute view models for in the background. Rows further down are built when first shown.
+static const NSUInteger FARowViewModelPrecomputeLimit = 300;
+
 @interface FAEventsViewController () <SFSafariViewControllerDelegate>
 
 // Get all companies from API. Typically called in a background thread
@@ -65,9 +77,51 @@
 // Remove the busy message in the header to show appropriate header.
 - (void)removeBusyMessage;
 
+// Has the events list been fetched. At launch this waits for the data store to be loaded in the background.
+@property (nonatomic) BOOL eventsListLoaded;
+
+// Fetch the events to show and start listening for changes to them and the data store. Needs the data store to be loaded.
+- (void)setUpEventsList;
+
 // User's calendar events and reminders data store
 @property (strong, nonatomic) EKEventStore *userEventStore;
 
+// Debounces search as you type and runs the searches in the background
+@property (strong, nonatomic) FASearchPipeline *searchPipeline;
+
+// Show the results of a search as you type, given the results controller and whether companies were matched instead of events.
+- (void)showSearchResults:(NSFetchedResultsController *)resultsController matchedCompanies:(BOOL)matchedCompanies forEventType:(NSString *)eventTypeTitle mainNav:(NSString *)mainNavTitle;
+
+// Formatted display values for event rows, keyed by event objectID. Only used on the main thread.
+@property (strong, nonatomic) NSMutableDictionary *rowViewModels;
+
+// Whether the Price event type was selected when the cached row view models were built, as rows show the distance differently for it.
+@property (nonatomic) BOOL rowViewModelsPriceTypeSelected;
+
+// Incremented whenever the row view models are thrown away. Background precomputes only add their results if it hasn't changed since they started.
+@property (nonatomic) NSUInteger rowViewModelGeneration;
+
+// Private queue context, child of the writer context, that row view models are precomputed on.
+@property (strong, nonatomic) NSManagedObjectContext *rowViewModelContext;
+
+// Get the view model for an event row, from the cache if it's there, else build it now and cache it. Call on the main thread.
+- (FAEventRowViewModel *)rowViewModelForEvent:(Event *)event;
+
+// Build the view model for an event row from the raw event values. Doesn't touch the UI or the event itself, so it's safe to call off the main thread.
+- (FAEventRowViewModel *)rowViewModelForEventType:(NSString *)eventType date:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails certainty:(NSString *)eventCertainty ticker:(NSString *)companyTicker companyName:(NSString *)companyName priceTypeSelected:(BOOL)priceSelected;
+
+// Precompute, in the background, the view models for the top rows of the events in the results controller and add them to the cache when done.
+- (void)precomputeRowViewModelsForResultsController:(NSFetchedResultsController *)resultsController;
+
+// Check if the Price event type is currently selected in the event type selector
+- (BOOL)isPriceEventTypeSelected;
+
+// Throw away all cached row view models, including any precompute that's still running.
+- (void)clearRowViewModels;
+
+// Calculate how far the event is from today, with the event type selector check passed in so that it can be called off the main thread.
+- (NSString *)calculateDistanceFromEventDate:(NSDate *)eventDate withEventType:(NSString *)rawEventType priceTypeSelected:(BOOL)priceSelected;
+
 @end
 
 @implementation FAEventsViewController
@@ -150,9 +204,39 @@
     // Format the initiate support button's background color to get it right. For some weird reason it doesn't go through properly when setting it in the storyboard.
     [self.supportButton setBackgroundColor:[UIColor colorWithRed:241.0f/255.0f green:243.0f/255.0f blue:243.0f/255.0f alpha:1.0f]];
 
+    // The data store is loaded in the background at launch, so that opening or migrating it doesn't hold up the first frame. If it's not loaded yet,
+    // show the busy message in an empty list till it is, instead of waiting for it on the main thread.
+    if ([[FADataStore sharedStore] isStoreLoaded]) {
+        [self setUpEventsList];
+    } else {
+        [self showBusyMessage];
+        __weak FAEventsViewController *weakSelf = self;
+        [[FADataStore sharedStore] loadPersistentStoreInBackgroundWithCompletion:^{
+            [weakSelf setUpEventsList];
+            [weakSelf.eventsListTable reloadData];
+            
+            // If the placeholder was showing, the events list is what's been rendered now
+            if (weakSelf.view.window) {
+                [[FALaunchScheduler sharedScheduler] eventsListDidRender];
+            }
+        }];
+    }
+}
+
+// Fetch the events to show and start listening for changes to them and the data store. Needs the data store to be loaded.
+- (void)setUpEventsList {
+    
     // Get a primary data controller that you will use later
     self.primaryDataController = [[FADataController alloc] init];
     
+    // Get the one data Snapshot to use later, so the brand colors table is only loaded once. Needed before the first events are fetched as their rows are precomputed using it.
+    self.dataSnapShot = [FASnapShot sharedSnapShot];
+    
+    // Set up the cache of formatted event rows, and the context they are precomputed on in the background
+    self.rowViewModels = [NSMutableDictionary dictionary];
+    self.rowViewModelContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [self.rowViewModelContext setParentContext:[[FADataStore sharedStore] writerContext]];
+    
     // Ensure that the remote fetch spinner is not animating thus hidden
     if ([[self.primaryDataController getEventSyncStatus] isEqualToString:@"RefreshCheckDone"]) {
         [self removeBusyMessage];
@@ -202,6 +286,16 @@
                                              selector:@selector(stopBusySpinner:)
                                                  name:@"StopBusySpinner" object:nil];
     
+    // Register a listener for changes to events and companies in the main context, so that their cached rows can be rebuilt
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(mainContextObjectsChanged:)
+                                                 name:NSManagedObjectContextObjectsDidChangeNotification object:[[FADataStore sharedStore] mainContext]];
+    
+    // Register a listener for the day changing, at midnight, since the cached rows show how far away each event is from today
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(significantTimeChanged:)
+                                                 name:UIApplicationSignificantTimeChangeNotification object:nil];
+    
    // Seed the company data, the very first time, to get the user started.
     // TO DO: UNCOMMENT FOR PRE SEEDING DB: Commenting out since we don't want to kick off a company/event sync due to preseeded data.
     /*if ([[self.primaryDataController getCompanySyncStatus] isEqualToString:@"NoSyncPerformed"]) {
@@ -293,8 +387,31 @@
     // This will remove extra separators from the bottom of the tableview which doesn't have any cells
     self.eventsListTable.tableFooterView = [[UIView alloc] initWithFrame:CGRectZero];
     
-    // Create (now but get later, once it's created right at the start) the data Snapshot to use later.
-    self.dataSnapShot = [[FASnapShot alloc] init];
+    // Create the pipeline that search as you type goes through
+    self.searchPipeline = [[FASearchPipeline alloc] init];
+    
+    // Build the company search index in the background, so that it's ready by the time the user starts typing a search. Same for the follow index, used to show what's being followed.
+    // At launch this waits till the app is idle after the first frame, so that it doesn't compete with showing the list.
+    [[FALaunchScheduler sharedScheduler] addTaskForStage:FALaunchStageIdle named:@"buildIndexes" usingBlock:^{
+        [[FACompanySearchIndex sharedIndex] buildIfNeeded];
+        [[FAFollowIndex sharedIndex] buildIfNeeded];
+    }];
+    
+    // The events list can be shown now
+    self.eventsListLoaded = YES;
+}
+
+- (void)viewDidAppear:(BOOL)animated {
+    
+    [super viewDidAppear:animated];
+    
+    // Let the launch scheduler know that the events list has been shown, so that the work waiting on the first frame can start. If the data store is
+    // still loading, only the placeholder has been shown, so the events list is counted as rendered once it's fetched.
+    if (self.eventsListLoaded) {
+        [[FALaunchScheduler sharedScheduler] eventsListDidRender];
+    } else {
+        [[FALaunchScheduler sharedScheduler] firstFrameDidRender];
+    }
 }
 
 - (void)didReceiveMemoryWarning {
@@ -396,6 +513,7 @@
 // TO DO LATER: IMPORTANT: Any change to the formatting here could affect reminder creation (processReminderForEventInCell:,editActionsForRowAtIndexPath) since the reminder values are taken from the cell. Additionally changes here need to be reconciled with changes in the getEvents for ticker's queued reminder creation. Also reconcile in didSelectRowAtIndexPath.
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
+    uint64_t spanStart = FATraceBegin();
     
     // Get a custom cell to display
     FAEventsTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"EventCell" forIndexPath:indexPath];
@@ -543,15 +661,13 @@
         
         // TO DO LATER: !!!!!!!!!!IMPORTANT!!!!!!!!!!!!!: Any change to the formatting here could affect reminder creation (processReminderForEventInCell:,editActionsForRowAtIndexPath) since the reminder values are taken from the cell. Additionally changes here need to be reconciled with changes in the getEvents for ticker's queued reminder creation. Also reconcile in didSelectRowAtIndexPath.
         
+        // Get the already formatted values for the row
+        FAEventRowViewModel *rowViewModel = [self rowViewModelForEvent:eventAtIndex];
+        
         // Make the cell inactive if it's of type 52 Week.
-        // NOTE: In some places just 52 Week is used
-        if ([eventAtIndex.type containsString:@"52 Week High"]||[eventAtIndex.type containsString:@"52 Week Low"]) {
-            cell.userInteractionEnabled = NO;
-        } else {
-            cell.userInteractionEnabled = YES;
-        }
+        cell.userInteractionEnabled = rowViewModel.interactionEnabled;
         // Set the company ticker text and then disable,hide it and no need for the gesture recognizer as the news button now takes it's place
-        [[cell companyTicker] setText:[self formatTickerBasedOnEventType:eventAtIndex.listedCompany.ticker]];
+        [[cell companyTicker] setText:rowViewModel.tickerText];
         [[cell companyTicker] setEnabled:NO];
         [[cell companyTicker] setHidden:YES];
         /*UITapGestureRecognizer *tickerTap = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(processTypeIconTap:)];
@@ -562,40 +678,34 @@
         cell.companyTicker.tag = indexPath.row;*/
         
         // Enable, Show and Set News Button text and color
-        [[cell newsButon] setTitle:[self formatTickerBasedOnEventType:eventAtIndex.listedCompany.ticker] forState:UIControlStateNormal];
+        [[cell newsButon] setTitle:rowViewModel.tickerText forState:UIControlStateNormal];
         [[cell newsButon] setHidden:NO];
         [[cell newsButon] setEnabled:YES];
-        cell.newsButon.backgroundColor = [self.dataSnapShot getBrandBkgrndColorForCompany:eventAtIndex.listedCompany.ticker];
-        [cell.newsButon setTitleColor:[self.dataSnapShot getBrandTextColorForCompany:eventAtIndex.listedCompany.ticker] forState:UIControlStateNormal];
+        cell.newsButon.backgroundColor = rowViewModel.brandBackgroundColor;
+        [cell.newsButon setTitleColor:rowViewModel.brandTextColor forState:UIControlStateNormal];
         
         cell.newsButon.tag = indexPath.row;
         // Also add the button press action.
         [cell.newsButon addTarget:self action:@selector(newsButtonPressed:) forControlEvents:UIControlEventTouchUpInside];
         
         // Format the company ticker just like above
-        cell.companyTicker.backgroundColor = [self.dataSnapShot getBrandBkgrndColorForCompany:eventAtIndex.listedCompany.ticker];
-        cell.companyTicker.textColor = [self.dataSnapShot getBrandTextColorForCompany:eventAtIndex.listedCompany.ticker];
+        cell.companyTicker.backgroundColor = rowViewModel.brandBackgroundColor;
+        cell.companyTicker.textColor = rowViewModel.brandTextColor;
         
         // Hide the company Name as this information is not needed to be displayed to the user.
         [[cell companyName] setHidden:YES];
         // Set the company name associated with the event as this is needed in places like getting the earnings.
-        [[cell  companyName] setText:eventAtIndex.listedCompany.name];
+        [[cell  companyName] setText:rowViewModel.companyName];
         // Center align the ticker for visual consistency with this view
         [[cell  companyTicker] setTextAlignment:NSTextAlignmentCenter];
         
         // If the product timeline view is selected, show timeline label
         // Check to see if the Product Main Nav is selected
         if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame) {
-    
-            // Format the ticker and news section with the correct brand colors. Looks hot!
-            cell.companyTicker.backgroundColor = [self.dataSnapShot getBrandBkgrndColorForCompany:eventAtIndex.listedCompany.ticker];
-            cell.companyTicker.textColor = [self.dataSnapShot getBrandTextColorForCompany:eventAtIndex.listedCompany.ticker];
-            cell.newsButon.backgroundColor = [self.dataSnapShot getBrandBkgrndColorForCompany:eventAtIndex.listedCompany.ticker];
-            [cell.newsButon setTitleColor:[self.dataSnapShot getBrandTextColorForCompany:eventAtIndex.listedCompany.ticker] forState:UIControlStateNormal];
             // Show the timeline label in case it was hidden
             cell.timelineLbl.hidden = NO;
             // Set color for timeline label based on event distance
-            cell.timelineLbl.backgroundColor = [self getColorForDistanceFromEventDate:eventAtIndex.date];
+            cell.timelineLbl.backgroundColor = rowViewModel.timelineColor;
         }
         
         // Set the fetch state of the event cell to false
@@ -603,31 +713,31 @@
         // be a unique identifier for each event ?
         cell.eventRemoteFetch = NO;
         
-        // Show the event type. Format it for display. Currently map "Quarterly Earnings" to "Earnings", "Jan US Fed Meeting" to "US Fed Meeting", "Jan US Jobs Report" to "US Jobs Report" and so on.
+        // Show the event type, formatted for display.
         // TO DO LATER: !!!!!!!!!!IMPORTANT!!!!!!!!!!!!! If you are making a change here, reconcile with prepareForSegue in addition to the methods mentioned above.
-        [[cell  eventDescription] setText:[self formatEventType:eventAtIndex.type]];
-        [cell.eventDescription setTextColor:[self getColorForCellLabelsBasedOnEventType:eventAtIndex.type]];
+        [[cell  eventDescription] setText:rowViewModel.descriptionText];
+        [cell.eventDescription setTextColor:rowViewModel.descriptionColor];
         
         // Show the event date
-        [[cell eventDate] setText:[self formatDateBasedOnEventType:eventAtIndex.type withDate:eventAtIndex.date withRelatedDetails:eventAtIndex.relatedDetails withStatus:eventAtIndex.certainty]];
+        [[cell eventDate] setText:rowViewModel.dateText];
         
-        // Show the event distance
-        [[cell eventDistance] setText:[self calculateDistanceFromEventDate:eventAtIndex.date withEventType:eventAtIndex.type]];
-        
-        // Set event distance to the appropriate color using a reddish scheme.
-        [[cell eventDistance] setTextColor:[self getColorForDistanceFromEventDate:eventAtIndex.date withEventType:eventAtIndex.type]];
+        // Show the event distance, in the appropriate color using a reddish scheme.
+        [[cell eventDistance] setText:rowViewModel.distanceText];
+        [[cell eventDistance] setTextColor:rowViewModel.distanceColor];
         
         // Show event impact label if the impact is high
-        if ([self.dataSnapShot isEventHighImpact:eventAtIndex.type eventParent:eventAtIndex.listedCompany.ticker]) {
+        if (rowViewModel.highImpact) {
             [[cell eventImpact] setHidden:NO];
         }
         
         // Hide the event certainty as this information is not needed to be displayed to the user.
         [[cell eventCertainty] setHidden:YES];
         // Set event certainty though since it's needed by reminder creation.
-        [[cell eventCertainty] setText:eventAtIndex.certainty];
+        [[cell eventCertainty] setText:rowViewModel.certainty];
     }
     
+    FATraceEnd(FATraceSpanCellConfiguration, spanStart);
+    
     return cell;
 }
 
@@ -828,7 +938,9 @@
                 if ([self checkForInternetConnectivity]) {
                     // Create a new FADataController so that this thread has its own MOC
                     FADataController *priceDetailsDataController = [[FADataController alloc] init];
-                    self.currPriceAndChange = [priceDetailsDataController getPriceDetailsForEventOfType:eventType withTicker:eventTicker];
+                    [priceDetailsDataController performBlockAndWait:^{
+                        self.currPriceAndChange = [priceDetailsDataController getPriceDetailsForEventOfType:eventType withTicker:eventTicker];
+                    }];
                 }
                 // If not, show error message
                 else {
@@ -861,16 +973,26 @@
     
     BOOL returnVal = YES;
     
-    // Get the cell for the row on which the action is being exercised
-    FAEventsTableViewCell *cell1 = (FAEventsTableViewCell *)[self.eventsListTable cellForRowAtIndexPath:indexPath];
+    // Get the event for the row on which the action is being exercised, if the row is for an event
+    Event *rowEvent = nil;
     
     // If a filter has been specified, meaning it's in search mode, don't allow edit if it's in the "GET EVENTS" or "SHOW TIMELINE" mode.
     if (self.filterSpecified) {
         if ([self.filterType isEqualToString:@"Match_Companies_NoEvents"]||[self.filterType isEqualToString:@"Match_Companies_ForTimeline"]) {
             returnVal = NO;
         }
+        if ([self.filterType isEqualToString:@"Match_Companies_Events"]) {
+            rowEvent = [self.filteredResultsController objectAtIndexPath:indexPath];
+        }
     }
-    if (([cell1.eventDescription.text containsString:@"52 Week"])||([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame)) {
+    else {
+        rowEvent = [self.eventResultsController objectAtIndexPath:indexPath];
+    }
+    if (![rowEvent isKindOfClass:[Event class]]) {
+        rowEvent = nil;
+    }
+    // 52 week high and low events, going by the typed price move window instead of the displayed text, can't be edited
+    if (([rowEvent.priceMoveWindow integerValue] == FAPriceMoveWindowFiftyTwoWeeks)||([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame)) {
         returnVal = NO;
     }
     
@@ -905,7 +1027,7 @@
     if ([self isEventFollowable:cellEventType]) {
         
         // For a price change event, create reminders for all followable events for that ticker thus indicating this ticker is being followed
-        if ([cellEventType containsString:@"% up"]||[cellEventType containsString:@"% down"])
+        if ([[FAEventClassification classificationForType:cellEventType ticker:nil] isPercentMove])
         {
             // Check to see if a reminder action has already been created for the quarterly earnings event for this ticker, which means this ticker is already being followed
             // TO DO: Hardcoding this for now to be quarterly earnings
@@ -1142,8 +1264,8 @@
         moreInfoURL = [NSString stringWithFormat:@"%@",@"https://www.google.com/m/search?q="];
         searchTerm = [NSString stringWithFormat:@"%@",@"stocks"];
         
-        // Get an instance of Data for entity like company
-        FACoinAltData *entityData = [[FACoinAltData alloc] init];
+        // Get the one instance of Data for entity like company
+        FACoinAltData *entityData = [FACoinAltData singleAltDataBox];
         NSString *actionLocation = nil;
         
         // For Quarterly Earnings, search query term is ticker and Earnings e.g. BOX earnings
@@ -1217,7 +1339,7 @@
         }
         // End new econ events types
     
-        if ([formattedEventType containsString:@"% up"]||[formattedEventType containsString:@"% down"]) {
+        if ([[FAEventClassification classificationForType:formattedEventType ticker:nil] isPercentMove]) {
             searchTerm = [NSString stringWithFormat:@"%@ %@",ticker,@"stock"];
             // Remove any spaces in the URL query string params
             searchTerm = [searchTerm stringByReplacingOccurrencesOfString:@" " withString:@"+"];
@@ -1391,7 +1513,7 @@
         }
     }
     // Product Event.
-    if ([cellEventType containsString:@"Launch"]||[cellEventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:cellEventType ticker:nil].kind == FAEventKindProduct) {
         
         // Check to see if the event represented by the cell is estimated or confirmed ?
         // If confirmed create and save to action data store
@@ -1416,7 +1538,7 @@
         }
     }
     // Price Change event. Do nothing currently
-    if ([cellEventType containsString:@"% up"]||[cellEventType containsString:@"% down"])
+    if ([[FAEventClassification classificationForType:cellEventType ticker:nil] isPercentMove])
     {
         
     }
@@ -1445,7 +1567,7 @@
         if ([self isEventFollowable:cellEventType]) {
             
             // For a price change event create a "PriceChange" action, which is only used for determining if this event ticker is being followed.
-            if ([cellEventType containsString:@"% up"]||[cellEventType containsString:@"% down"])
+            if ([[FAEventClassification classificationForType:cellEventType ticker:nil] isPercentMove])
             {
                 [appropriateDataController insertActionOfType:@"PriceChange" status:@"Queued" eventTicker:ticker eventType:cellEventType];
             }
@@ -1571,7 +1693,7 @@
         reminderText = [NSString stringWithFormat:@"Knotifi ▶︎ US New Homes Sales %@", eventDateText];
     }
     // End new econ events types
-    if ([eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:eventType ticker:nil].kind == FAEventKindProduct) {
         reminderText = [NSString stringWithFormat:@"Knotifi ▶︎ %@ tomorrow %@",eventType,eventDateText];
     }
     eventReminder.title = reminderText;
@@ -1584,7 +1706,7 @@
     
     // Subtract a day as we want to remind the user a day prior and then set the reminder time to noon of the previous day
     // and set reminder due date to that.
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSCalendar *aGregorianCalendar = [FADateCache gregorianCalendar];
     NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
     differenceDayComponents.day = -1;
     NSDate *reminderDateTime = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:eventDate options:0];
@@ -1617,7 +1739,12 @@
         
         // Get all future product events with the given ticker
         FADataController *tickerDataController = [[FADataController alloc] init];
-        NSArray *tickerFutureProductEvents = [tickerDataController getAllFutureProductEventsForTicker:ticker];
+        NSMutableArray *tickerFutureProductEventTypes = [NSMutableArray array];
+        [tickerDataController performBlockAndWait:^{
+            for (Event *tickerEvent in [tickerDataController getAllFutureProductEventsForTicker:ticker]) {
+                [tickerFutureProductEventTypes addObject:tickerEvent.type];
+            }
+        }];
         
         for (EKReminder *eventReminder in eventReminders) {
             
@@ -1627,8 +1754,8 @@
             }
             
             // See if a matching product event for that ticker is found, if so add to batch to be deleted
-            for(Event *listEvent in tickerFutureProductEvents) {
-                if([eventReminder.title containsString:listEvent.type]) {
+            for(NSString *listEventType in tickerFutureProductEventTypes) {
+                if([eventReminder.title containsString:listEventType]) {
                     [self.userEventStore removeReminder:eventReminder commit:NO error:&error];
                 }
             }
@@ -1676,10 +1803,12 @@
         // Clean up any unfinished task business before it's about to be terminated
         // In our case, check if all pages of companies data has been synced. If not, mark status to failed
         // so that another thread can pick up the completion on restart. Currently this is hardcoded to 26 as 26 pages worth of companies (7375 companies at 300 per page) were available as of July 15, 2105. When you change this, change the hard coded value in getAllCompaniesFromApi in FADataController. Also change in Search Bar Began Editing in the Events View Controller.
-        if ([[companiesDataController getCompanySyncStatus] isEqualToString:@"FullSyncStarted"]&&[[companiesDataController getCompanySyncedUptoPage] integerValue] < [[companiesDataController getTotalNoOfCompanyPagesToSync] integerValue])
-        {
-            [companiesDataController upsertUserWithCompanySyncStatus:@"FullSyncAttemptedButFailed" syncedPageNo:[companiesDataController getCompanySyncedUptoPage]];
-        }
+        [companiesDataController performBlockAndWait:^{
+            if ([[companiesDataController getCompanySyncStatus] isEqualToString:@"FullSyncStarted"]&&[[companiesDataController getCompanySyncedUptoPage] integerValue] < [[companiesDataController getTotalNoOfCompanyPagesToSync] integerValue])
+            {
+                [companiesDataController upsertUserWithCompanySyncStatus:@"FullSyncAttemptedButFailed" syncedPageNo:[companiesDataController getCompanySyncedUptoPage]];
+            }
+        }];
         
         // Stopped or ending the task outright.
         [[UIApplication sharedApplication] endBackgroundTask:bgFetchTask];
@@ -1689,7 +1818,9 @@
     // Start the long-running task and return immediately.
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
         
-        [companiesDataController getAllCompaniesFromApi];
+        [companiesDataController performBlockAndWait:^{
+            [companiesDataController getAllCompaniesFromApi];
+        }];
         
         [[UIApplication sharedApplication] endBackgroundTask:bgFetchTask];
         bgFetchTask = UIBackgroundTaskInvalid;
@@ -1759,6 +1890,9 @@
 // companies to prompt the user to fetch the events data for these companies.
 - (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar {
     
+    // The search is run right away, so drop any search as you type still in flight
+    [self.searchPipeline cancelPendingSearches];
+    
     // Validate search text entered. If valid
     if ([self searchTextValid:searchBar.text]) {
         
@@ -1978,226 +2112,74 @@
     // If valid
     if ([self searchTextValid:searchBar.text]) {
         
-        // Check to see if "All" events types are selected. Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Home"] == NSOrderedSame) {
-            
-            // Check to see if the Events Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Events"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchEventsFor:searchBar.text eventDisplayType:@"Home"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, search for the name and ticker fields on the companies data store.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                    
-                    // Set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events
-                    // has been specified.
-                    self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
-                }
-            }
-            // Check to see if the Following Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Following"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchFollowingEventsFor:searchBar.text eventDisplayType:@"All"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, that means search for the name and ticker fields on the companies data store.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                    
-                    // Set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events
-                    // has been specified.
-                    self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
-                }
-            }
-            // Check to see if Product Main Option is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame) {
-                // Basically find Companies so that user can select one to show the product timeline
-                self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                // Set the filter type to Match_Companies_ForTimeline, meaning a filter matching companies with no existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_ForTimeline"];
+        NSString *eventTypeTitle = [self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex];
+        NSString *mainNavTitle = [self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex];
+        BOOL eventsNav = ([mainNavTitle caseInsensitiveCompare:@"Events"] == NSOrderedSame);
+        BOOL followingNav = ([mainNavTitle caseInsensitiveCompare:@"Following"] == NSOrderedSame);
+        
+        // Work out what to search for, the same way as when the search button is clicked. Search on "ticker" or "name" fields for the listed Company
+        // or the "type" field on the event. For some event types, if no events are found, search for the name and ticker fields on the companies instead.
+        BOOL searchTypeKnown = YES;
+        BOOL searchNeeded = YES;
+        FASearchScope searchScope = FASearchScopeEvents;
+        NSString *searchDisplayType = nil;
+        BOOL fallBackToCompanies = NO;
+        if ([eventTypeTitle caseInsensitiveCompare:@"Home"] == NSOrderedSame) {
+            searchScope = eventsNav ? FASearchScopeEvents : FASearchScopeFollowingEvents;
+            searchDisplayType = eventsNav ? @"Home" : @"All";
+            fallBackToCompanies = YES;
+            // Basically find Companies so that user can select one to show the product timeline
+            if ([mainNavTitle caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame) {
+                searchScope = FASearchScopeCompanies;
+                fallBackToCompanies = NO;
+            } else {
+                searchNeeded = eventsNav||followingNav;
             }
-            
-            // Set the Filter Specified flag to true, indicating that a search filter has been specified
-            self.filterSpecified = YES;
-            
-            // Reload messages table
-            [self.eventsListTable reloadData];
         }
-        
-        // Check to see if "Earnings" events types are selected. Search on "ticker" or "name" fields for the listed Company for earnings events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Earnings"] == NSOrderedSame) {
-            
-            // Check to see if the Events Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Events"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchEventsFor:searchBar.text eventDisplayType:@"Earnings"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, search for the name and ticker fields on the companies data store.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                    
-                    // Set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events
-                    // has been specified.
-                    self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
-                }
-            }
-            // Check to see if the Following Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Following"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchFollowingEventsFor:searchBar.text eventDisplayType:@"Earnings"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, search for the name and ticker fields on the companies data store.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                    
-                    // Set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events
-                    // has been specified.
-                    self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
-                }
-            }
-            
-            // Set the Filter Specified flag to true, indicating that a search filter has been specified
-            self.filterSpecified = YES;
-            
-            // Reload messages table
-            [self.eventsListTable reloadData];
+        else if ([eventTypeTitle caseInsensitiveCompare:@"Earnings"] == NSOrderedSame) {
+            searchScope = eventsNav ? FASearchScopeEvents : FASearchScopeFollowingEvents;
+            searchDisplayType = @"Earnings";
+            fallBackToCompanies = YES;
+            searchNeeded = eventsNav||followingNav;
+        }
+        else if ([eventTypeTitle caseInsensitiveCompare:@"Econ"] == NSOrderedSame) {
+            searchScope = eventsNav ? FASearchScopeEvents : FASearchScopeFollowingEvents;
+            searchDisplayType = @"Economic";
+            searchNeeded = eventsNav||followingNav;
+        }
+        else if ([eventTypeTitle caseInsensitiveCompare:@"Crypto"] == NSOrderedSame) {
+            searchScope = eventsNav ? FASearchScopeEvents : FASearchScopeFollowingEvents;
+            searchDisplayType = @"Crypto";
+            searchNeeded = eventsNav||followingNav;
+        }
+        else if ([eventTypeTitle caseInsensitiveCompare:@"Prod"] == NSOrderedSame) {
+            searchScope = FASearchScopeEvents;
+            searchDisplayType = @"Product";
+            searchNeeded = eventsNav;
+        }
+        else if ([eventTypeTitle caseInsensitiveCompare:@"Price"] == NSOrderedSame) {
+            searchScope = FASearchScopeFollowingEvents;
+            searchDisplayType = @"Price";
+            fallBackToCompanies = YES;
+            searchNeeded = followingNav;
         }
-        
-        // Check to see if "Economic" events types are selected. Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all economic events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Econ"] == NSOrderedSame) {
-            
-            // Check to see if the Events Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Events"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchEventsFor:searchBar.text eventDisplayType:@"Economic"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-            }
-            // Check to see if the Following Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Following"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchFollowingEventsFor:searchBar.text eventDisplayType:@"Economic"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, set the appropriate header message.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    // Set navigation bar header to an attention orange color
-                    NSDictionary *attentionHeaderAttributes = [NSDictionary dictionaryWithObjectsAndKeys:
-                                                               [UIFont boldSystemFontOfSize:14], NSFontAttributeName,
-                                                               [UIColor colorWithRed:205.0f/255.0f green:151.0f/255.0f blue:61.0f/255.0f alpha:1.0f], NSForegroundColorAttributeName,
-                                                               nil];
-                    [self.navigationController.navigationBar setTitleTextAttributes:attentionHeaderAttributes];
-                    [self.navigationController.navigationBar.topItem setTitle:@"No matching events being followed"];
-                }
-            }
-            
-            // Set the Filter Specified flag to true, indicating that a search filter has been specified
-            self.filterSpecified = YES;
-            
-            // Reload messages table
-            [self.eventsListTable reloadData];
+        else {
+            searchTypeKnown = NO;
         }
         
-        // Check to see if "Crypto" events types are selected. Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all economic events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Crypto"] == NSOrderedSame) {
-            
-            // Check to see if the Events Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Events"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchEventsFor:searchBar.text eventDisplayType:@"Crypto"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-            }
-            // Check to see if the Following Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Following"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchFollowingEventsFor:searchBar.text eventDisplayType:@"Crypto"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, set the appropriate header message.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    // Set navigation bar header to an attention orange color
-                    NSDictionary *attentionHeaderAttributes = [NSDictionary dictionaryWithObjectsAndKeys:
-                                                               [UIFont boldSystemFontOfSize:14], NSFontAttributeName,
-                                                               [UIColor colorWithRed:205.0f/255.0f green:151.0f/255.0f blue:61.0f/255.0f alpha:1.0f], NSForegroundColorAttributeName,
-                                                               nil];
-                    [self.navigationController.navigationBar setTitleTextAttributes:attentionHeaderAttributes];
-                    [self.navigationController.navigationBar.topItem setTitle:@"No matching events being followed"];
-                }
-            }
-            
-            // Set the Filter Specified flag to true, indicating that a search filter has been specified
-            self.filterSpecified = YES;
-            
-            // Reload messages table
-            [self.eventsListTable reloadData];
-        }
-
-        // Check to see if "Product" events types are selected. Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all product events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Prod"] == NSOrderedSame) {
-            
-            // Check to see if the Events Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Events"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchEventsFor:searchBar.text eventDisplayType:@"Product"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-            }
-            
-            // Set the Filter Specified flag to true, indicating that a search filter has been specified
-            self.filterSpecified = YES;
-            
-            // Reload messages table
-            [self.eventsListTable reloadData];
+        // Search once typing pauses, off the main thread. Keystrokes that come in before the results do make them obsolete.
+        // The keystroke is traced until the results for it are shown, so obsolete ones aren't traced.
+        if (searchTypeKnown && searchNeeded) {
+            __weak FAEventsViewController *weakSelf = self;
+            uint64_t spanStart = FATraceBegin();
+            [self.searchPipeline searchFor:searchBar.text scope:searchScope eventDisplayType:searchDisplayType fallBackToCompanies:fallBackToCompanies completionHandler:^(NSFetchedResultsController *resultsController, BOOL matchedCompanies) {
+                [weakSelf showSearchResults:resultsController matchedCompanies:matchedCompanies forEventType:eventTypeTitle mainNav:mainNavTitle];
+                FATraceEnd(FATraceSpanSearchKeystroke, spanStart);
+            }];
         }
-        
-        // Check to see if "Price" events type is selected. Search on "ticker" or "name" fields for the listed Company or the "type" field on the event for all price events
-        if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Price"] == NSOrderedSame) {
+        else if (searchTypeKnown) {
             
-            // Double check to see if the Following Main Nav is selected
-            if ([[self.mainNavSelector titleForSegmentAtIndex:self.mainNavSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Following"] == NSOrderedSame) {
-                // Search the ticker and name fields on the company related to the events and the type of event in the data store, for the search text entered
-                self.filteredResultsController = [self.primaryDataController searchFollowingEventsFor:searchBar.text eventDisplayType:@"Price"];
-                // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events
-                // has been specified.
-                self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
-                
-                // If no events are found, search for the name and ticker fields on the companies data store.
-                if ([self.filteredResultsController fetchedObjects].count == 0) {
-                    
-                    self.filteredResultsController = [self.primaryDataController searchCompaniesFor:searchBar.text];
-                    
-                    // Set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events
-                    // has been specified.
-                    self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
-                }
-            }
+            [self.searchPipeline cancelPendingSearches];
             
             // Set the Filter Specified flag to true, indicating that a search filter has been specified
             self.filterSpecified = YES;
@@ -2209,6 +2191,9 @@
     // If not valid
     else {
         
+        // Don't let a search still in flight replace the events shown
+        [self.searchPipeline cancelPendingSearches];
+        
         // Check to see if "All" events types are selected. In this case query all events
         if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Home"] == NSOrderedSame) {
             
@@ -2405,6 +2390,42 @@
     }
 }
 
+// Show the results of a search as you type, given the results controller and whether companies were matched instead of events.
+- (void)showSearchResults:(NSFetchedResultsController *)resultsController matchedCompanies:(BOOL)matchedCompanies forEventType:(NSString *)eventTypeTitle mainNav:(NSString *)mainNavTitle {
+    
+    self.filteredResultsController = resultsController;
+    
+    // Set the filter type to Match_Companies_Events, meaning a filter matching companies with existing events has been specified.
+    self.filterType = [NSString stringWithFormat:@"Match_Companies_Events"];
+    if (matchedCompanies) {
+        // If companies were found for the product timeline, set the filter type to Match_Companies_ForTimeline. Otherwise no events were found, so
+        // set the filter type to Match_Companies_NoEvents, meaning a filter matching companies with no existing events has been specified.
+        if ([mainNavTitle caseInsensitiveCompare:self.mainNavProductOption] == NSOrderedSame) {
+            self.filterType = [NSString stringWithFormat:@"Match_Companies_ForTimeline"];
+        } else {
+            self.filterType = [NSString stringWithFormat:@"Match_Companies_NoEvents"];
+        }
+    }
+    
+    // If no economic or crypto events being followed are found, set the appropriate header message.
+    if ((([eventTypeTitle caseInsensitiveCompare:@"Econ"] == NSOrderedSame)||([eventTypeTitle caseInsensitiveCompare:@"Crypto"] == NSOrderedSame)) && ([mainNavTitle caseInsensitiveCompare:@"Following"] == NSOrderedSame) && ([resultsController fetchedObjects].count == 0)) {
+        
+        // Set navigation bar header to an attention orange color
+        NSDictionary *attentionHeaderAttributes = [NSDictionary dictionaryWithObjectsAndKeys:
+                                                   [UIFont boldSystemFontOfSize:14], NSFontAttributeName,
+                                                   [UIColor colorWithRed:205.0f/255.0f green:151.0f/255.0f blue:61.0f/255.0f alpha:1.0f], NSForegroundColorAttributeName,
+                                                   nil];
+        [self.navigationController.navigationBar setTitleTextAttributes:attentionHeaderAttributes];
+        [self.navigationController.navigationBar.topItem setTitle:@"No matching events being followed"];
+    }
+    
+    // Set the Filter Specified flag to true, indicating that a search filter has been specified
+    self.filterSpecified = YES;
+    
+    // Reload messages table
+    [self.eventsListTable reloadData];
+}
+
 // Validate search text entered. Currently only checking for if the search text is empty.
 - (BOOL) searchTextValid:(NSString *)text {
     
@@ -2771,7 +2792,9 @@
                         // Create a new FADataController so that this thread has its own MOC
                         FADataController *priceDataController = [[FADataController alloc] init];
                         
-                        [priceDataController getPriceChangeEventsForFollowingStocksWrapper];
+                        [priceDataController performBlockAndWait:^{
+                            [priceDataController getPriceChangeEventsForFollowingStocksWrapper];
+                        }];
                     });
                 /*}
                 // Show existing price events along with a refresh message
@@ -3082,13 +3105,76 @@
 
 #pragma mark - Change Listener Responses
 
+// Set the results controller for the events table and listen to it for changes, so that events merged in from background syncs show up without a refetch.
+- (void)setEventResultsController:(NSFetchedResultsController *)eventResultsController {
+    
+    _eventResultsController.delegate = nil;
+    _eventResultsController = eventResultsController;
+    _eventResultsController.delegate = self;
+    
+    // The rows shown can depend on the event type selected, so start over with the cached rows for the new events
+    [self clearRowViewModels];
+    [self precomputeRowViewModelsForResultsController:eventResultsController];
+}
+
+// Set the results controller for search results, listen to it for changes, so that search results pick up background syncs too, and precompute the rows for them, if they are events.
+- (void)setFilteredResultsController:(NSFetchedResultsController *)filteredResultsController {
+    
+    _filteredResultsController.delegate = nil;
+    _filteredResultsController = filteredResultsController;
+    _filteredResultsController.delegate = self;
+    
+    // The cached rows may be for a different set of events, so start over with them for the search results
+    [self clearRowViewModels];
+    [self precomputeRowViewModelsForResultsController:filteredResultsController];
+}
+
+// Refresh the events table when the events or search results in the results controller it's showing have changed.
+- (void)controllerDidChangeContent:(NSFetchedResultsController *)controller {
+    
+    if (((controller == self.eventResultsController)&&!self.filterSpecified)||((controller == self.filteredResultsController)&&self.filterSpecified)) {
+        [self.eventsListTable reloadData];
+    }
+}
+
+// Throw away the cached rows for events that have changed in the main context, so that they are rebuilt when next shown. If a company changed or everything was invalidated, throw away all of them. Other objects, like actions and event histories, don't change the rows.
+- (void)mainContextObjectsChanged:(NSNotification *)notification {
+    
+    if ([notification.userInfo objectForKey:NSInvalidatedAllObjectsKey] != nil) {
+        [self clearRowViewModels];
+        return;
+    }
+    
+    NSArray *changeKeys = @[NSUpdatedObjectsKey, NSDeletedObjectsKey, NSRefreshedObjectsKey, NSInvalidatedObjectsKey];
+    for (NSString *changeKey in changeKeys) {
+        for (NSManagedObject *changedObject in [notification.userInfo objectForKey:changeKey]) {
+            if ([changedObject isKindOfClass:[Company class]]) {
+                [self clearRowViewModels];
+                return;
+            }
+            // Actions and event histories don't change what the rows show
+            if (![changedObject isKindOfClass:[Event class]]) {
+                continue;
+            }
+            [self.rowViewModels removeObjectForKey:changedObject.objectID];
+            // Any precompute still running may have the old values for the event
+            self.rowViewModelGeneration = self.rowViewModelGeneration + 1;
+        }
+    }
+}
+
+// Rebuild the rows when the day changes, at midnight, as they show how far away each event is from today.
+- (void)significantTimeChanged:(NSNotification *)notification {
+    
+    [self clearRowViewModels];
+    [self precomputeRowViewModelsForResultsController:(self.filterSpecified ? self.filteredResultsController : self.eventResultsController)];
+    [self.eventsListTable reloadData];
+}
+
 // Refetch the events and refresh the events table when the events store for the table has changed
 - (void)eventStoreChanged:(NSNotification *)notification {
     
-    // Create a new DataController so that this thread has its own MOC
-    // TO DO: Understand at what point does a new thread get spawned off. Seems to me the new thread is being created for
-    // reloading the table. SHouldn't I be creating the new MOC in that thread as opposed to here ? Maybe it doesn't matter
-    // as long as I am not sharing MOCs across threads ? The general rule with Core Data is one Managed Object Context per thread, and one thread per MOC
+    // Create a new DataController. On the main thread this shares the main queue context that the UI uses.
     FADataController *secondaryDataController = [[FADataController alloc] init];
     
     // Query all future events depending on the type selected in the selector, including today, as that is the default view first shown
@@ -3160,8 +3246,7 @@
 // Process the notification to update screen header which is the navigation bar title. Currently just set it to today's date.
 - (void)updateScreenHeader:(NSNotification *)notification {
     
-    NSDateFormatter *todayDateFormatter = [[NSDateFormatter alloc] init];
-    [todayDateFormatter setDateFormat:@"EEE MMMM dd"];
+    NSDateFormatter *todayDateFormatter = [FADateCache formatterWithFormat:@"EEE MMMM dd"];
     [self.navigationController.navigationBar.topItem setTitle:[todayDateFormatter stringFromDate:[NSDate date]]];
 }
 
@@ -3337,117 +3422,137 @@
     }*/
 }
 
-#pragma mark - Utility Methods
+#pragma mark - Event Row View Models
 
-// Compute the likely date for the previous event based on current event type (currently only Quarterly), previous event related date (e.g. quarter end related to the quarterly earnings), current event date and current event related date.
-- (NSDate *)computePreviousEventDateWithCurrentEventType:(NSString *)currentType currentEventDate:(NSDate *)currentDate currentEventRelatedDate:(NSDate *)currentRelatedDate previousEventRelatedDate:(NSDate *)previousRelatedDate
+// Get the view model for an event row, from the cache if it's there, else build it now and cache it. Call on the main thread.
+- (FAEventRowViewModel *)rowViewModelForEvent:(Event *)event
 {
+    // The cached rows are only good for the event type selection they were built with
+    BOOL priceSelected = [self isPriceEventTypeSelected];
+    if (priceSelected != self.rowViewModelsPriceTypeSelected) {
+        [self clearRowViewModels];
+        self.rowViewModelsPriceTypeSelected = priceSelected;
+    }
     
-    // TO DO: Use Earnings type later
-    
-    // Calculate the number of days between current event date (quarterly earnings) and current event related date (end of quarter being reported)
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    // NSUInteger unitFlags = NSCalendarUnitEra | NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay;
-    NSUInteger unitFlags =  NSCalendarUnitDay;
-    NSDateComponents *diffDateComponents = [aGregorianCalendar components:unitFlags fromDate:currentRelatedDate toDate:currentDate options:0];
-    NSInteger difference = [diffDateComponents day];
-    
-    // Add the no of days to the previous related event date (previously reported quarter end)
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = difference;
-    NSDate *previousEventDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:previousRelatedDate options:0];
+    FAEventRowViewModel *rowViewModel = [self.rowViewModels objectForKey:event.objectID];
     
-    // Make sure the date doesn't fall on a Friday, Saturday, Sunday. In these cases move it to the previous Thursday for Friday and following Monday for Saturday and Sunday. TO DO LATER: Factor in holidays here.
-    // Convert from string to Date
-    NSDateFormatter *previousDayFormatter = [[NSDateFormatter alloc] init];
-    [previousDayFormatter setDateFormat:@"EEE"];
-    NSString *previousDayString = [previousDayFormatter stringFromDate:previousEventDate];
-    if ([previousDayString isEqualToString:@"Fri"]) {
-        differenceDayComponents.day = -1;
-        previousEventDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:previousEventDate options:0];
-    }
-    if ([previousDayString isEqualToString:@"Sat"]) {
-        differenceDayComponents.day = 2;
-        previousEventDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:previousEventDate options:0];
-    }
-    if ([previousDayString isEqualToString:@"Sun"]) {
-        differenceDayComponents.day = 1;
-        previousEventDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:previousEventDate options:0];
+    if (rowViewModel == nil) {
+        rowViewModel = [self rowViewModelForEventType:event.type date:event.date relatedDetails:event.relatedDetails certainty:event.certainty ticker:event.listedCompany.ticker companyName:event.listedCompany.name priceTypeSelected:priceSelected];
+        [self.rowViewModels setObject:rowViewModel forKey:event.objectID];
     }
     
-    return previousEventDate;
+    return rowViewModel;
 }
 
-// Compute the unscrubbed date 30 days ago from today. Unscrubbed means it could be a weekend or a holiday.
-- (NSDate *)computeDate30DaysAgoFrom:(NSDate *)startingDate
+// Build the view model for an event row from the raw event values. Doesn't touch the UI or the event itself, so it's safe to call off the main thread.
+- (FAEventRowViewModel *)rowViewModelForEventType:(NSString *)eventType date:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails certainty:(NSString *)eventCertainty ticker:(NSString *)companyTicker companyName:(NSString *)companyName priceTypeSelected:(BOOL)priceSelected
 {
-    // Subtract 30 days from start date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = -30;
-    NSDate *returnDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:startingDate options:0];
-    
-    return returnDate;
+    // NOTE: In some places just 52 Week is used
+    BOOL interactionEnabled = ([FAEventClassification classificationForType:eventType ticker:companyTicker].kind != FAEventKind52WeekHighLow);
+    
+    return [[FAEventRowViewModel alloc] initWithTickerText:[self formatTickerBasedOnEventType:companyTicker]
+                                               companyName:companyName
+                                      brandBackgroundColor:[self.dataSnapShot getBrandBkgrndColorForCompany:companyTicker]
+                                            brandTextColor:[self.dataSnapShot getBrandTextColorForCompany:companyTicker]
+                                           descriptionText:[self formatEventType:eventType]
+                                          descriptionColor:[self getColorForCellLabelsBasedOnEventType:eventType]
+                                                  dateText:[self formatDateBasedOnEventType:eventType withDate:eventDate withRelatedDetails:eventRelatedDetails withStatus:eventCertainty]
+                                              distanceText:[self calculateDistanceFromEventDate:eventDate withEventType:eventType priceTypeSelected:priceSelected]
+                                             distanceColor:[self getColorForDistanceFromEventDate:eventDate withEventType:eventType]
+                                             timelineColor:[self getColorForDistanceFromEventDate:eventDate]
+                                                 certainty:eventCertainty
+                                                highImpact:[self.dataSnapShot isEventHighImpact:eventType eventParent:companyTicker]
+                                        interactionEnabled:interactionEnabled];
 }
 
-// Compute the unscrubbed date 4 mos ago from today. Unscrubbed means it could be a weekend or a holiday.
-- (NSDate *)computeDate4MosAgoFrom:(NSDate *)startingDate
+// Precompute, in the background, the view models for the top rows of the events in the results controller and add them to the cache when done.
+- (void)precomputeRowViewModelsForResultsController:(NSFetchedResultsController *)resultsController
 {
-    // Subtract 124 days from start date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = -124;
-    NSDate *returnDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:startingDate options:0];
+    NSFetchRequest *eventsRequest = [resultsController.fetchRequest copy];
+    if (![eventsRequest.entityName isEqualToString:@"Event"]) {
+        return;
+    }
     
-    return returnDate;
-}
-
-// Compute the scrubbed first market day of the year for the given date. Currently it works only for 2016.
-// TO DO: Change this for 2017 and so on and so forth
-- (NSDate *)computeMarketStartDateOfTheYearFrom:(NSDate *)givenDate
-{
-    // Compute the first date of the year from the given date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents * aCalComponents = [aGregorianCalendar components: NSCalendarUnitYear fromDate:givenDate];
-    [aCalComponents setYear:[aCalComponents year]];
-    NSDate *returnDate = [aGregorianCalendar dateFromComponents:aCalComponents];
+    // Just get the values the rows show, along with the event identity, for the top rows, in the same order
+    NSExpressionDescription *objectIDDescription = [[NSExpressionDescription alloc] init];
+    objectIDDescription.name = @"objectID";
+    objectIDDescription.expression = [NSExpression expressionForEvaluatedObject];
+    objectIDDescription.expressionResultType = NSObjectIDAttributeType;
+    [eventsRequest setResultType:NSDictionaryResultType];
+    [eventsRequest setPropertiesToFetch:@[objectIDDescription, @"type", @"date", @"relatedDetails", @"certainty", @"listedCompany.ticker", @"listedCompany.name"]];
+    [eventsRequest setFetchBatchSize:0];
+    [eventsRequest setFetchLimit:FARowViewModelPrecomputeLimit];
     
-    // For 2016, the first market open day was 3 days after, Jan 1 putting it at Jan 4.
-    // TO DO Change for beginning of the year 2019: For 2017, the first market day will be 2 days later on Jan 3. So add 2 instead of 3 here. That's it. www.timeanddate.com/calendar/?year=2017&country=1
-    // FOR 2018: the first day the market is open is Tue Jan 2nd. So add 1 instead of 2.
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    differenceDayComponents.day = 1;
-    returnDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:returnDate options:0];
+    NSUInteger generation = self.rowViewModelGeneration;
+    BOOL priceSelected = [self isPriceEventTypeSelected];
     
-    return returnDate;
+    [self.rowViewModelContext performBlock:^{
+        
+        NSError *error;
+        NSArray *eventRows = [self.rowViewModelContext executeFetchRequest:eventsRequest error:&error];
+        if (error) {
+            NSLog(@"ERROR: Getting events to precompute their rows, from data store, failed: %@",error.description);
+            return;
+        }
+        
+        NSMutableDictionary *precomputedRows = [NSMutableDictionary dictionaryWithCapacity:eventRows.count];
+        for (NSDictionary *eventRow in eventRows) {
+            FAEventRowViewModel *rowViewModel = [self rowViewModelForEventType:[eventRow objectForKey:@"type"] date:[eventRow objectForKey:@"date"] relatedDetails:[eventRow objectForKey:@"relatedDetails"] certainty:[eventRow objectForKey:@"certainty"] ticker:[eventRow objectForKey:@"listedCompany.ticker"] companyName:[eventRow objectForKey:@"listedCompany.name"] priceTypeSelected:priceSelected];
+            [precomputedRows setObject:rowViewModel forKey:[eventRow objectForKey:@"objectID"]];
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Drop the results if the cache has been thrown away since, as they may be out of date. Don't replace rows built, or rebuilt, in the meantime.
+            if ((generation != self.rowViewModelGeneration)||(priceSelected != self.rowViewModelsPriceTypeSelected)) {
+                return;
+            }
+            for (NSManagedObjectID *eventID in precomputedRows) {
+                if ([self.rowViewModels objectForKey:eventID] == nil) {
+                    [self.rowViewModels setObject:[precomputedRows objectForKey:eventID] forKey:eventID];
+                }
+            }
+        });
+    }];
 }
 
+// Check if the Price event type is currently selected in the event type selector
+- (BOOL)isPriceEventTypeSelected
+{
+    return ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Price"] == NSOrderedSame);
+}
 
-// Make sure the date doesn't fall on a Friday, Saturday, Sunday. In these cases move it to the previous Friday for Saturday and following Monday for Sunday. TO DO LATER: Factor in holidays here.
-- (NSDate *)scrubDateToNotBeWeekendOrHoliday:(NSDate *)dateToScrub
+// Throw away all cached row view models, including any precompute that's still running.
+- (void)clearRowViewModels
 {
-    // Make sure the date doesn't fall on a Friday, Saturday, Sunday. In these cases move it to the previous Friday for Saturday and following Monday for Sunday. TO DO LATER: Factor in holidays here.
-    // Convert from string to Date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateFormatter *dayFormatter = [[NSDateFormatter alloc] init];
-    [dayFormatter setDateFormat:@"EEE"];
-    // Set the formatter to be GMT since dates are always GMT and formatters are defaulted to local timezone
-    [dayFormatter setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
-    NSDateComponents *differenceDayComponents = [[NSDateComponents alloc] init];
-    NSDate *scrubbedDate = dateToScrub;
-    NSString *dayString = [dayFormatter stringFromDate:dateToScrub];
+    self.rowViewModelGeneration = self.rowViewModelGeneration + 1;
+    [self.rowViewModels removeAllObjects];
+}
 
-    if ([dayString isEqualToString:@"Sat"]) {
-        differenceDayComponents.day = -1;
-        scrubbedDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:dateToScrub options:0];
-    }
+#pragma mark - Utility Methods
+
+// Compute the likely date for the previous event based on current event type (currently only Quarterly), previous event related date (e.g. quarter end related to the quarterly earnings), current event date and current event related date.
+- (NSDate *)computePreviousEventDateWithCurrentEventType:(NSString *)currentType currentEventDate:(NSDate *)currentDate currentEventRelatedDate:(NSDate *)currentRelatedDate previousEventRelatedDate:(NSDate *)previousRelatedDate
+{
+    
+    // TO DO: Use Earnings type later
     
-    if ([dayString isEqualToString:@"Sun"]) {
-        differenceDayComponents.day = 1;
-        scrubbedDate = [aGregorianCalendar dateByAddingComponents:differenceDayComponents toDate:dateToScrub options:0];
+    // Add the number of days between current event date (quarterly earnings) and current event related date (end of quarter being reported) to the previous related event date (previously reported quarter end)
+    int32_t previousEventDay = [FADateCache localEpochDayForDate:previousRelatedDate] + ([FADateCache localEpochDayForDate:currentDate] - [FADateCache localEpochDayForDate:currentRelatedDate]);
+    
+    // Make sure the date doesn't fall on a Friday, Saturday, Sunday or holiday. In these cases move it to the previous Thursday for Friday and the following trading day otherwise.
+    if ([FAMarketCalendar weekdayForEpochDay:previousEventDay] == 6) {
+        previousEventDay = previousEventDay - 1;
     }
+    previousEventDay = [FAMarketCalendar tradingEpochDayOnOrAfter:previousEventDay];
     
-    return scrubbedDate;
+    return [FADateCache dateForEpochDay:previousEventDay];
+}
+
+// Compute the unscrubbed date 4 mos ago from today. Unscrubbed means it could be a weekend or a holiday.
+- (NSDate *)computeDate4MosAgoFrom:(NSDate *)startingDate
+{
+    // Subtract 124 days from start date
+    return [FADateCache dateByAddingDays:-124 toDate:startingDate];
 }
 
 // Check if the ticker other than a normal ticker e.g. for economic event
@@ -3578,7 +3683,7 @@
         formattedEventType = [NSString stringWithFormat:@"%@ %@",rawEventType,@"Conference"];
     } else if (([addtlInfo isEqualToString:@"Confirmed"]||[addtlInfo isEqualToString:@"Estimated"])&&([rawEventType containsString:@"Launch"])) {
         // Do Nothing as for Launch the full event type already exists
-    } else if ([rawEventType containsString:@"% up"]||[rawEventType containsString:@"% down"]) {
+    } else if ([[FAEventClassification classificationForType:rawEventType ticker:nil] isPercentMove]) {
         // Do Nothing as for price events the full event type already exists
     } else {
         formattedEventType = [NSString stringWithFormat:@"%@ %@",addtlInfo,rawEventType];
@@ -3592,7 +3697,8 @@
 {
     BOOL returnVal = NO;
     
-    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventType containsString:@"% up"]||[eventType containsString:@"% down"]||[eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:nil];
+    if ([eventType isEqualToString:@"Quarterly Earnings"]||[eventClassification isPercentMove]||(eventClassification.kind == FAEventKindProduct)) {
         returnVal = YES;
     }
     
@@ -3616,8 +3722,7 @@
 - (NSString *)formatDateBasedOnEventType:(NSString *)rawEventType withDate:(NSDate *)eventDate withRelatedDetails:(NSString *)eventRelatedDetails withStatus:(NSString *)eventStatus
 {
     
-    NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
-    [eventDateFormatter setDateFormat:@"EEE MMMM dd"];
+    NSDateFormatter *eventDateFormatter = [FADateCache formatterWithFormat:@"EEE MMMM dd"];
     NSString *eventDateString = [eventDateFormatter stringFromDate:eventDate];
     NSString *eventTimeString = eventRelatedDetails;
     
@@ -3682,7 +3787,7 @@
     }
     // End new econ events types
     
-    if ([rawEventType containsString:@"Launch"]||[rawEventType containsString:@"Conference"]) {
+    if ([FAEventClassification classificationForType:rawEventType ticker:nil].kind == FAEventKindProduct) {
         
         if ([eventStatus isEqualToString:@"Confirmed"]) {
             eventDateString = [NSString stringWithFormat:@"%@ %@",eventDateString,eventTimeString];
@@ -3691,8 +3796,7 @@
         if ([eventStatus isEqualToString:@"Estimated"]) {
             
             // Get the year in the event date as rumored product events could well be in the next year
-            [eventDateFormatter setDateFormat:@"EEE MMMM dd y"];
-            eventDateString = [eventDateFormatter stringFromDate:eventDate];
+            eventDateString = [[FADateCache formatterWithFormat:@"EEE MMMM dd y"] stringFromDate:eventDate];
             NSArray *eventDateComponents = [eventDateString componentsSeparatedByString:@" "];
             NSString *eventDayString = eventDateComponents[2];
             int eventDay = [eventDayString intValue];
@@ -3708,7 +3812,7 @@
     }
     
     // For price change events, there's no schedule
-    if ([rawEventType containsString:@"% up"]||[rawEventType containsString:@"% down"]) {
+    if ([[FAEventClassification classificationForType:rawEventType ticker:nil] isPercentMove]) {
         eventDateString = @" ";
     }
     
@@ -3717,14 +3821,19 @@
 
 // Calculate how far the event is from today. Typical values are Past,Today, Tomorrow, 2d, 3d and so on.
 - (NSString *)calculateDistanceFromEventDate:(NSDate *)eventDate withEventType:(NSString *)rawEventType
+{
+    BOOL priceSelected = ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Price"] == NSOrderedSame);
+    
+    return [self calculateDistanceFromEventDate:eventDate withEventType:rawEventType priceTypeSelected:priceSelected];
+}
+
+// Calculate how far the event is from today, with the event type selector check passed in so that it can be called off the main thread.
+- (NSString *)calculateDistanceFromEventDate:(NSDate *)eventDate withEventType:(NSString *)rawEventType priceTypeSelected:(BOOL)priceSelected
 {
     NSString *formattedDistance = @"Details ▸";
     
     // Calculate the number of days between event date and today's date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSUInteger unitFlags =  NSCalendarUnitDay;
-    NSDateComponents *diffDateComponents = [aGregorianCalendar components:unitFlags fromDate:[self setTimeToMidnightLastNightOnDate:[NSDate date]] toDate:[self setTimeToMidnightLastNightOnDate:eventDate] options:0];
-    NSInteger difference = [diffDateComponents day];
+    NSInteger difference = [FADateCache localEpochDayForDate:eventDate] - [FADateCache localEpochDayForDate:[NSDate date]];
     
     // Return an appropriately formatted string
    /* if ((difference < 0)&&(difference > -2)) {
@@ -3775,7 +3884,7 @@
     
     
     // Return an appropriately formatted string. Show the ▸ when it's not a price event, else don't show that for price event as there is going to be no detail view for that.
-    if ([[self.eventTypeSelector titleForSegmentAtIndex:self.eventTypeSelector.selectedSegmentIndex] caseInsensitiveCompare:@"Price"] == NSOrderedSame) {
+    if (priceSelected) {
         if ((difference < 0)&&(difference > -2)) {
             formattedDistance = @"Yesterday";
         } else if ((difference <= -2)&&(difference > -4)) {
@@ -3799,7 +3908,7 @@
         } else {
             formattedDistance = [NSString stringWithFormat:@"%@d",[@(difference) stringValue]];
         }
-        if ([rawEventType containsString:@"% up"]||[rawEventType containsString:@"% down"]) {
+        if ([[FAEventClassification classificationForType:rawEventType ticker:nil] isPercentMove]) {
             formattedDistance = [NSString stringWithFormat:@"%@ ▸",formattedDistance];
         }
     } else {
@@ -3838,20 +3947,21 @@
     UIColor *colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
     
     // For % up and down events, go with the color green or red. For all others include the
-    if ([rawEventType containsString:@"% up"])
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:rawEventType ticker:nil];
+    if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         // Kinda Green
         //colorToReturn = [UIColor colorWithRed:56.0f/255.0f green:197.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
         colorToReturn = [UIColor colorWithRed:52.0f/255.0f green:181.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"% down"])
+    } else if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         // Kinda Red
         colorToReturn = [UIColor colorWithRed:255.0f/255.0f green:63.0f/255.0f blue:61.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"52 Week High"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         // Very lightish gray
         colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"52 Week Low"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         // Very lightish gray
         colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
@@ -3879,10 +3989,7 @@
     UIColor *colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
     
     // Calculate the number of days between event date and today's date
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSUInteger unitFlags =  NSCalendarUnitDay;
-    NSDateComponents *diffDateComponents = [aGregorianCalendar components:unitFlags fromDate:[self setTimeToMidnightLastNightOnDate:[NSDate date]] toDate:[self setTimeToMidnightLastNightOnDate:eventDate] options:0];
-    NSInteger difference = [diffDateComponents day];
+    NSInteger difference = [FADateCache localEpochDayForDate:eventDate] - [FADateCache localEpochDayForDate:[NSDate date]];
     
     // Return an appropriate color based on distance. Typical values and colors are Past(Light Gray Text),Today(Orangish Red), Tomorrow (Slightly less orangish red), 2d-7d (More orange, less red) and everything else (Light Gray).
     // Currently return only a single shade of red for near events.
@@ -3944,20 +4051,21 @@
     UIColor *colorToReturn = [UIColor colorWithRed:63.0f/255.0f green:63.0f/255.0f blue:63.0f/255.0f alpha:1.0f];
     
     // For % up and down events, go with the color green or red. For all others include the
-    if ([rawEventType containsString:@"% up"])
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:rawEventType ticker:nil];
+    if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         // Kinda Green
         //colorToReturn = [UIColor colorWithRed:56.0f/255.0f green:197.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
         colorToReturn = [UIColor colorWithRed:52.0f/255.0f green:181.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"% down"])
+    } else if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         // Kinda Red
         colorToReturn = [UIColor colorWithRed:255.0f/255.0f green:63.0f/255.0f blue:61.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"52 Week High"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         // Very lightish gray
         colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
-    } else if ([rawEventType containsString:@"52 Week Low"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         // Very lightish gray
         colorToReturn = [UIColor colorWithRed:150.0f/255.0f green:150.0f/255.0f blue:150.0f/255.0f alpha:1.0f];
@@ -4100,19 +4208,20 @@
     UIColor *colorToReturn = [UIColor colorWithRed:63.0f/255.0f green:63.0f/255.0f blue:63.0f/255.0f alpha:1.0f];
     
     // For % up and down events, go with the color green or red. For all others include the
-    if ([eventType containsString:@"% up"])
+    FAEventClassification *eventClassification = [FAEventClassification classificationForType:eventType ticker:nil];
+    if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         // Kinda Green
         //colorToReturn = [UIColor colorWithRed:56.0f/255.0f green:197.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
         colorToReturn = [UIColor colorWithRed:52.0f/255.0f green:181.0f/255.0f blue:4.0f/255.0f alpha:1.0f];
-    } else if ([eventType containsString:@"% down"])
+    } else if ([eventClassification isPercentMove]&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         // Kinda Red
         colorToReturn = [UIColor colorWithRed:255.0f/255.0f green:63.0f/255.0f blue:61.0f/255.0f alpha:1.0f];
-    } else if ([eventType containsString:@"52 Week High"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionUp))
     {
         colorToReturn = [UIColor whiteColor];
-    } else if ([eventType containsString:@"52 Week Low"])
+    } else if ((eventClassification.kind == FAEventKind52WeekHighLow)&&(eventClassification.direction == FAPriceMoveDirectionDown))
     {
         colorToReturn = [UIColor whiteColor];
     } else {
@@ -4127,11 +4236,7 @@
 // Format the given date to set the time on it to midnight last night. e.g. 03/21/2016 9:00 pm becomes 03/21/2016 12:00 am.
 - (NSDate *)setTimeToMidnightLastNightOnDate:(NSDate *)dateToFormat
 {
-    NSCalendar *aGregorianCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
-    NSDateComponents *dateComponents = [aGregorianCalendar components:(NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay) fromDate:dateToFormat];
-    NSDate *formattedDate = [aGregorianCalendar dateFromComponents:dateComponents];
-    
-    return formattedDate;
+    return [FADateCache dateForEpochDay:[FADateCache localEpochDayForDate:dateToFormat]];
 }
 
 // Format the current price and change string appropriately
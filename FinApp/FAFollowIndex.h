@@ -0,0 +1,48 @@
+//
+//  FAFollowIndex.h
+//  FinApp
+//
+//  Class that keeps an in memory index of what's being followed, so that checking if a
+//  ticker or an event is followed doesn't have to fetch actions from the data store each
+//  time. A ticker is followed if any of it's events has an "OSReminder" or "PriceChange"
+//  action. An event is followed if it has an "OSReminder" action, and an econ event type
+//  e.g. Feb US Jobs Report is followed if any event of that type has one. The index is built
+//  from the data store the first time it's needed and kept up to date by the data controller
+//  as actions are inserted and deleted.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@interface FAFollowIndex : NSObject
+
+// Create and/or return the single shared follow index
++ (FAFollowIndex *)sharedIndex;
+
+// Build the index from the actions in the data store, if it hasn't been built already. Can be called from any thread.
+- (void)buildIfNeeded;
+
+// Check if the ticker is being followed i.e. any of it's events has an "OSReminder" or "PriceChange" action.
+- (BOOL)isTickerFollowed:(NSString *)ticker;
+
+// Check if the event, given the company ticker and event type, has an "OSReminder" action. The event type is matched ignoring case.
+- (BOOL)hasReminderForEventWithTicker:(NSString *)ticker eventType:(NSString *)eventType;
+
+// Check if any event of the given full event type (e.g. Feb US Jobs Report) has an "OSReminder" action. The event type is matched ignoring case.
+- (BOOL)hasReminderForEventType:(NSString *)eventType;
+
+// Record that an action of the given type was saved for the event given by the company ticker and event type.
+- (void)addActionOfType:(NSString *)actionType eventTicker:(NSString *)ticker eventType:(NSString *)eventType;
+
+// Record that an action of the given type was deleted for the event given by the company ticker and event type.
+- (void)removeActionOfType:(NSString *)actionType eventTicker:(NSString *)ticker eventType:(NSString *)eventType;
+
+// Record that all actions were deleted.
+- (void)removeAllActions;
+
+// Drop the index so that it's built again from the data store the next time it's needed. Used when actions are deleted in the store directly.
+- (void)reset;
+
+@end
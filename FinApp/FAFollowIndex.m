@@ -0,0 +1,254 @@
+//
+//  FAFollowIndex.m
+//  FinApp
+//
+//  Class that keeps an in memory index of what's being followed, so that checking if a
+//  ticker or an event is followed doesn't have to fetch actions from the data store each
+//  time. A ticker is followed if any of it's events has an "OSReminder" or "PriceChange"
+//  action. An event is followed if it has an "OSReminder" action, and an econ event type
+//  e.g. Feb US Jobs Report is followed if any event of that type has one. The index is built
+//  from the data store the first time it's needed and kept up to date by the data controller
+//  as actions are inserted and deleted.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAFollowIndex.h"
+#import <CoreData/CoreData.h>
+#import "FADataStore.h"
+
+// Types of actions that mean an event is being followed
+static NSString * const FAFollowReminderActionType = @"OSReminder";
+static NSString * const FAFollowPriceChangeActionType = @"PriceChange";
+
+@interface FAFollowIndex ()
+
+// Has the index been built from the data store yet
+@property (nonatomic) BOOL built;
+
+// Follow entries for each ticker, keyed by ticker key (uppercased ticker). An entry is the action type and the lowercased event type, separated by
+// a newline, for each followed event of the ticker. A ticker with no entries is removed, so a ticker is followed if it has a key here.
+@property (strong, nonatomic) NSMutableDictionary *followEntriesByTicker;
+
+// Lowercased event types that have an "OSReminder" action, counted once for each ticker that has one for that type.
+@property (strong, nonatomic) NSCountedSet *remindedEventTypes;
+
+// Get the action type as one of the types that mean following, or nil if it isn't one of them.
+- (NSString *)followActionTypeForActionType:(NSString *)actionType;
+
+// Add a follow entry to the index. Must be called with the index locked.
+- (void)addEntryForActionType:(NSString *)actionType tickerKey:(NSString *)tickerKey eventType:(NSString *)eventType;
+
+@end
+
+@implementation FAFollowIndex
+
+static FAFollowIndex *sharedInstance;
+
+// Implement this class as a Singleton so that there's a single index kept up to date for the whole app.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a follow index doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FAFollowIndex alloc] init];
+    }
+}
+
+// Create and/or return the single shared follow index
++ (FAFollowIndex *)sharedIndex {
+
+    return sharedInstance;
+}
+
+// Set up an empty index.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.followEntriesByTicker = [[NSMutableDictionary alloc] init];
+        self.remindedEventTypes = [[NSCountedSet alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Building and Updating
+
+// Build the index from the actions in the data store, if it hasn't been built already. Can be called from any thread.
+- (void)buildIfNeeded
+{
+    @synchronized(self) {
+
+        if (self.built) {
+            return;
+        }
+
+        // Get just the type of each following action and the ticker key and type of it's event, without creating managed objects for them
+        NSManagedObjectContext *buildContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+        [buildContext setParentContext:[[FADataStore sharedStore] writerContext]];
+        [buildContext performBlockAndWait:^{
+
+            NSFetchRequest *actionFetchRequest = [[NSFetchRequest alloc] init];
+            NSEntityDescription *actionEntity = [NSEntityDescription entityForName:@"Action" inManagedObjectContext:buildContext];
+            [actionFetchRequest setEntity:actionEntity];
+            [actionFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"(type =[c] %@ OR type =[c] %@) AND parentEvent != nil", FAFollowReminderActionType, FAFollowPriceChangeActionType]];
+            [actionFetchRequest setPropertiesToFetch:@[@"type", @"parentEvent.tickerKey", @"parentEvent.type"]];
+            [actionFetchRequest setResultType:NSDictionaryResultType];
+            NSError *error;
+            NSArray *fetchedActions = [buildContext executeFetchRequest:actionFetchRequest error:&error];
+            if (error) {
+                NSLog(@"ERROR: Getting all following actions from data store, to build the follow index, failed: %@",error.description);
+                return;
+            }
+
+            for (NSDictionary *fetchedAction in fetchedActions) {
+                [self addEntryForActionType:[self followActionTypeForActionType:[fetchedAction objectForKey:@"type"]] tickerKey:[fetchedAction objectForKey:@"parentEvent.tickerKey"] eventType:[fetchedAction objectForKey:@"parentEvent.type"]];
+            }
+            self.built = YES;
+        }];
+    }
+}
+
+// Record that an action of the given type was saved for the event given by the company ticker and event type.
+- (void)addActionOfType:(NSString *)actionType eventTicker:(NSString *)ticker eventType:(NSString *)eventType
+{
+    @synchronized(self) {
+
+        // If the index hasn't been built yet, this action will be picked up when it is
+        if (!self.built) {
+            return;
+        }
+
+        [self addEntryForActionType:[self followActionTypeForActionType:actionType] tickerKey:[ticker uppercaseString] eventType:eventType];
+    }
+}
+
+// Record that an action of the given type was deleted for the event given by the company ticker and event type.
+- (void)removeActionOfType:(NSString *)actionType eventTicker:(NSString *)ticker eventType:(NSString *)eventType
+{
+    NSString *followActionType = [self followActionTypeForActionType:actionType];
+    NSString *tickerKey = [ticker uppercaseString];
+    if (followActionType == nil || tickerKey == nil || eventType == nil) {
+        return;
+    }
+
+    @synchronized(self) {
+
+        NSMutableSet *followEntries = [self.followEntriesByTicker objectForKey:tickerKey];
+        NSString *followEntry = [NSString stringWithFormat:@"%@\n%@", followActionType, [eventType lowercaseString]];
+        if (![followEntries containsObject:followEntry]) {
+            return;
+        }
+
+        [followEntries removeObject:followEntry];
+        if (followEntries.count == 0) {
+            [self.followEntriesByTicker removeObjectForKey:tickerKey];
+        }
+        if ([followActionType isEqualToString:FAFollowReminderActionType]) {
+            [self.remindedEventTypes removeObject:[eventType lowercaseString]];
+        }
+    }
+}
+
+// Record that all actions were deleted.
+- (void)removeAllActions
+{
+    @synchronized(self) {
+        [self.followEntriesByTicker removeAllObjects];
+        [self.remindedEventTypes removeAllObjects];
+    }
+}
+
+// Drop the index so that it's built again from the data store the next time it's needed. Used when actions are deleted in the store directly.
+- (void)reset
+{
+    @synchronized(self) {
+        [self.followEntriesByTicker removeAllObjects];
+        [self.remindedEventTypes removeAllObjects];
+        self.built = NO;
+    }
+}
+
+// Add a follow entry to the index. Must be called with the index locked.
+- (void)addEntryForActionType:(NSString *)actionType tickerKey:(NSString *)tickerKey eventType:(NSString *)eventType
+{
+    if (actionType == nil || tickerKey == nil || eventType == nil) {
+        return;
+    }
+
+    NSMutableSet *followEntries = [self.followEntriesByTicker objectForKey:tickerKey];
+    if (followEntries == nil) {
+        followEntries = [[NSMutableSet alloc] init];
+        [self.followEntriesByTicker setObject:followEntries forKey:tickerKey];
+    }
+
+    // The same action more than once for an event only counts once
+    NSString *followEntry = [NSString stringWithFormat:@"%@\n%@", actionType, [eventType lowercaseString]];
+    if ([followEntries containsObject:followEntry]) {
+        return;
+    }
+
+    [followEntries addObject:followEntry];
+    if ([actionType isEqualToString:FAFollowReminderActionType]) {
+        [self.remindedEventTypes addObject:[eventType lowercaseString]];
+    }
+}
+
+// Get the action type as one of the types that mean following, or nil if it isn't one of them.
+- (NSString *)followActionTypeForActionType:(NSString *)actionType
+{
+    if ([actionType caseInsensitiveCompare:FAFollowReminderActionType] == NSOrderedSame) {
+        return FAFollowReminderActionType;
+    }
+    if ([actionType caseInsensitiveCompare:FAFollowPriceChangeActionType] == NSOrderedSame) {
+        return FAFollowPriceChangeActionType;
+    }
+    return nil;
+}
+
+#pragma mark - Lookups
+
+// Check if the ticker is being followed i.e. any of it's events has an "OSReminder" or "PriceChange" action.
+- (BOOL)isTickerFollowed:(NSString *)ticker
+{
+    [self buildIfNeeded];
+
+    @synchronized(self) {
+        return ([self.followEntriesByTicker objectForKey:[ticker uppercaseString]] != nil);
+    }
+}
+
+// Check if the event, given the company ticker and event type, has an "OSReminder" action. The event type is matched ignoring case.
+- (BOOL)hasReminderForEventWithTicker:(NSString *)ticker eventType:(NSString *)eventType
+{
+    if (ticker == nil || eventType == nil) {
+        return NO;
+    }
+
+    [self buildIfNeeded];
+
+    @synchronized(self) {
+        NSString *followEntry = [NSString stringWithFormat:@"%@\n%@", FAFollowReminderActionType, [eventType lowercaseString]];
+        return [[self.followEntriesByTicker objectForKey:[ticker uppercaseString]] containsObject:followEntry];
+    }
+}
+
+// Check if any event of the given full event type (e.g. Feb US Jobs Report) has an "OSReminder" action. The event type is matched ignoring case.
+- (BOOL)hasReminderForEventType:(NSString *)eventType
+{
+    if (eventType == nil) {
+        return NO;
+    }
+
+    [self buildIfNeeded];
+
+    @synchronized(self) {
+        return ([self.remindedEventTypes countForObject:[eventType lowercaseString]] > 0);
+    }
+}
+
+@end
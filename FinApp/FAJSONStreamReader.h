@@ -0,0 +1,43 @@
+//
+//  FAJSONStreamReader.h
+//  FinApp
+//
+//  Class that reads JSON in a single forward pass over the raw bytes, without first
+//  materializing the whole response into dictionaries and arrays. Only the records at
+//  a given key path, and only the requested fields of each record, are turned into
+//  objects. Everything else is skipped over in place. Memory used by a read is thus
+//  bounded by the size of a single record, not the size of the response.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Error domain for JSON that can't be read
+extern NSString * const FAJSONStreamReaderErrorDomain;
+
+// Block called for each record read. The record contains only the requested fields that were present. Set stop to YES to stop reading further.
+typedef void (^FAJSONRecordHandler)(NSDictionary *record, BOOL *stop);
+
+@interface FAJSONStreamReader : NSObject
+
+// Create a reader over the given JSON data
+- (instancetype)initWithData:(NSData *)jsonData;
+
+// Create a reader over the JSON file at the given path. The file is memory mapped, instead of read in, when possible.
++ (FAJSONStreamReader *)readerWithContentsOfFile:(NSString *)filePath error:(NSError **)error;
+
+// Read the array at the record key path e.g. @"dataset.data", calling the handler with each element of it. For elements that are objects the fields are keys
+// e.g. @"ticker", for elements that are arrays the fields are positions e.g. @0. Values of requested fields are read in full, all other values are skipped.
+// Scalar or small values outside the records can be picked up in the same pass by passing their key paths e.g. @"meta.total_pages" in valuePaths. They are
+// returned in foundValues keyed by path. Returns NO and sets error if the JSON is malformed. If the record path is not an array in the JSON, no records are read.
+- (BOOL)enumerateRecordsAtPath:(NSString *)recordPath fields:(NSArray *)fields valuesAtPaths:(NSArray *)valuePaths foundValues:(NSDictionary **)foundValues error:(NSError **)error usingBlock:(FAJSONRecordHandler)handler;
+
+// Same as above, without any values outside the records.
+- (BOOL)enumerateRecordsAtPath:(NSString *)recordPath fields:(NSArray *)fields error:(NSError **)error usingBlock:(FAJSONRecordHandler)handler;
+
+// Whether the last read found an array at the record path. Lets a response with no records be told apart from one where the records are missing altogether.
+@property (nonatomic, readonly) BOOL recordsFound;
+
+@end
@@ -0,0 +1,811 @@
+//
+//  FAJSONStreamReader.m
+//  FinApp
+//
+//  Class that reads JSON in a single forward pass over the raw bytes, without first
+//  materializing the whole response into dictionaries and arrays. Only the records at
+//  a given key path, and only the requested fields of each record, are turned into
+//  objects. Everything else is skipped over in place. Memory used by a read is thus
+//  bounded by the size of a single record, not the size of the response.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAJSONStreamReader.h"
+#import "FATrace.h"
+
+NSString * const FAJSONStreamReaderErrorDomain = @"FAJSONStreamReaderErrorDomain";
+
+@interface FAJSONStreamReader () {
+    // Raw bytes of the JSON and the position of the next byte to read
+    const uint8_t *_bytes;
+    NSUInteger _length;
+    NSUInteger _position;
+    // Set when the record handler asks to stop reading
+    BOOL _stopped;
+    // Set when the JSON is malformed
+    NSError *_readError;
+    // Time spent in the record handler during a traced read, in mach absolute time units, and the number of records handed to it
+    uint64_t _handlerTime;
+    int64_t _recordsRead;
+}
+
+// JSON data being read. Held on to so that the raw bytes stay valid.
+@property (strong, nonatomic) NSData *jsonData;
+
+// Key path of the records being read, split into it's keys
+@property (strong, nonatomic) NSArray *recordPathKeys;
+
+// Key paths of the values outside the records being read, split into their keys
+@property (strong, nonatomic) NSArray *valuePathsKeys;
+
+// Requested fields of object records as UTF8 data, for matching against raw keys without creating strings for them
+@property (strong, nonatomic) NSArray *recordFieldKeys;
+@property (strong, nonatomic) NSArray *recordFieldKeysData;
+
+// Requested fields of array records, as positions
+@property (strong, nonatomic) NSMutableIndexSet *recordFieldPositions;
+
+// Whether the last read found an array at the record path
+@property (nonatomic, readwrite) BOOL recordsFound;
+
+// Handler to call with each record
+@property (copy, nonatomic) FAJSONRecordHandler recordHandler;
+
+// Values outside the records that have been found, keyed by their key path
+@property (strong, nonatomic) NSMutableDictionary *valuesFound;
+
+// Skip whitespace before the next token
+- (void)skipWhitespace;
+
+// Record that the JSON is malformed at the current position, with the given reason. Always returns NO.
+- (BOOL)failWithReason:(NSString *)reason;
+
+// Scan past the string starting at the current position, returning the range of it's contents, without the quotes, and whether it has any escapes.
+- (BOOL)scanStringWithRange:(NSRange *)contentRange hasEscapes:(BOOL *)hasEscapes;
+
+// Create a string from the contents of a scanned string, decoding any escapes.
+- (NSString *)stringWithContentsInRange:(NSRange)contentRange hasEscapes:(BOOL)hasEscapes;
+
+// Skip over the value starting at the current position without creating any objects for it.
+- (BOOL)skipValue;
+
+// Read the value starting at the current position, in full, into the same objects that NSJSONSerialization would create.
+- (id)readValue;
+
+// Read the number starting at the current position
+- (NSNumber *)readNumber;
+
+// Walk the value at the current position, which is at the given key path, reading any records or values at or under it and skipping the rest.
+- (BOOL)walkValueAtPath:(NSMutableArray *)currentPath;
+
+// Read the records in the array at the current position, calling the record handler with each one.
+- (BOOL)readRecords;
+
+// Read the requested fields of the object or array record at the current position.
+- (NSDictionary *)readRecord;
+
+@end
+
+@implementation FAJSONStreamReader
+
+#pragma mark - Initialization
+
+// Create a reader over the given JSON data
+- (instancetype)initWithData:(NSData *)jsonData
+{
+    self = [super init];
+    if (self) {
+        self.jsonData = jsonData;
+        _bytes = (const uint8_t *)[jsonData bytes];
+        _length = [jsonData length];
+    }
+    return self;
+}
+
+// Create a reader over the JSON file at the given path. The file is memory mapped, instead of read in, when possible.
++ (FAJSONStreamReader *)readerWithContentsOfFile:(NSString *)filePath error:(NSError **)error
+{
+    NSData *fileData = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:error];
+    if (fileData == nil) {
+        return nil;
+    }
+    return [[FAJSONStreamReader alloc] initWithData:fileData];
+}
+
+#pragma mark - Reading Records
+
+// Same as below, without any values outside the records.
+- (BOOL)enumerateRecordsAtPath:(NSString *)recordPath fields:(NSArray *)fields error:(NSError **)error usingBlock:(FAJSONRecordHandler)handler
+{
+    return [self enumerateRecordsAtPath:recordPath fields:fields valuesAtPaths:nil foundValues:NULL error:error usingBlock:handler];
+}
+
+// Read the array at the record key path, calling the handler with each element of it, and pick up any values at the value key paths in the same pass.
+- (BOOL)enumerateRecordsAtPath:(NSString *)recordPath fields:(NSArray *)fields valuesAtPaths:(NSArray *)valuePaths foundValues:(NSDictionary **)foundValues error:(NSError **)error usingBlock:(FAJSONRecordHandler)handler
+{
+    // Split the key paths into their keys
+    self.recordPathKeys = [recordPath componentsSeparatedByString:@"."];
+    NSMutableArray *valuePathsKeys = [[NSMutableArray alloc] init];
+    for (NSString *valuePath in valuePaths) {
+        [valuePathsKeys addObject:[valuePath componentsSeparatedByString:@"."]];
+    }
+    self.valuePathsKeys = valuePathsKeys;
+
+    // Split the fields into keys, for object records, and positions, for array records
+    NSMutableArray *recordFieldKeys = [[NSMutableArray alloc] init];
+    NSMutableArray *recordFieldKeysData = [[NSMutableArray alloc] init];
+    self.recordFieldPositions = [[NSMutableIndexSet alloc] init];
+    for (id field in fields) {
+        if ([field isKindOfClass:[NSString class]]) {
+            [recordFieldKeys addObject:field];
+            [recordFieldKeysData addObject:[field dataUsingEncoding:NSUTF8StringEncoding]];
+        } else if ([field isKindOfClass:[NSNumber class]]) {
+            [self.recordFieldPositions addIndex:[field unsignedIntegerValue]];
+        }
+    }
+    self.recordFieldKeys = recordFieldKeys;
+    self.recordFieldKeysData = recordFieldKeysData;
+
+    self.recordHandler = handler;
+    self.valuesFound = [[NSMutableDictionary alloc] init];
+    self.recordsFound = NO;
+    _position = 0;
+    _stopped = NO;
+    _readError = nil;
+    _handlerTime = 0;
+    _recordsRead = 0;
+    uint64_t spanStart = FATraceBegin();
+
+    // Skip the UTF8 byte order mark, if there is one
+    if ((_length >= 3)&&(_bytes[0] == 0xEF)&&(_bytes[1] == 0xBB)&&(_bytes[2] == 0xBF)) {
+        _position = 3;
+    }
+
+    BOOL readOk = NO;
+    [self skipWhitespace];
+    if (_position >= _length) {
+        readOk = [self failWithReason:@"No JSON value"];
+    } else {
+        readOk = [self walkValueAtPath:[[NSMutableArray alloc] init]];
+    }
+
+    if (foundValues) {
+        *foundValues = [self.valuesFound copy];
+    }
+    if (error) {
+        *error = readOk ? nil : _readError;
+    }
+
+    // Don't hold on to the handler, and anything it captured, past the read
+    self.recordHandler = nil;
+    self.valuesFound = nil;
+
+    // Time only the parsing, not what the handler does with the records, by moving the start of the span forward by the time spent in the handler
+    if (spanStart != 0) {
+        FATraceEnd(FATraceSpanJSONParse, spanStart + _handlerTime);
+        FATraceCount(FATraceCounterParsedRecords, _recordsRead);
+    }
+
+    return readOk;
+}
+
+// Walk the value at the current position, which is at the given key path, reading any records or values at or under it and skipping the rest.
+- (BOOL)walkValueAtPath:(NSMutableArray *)currentPath
+{
+    [self skipWhitespace];
+    if (_position >= _length) {
+        return [self failWithReason:@"Unexpected end of JSON"];
+    }
+
+    // If this is the record path, read the records
+    if ([currentPath isEqualToArray:self.recordPathKeys]) {
+        if (_bytes[_position] == '[') {
+            self.recordsFound = YES;
+            return [self readRecords];
+        }
+        return [self skipValue];
+    }
+
+    // If this is one of the value paths, read the value in full
+    BOOL underRequestedPath = NO;
+    for (NSArray *valuePathKeys in self.valuePathsKeys) {
+        if ([currentPath isEqualToArray:valuePathKeys]) {
+            id value = [self readValue];
+            if (value == nil) {
+                return NO;
+            }
+            [self.valuesFound setObject:value forKey:[currentPath componentsJoinedByString:@"."]];
+            return YES;
+        }
+        if ((currentPath.count < valuePathKeys.count)&&[currentPath isEqualToArray:[valuePathKeys subarrayWithRange:NSMakeRange(0, currentPath.count)]]) {
+            underRequestedPath = YES;
+        }
+    }
+    if ((currentPath.count < self.recordPathKeys.count)&&[currentPath isEqualToArray:[self.recordPathKeys subarrayWithRange:NSMakeRange(0, currentPath.count)]]) {
+        underRequestedPath = YES;
+    }
+
+    // If a record or value path is under this object, walk down it's keys. Otherwise skip it.
+    if (!underRequestedPath||(_bytes[_position] != '{')) {
+        return [self skipValue];
+    }
+
+    ++_position;
+    [self skipWhitespace];
+    if ((_position < _length)&&(_bytes[_position] == '}')) {
+        ++_position;
+        return YES;
+    }
+    while (!_stopped) {
+
+        // Read the key
+        [self skipWhitespace];
+        NSRange keyRange;
+        BOOL keyHasEscapes = NO;
+        if (![self scanStringWithRange:&keyRange hasEscapes:&keyHasEscapes]) {
+            return NO;
+        }
+        NSString *key = [self stringWithContentsInRange:keyRange hasEscapes:keyHasEscapes];
+        if (key == nil) {
+            return [self failWithReason:@"Invalid UTF8 in object key"];
+        }
+        [self skipWhitespace];
+        if ((_position >= _length)||(_bytes[_position] != ':')) {
+            return [self failWithReason:@"Expected : after object key"];
+        }
+        ++_position;
+
+        // Walk it's value
+        [currentPath addObject:key];
+        BOOL walkOk = [self walkValueAtPath:currentPath];
+        [currentPath removeLastObject];
+        if (!walkOk) {
+            return NO;
+        }
+        if (_stopped) {
+            break;
+        }
+
+        // Move on to the next key, if there is one
+        [self skipWhitespace];
+        if (_position >= _length) {
+            return [self failWithReason:@"Unexpected end of JSON in object"];
+        }
+        if (_bytes[_position] == ',') {
+            ++_position;
+        } else if (_bytes[_position] == '}') {
+            ++_position;
+            break;
+        } else {
+            return [self failWithReason:@"Expected , or } in object"];
+        }
+    }
+
+    return YES;
+}
+
+// Read the records in the array at the current position, calling the record handler with each one.
+- (BOOL)readRecords
+{
+    ++_position;
+    [self skipWhitespace];
+    if ((_position < _length)&&(_bytes[_position] == ']')) {
+        ++_position;
+        return YES;
+    }
+    while (YES) {
+
+        [self skipWhitespace];
+        if (_position >= _length) {
+            return [self failWithReason:@"Unexpected end of JSON in array"];
+        }
+
+        // Objects created for a record, including any the handler creates, are released before the next one is read.
+        @autoreleasepool {
+            if ((_bytes[_position] == '{')||(_bytes[_position] == '[')) {
+                NSDictionary *record = [self readRecord];
+                if (record == nil) {
+                    return NO;
+                }
+                BOOL stop = NO;
+                if (self.recordHandler) {
+                    uint64_t handlerStart = FATraceBegin();
+                    self.recordHandler(record, &stop);
+                    if (handlerStart != 0) {
+                        _handlerTime += mach_absolute_time() - handlerStart;
+                        _recordsRead++;
+                    }
+                }
+                if (stop) {
+                    _stopped = YES;
+                    return YES;
+                }
+            } else if (![self skipValue]) {
+                return NO;
+            }
+        }
+
+        // Move on to the next record, if there is one
+        [self skipWhitespace];
+        if (_position >= _length) {
+            return [self failWithReason:@"Unexpected end of JSON in array"];
+        }
+        if (_bytes[_position] == ',') {
+            ++_position;
+        } else if (_bytes[_position] == ']') {
+            ++_position;
+            return YES;
+        } else {
+            return [self failWithReason:@"Expected , or ] in array"];
+        }
+    }
+}
+
+// Read the requested fields of the object or array record at the current position.
+- (NSDictionary *)readRecord
+{
+    NSMutableDictionary *record = [[NSMutableDictionary alloc] init];
+
+    // Array record: read the elements at the requested positions
+    if (_bytes[_position] == '[') {
+
+        ++_position;
+        [self skipWhitespace];
+        if ((_position < _length)&&(_bytes[_position] == ']')) {
+            ++_position;
+            return record;
+        }
+        NSUInteger elementPosition = 0;
+        while (YES) {
+            if ([self.recordFieldPositions containsIndex:elementPosition]) {
+                id value = [self readValue];
+                if (value == nil) {
+                    return nil;
+                }
+                [record setObject:value forKey:[NSNumber numberWithUnsignedInteger:elementPosition]];
+            } else if (![self skipValue]) {
+                return nil;
+            }
+            ++elementPosition;
+
+            [self skipWhitespace];
+            if (_position >= _length) {
+                [self failWithReason:@"Unexpected end of JSON in array"];
+                return nil;
+            }
+            if (_bytes[_position] == ',') {
+                ++_position;
+            } else if (_bytes[_position] == ']') {
+                ++_position;
+                return record;
+            } else {
+                [self failWithReason:@"Expected , or ] in array"];
+                return nil;
+            }
+        }
+    }
+
+    // Object record: read the values of the requested keys, matching the raw key bytes so no strings are created for the other keys
+    ++_position;
+    [self skipWhitespace];
+    if ((_position < _length)&&(_bytes[_position] == '}')) {
+        ++_position;
+        return record;
+    }
+    while (YES) {
+
+        [self skipWhitespace];
+        NSRange keyRange;
+        BOOL keyHasEscapes = NO;
+        if (![self scanStringWithRange:&keyRange hasEscapes:&keyHasEscapes]) {
+            return nil;
+        }
+        NSString *requestedKey = nil;
+        if (keyHasEscapes) {
+            NSString *key = [self stringWithContentsInRange:keyRange hasEscapes:keyHasEscapes];
+            if (key == nil) {
+                [self failWithReason:@"Invalid UTF8 in object key"];
+                return nil;
+            }
+            if ([self.recordFieldKeys containsObject:key]) {
+                requestedKey = key;
+            }
+        } else {
+            for (NSUInteger i = 0; i < self.recordFieldKeysData.count; i++) {
+                NSData *fieldKeyData = [self.recordFieldKeysData objectAtIndex:i];
+                if ((fieldKeyData.length == keyRange.length)&&(memcmp(fieldKeyData.bytes, (_bytes + keyRange.location), keyRange.length) == 0)) {
+                    requestedKey = [self.recordFieldKeys objectAtIndex:i];
+                    break;
+                }
+            }
+        }
+
+        [self skipWhitespace];
+        if ((_position >= _length)||(_bytes[_position] != ':')) {
+            [self failWithReason:@"Expected : after object key"];
+            return nil;
+        }
+        ++_position;
+
+        if (requestedKey) {
+            id value = [self readValue];
+            if (value == nil) {
+                return nil;
+            }
+            [record setObject:value forKey:requestedKey];
+        } else if (![self skipValue]) {
+            return nil;
+        }
+
+        [self skipWhitespace];
+        if (_position >= _length) {
+            [self failWithReason:@"Unexpected end of JSON in object"];
+            return nil;
+        }
+        if (_bytes[_position] == ',') {
+            ++_position;
+        } else if (_bytes[_position] == '}') {
+            ++_position;
+            return record;
+        } else {
+            [self failWithReason:@"Expected , or } in object"];
+            return nil;
+        }
+    }
+}
+
+#pragma mark - Scanning Values
+
+// Skip whitespace before the next token
+- (void)skipWhitespace
+{
+    while (_position < _length) {
+        uint8_t byte = _bytes[_position];
+        if ((byte != ' ')&&(byte != '\n')&&(byte != '\r')&&(byte != '\t')) {
+            break;
+        }
+        ++_position;
+    }
+}
+
+// Record that the JSON is malformed at the current position, with the given reason. Always returns NO.
+- (BOOL)failWithReason:(NSString *)reason
+{
+    if (_readError == nil) {
+        NSString *description = [NSString stringWithFormat:@"%@ at byte %lu",reason,(unsigned long)_position];
+        _readError = [NSError errorWithDomain:FAJSONStreamReaderErrorDomain code:1 userInfo:@{NSLocalizedDescriptionKey:description}];
+    }
+    return NO;
+}
+
+// Scan past the string starting at the current position, returning the range of it's contents, without the quotes, and whether it has any escapes.
+- (BOOL)scanStringWithRange:(NSRange *)contentRange hasEscapes:(BOOL *)hasEscapes
+{
+    if ((_position >= _length)||(_bytes[_position] != '"')) {
+        return [self failWithReason:@"Expected string"];
+    }
+    ++_position;
+    NSUInteger contentStart = _position;
+    *hasEscapes = NO;
+    while (_position < _length) {
+        uint8_t byte = _bytes[_position];
+        if (byte == '"') {
+            *contentRange = NSMakeRange(contentStart, (_position - contentStart));
+            ++_position;
+            return YES;
+        }
+        if (byte == '\\') {
+            *hasEscapes = YES;
+            // Skip the escaped character, which may be a quote
+            ++_position;
+        }
+        ++_position;
+    }
+    return [self failWithReason:@"Unterminated string"];
+}
+
+// Create a string from the contents of a scanned string, decoding any escapes.
+- (NSString *)stringWithContentsInRange:(NSRange)contentRange hasEscapes:(BOOL)hasEscapes
+{
+    if (!hasEscapes) {
+        return [[NSString alloc] initWithBytes:(_bytes + contentRange.location) length:contentRange.length encoding:NSUTF8StringEncoding];
+    }
+
+    // Decode escapes into UTF8 bytes and make a string from those
+    NSMutableData *decodedBytes = [[NSMutableData alloc] initWithCapacity:contentRange.length];
+    NSUInteger i = contentRange.location;
+    NSUInteger contentEnd = NSMaxRange(contentRange);
+    while (i < contentEnd) {
+
+        // Copy the run of bytes up to the next escape as is
+        NSUInteger runStart = i;
+        while ((i < contentEnd)&&(_bytes[i] != '\\')) {
+            ++i;
+        }
+        [decodedBytes appendBytes:(_bytes + runStart) length:(i - runStart)];
+        if ((i + 1) >= contentEnd) {
+            break;
+        }
+
+        uint8_t escaped = _bytes[i + 1];
+        i += 2;
+        char simple = 0;
+        switch (escaped) {
+            case '"': simple = '"'; break;
+            case '\\': simple = '\\'; break;
+            case '/': simple = '/'; break;
+            case 'b': simple = '\b'; break;
+            case 'f': simple = '\f'; break;
+            case 'n': simple = '\n'; break;
+            case 'r': simple = '\r'; break;
+            case 't': simple = '\t'; break;
+            case 'u': {
+                // \uXXXX, which may be the first half of a surrogate pair
+                if ((i + 4) > contentEnd) {
+                    i = contentEnd;
+                    break;
+                }
+                char hex[5] = {0};
+                memcpy(hex, (_bytes + i), 4);
+                uint32_t codePoint = (uint32_t)strtoul(hex, NULL, 16);
+                i += 4;
+                if ((codePoint >= 0xD800)&&(codePoint <= 0xDBFF)&&((i + 6) <= contentEnd)&&(_bytes[i] == '\\')&&(_bytes[i + 1] == 'u')) {
+                    memcpy(hex, (_bytes + i + 2), 4);
+                    uint32_t lowSurrogate = (uint32_t)strtoul(hex, NULL, 16);
+                    if ((lowSurrogate >= 0xDC00)&&(lowSurrogate <= 0xDFFF)) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                        i += 6;
+                    }
+                }
+                uint8_t utf8[4];
+                NSUInteger utf8Length = 0;
+                if (codePoint < 0x80) {
+                    utf8[0] = (uint8_t)codePoint;
+                    utf8Length = 1;
+                } else if (codePoint < 0x800) {
+                    utf8[0] = (uint8_t)(0xC0 | (codePoint >> 6));
+                    utf8[1] = (uint8_t)(0x80 | (codePoint & 0x3F));
+                    utf8Length = 2;
+                } else if (codePoint < 0x10000) {
+                    utf8[0] = (uint8_t)(0xE0 | (codePoint >> 12));
+                    utf8[1] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+                    utf8[2] = (uint8_t)(0x80 | (codePoint & 0x3F));
+                    utf8Length = 3;
+                } else {
+                    utf8[0] = (uint8_t)(0xF0 | (codePoint >> 18));
+                    utf8[1] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+                    utf8[2] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+                    utf8[3] = (uint8_t)(0x80 | (codePoint & 0x3F));
+                    utf8Length = 4;
+                }
+                [decodedBytes appendBytes:utf8 length:utf8Length];
+                break;
+            }
+            default:
+                // Unknown escape, keep the escaped character as is
+                simple = (char)escaped;
+                break;
+        }
+        if (simple != 0) {
+            [decodedBytes appendBytes:&simple length:1];
+        }
+    }
+
+    return [[NSString alloc] initWithData:decodedBytes encoding:NSUTF8StringEncoding];
+}
+
+// Skip over the value starting at the current position without creating any objects for it. Nested objects and arrays are skipped by
+// matching brackets, so their contents are not checked for being well formed.
+- (BOOL)skipValue
+{
+    [self skipWhitespace];
+    if (_position >= _length) {
+        return [self failWithReason:@"Unexpected end of JSON"];
+    }
+
+    uint8_t byte = _bytes[_position];
+
+    if (byte == '"') {
+        NSRange contentRange;
+        BOOL hasEscapes = NO;
+        return [self scanStringWithRange:&contentRange hasEscapes:&hasEscapes];
+    }
+
+    if ((byte == '{')||(byte == '[')) {
+        NSUInteger depth = 0;
+        while (_position < _length) {
+            byte = _bytes[_position];
+            if (byte == '"') {
+                NSRange contentRange;
+                BOOL hasEscapes = NO;
+                if (![self scanStringWithRange:&contentRange hasEscapes:&hasEscapes]) {
+                    return NO;
+                }
+                continue;
+            }
+            if ((byte == '{')||(byte == '[')) {
+                ++depth;
+            } else if ((byte == '}')||(byte == ']')) {
+                --depth;
+                if (depth == 0) {
+                    ++_position;
+                    return YES;
+                }
+            }
+            ++_position;
+        }
+        return [self failWithReason:@"Unterminated object or array"];
+    }
+
+    // Number or literal: skip to the next delimiter
+    NSUInteger scalarStart = _position;
+    while (_position < _length) {
+        byte = _bytes[_position];
+        if ((byte == ',')||(byte == '}')||(byte == ']')||(byte == ' ')||(byte == '\n')||(byte == '\r')||(byte == '\t')) {
+            break;
+        }
+        ++_position;
+    }
+    if (_position == scalarStart) {
+        return [self failWithReason:@"Expected value"];
+    }
+    return YES;
+}
+
+// Read the value starting at the current position, in full, into the same objects that NSJSONSerialization would create.
+- (id)readValue
+{
+    [self skipWhitespace];
+    if (_position >= _length) {
+        [self failWithReason:@"Unexpected end of JSON"];
+        return nil;
+    }
+
+    uint8_t byte = _bytes[_position];
+
+    // String
+    if (byte == '"') {
+        NSRange contentRange;
+        BOOL hasEscapes = NO;
+        if (![self scanStringWithRange:&contentRange hasEscapes:&hasEscapes]) {
+            return nil;
+        }
+        NSString *value = [self stringWithContentsInRange:contentRange hasEscapes:hasEscapes];
+        if (value == nil) {
+            [self failWithReason:@"Invalid UTF8 in string"];
+        }
+        return value;
+    }
+
+    // Object
+    if (byte == '{') {
+        NSMutableDictionary *object = [[NSMutableDictionary alloc] init];
+        ++_position;
+        [self skipWhitespace];
+        if ((_position < _length)&&(_bytes[_position] == '}')) {
+            ++_position;
+            return object;
+        }
+        while (YES) {
+            [self skipWhitespace];
+            NSRange keyRange;
+            BOOL keyHasEscapes = NO;
+            if (![self scanStringWithRange:&keyRange hasEscapes:&keyHasEscapes]) {
+                return nil;
+            }
+            NSString *key = [self stringWithContentsInRange:keyRange hasEscapes:keyHasEscapes];
+            if (key == nil) {
+                [self failWithReason:@"Invalid UTF8 in object key"];
+                return nil;
+            }
+            [self skipWhitespace];
+            if ((_position >= _length)||(_bytes[_position] != ':')) {
+                [self failWithReason:@"Expected : after object key"];
+                return nil;
+            }
+            ++_position;
+            id value = [self readValue];
+            if (value == nil) {
+                return nil;
+            }
+            [object setObject:value forKey:key];
+            [self skipWhitespace];
+            if (_position >= _length) {
+                [self failWithReason:@"Unexpected end of JSON in object"];
+                return nil;
+            }
+            if (_bytes[_position] == ',') {
+                ++_position;
+            } else if (_bytes[_position] == '}') {
+                ++_position;
+                return object;
+            } else {
+                [self failWithReason:@"Expected , or } in object"];
+                return nil;
+            }
+        }
+    }
+
+    // Array
+    if (byte == '[') {
+        NSMutableArray *array = [[NSMutableArray alloc] init];
+        ++_position;
+        [self skipWhitespace];
+        if ((_position < _length)&&(_bytes[_position] == ']')) {
+            ++_position;
+            return array;
+        }
+        while (YES) {
+            id value = [self readValue];
+            if (value == nil) {
+                return nil;
+            }
+            [array addObject:value];
+            [self skipWhitespace];
+            if (_position >= _length) {
+                [self failWithReason:@"Unexpected end of JSON in array"];
+                return nil;
+            }
+            if (_bytes[_position] == ',') {
+                ++_position;
+            } else if (_bytes[_position] == ']') {
+                ++_position;
+                return array;
+            } else {
+                [self failWithReason:@"Expected , or ] in array"];
+                return nil;
+            }
+        }
+    }
+
+    // Literals
+    if ((byte == 't')&&((_position + 4) <= _length)&&(memcmp((_bytes + _position), "true", 4) == 0)) {
+        _position += 4;
+        return [NSNumber numberWithBool:YES];
+    }
+    if ((byte == 'f')&&((_position + 5) <= _length)&&(memcmp((_bytes + _position), "false", 5) == 0)) {
+        _position += 5;
+        return [NSNumber numberWithBool:NO];
+    }
+    if ((byte == 'n')&&((_position + 4) <= _length)&&(memcmp((_bytes + _position), "null", 4) == 0)) {
+        _position += 4;
+        return [NSNull null];
+    }
+
+    // Number
+    if ((byte == '-')||((byte >= '0')&&(byte <= '9'))) {
+        return [self readNumber];
+    }
+
+    [self failWithReason:@"Unexpected character"];
+    return nil;
+}
+
+// Read the number starting at the current position
+- (NSNumber *)readNumber
+{
+    // Numbers are short so copy the digits into a C string to convert
+    char digits[64];
+    NSUInteger digitCount = 0;
+    BOOL isFloatingPoint = NO;
+    while ((_position < _length)&&(digitCount < (sizeof(digits) - 1))) {
+        uint8_t byte = _bytes[_position];
+        if ((byte == '.')||(byte == 'e')||(byte == 'E')) {
+            isFloatingPoint = YES;
+        } else if (!((byte >= '0')&&(byte <= '9'))&&(byte != '-')&&(byte != '+')) {
+            break;
+        }
+        digits[digitCount++] = (char)byte;
+        ++_position;
+    }
+    digits[digitCount] = '\0';
+
+    if (isFloatingPoint) {
+        return [NSNumber numberWithDouble:strtod(digits, NULL)];
+    }
+    return [NSNumber numberWithLongLong:strtoll(digits, NULL, 10)];
+}
+
+@end
@@ -0,0 +1,50 @@
+//
+//  FALaunchScheduler.h
+//  FinApp
+//
+//  Class that runs the work done at launch in stages, so that the first frame isn't held
+//  up by work that can wait. First frame critical tasks run on the main thread, in the order
+//  they were added, when the scheduler is started. After first frame tasks run, in order, on
+//  a serial background queue once the first screen reports that it has rendered, or after a
+//  short timeout if it never does. Idle tasks run after those, on the same queue at background
+//  priority, once the main thread has gone idle. Also records the time from the process
+//  starting to the first events list being rendered.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Stages of launch, in the order they run
+typedef NS_ENUM(NSInteger, FALaunchStage) {
+    // Needed to show the first frame. Run on the main thread, before application:didFinishLaunchingWithOptions: returns.
+    FALaunchStageFirstFrameCritical = 0,
+    // Run in the background just after the first frame has rendered e.g. one time data migrations.
+    FALaunchStageAfterFirstFrame = 1,
+    // Run in the background, at low priority, once the main thread has gone idle after the first frame e.g. warming up indexes.
+    FALaunchStageIdle = 2
+};
+
+@interface FALaunchScheduler : NSObject
+
+// Create and/or return the single shared launch scheduler
++ (FALaunchScheduler *)sharedScheduler;
+
+// Seconds from the process starting to the first events list being rendered, or 0 if it hasn't been rendered yet.
+@property (nonatomic, readonly) NSTimeInterval timeToFirstEventsList;
+
+// Add a task to run in the given stage. Tasks in a stage run in the order they were added. A task added to a stage that has
+// already started runs as soon as it can in that stage. The name is used for logging.
+- (void)addTaskForStage:(FALaunchStage)stage named:(NSString *)taskName usingBlock:(void (^)(void))task;
+
+// Run the first frame critical tasks and get ready for the later stages. Call from application:didFinishLaunchingWithOptions:
+- (void)start;
+
+// Let the scheduler know that the first screen has rendered, so that the after first frame tasks can start. Only the first call counts.
+- (void)firstFrameDidRender;
+
+// Let the scheduler know that the events list has rendered, to record the time to the first events list. This also counts as the first frame.
+- (void)eventsListDidRender;
+
+@end
@@ -0,0 +1,232 @@
+//
+//  FALaunchScheduler.m
+//  FinApp
+//
+//  Class that runs the work done at launch in stages, so that the first frame isn't held
+//  up by work that can wait. First frame critical tasks run on the main thread, in the order
+//  they were added, when the scheduler is started. After first frame tasks run, in order, on
+//  a serial background queue once the first screen reports that it has rendered, or after a
+//  short timeout if it never does. Idle tasks run after those, on the same queue at background
+//  priority, once the main thread has gone idle. Also records the time from the process
+//  starting to the first events list being rendered.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FALaunchScheduler.h"
+#import "FATrace.h"
+#import <sys/sysctl.h>
+#import <unistd.h>
+
+// Seconds to wait for the first screen to report that it has rendered, before starting the after first frame tasks anyway
+static const NSTimeInterval FALaunchFirstFrameTimeout = 2.0;
+
+// Stage started before the scheduler is started
+static const NSInteger FALaunchStageNone = -1;
+
+@interface FALaunchScheduler ()
+
+// Seconds from the process starting to the first events list being rendered, or 0 if it hasn't been rendered yet.
+@property (nonatomic, readwrite) NSTimeInterval timeToFirstEventsList;
+
+// Tasks waiting for their stage to start, an array for each stage. Each task is an array of the name and the block.
+@property (strong, nonatomic) NSArray *pendingTasks;
+
+// Latest stage that has been started, or FALaunchStageNone
+@property (nonatomic) NSInteger startedStage;
+
+// Serial queue that the after first frame and idle tasks run on
+@property (strong, nonatomic) dispatch_queue_t launchQueue;
+
+// Start the stage, if it hasn't already been started, running the tasks waiting for it. Returns YES if the stage was started by this call.
+- (BOOL)startStage:(FALaunchStage)stage;
+
+// Run a task the way tasks in the given stage are run. Must be called with the scheduler locked so tasks in a stage stay in order.
+- (void)runTaskNamed:(NSString *)taskName inStage:(FALaunchStage)stage usingBlock:(void (^)(void))task;
+
+// Start the idle stage the next time the main run loop is about to wait for events.
+- (void)startIdleStageWhenMainThreadIsIdle;
+
+// Get the seconds since the process was started by the system, or 0 if that can't be found out.
++ (NSTimeInterval)secondsSinceProcessStart;
+
+@end
+
+@implementation FALaunchScheduler
+
+static FALaunchScheduler *sharedInstance;
+
+// Implement this class as a Singleton so that there's a single schedule of launch tasks for the whole app.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a launch scheduler doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FALaunchScheduler alloc] init];
+    }
+}
+
+// Create and/or return the single shared launch scheduler
++ (FALaunchScheduler *)sharedScheduler {
+
+    return sharedInstance;
+}
+
+// Set up with no tasks and no stage started.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.pendingTasks = @[[[NSMutableArray alloc] init], [[NSMutableArray alloc] init], [[NSMutableArray alloc] init]];
+        self.startedStage = FALaunchStageNone;
+        self.launchQueue = dispatch_queue_create("com.siddsingh.FinApp.launch", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+#pragma mark - Scheduling
+
+// Add a task to run in the given stage. Tasks in a stage run in the order they were added. A task added to a stage that has
+// already started runs as soon as it can in that stage. The name is used for logging.
+- (void)addTaskForStage:(FALaunchStage)stage named:(NSString *)taskName usingBlock:(void (^)(void))task
+{
+    if ((stage < FALaunchStageFirstFrameCritical) || (stage > FALaunchStageIdle) || (task == nil)) {
+        NSLog(@"ERROR: Could not add launch task %@ as the stage %ld or the task is not valid",taskName,(long)stage);
+        return;
+    }
+
+    @synchronized(self) {
+        if (self.startedStage < stage) {
+            [[self.pendingTasks objectAtIndex:stage] addObject:@[taskName, [task copy]]];
+        } else {
+            [self runTaskNamed:taskName inStage:stage usingBlock:task];
+        }
+    }
+}
+
+// Run the first frame critical tasks and get ready for the later stages. Call from application:didFinishLaunchingWithOptions:
+- (void)start
+{
+    [self startStage:FALaunchStageFirstFrameCritical];
+
+    // In case the first screen never reports that it has rendered
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(FALaunchFirstFrameTimeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self firstFrameDidRender];
+    });
+}
+
+// Let the scheduler know that the first screen has rendered, so that the after first frame tasks can start. Only the first call counts.
+- (void)firstFrameDidRender
+{
+    if ([self startStage:FALaunchStageAfterFirstFrame]) {
+        [self startIdleStageWhenMainThreadIsIdle];
+    }
+}
+
+// Let the scheduler know that the events list has rendered, to record the time to the first events list. This also counts as the first frame.
+- (void)eventsListDidRender
+{
+    @synchronized(self) {
+        if (self.timeToFirstEventsList == 0) {
+            self.timeToFirstEventsList = [FALaunchScheduler secondsSinceProcessStart];
+
+            // Record it as a span that started when the process did
+            if (FATraceEnabled && (self.timeToFirstEventsList > 0)) {
+                mach_timebase_info_data_t timebase;
+                mach_timebase_info(&timebase);
+                uint64_t launchDuration = (uint64_t)(self.timeToFirstEventsList * NSEC_PER_SEC) * timebase.denom / timebase.numer;
+                FATraceRecordSpan(FATraceSpanLaunch, (mach_absolute_time() - launchDuration));
+            }
+        }
+    }
+
+    [self firstFrameDidRender];
+}
+
+// Start the stage, if it hasn't already been started, running the tasks waiting for it. Returns YES if the stage was started by this call.
+- (BOOL)startStage:(FALaunchStage)stage
+{
+    @synchronized(self) {
+
+        // Stages start in order, so a later stage having started means this one has too
+        if (self.startedStage >= stage) {
+            return NO;
+        }
+        self.startedStage = stage;
+
+        NSMutableArray *stageTasks = [self.pendingTasks objectAtIndex:stage];
+        for (NSArray *stageTask in stageTasks) {
+            [self runTaskNamed:[stageTask objectAtIndex:0] inStage:stage usingBlock:[stageTask objectAtIndex:1]];
+        }
+        [stageTasks removeAllObjects];
+    }
+
+    return YES;
+}
+
+// Run a task the way tasks in the given stage are run. Must be called with the scheduler locked so tasks in a stage stay in order.
+- (void)runTaskNamed:(NSString *)taskName inStage:(FALaunchStage)stage usingBlock:(void (^)(void))task
+{
+    // When tracing, log how long each task takes, to see what's slowing down launch
+    void (^timedTask)(void) = ^{
+        CFAbsoluteTime taskStart = CFAbsoluteTimeGetCurrent();
+        task();
+        if (FATraceEnabled) {
+            NSLog(@"Launch task %@ in stage %ld took %.1f ms",taskName,(long)stage,((CFAbsoluteTimeGetCurrent() - taskStart) * 1000.0));
+        }
+    };
+
+    switch (stage) {
+        case FALaunchStageFirstFrameCritical:
+            if ([NSThread isMainThread]) {
+                timedTask();
+            } else {
+                dispatch_async(dispatch_get_main_queue(), timedTask);
+            }
+            break;
+
+        case FALaunchStageAfterFirstFrame:
+            dispatch_async(self.launchQueue, timedTask);
+            break;
+
+        case FALaunchStageIdle:
+            dispatch_async(self.launchQueue, dispatch_block_create_with_qos_class(DISPATCH_BLOCK_ENFORCE_QOS_CLASS, QOS_CLASS_BACKGROUND, 0, timedTask));
+            break;
+    }
+}
+
+// Start the idle stage the next time the main run loop is about to wait for events.
+- (void)startIdleStageWhenMainThreadIsIdle
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        CFRunLoopObserverRef idleObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, NO, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+            [self startStage:FALaunchStageIdle];
+        });
+        CFRunLoopAddObserver(CFRunLoopGetMain(), idleObserver, kCFRunLoopCommonModes);
+        CFRelease(idleObserver);
+    });
+}
+
+#pragma mark - Launch Time
+
+// Get the seconds since the process was started by the system, or 0 if that can't be found out.
++ (NSTimeInterval)secondsSinceProcessStart
+{
+    struct kinfo_proc processInfo;
+    size_t processInfoSize = sizeof(processInfo);
+    int processInfoQuery[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+    if (sysctl(processInfoQuery, 4, &processInfo, &processInfoSize, NULL, 0) != 0) {
+        NSLog(@"ERROR: Could not get the process start time to work out the launch time");
+        return 0;
+    }
+
+    struct timeval processStart = processInfo.kp_proc.p_starttime;
+    NSTimeInterval processStartTime = processStart.tv_sec + (processStart.tv_usec / 1000000.0);
+    return ([[NSDate date] timeIntervalSince1970] - processStartTime);
+}
+
+@end
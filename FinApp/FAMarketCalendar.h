@@ -0,0 +1,49 @@
+//
+//  FAMarketCalendar.h
+//  FinApp
+//
+//  Class that knows which days the US stock market (NYSE) is open. Works on epoch days,
+//  the number of days from 1970-01-01 (see FADateCache), so weekday checks and trading
+//  day lookups are integer math. Holidays come from a table, worked out once from the
+//  NYSE holiday rules plus one off closures, for the years it covers.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@interface FAMarketCalendar : NSObject
+
+// Get the day of the week for an epoch day, numbered the same way as NSCalendar i.e. 1 for Sunday through 7 for Saturday.
++ (NSInteger)weekdayForEpochDay:(int32_t)epochDay;
+
+// Is the epoch day a Saturday or Sunday.
++ (BOOL)isWeekendEpochDay:(int32_t)epochDay;
+
+// Is the epoch day a weekday on which the market is closed for a holiday or one off closure. Only known for the years covered by the holiday table, 1990 to 2099.
++ (BOOL)isHolidayEpochDay:(int32_t)epochDay;
+
+// Is the market open on the epoch day.
++ (BOOL)isTradingEpochDay:(int32_t)epochDay;
+
+// Get the first epoch day, on or after the given one, that the market is open.
++ (int32_t)tradingEpochDayOnOrAfter:(int32_t)epochDay;
+
+// Get the last epoch day, on or before the given one, that the market is open.
++ (int32_t)tradingEpochDayOnOrBefore:(int32_t)epochDay;
+
+// Get the epoch day of the first day the market is open in the year e.g. 2018-01-02 for 2018.
++ (int32_t)firstTradingEpochDayOfYear:(int32_t)year;
+
+// Get the date 30 days before the given one, at the same time of day. It could be a weekend or a holiday.
++ (NSDate *)dateThirtyDaysBeforeDate:(NSDate *)date;
+
+// Move a date that falls on a weekend or market holiday to a trading day, at the same time of day. Saturdays and holidays move back to the trading day
+// before e.g. Friday, and Sundays move forward to the trading day after e.g. Monday. Days are in the local time zone.
++ (NSDate *)tradingDayForDate:(NSDate *)date;
+
+// Get the first day the market is open in the year of the given date, at midnight e.g. Tue Jan 2nd for 2018.
++ (NSDate *)firstTradingDayOfYearForDate:(NSDate *)date;
+
+@end
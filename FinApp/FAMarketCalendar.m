@@ -0,0 +1,279 @@
+//
+//  FAMarketCalendar.m
+//  FinApp
+//
+//  Class that knows which days the US stock market (NYSE) is open. Works on epoch days,
+//  the number of days from 1970-01-01 (see FADateCache), so weekday checks and trading
+//  day lookups are integer math. Holidays come from a table, worked out once from the
+//  NYSE holiday rules plus one off closures, for the years it covers.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAMarketCalendar.h"
+#import "FADateCache.h"
+
+// Years covered by the holiday table
+static const int32_t FAMarketCalendarFirstYear = 1990;
+static const int32_t FAMarketCalendarLastYear = 2099;
+
+// Maximum number of days in the holiday table, one bit per day
+#define FAMarketCalendarMaxDays (((2099 - 1990) + 1) * 366)
+
+// Bit set, by epoch day from the first day in the table, of the weekdays the market is closed
+static uint8_t FAMarketClosedDays[(FAMarketCalendarMaxDays / 8) + 1];
+
+// Epoch days of the first and last days in the holiday table
+static int32_t FAMarketCalendarFirstEpochDay;
+static int32_t FAMarketCalendarLastEpochDay;
+
+// Days the market was closed outside of the regular holidays e.g. for 9/11, Hurricane Sandy and national days of mourning
+static const int32_t FAMarketOneOffClosures[] = {
+    19940427, 20010911, 20010912, 20010913, 20010914, 20040611, 20070102, 20121029, 20121030, 20181205, 20250109
+};
+
+@interface FAMarketCalendar ()
+
+// Mark the day, given as a day number e.g. 20160704, as a market holiday.
++ (void)markClosedDayNumber:(int32_t)dayNumber;
+
+// Mark a holiday that falls on a fixed date, moved to the Friday before if it's on a Saturday and the Monday after if it's on a Sunday.
++ (void)markObservedHolidayForYear:(int32_t)year month:(int32_t)month day:(int32_t)day;
+
+// Get the epoch day of the nth given weekday (1 for Sunday through 7 for Saturday) in a month e.g. the 3rd Monday in January. A count of -1 gets the last one.
++ (int32_t)epochDayForWeekday:(NSInteger)weekday count:(NSInteger)count year:(int32_t)year month:(int32_t)month;
+
+// Get the epoch day of Easter Sunday in the year.
++ (int32_t)easterEpochDayForYear:(int32_t)year;
+
+@end
+
+@implementation FAMarketCalendar
+
+// Work out the holiday table from the NYSE holiday rules, once.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    if(!exists)
+    {
+        exists = YES;
+        FAMarketCalendarFirstEpochDay = [FADateCache epochDayForDayNumber:((FAMarketCalendarFirstYear * 10000) + 101)];
+        FAMarketCalendarLastEpochDay = [FADateCache epochDayForDayNumber:((FAMarketCalendarLastYear * 10000) + 1231)];
+
+        for (int32_t year = FAMarketCalendarFirstYear; year <= FAMarketCalendarLastYear; year++) {
+
+            // New Year's Day. When it's on a Saturday the market stays open on the Friday before, as that is the last trading day of the year.
+            int32_t newYearsDay = [FADateCache epochDayForDayNumber:((year * 10000) + 101)];
+            if ([self weekdayForEpochDay:newYearsDay] == 1) {
+                [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:(newYearsDay + 1)]];
+            } else {
+                [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:newYearsDay]];
+            }
+
+            // Martin Luther King Jr. Day, the 3rd Monday in January, since 1998
+            if (year >= 1998) {
+                [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:[self epochDayForWeekday:2 count:3 year:year month:1]]];
+            }
+
+            // Washington's Birthday, the 3rd Monday in February
+            [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:[self epochDayForWeekday:2 count:3 year:year month:2]]];
+
+            // Good Friday
+            [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:([self easterEpochDayForYear:year] - 2)]];
+
+            // Memorial Day, the last Monday in May
+            [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:[self epochDayForWeekday:2 count:-1 year:year month:5]]];
+
+            // Juneteenth, since 2022
+            if (year >= 2022) {
+                [self markObservedHolidayForYear:year month:6 day:19];
+            }
+
+            // Independence Day
+            [self markObservedHolidayForYear:year month:7 day:4];
+
+            // Labor Day, the 1st Monday in September
+            [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:[self epochDayForWeekday:2 count:1 year:year month:9]]];
+
+            // Thanksgiving Day, the 4th Thursday in November
+            [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:[self epochDayForWeekday:5 count:4 year:year month:11]]];
+
+            // Christmas Day
+            [self markObservedHolidayForYear:year month:12 day:25];
+        }
+
+        for (NSUInteger i = 0; i < (sizeof(FAMarketOneOffClosures) / sizeof(FAMarketOneOffClosures[0])); i++) {
+            [self markClosedDayNumber:FAMarketOneOffClosures[i]];
+        }
+    }
+}
+
+#pragma mark - Trading Days
+
+// Get the day of the week for an epoch day, 1 for Sunday through 7 for Saturday. 1970-01-01 was a Thursday.
++ (NSInteger)weekdayForEpochDay:(int32_t)epochDay
+{
+    int32_t daysFromSunday = (epochDay + 4) % 7;
+    if (daysFromSunday < 0) {
+        daysFromSunday += 7;
+    }
+
+    return daysFromSunday + 1;
+}
+
+// Is the epoch day a Saturday or Sunday.
++ (BOOL)isWeekendEpochDay:(int32_t)epochDay
+{
+    NSInteger weekday = [self weekdayForEpochDay:epochDay];
+
+    return ((weekday == 1)||(weekday == 7));
+}
+
+// Is the epoch day a weekday on which the market is closed for a holiday or one off closure.
++ (BOOL)isHolidayEpochDay:(int32_t)epochDay
+{
+    if ((epochDay < FAMarketCalendarFirstEpochDay)||(epochDay > FAMarketCalendarLastEpochDay)) {
+        return NO;
+    }
+    int32_t tableDay = epochDay - FAMarketCalendarFirstEpochDay;
+
+    return ((FAMarketClosedDays[tableDay / 8] & (1 << (tableDay % 8))) != 0);
+}
+
+// Is the market open on the epoch day.
++ (BOOL)isTradingEpochDay:(int32_t)epochDay
+{
+    return (![self isWeekendEpochDay:epochDay] && ![self isHolidayEpochDay:epochDay]);
+}
+
+// Get the first epoch day, on or after the given one, that the market is open. Never more than a few days away.
++ (int32_t)tradingEpochDayOnOrAfter:(int32_t)epochDay
+{
+    int32_t tradingDay = epochDay;
+    while (![self isTradingEpochDay:tradingDay]) {
+        tradingDay++;
+    }
+
+    return tradingDay;
+}
+
+// Get the last epoch day, on or before the given one, that the market is open. Never more than a few days away.
++ (int32_t)tradingEpochDayOnOrBefore:(int32_t)epochDay
+{
+    int32_t tradingDay = epochDay;
+    while (![self isTradingEpochDay:tradingDay]) {
+        tradingDay--;
+    }
+
+    return tradingDay;
+}
+
+// Get the epoch day of the first day the market is open in the year.
++ (int32_t)firstTradingEpochDayOfYear:(int32_t)year
+{
+    return [self tradingEpochDayOnOrAfter:[FADateCache epochDayForDayNumber:((year * 10000) + 101)]];
+}
+
+#pragma mark - Trading Dates
+
+// Get the date 30 days before the given one, at the same time of day. It could be a weekend or a holiday.
++ (NSDate *)dateThirtyDaysBeforeDate:(NSDate *)date
+{
+    return [FADateCache dateByAddingDays:-30 toDate:date];
+}
+
+// Move a date that falls on a weekend or market holiday to a trading day, at the same time of day. Saturdays and holidays move back to the trading day
+// before e.g. Friday, and Sundays move forward to the trading day after e.g. Monday. Days are in the local time zone.
++ (NSDate *)tradingDayForDate:(NSDate *)date
+{
+    // Days are in the local time zone, the same one the days are then added in, so the date keeps it's time of day and lands on the trading day
+    int32_t day = [FADateCache localEpochDayForDate:date];
+    int32_t tradingDay;
+    if ([self weekdayForEpochDay:day] == 1) {
+        tradingDay = [self tradingEpochDayOnOrAfter:day];
+    } else {
+        tradingDay = [self tradingEpochDayOnOrBefore:day];
+    }
+
+    return [FADateCache dateByAddingDays:(tradingDay - day) toDate:date];
+}
+
+// Get the first day the market is open in the year of the given date, at midnight e.g. Tue Jan 2nd for 2018.
++ (NSDate *)firstTradingDayOfYearForDate:(NSDate *)date
+{
+    int32_t year = [FADateCache dayNumberForEpochDay:[FADateCache localEpochDayForDate:date]] / 10000;
+
+    return [FADateCache dateForEpochDay:[self firstTradingEpochDayOfYear:year]];
+}
+
+#pragma mark - Holiday Table
+
+// Mark the day, given as a day number e.g. 20160704, as a market holiday.
++ (void)markClosedDayNumber:(int32_t)dayNumber
+{
+    int32_t epochDay = [FADateCache epochDayForDayNumber:dayNumber];
+    if ((epochDay < FAMarketCalendarFirstEpochDay)||(epochDay > FAMarketCalendarLastEpochDay)) {
+        return;
+    }
+    int32_t tableDay = epochDay - FAMarketCalendarFirstEpochDay;
+
+    FAMarketClosedDays[tableDay / 8] |= (uint8_t)(1 << (tableDay % 8));
+}
+
+// Mark a holiday that falls on a fixed date, moved to the Friday before if it's on a Saturday and the Monday after if it's on a Sunday.
++ (void)markObservedHolidayForYear:(int32_t)year month:(int32_t)month day:(int32_t)day
+{
+    int32_t holiday = [FADateCache epochDayForDayNumber:((year * 10000) + (month * 100) + day)];
+    NSInteger weekday = [self weekdayForEpochDay:holiday];
+
+    if (weekday == 7) {
+        holiday--;
+    }
+    if (weekday == 1) {
+        holiday++;
+    }
+
+    [self markClosedDayNumber:[FADateCache dayNumberForEpochDay:holiday]];
+}
+
+// Get the epoch day of the nth given weekday (1 for Sunday through 7 for Saturday) in a month. A count of -1 gets the last one.
++ (int32_t)epochDayForWeekday:(NSInteger)weekday count:(NSInteger)count year:(int32_t)year month:(int32_t)month
+{
+    if (count < 0) {
+        // Go back from the last day of the month, which is the day before the 1st of the next month
+        int32_t nextMonthDayNumber = (month == 12) ? (((year + 1) * 10000) + 101) : ((year * 10000) + ((month + 1) * 100) + 1);
+        int32_t lastDay = [FADateCache epochDayForDayNumber:nextMonthDayNumber] - 1;
+        int32_t daysBack = (int32_t)(([self weekdayForEpochDay:lastDay] - weekday + 7) % 7);
+        return lastDay - daysBack;
+    }
+
+    int32_t firstDay = [FADateCache epochDayForDayNumber:((year * 10000) + (month * 100) + 1)];
+    int32_t daysForward = (int32_t)((weekday - [self weekdayForEpochDay:firstDay] + 7) % 7);
+
+    return firstDay + daysForward + (int32_t)((count - 1) * 7);
+}
+
+// Get the epoch day of Easter Sunday in the year, using the anonymous Gregorian algorithm.
++ (int32_t)easterEpochDayForYear:(int32_t)year
+{
+    int32_t a = year % 19;
+    int32_t b = year / 100;
+    int32_t c = year % 100;
+    int32_t d = b / 4;
+    int32_t e = b % 4;
+    int32_t f = (b + 8) / 25;
+    int32_t g = (b - f + 1) / 3;
+    int32_t h = ((19 * a) + b - d - g + 15) % 30;
+    int32_t i = c / 4;
+    int32_t k = c % 4;
+    int32_t l = (32 + (2 * e) + (2 * i) - h - k) % 7;
+    int32_t m = (a + (11 * h) + (22 * l)) / 451;
+    int32_t month = (h + l - (7 * m) + 114) / 31;
+    int32_t day = ((h + l - (7 * m) + 114) % 31) + 1;
+
+    return [FADateCache epochDayForDayNumber:((year * 10000) + (month * 100) + day)];
+}
+
+@end
@@ -0,0 +1,47 @@
+//
+//  FAPreseedSnapshot.h
+//  FinApp
+//
+//  Class that reads the preseed snapshot, a compact, versioned, binary file with all the
+//  data the data store is seeded with i.e. companies, economic and placeholder events and
+//  the user's sync state. It's compiled at build time from the seed data files by
+//  Scripts/compile_preseed_snapshot.py, which documents the format, and imported into the
+//  data store in a single transaction on first launch and whenever the seed data changes.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+
+// Error domain for snapshots that can't be read
+extern NSString * const FAPreseedSnapshotErrorDomain;
+
+// Version of the snapshot format this class reads. Snapshots in any other format are rejected.
+extern const uint32_t FAPreseedSnapshotFormatVersion;
+
+// User defaults key for the seed version of the last snapshot imported into the data store
+extern NSString * const FAPreseedSnapshotVersionKey;
+
+@interface FAPreseedSnapshot : NSObject
+
+// Version of the seed data in the snapshot, which changes whenever the seed data does
+@property (readonly, nonatomic) uint32_t seedVersion;
+
+// Number of companies and events in the snapshot
+@property (readonly, nonatomic) NSUInteger companyCount;
+@property (readonly, nonatomic) NSUInteger eventCount;
+
+// Get the snapshot bundled with the app. Returns nil, after logging why, if it's missing or not valid.
++ (FAPreseedSnapshot *)bundledSnapshot;
+
+// Get a snapshot by memory mapping the file at the given path and checking it's header. Returns nil, with the error set, if it's not a valid snapshot.
++ (FAPreseedSnapshot *)snapshotWithContentsOfFile:(NSString *)filePath error:(NSError **)error;
+
+// Import the snapshot into the data store, through the given context, with a single save. Must be called on the context's queue.
+// Companies whose ticker doesn't exist are added. Economic events are added or updated, placeholder events are only added if missing
+// and the user's sync state is only added if there is no user. Returns NO, with the error set, if the save fails.
+- (BOOL)importIntoContext:(NSManagedObjectContext *)context error:(NSError **)error;
+
+@end
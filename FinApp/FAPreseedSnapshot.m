@@ -0,0 +1,348 @@
+//
+//  FAPreseedSnapshot.m
+//  FinApp
+//
+//  Class that reads the preseed snapshot, a compact, versioned, binary file with all the
+//  data the data store is seeded with i.e. companies, economic and placeholder events and
+//  the user's sync state. It's compiled at build time from the seed data files by
+//  Scripts/compile_preseed_snapshot.py, which documents the format, and imported into the
+//  data store in a single transaction on first launch and whenever the seed data changes.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAPreseedSnapshot.h"
+#import "FADateCache.h"
+#import "Company.h"
+#import "Event.h"
+#import "User.h"
+
+NSString * const FAPreseedSnapshotErrorDomain = @"FAPreseedSnapshotErrorDomain";
+
+const uint32_t FAPreseedSnapshotFormatVersion = 1;
+
+NSString * const FAPreseedSnapshotVersionKey = @"PreseedSnapshotVersion";
+
+// Sizes, in bytes, of the header and of each kind of record
+static const NSUInteger FAPreseedHeaderSize = 64;
+static const NSUInteger FAPreseedCompanySize = 8;
+static const NSUInteger FAPreseedEventSize = 56;
+static const NSUInteger FAPreseedUserSize = 40;
+
+// String reference for no string
+static const uint32_t FAPreseedNoString = 0xFFFFFFFF;
+
+// Event flags. Upserted events are updated if they exist, others are only added if missing.
+static const uint32_t FAPreseedEventUpsert = 1 << 0;
+static const uint32_t FAPreseedEventHasEstimatedEps = 1 << 1;
+static const uint32_t FAPreseedEventHasActualEpsPrior = 1 << 2;
+
+// Read little endian values, that may not be aligned, from the snapshot
+static inline uint32_t FAPreseedReadUInt32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
+static inline int64_t FAPreseedReadInt64(const uint8_t *bytes)
+{
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return (int64_t)CFSwapInt64LittleToHost(value);
+}
+
+static inline float FAPreseedReadFloat(const uint8_t *bytes)
+{
+    uint32_t value = FAPreseedReadUInt32(bytes);
+    float floatValue;
+    memcpy(&floatValue, &value, sizeof(floatValue));
+    return floatValue;
+}
+
+static inline double FAPreseedReadDouble(const uint8_t *bytes)
+{
+    uint64_t value = (uint64_t)FAPreseedReadInt64(bytes);
+    double doubleValue;
+    memcpy(&doubleValue, &value, sizeof(doubleValue));
+    return doubleValue;
+}
+
+@interface FAPreseedSnapshot ()
+
+// Contents of the snapshot file, memory mapped
+@property (strong, nonatomic) NSData *snapshotData;
+
+// Offsets of the records and strings in the snapshot
+@property (assign, nonatomic) NSUInteger companiesOffset;
+@property (assign, nonatomic) NSUInteger eventsOffset;
+@property (assign, nonatomic) NSUInteger userCount;
+@property (assign, nonatomic) NSUInteger usersOffset;
+@property (assign, nonatomic) NSUInteger stringsOffset;
+@property (assign, nonatomic) NSUInteger stringsLength;
+
+// Strings that have been read, keyed by their offset, so that a string used by many records e.g. a certainty is only created once
+@property (strong, nonatomic) NSMutableDictionary *readStrings;
+
+// Set up the snapshot over the file contents, checking that the header and records are all within it. Returns nil, with the error set, if not.
+- (id)initWithData:(NSData *)snapshotData error:(NSError **)error;
+
+// Get the string for a string reference. Returns nil for no string or a reference that's not valid.
+- (NSString *)stringForReference:(uint32_t)stringReference;
+
+// Get the date for seconds since 2001-01-01 GMT, stored as NaN for no date.
+- (NSDate *)dateForReferenceSeconds:(double)referenceSeconds;
+
+@end
+
+@implementation FAPreseedSnapshot
+
+#pragma mark - Reading the Snapshot
+
+// Get the snapshot bundled with the app. Returns nil, after logging why, if it's missing or not valid.
++ (FAPreseedSnapshot *)bundledSnapshot
+{
+    NSString *snapshotFilePath = [[NSBundle mainBundle] pathForResource:@"Preseed" ofType:@"snapshot"];
+    if (snapshotFilePath == nil) {
+        NSLog(@"ERROR: Could not find the preseed snapshot in the bundle");
+        return nil;
+    }
+
+    NSError *error = nil;
+    FAPreseedSnapshot *snapshot = [self snapshotWithContentsOfFile:snapshotFilePath error:&error];
+    if (snapshot == nil) {
+        NSLog(@"ERROR: Could not read the preseed snapshot at %@. Error description: %@",snapshotFilePath,error.description);
+    }
+
+    return snapshot;
+}
+
+// Get a snapshot by memory mapping the file at the given path and checking it's header.
++ (FAPreseedSnapshot *)snapshotWithContentsOfFile:(NSString *)filePath error:(NSError **)error
+{
+    NSData *snapshotData = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:error];
+    if (snapshotData == nil) {
+        return nil;
+    }
+
+    return [[FAPreseedSnapshot alloc] initWithData:snapshotData error:error];
+}
+
+// Set up the snapshot over the file contents, checking that the header and records are all within it.
+- (id)initWithData:(NSData *)snapshotData error:(NSError **)error
+{
+    self = [super init];
+    if (self) {
+
+        const uint8_t *bytes = snapshotData.bytes;
+        NSUInteger length = snapshotData.length;
+        NSString *problem = nil;
+
+        if ((length < FAPreseedHeaderSize)||(memcmp(bytes, "FAPS", 4) != 0)) {
+            problem = @"Not a preseed snapshot";
+        } else if (FAPreseedReadUInt32(bytes + 4) != FAPreseedSnapshotFormatVersion) {
+            problem = [NSString stringWithFormat:@"Snapshot format version %u is not supported",FAPreseedReadUInt32(bytes + 4)];
+        } else {
+            _seedVersion = FAPreseedReadUInt32(bytes + 8);
+            _companyCount = FAPreseedReadUInt32(bytes + 12);
+            _companiesOffset = FAPreseedReadUInt32(bytes + 16);
+            _eventCount = FAPreseedReadUInt32(bytes + 20);
+            _eventsOffset = FAPreseedReadUInt32(bytes + 24);
+            _userCount = FAPreseedReadUInt32(bytes + 28);
+            _usersOffset = FAPreseedReadUInt32(bytes + 32);
+            _stringsOffset = FAPreseedReadUInt32(bytes + 36);
+            _stringsLength = FAPreseedReadUInt32(bytes + 40);
+
+            // Sizes are worked out in 64 bits, from 32 bit counts, so they can't overflow
+            if (((uint64_t)_companiesOffset + ((uint64_t)_companyCount * FAPreseedCompanySize) > length)||
+                ((uint64_t)_eventsOffset + ((uint64_t)_eventCount * FAPreseedEventSize) > length)||
+                ((uint64_t)_usersOffset + ((uint64_t)_userCount * FAPreseedUserSize) > length)||
+                ((uint64_t)_stringsOffset + (uint64_t)_stringsLength > length)) {
+                problem = @"Snapshot records go past the end of the file";
+            }
+        }
+
+        if (problem != nil) {
+            if (error) {
+                *error = [NSError errorWithDomain:FAPreseedSnapshotErrorDomain code:1 userInfo:@{NSLocalizedDescriptionKey:problem}];
+            }
+            return nil;
+        }
+
+        _snapshotData = snapshotData;
+        _readStrings = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+// Get the string for a string reference, which is stored as a 2 byte length followed by UTF-8 bytes. Returns nil for no string or a reference that's not valid.
+- (NSString *)stringForReference:(uint32_t)stringReference
+{
+    if ((stringReference == FAPreseedNoString)||((NSUInteger)stringReference + 2 > self.stringsLength)) {
+        return nil;
+    }
+
+    NSNumber *stringKey = @(stringReference);
+    NSString *string = [self.readStrings objectForKey:stringKey];
+    if (string == nil) {
+        const uint8_t *stringBytes = (const uint8_t *)self.snapshotData.bytes + self.stringsOffset + stringReference;
+        NSUInteger stringLength = stringBytes[0] | (stringBytes[1] << 8);
+        if ((NSUInteger)stringReference + 2 + stringLength > self.stringsLength) {
+            return nil;
+        }
+        string = [[NSString alloc] initWithBytes:(stringBytes + 2) length:stringLength encoding:NSUTF8StringEncoding];
+        if (string != nil) {
+            [self.readStrings setObject:string forKey:stringKey];
+        }
+    }
+
+    return string;
+}
+
+// Get the date for seconds since 2001-01-01 GMT, stored as NaN for no date.
+- (NSDate *)dateForReferenceSeconds:(double)referenceSeconds
+{
+    if (isnan(referenceSeconds)) {
+        return nil;
+    }
+
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:referenceSeconds];
+}
+
+#pragma mark - Importing
+
+// Import the snapshot into the data store, through the given context, with a single save. Must be called on the context's queue.
+- (BOOL)importIntoContext:(NSManagedObjectContext *)context error:(NSError **)error
+{
+    const uint8_t *bytes = self.snapshotData.bytes;
+    NSError *fetchError = nil;
+
+    // Get the tickers of the companies that events are listed under, to look up the existing ones and keep track of the new ones
+    NSMutableSet *eventTickerKeys = [[NSMutableSet alloc] init];
+    for (NSUInteger i = 0; i < self.eventCount; i++) {
+        NSString *eventTicker = [self stringForReference:FAPreseedReadUInt32(bytes + self.eventsOffset + (i * FAPreseedEventSize))];
+        if (eventTicker != nil) {
+            [eventTickerKeys addObject:[eventTicker uppercaseString]];
+        }
+    }
+
+    // Get the tickers of all existing companies in one fetch, as plain values instead of objects
+    NSFetchRequest *tickerFetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"Company"];
+    [tickerFetchRequest setResultType:NSDictionaryResultType];
+    [tickerFetchRequest setPropertiesToFetch:@[@"tickerKey"]];
+    NSArray *existingTickers = [context executeFetchRequest:tickerFetchRequest error:&fetchError];
+    if (existingTickers == nil) {
+        NSLog(@"ERROR: Getting existing company tickers, to import the preseed snapshot, failed: %@",fetchError.description);
+    }
+    NSMutableSet *existingTickerKeys = [NSMutableSet setWithArray:[existingTickers valueForKey:@"tickerKey"]];
+
+    // Get the existing companies that events are listed under, keyed by uppercased ticker
+    NSMutableDictionary *companiesByTicker = [[NSMutableDictionary alloc] init];
+    NSFetchRequest *companyFetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"Company"];
+    [companyFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"tickerKey IN %@",eventTickerKeys]];
+    for (Company *existingCompany in [context executeFetchRequest:companyFetchRequest error:&fetchError]) {
+        [companiesByTicker setObject:existingCompany forKey:[existingCompany.ticker uppercaseString]];
+    }
+
+    // Add the companies that don't exist. The ticker key is set here, instead of when saving, so the company isn't changed again then.
+    for (NSUInteger i = 0; i < self.companyCount; i++) {
+        const uint8_t *record = bytes + self.companiesOffset + (i * FAPreseedCompanySize);
+        NSString *companyTicker = [self stringForReference:FAPreseedReadUInt32(record)];
+        NSString *tickerKey = [companyTicker uppercaseString];
+        if ((tickerKey == nil)||[existingTickerKeys containsObject:tickerKey]) {
+            continue;
+        }
+        Company *company = [NSEntityDescription insertNewObjectForEntityForName:@"Company" inManagedObjectContext:context];
+        company.ticker = companyTicker;
+        company.name = [self stringForReference:FAPreseedReadUInt32(record + 4)];
+        company.tickerKey = tickerKey;
+        [existingTickerKeys addObject:tickerKey];
+        if ([eventTickerKeys containsObject:tickerKey]) {
+            [companiesByTicker setObject:company forKey:tickerKey];
+        }
+    }
+
+    // Get all existing events for the companies events are listed under, in one fetch, grouped by uppercased ticker
+    NSMutableDictionary *eventsByTicker = [[NSMutableDictionary alloc] init];
+    NSFetchRequest *eventFetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"Event"];
+    [eventFetchRequest setPredicate:[NSPredicate predicateWithFormat:@"tickerKey IN %@",eventTickerKeys]];
+    for (Event *existingEvent in [context executeFetchRequest:eventFetchRequest error:&fetchError]) {
+        NSString *tickerKey = [existingEvent.listedCompany.ticker uppercaseString];
+        if (tickerKey == nil) {
+            continue;
+        }
+        if (![eventsByTicker objectForKey:tickerKey]) {
+            [eventsByTicker setObject:[[NSMutableArray alloc] init] forKey:tickerKey];
+        }
+        [[eventsByTicker objectForKey:tickerKey] addObject:existingEvent];
+    }
+
+    // Add or update the events
+    for (NSUInteger i = 0; i < self.eventCount; i++) {
+
+        const uint8_t *record = bytes + self.eventsOffset + (i * FAPreseedEventSize);
+        NSString *tickerKey = [[self stringForReference:FAPreseedReadUInt32(record)] uppercaseString];
+        NSString *eventType = [self stringForReference:FAPreseedReadUInt32(record + 4)];
+        Company *listedCompany = [companiesByTicker objectForKey:tickerKey];
+        if ((eventType == nil)||(listedCompany == nil)) {
+            NSLog(@"ERROR: Did not import preseed event of type: %@ and with ticker:%@ as one of them is missing",eventType,tickerKey);
+            continue;
+        }
+        uint32_t flags = FAPreseedReadUInt32(record + 28);
+
+        Event *event = nil;
+        for (Event *tickerEvent in [eventsByTicker objectForKey:tickerKey]) {
+            if ([tickerEvent.type caseInsensitiveCompare:eventType] == NSOrderedSame) {
+                event = tickerEvent;
+            }
+        }
+        if ((event != nil)&&!(flags & FAPreseedEventUpsert)) {
+            continue;
+        }
+        if (event == nil) {
+            event = [NSEntityDescription insertNewObjectForEntityForName:@"Event" inManagedObjectContext:context];
+            event.type = eventType;
+            event.listedCompany = listedCompany;
+            if (![eventsByTicker objectForKey:tickerKey]) {
+                [eventsByTicker setObject:[[NSMutableArray alloc] init] forKey:tickerKey];
+            }
+            [[eventsByTicker objectForKey:tickerKey] addObject:event];
+        }
+
+        // Dates stored as a day number are at midnight in the local time zone, the rest are absolute
+        int32_t dayNumber = (int32_t)FAPreseedReadUInt32(record + 16);
+        event.date = (dayNumber != 0) ? [FADateCache dateForDayNumber:dayNumber] : [self dateForReferenceSeconds:FAPreseedReadDouble(record + 32)];
+        event.certainty = [self stringForReference:FAPreseedReadUInt32(record + 8)];
+        event.relatedDetails = [self stringForReference:FAPreseedReadUInt32(record + 12)];
+        event.relatedDate = [self dateForReferenceSeconds:FAPreseedReadDouble(record + 40)];
+        event.priorEndDate = [self dateForReferenceSeconds:FAPreseedReadDouble(record + 48)];
+        event.estimatedEps = (flags & FAPreseedEventHasEstimatedEps) ? [NSNumber numberWithFloat:FAPreseedReadFloat(record + 20)] : nil;
+        event.actualEpsPrior = (flags & FAPreseedEventHasActualEpsPrior) ? [NSNumber numberWithFloat:FAPreseedReadFloat(record + 24)] : nil;
+        [event updateLookupKeys];
+    }
+
+    // Add the user's sync state if there is no user
+    if (self.userCount > 0) {
+        NSFetchRequest *userFetchRequest = [[NSFetchRequest alloc] initWithEntityName:@"User"];
+        if ([context countForFetchRequest:userFetchRequest error:&fetchError] == 0) {
+            const uint8_t *record = bytes + self.usersOffset;
+            User *user = [NSEntityDescription insertNewObjectForEntityForName:@"User" inManagedObjectContext:context];
+            user.companySyncStatus = [self stringForReference:FAPreseedReadUInt32(record)];
+            user.eventSyncStatus = [self stringForReference:FAPreseedReadUInt32(record + 4)];
+            user.companyPageNumber = [NSNumber numberWithLongLong:FAPreseedReadInt64(record + 8)];
+            user.companyTotalPages = [NSNumber numberWithLongLong:FAPreseedReadInt64(record + 16)];
+            user.companySyncDate = [self dateForReferenceSeconds:FAPreseedReadDouble(record + 24)];
+            user.eventSyncDate = [self dateForReferenceSeconds:FAPreseedReadDouble(record + 32)];
+        }
+    }
+
+    // Commit everything in one transaction
+    if ([context hasChanges] && ![context save:error]) {
+        return NO;
+    }
+
+    return YES;
+}
+
+@end
@@ -0,0 +1,45 @@
+//
+//  FAPriceBarStore.h
+//  FinApp
+//
+//  Class that keeps a local, append only, store of daily closing prices for each
+//  ticker. Each ticker's bars are kept in date order in a compact file of fixed size
+//  records, so the price on a given date is looked up with a binary search and new bars
+//  are simply appended. This lets historical prices be answered locally and history
+//  fetches ask only for the bars from a little before the last one stored, the overlap
+//  being checked against what's stored to catch closes adjusted for splits or dividends.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@interface FAPriceBarStore : NSObject
+
+// Create and/or return the single shared price bar store
++ (FAPriceBarStore *)sharedStore;
+
+// Get the date of the last bar stored for the ticker. Returns nil if there are no bars for it.
+- (NSDate *)lastBarDateForTicker:(NSString *)ticker;
+
+// Append daily bars for the ticker. Each bar is a dictionary with the trading day as a "yyyy-MM-dd" string e.g. 2016-03-31 for key "tradingDay"
+// and the closing price for key "close". Bars that are not after the last bar stored are only checked against the stored ones, so overlapping fetches
+// are safe. If their closes disagree, as happens when the price history is adjusted for a split or dividend, all the bars stored for the ticker are
+// dropped, nothing is appended and NO is returned, so that the caller fetches the full history again.
+- (BOOL)appendBars:(NSArray *)bars forTicker:(NSString *)ticker;
+
+// Get the closing price for the ticker on the given date or, if that wasn't a trading day, the closest trading day before it. Returns nil if
+// there is no bar for that date or earlier, or if the bars stored end before the last trading day on or before the date, so that the caller fetches.
+- (NSNumber *)closePriceForTicker:(NSString *)ticker onOrBeforeDate:(NSDate *)date;
+
+// Remove all the bars stored for the ticker, both the file and the ones in memory, e.g. to start over with fetching it's prices.
+- (void)removeBarsForTicker:(NSString *)ticker;
+
+// Get the trading day number e.g. 20160331, used to key bars, for a date. Dates are GMT.
++ (int32_t)dayNumberForDate:(NSDate *)date;
+
+// Get the date for a trading day number e.g. 20160331. Dates are GMT.
++ (NSDate *)dateForDayNumber:(int32_t)dayNumber;
+
+@end
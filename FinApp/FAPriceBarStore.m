@@ -0,0 +1,303 @@
+//
+//  FAPriceBarStore.m
+//  FinApp
+//
+//  Class that keeps a local, append only, store of daily closing prices for each
+//  ticker. Each ticker's bars are kept in date order in a compact file of fixed size
+//  records, so the price on a given date is looked up with a binary search and new bars
+//  are simply appended. This lets historical prices be answered locally and history
+//  fetches ask only for the bars from a little before the last one stored, the overlap
+//  being checked against what's stored to catch closes adjusted for splits or dividends.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAPriceBarStore.h"
+#import "FADateCache.h"
+#import "FAMarketCalendar.h"
+
+// Each bar is stored as a 4 byte trading day number e.g. 20160331 followed by an 8 byte closing price
+static const NSUInteger FAPriceBarSize = sizeof(int32_t) + sizeof(double);
+
+@interface FAPriceBarStore ()
+
+// Bars for the tickers that have been read in, keyed by ticker. Evicted under memory pressure and read back in from the file when needed.
+@property (strong, nonatomic) NSCache *loadedBars;
+
+// Get the directory that the bar files are kept in, creating it if needed.
+- (NSURL *)barsDirectory;
+
+// Get the file that the bars for the ticker are kept in.
+- (NSURL *)barsFileForTicker:(NSString *)ticker;
+
+// Get the bars for the ticker, reading them in from the file if needed. Must be called with the store locked.
+- (NSMutableData *)barsForTicker:(NSString *)ticker;
+
+// Get the number of bars, of the first noOfBars in the bars, that are on or before the trading day number, with a binary search.
+- (NSUInteger)countOfBarsOnOrBeforeDayNumber:(int32_t)dayNumber inBars:(NSData *)bars noOfBars:(NSUInteger)noOfBars;
+
+// Get the trading day number of the bar at the given index in the bars.
+- (int32_t)dayNumberOfBarAtIndex:(NSUInteger)barIndex inBars:(NSData *)bars;
+
+// Get the closing price of the bar at the given index in the bars.
+- (double)closeOfBarAtIndex:(NSUInteger)barIndex inBars:(NSData *)bars;
+
+// Get the trading day number for a "yyyy-MM-dd" string e.g. 2016-03-31. Returns 0 if the string is not in this format.
++ (int32_t)dayNumberForTradingDayString:(NSString *)tradingDay;
+
+@end
+
+@implementation FAPriceBarStore
+
+static FAPriceBarStore *sharedInstance;
+
+// Implement this class as a Singleton so that there's a single writer for the bar files.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a price bar store doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FAPriceBarStore alloc] init];
+    }
+}
+
+// Create and/or return the single shared price bar store
++ (FAPriceBarStore *)sharedStore {
+
+    return sharedInstance;
+}
+
+// Set up the cache of bars that have been read in.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.loadedBars = [[NSCache alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Reading and Writing Bars
+
+// Get the date of the last bar stored for the ticker. Returns nil if there are no bars for it.
+- (NSDate *)lastBarDateForTicker:(NSString *)ticker
+{
+    @synchronized(self) {
+        NSMutableData *bars = [self barsForTicker:ticker];
+        NSUInteger noOfBars = bars.length / FAPriceBarSize;
+        if (noOfBars == 0) {
+            return nil;
+        }
+        return [FAPriceBarStore dateForDayNumber:[self dayNumberOfBarAtIndex:(noOfBars - 1) inBars:bars]];
+    }
+}
+
+// Append daily bars for the ticker. Bars that are not after the last bar stored are only checked against the stored ones. If their closes disagree,
+// all the bars stored for the ticker are dropped, nothing is appended and NO is returned.
+- (BOOL)appendBars:(NSArray *)bars forTicker:(NSString *)ticker
+{
+    @synchronized(self) {
+
+        // Go by the bars in the file, not the ones in memory, since the file can have gone e.g. if iOS cleared the caches directory. If the bars in memory
+        // are out of step with the file, drop them so that they're read in again.
+        NSURL *barsFile = [self barsFileForTicker:ticker];
+        NSDictionary *barsFileAttributes = [[NSFileManager defaultManager] attributesOfItemAtPath:barsFile.path error:nil];
+        NSUInteger noOfFileBars = (NSUInteger)([barsFileAttributes fileSize] / FAPriceBarSize);
+        NSMutableData *loadedTickerBars = [self.loadedBars objectForKey:[ticker uppercaseString]];
+        if ((loadedTickerBars != nil)&&((loadedTickerBars.length / FAPriceBarSize) != noOfFileBars)) {
+            [self.loadedBars removeObjectForKey:[ticker uppercaseString]];
+        }
+
+        NSMutableData *storedBars = [self barsForTicker:ticker];
+        NSUInteger noOfStoredBars = MIN((storedBars.length / FAPriceBarSize), noOfFileBars);
+        int32_t lastDayNumber = (noOfStoredBars > 0) ? [self dayNumberOfBarAtIndex:(noOfStoredBars - 1) inBars:storedBars] : 0;
+
+        // Get the new bars, in date order, as records
+        NSMutableDictionary *newCloses = [[NSMutableDictionary alloc] init];
+        for (NSDictionary *bar in bars) {
+            id tradingDay = [bar objectForKey:@"tradingDay"];
+            id close = [bar objectForKey:@"close"];
+            if (![tradingDay isKindOfClass:[NSString class]]||![close respondsToSelector:@selector(doubleValue)]) {
+                continue;
+            }
+            int32_t dayNumber = [FAPriceBarStore dayNumberForTradingDayString:tradingDay];
+            if (dayNumber > lastDayNumber) {
+                [newCloses setObject:[NSNumber numberWithDouble:[close doubleValue]] forKey:[NSNumber numberWithInt:dayNumber]];
+                continue;
+            }
+            
+            // Closes are adjusted for splits and dividends, so if an overlapping close has changed, so has all the history before it. Drop it all.
+            NSUInteger noOfBarsOnOrBefore = [self countOfBarsOnOrBeforeDayNumber:dayNumber inBars:storedBars noOfBars:noOfStoredBars];
+            if ((noOfBarsOnOrBefore > 0) && ([self dayNumberOfBarAtIndex:(noOfBarsOnOrBefore - 1) inBars:storedBars] == dayNumber)) {
+                double storedClose = [self closeOfBarAtIndex:(noOfBarsOnOrBefore - 1) inBars:storedBars];
+                if (fabs(storedClose - [close doubleValue]) > MAX(0.0001, (0.0001 * fabs(storedClose)))) {
+                    [self removeBarsForTicker:ticker];
+                    return NO;
+                }
+            }
+        }
+        if (newCloses.count == 0) {
+            return YES;
+        }
+        NSMutableData *newBars = [[NSMutableData alloc] initWithCapacity:(newCloses.count * FAPriceBarSize)];
+        for (NSNumber *dayNumber in [[newCloses allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+            int32_t day = [dayNumber intValue];
+            double close = [[newCloses objectForKey:dayNumber] doubleValue];
+            [newBars appendBytes:&day length:sizeof(day)];
+            [newBars appendBytes:&close length:sizeof(close)];
+        }
+
+        // Append them to the file and the bars in memory
+        if (barsFileAttributes == nil) {
+            [[NSFileManager defaultManager] createFileAtPath:barsFile.path contents:nil attributes:nil];
+        }
+        NSError *error = nil;
+        NSFileHandle *barsFileHandle = [NSFileHandle fileHandleForWritingToURL:barsFile error:&error];
+        if (barsFileHandle == nil) {
+            NSLog(@"ERROR: Could not open the price bars file for ticker:%@. Error description: %@",ticker,error.description);
+            return YES;
+        }
+        // If a previous append was cut short, drop the partial bar so records stay aligned
+        [barsFileHandle truncateFileAtOffset:(noOfStoredBars * FAPriceBarSize)];
+        [barsFileHandle writeData:newBars];
+        [barsFileHandle closeFile];
+
+        [storedBars setLength:(noOfStoredBars * FAPriceBarSize)];
+        [storedBars appendData:newBars];
+    }
+    
+    return YES;
+}
+
+// Get the closing price for the ticker on the given date or, if that wasn't a trading day, the closest trading day before it. Returns nil if the bars
+// stored end before the last trading day on or before the date.
+- (NSNumber *)closePriceForTicker:(NSString *)ticker onOrBeforeDate:(NSDate *)date
+{
+    if (date == nil) {
+        return nil;
+    }
+    int32_t targetDayNumber = [FAPriceBarStore dayNumberForDate:date];
+    int32_t targetTradingDayNumber = [FADateCache dayNumberForEpochDay:[FAMarketCalendar tradingEpochDayOnOrBefore:[FADateCache gmtEpochDayForDate:date]]];
+
+    @synchronized(self) {
+
+        NSMutableData *bars = [self barsForTicker:ticker];
+        NSUInteger noOfBars = bars.length / FAPriceBarSize;
+        NSUInteger noOfBarsOnOrBefore = [self countOfBarsOnOrBeforeDayNumber:targetDayNumber inBars:bars noOfBars:noOfBars];
+        if (noOfBarsOnOrBefore == 0) {
+            return nil;
+        }
+        
+        // If the stored bars stop short of the trading day, the close on it isn't known yet
+        if ([self dayNumberOfBarAtIndex:(noOfBarsOnOrBefore - 1) inBars:bars] < targetTradingDayNumber) {
+            return nil;
+        }
+        return [NSNumber numberWithDouble:[self closeOfBarAtIndex:(noOfBarsOnOrBefore - 1) inBars:bars]];
+    }
+}
+
+// Remove all the bars stored for the ticker, both the file and the ones in memory.
+- (void)removeBarsForTicker:(NSString *)ticker
+{
+    @synchronized(self) {
+
+        [self.loadedBars removeObjectForKey:[ticker uppercaseString]];
+
+        NSURL *barsFile = [self barsFileForTicker:ticker];
+        NSError *error = nil;
+        if ([[NSFileManager defaultManager] fileExistsAtPath:barsFile.path] && ![[NSFileManager defaultManager] removeItemAtURL:barsFile error:&error]) {
+            NSLog(@"ERROR: Removing the price bars file for %@ failed: %@",ticker,error.description);
+        }
+    }
+}
+
+// Get the bars for the ticker, reading them in from the file if needed. Must be called with the store locked.
+- (NSMutableData *)barsForTicker:(NSString *)ticker
+{
+    NSString *tickerKey = [ticker uppercaseString];
+    NSMutableData *bars = [self.loadedBars objectForKey:tickerKey];
+    if (bars == nil) {
+        bars = [NSMutableData dataWithContentsOfURL:[self barsFileForTicker:ticker]];
+        if (bars == nil) {
+            bars = [[NSMutableData alloc] init];
+        }
+        [self.loadedBars setObject:bars forKey:tickerKey];
+    }
+    return bars;
+}
+
+// Get the number of bars, of the first noOfBars in the bars, that are on or before the trading day number, with a binary search.
+- (NSUInteger)countOfBarsOnOrBeforeDayNumber:(int32_t)dayNumber inBars:(NSData *)bars noOfBars:(NSUInteger)noOfBars
+{
+    NSUInteger low = 0;
+    NSUInteger high = noOfBars;
+    while (low < high) {
+        NSUInteger mid = low + ((high - low) / 2);
+        if ([self dayNumberOfBarAtIndex:mid inBars:bars] <= dayNumber) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Get the trading day number of the bar at the given index in the bars.
+- (int32_t)dayNumberOfBarAtIndex:(NSUInteger)barIndex inBars:(NSData *)bars
+{
+    int32_t dayNumber = 0;
+    memcpy(&dayNumber, ((const uint8_t *)bars.bytes + (barIndex * FAPriceBarSize)), sizeof(dayNumber));
+    return dayNumber;
+}
+
+// Get the closing price of the bar at the given index in the bars.
+- (double)closeOfBarAtIndex:(NSUInteger)barIndex inBars:(NSData *)bars
+{
+    double close = 0;
+    memcpy(&close, ((const uint8_t *)bars.bytes + (barIndex * FAPriceBarSize) + sizeof(int32_t)), sizeof(close));
+    return close;
+}
+
+#pragma mark - Files
+
+// Get the directory that the bar files are kept in, creating it if needed. Since the bars can always be fetched again, they are kept in Caches.
+- (NSURL *)barsDirectory
+{
+    NSURL *cachesDirectory = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] lastObject];
+    NSURL *barsDirectory = [cachesDirectory URLByAppendingPathComponent:@"PriceBars" isDirectory:YES];
+    [[NSFileManager defaultManager] createDirectoryAtURL:barsDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+    return barsDirectory;
+}
+
+// Get the file that the bars for the ticker are kept in e.g. PriceBars/AAPL.bars
+- (NSURL *)barsFileForTicker:(NSString *)ticker
+{
+    NSString *fileName = [[[ticker uppercaseString] stringByReplacingOccurrencesOfString:@"/" withString:@"_"] stringByAppendingPathExtension:@"bars"];
+    return [[self barsDirectory] URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
+#pragma mark - Trading Days
+
+// Get the trading day number e.g. 20160331, used to key bars, for a date. Dates are GMT.
++ (int32_t)dayNumberForDate:(NSDate *)date
+{
+    return [FADateCache gmtDayNumberForDate:date];
+}
+
+// Get the date for a trading day number e.g. 20160331. Dates are GMT.
++ (NSDate *)dateForDayNumber:(int32_t)dayNumber
+{
+    return [FADateCache gmtDateForDayNumber:dayNumber];
+}
+
+// Get the trading day number for a "yyyy-MM-dd" string e.g. 2016-03-31. Returns 0 if the string is not in this format.
++ (int32_t)dayNumberForTradingDayString:(NSString *)tradingDay
+{
+    return [FADateCache dayNumberForDateString:tradingDay];
+}
+
+@end
@@ -0,0 +1,44 @@
+//
+//  FAQuoteBatcher.h
+//  FinApp
+//
+//  Class that batches requests for current stock quotes into multi symbol calls to
+//  the quote API. A request is sent right away if no calls are in flight. Requests made
+//  while calls are in flight, from any thread, are coalesced and split into chunks that
+//  keep the request URL to a safe length. Chunks are fetched in parallel. A symbol whose quote is already being fetched is not fetched
+//  again; the quote is handed to everyone waiting on it when it arrives.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class FADataController;
+
+// Block called once the quotes for all requested symbols have been fetched. Quotes are keyed by the requested symbol and contain the quote fields
+// (symbol, mode, tradeTimestamp, lastPrice, netChange, percentChange, fiftyTwoWkHigh, fiftyTwoWkHighDate, fiftyTwoWkLow, fiftyTwoWkLowDate) that were
+// present. Symbols for which no quote came back are left out. Error is set if any of the calls failed.
+typedef void (^FAQuotesCompletionHandler)(NSDictionary *quotes, NSError *error);
+
+@interface FAQuoteBatcher : NSObject
+
+// Create and/or return the single shared quote batcher
++ (FAQuoteBatcher *)sharedBatcher;
+
+// While calls are in flight, how long requests wait to coalesce with others, if the calls in flight haven't come back by then. Defaults to 0.05 secs.
+@property (nonatomic) NSTimeInterval coalescingInterval;
+
+// Data controller that the calls are made through, so that they are traced and sent the same way as every other API call. Defaults to one of it's own.
+@property (strong, nonatomic) FADataController *requestController;
+
+// Max length of a request URL. Symbols are split into as many calls as needed to stay under this. Defaults to 2000.
+@property (nonatomic) NSUInteger maxRequestURLLength;
+
+// Fetch the current quotes for the given tickers, calling the completion handler on a background queue once they are all in.
+- (void)fetchQuotesForSymbols:(NSArray *)symbols completionHandler:(FAQuotesCompletionHandler)completionHandler;
+
+// Fetch the current quotes for the given tickers and wait for them to come in. The calling thread is parked, not spinning, till then. Should never be called on the main thread.
+- (NSDictionary *)quotesForSymbols:(NSArray *)symbols error:(NSError **)error;
+
+@end
@@ -0,0 +1,322 @@
+//
+//  FAQuoteBatcher.m
+//  FinApp
+//
+//  Class that batches requests for current stock quotes into multi symbol calls to
+//  the quote API. A request is sent right away if no calls are in flight. Requests made
+//  while calls are in flight, from any thread, are coalesced and split into chunks that
+//  keep the request URL to a safe length. Chunks are fetched in parallel. A symbol whose quote is already being fetched is not fetched
+//  again; the quote is handed to everyone waiting on it when it arrives.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAQuoteBatcher.h"
+#import "FAJSONStreamReader.h"
+#import "FADataController.h"
+
+// Quote API endpoint, including the key, and the additional fields we want for each quote e.g.
+// marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809&symbols=UA,FB,GPRO&fields=fiftyTwoWkHigh,fiftyTwoWkHighDate,fiftyTwoWkLow,fiftyTwoWkLowDate
+static NSString * const FAQuoteEndpointURL = @"http://marketdata.websol.barchart.com/getQuote.json?key=9d040a74abe6d5df65a38df9b4253809";
+static NSString * const FAQuoteAddtlFields = @"&fields=fiftyTwoWkHigh,fiftyTwoWkHighDate,fiftyTwoWkLow,fiftyTwoWkLowDate";
+
+// Block called, on the batcher queue, with the quote for a single symbol when it arrives
+typedef void (^FAQuoteWaiter)(NSDictionary *quote, NSError *error);
+
+@interface FAQuoteBatcher ()
+
+// Serial queue that all the batching state is accessed on
+@property (strong, nonatomic) dispatch_queue_t batcherQueue;
+
+// Waiters for each symbol, keyed by the symbol as the API expects it. A symbol is in here from the time it's first requested till it's quote arrives,
+// so later requests for it just wait on the call that's already been made or is about to be.
+@property (strong, nonatomic) NSMutableDictionary *symbolWaiters;
+
+// Symbols to include in the next set of calls
+@property (strong, nonatomic) NSMutableOrderedSet *pendingSymbols;
+
+// Whether the next set of calls has been scheduled
+@property (nonatomic) BOOL flushScheduled;
+
+// No of calls made whose quotes haven't been delivered yet
+@property (nonatomic) NSUInteger callsInFlight;
+
+// Format a ticker the way the quote API expects it e.g. for V.HSR replace with V_HSR. Also used as the key to match quotes to requests.
+- (NSString *)apiSymbolForTicker:(NSString *)ticker;
+
+// Make the calls for all the pending symbols, if there are any. Called on the batcher queue.
+- (void)flushPendingSymbols;
+
+// Split the symbols into chunks, each of which fits in a request URL of the max length.
+- (NSArray *)chunksForSymbols:(NSArray *)symbols;
+
+// Get the quote API URL for the given symbols
+- (NSString *)quoteURLStringForSymbols:(NSArray *)symbols;
+
+// Make a single call for the quotes for a chunk of symbols and hand them to the waiters when they arrive.
+- (void)fetchQuotesForChunk:(NSArray *)chunk;
+
+// Hand the quotes for a chunk of symbols to everyone waiting on them. Called on the batcher queue.
+- (void)deliverQuotes:(NSDictionary *)quotes error:(NSError *)error forChunk:(NSArray *)chunk;
+
+@end
+
+@implementation FAQuoteBatcher
+
+static FAQuoteBatcher *sharedInstance;
+
+// Implement this class as a Singleton so that requests from anywhere in the app are batched together.
++ (void)initialize
+{
+    static BOOL exists = NO;
+
+    // If a batcher doesn't already exist
+    if(!exists)
+    {
+        exists = YES;
+        sharedInstance = [[FAQuoteBatcher alloc] init];
+    }
+}
+
+// Create and/or return the single shared quote batcher
++ (FAQuoteBatcher *)sharedBatcher {
+
+    return sharedInstance;
+}
+
+// Set up the batching state, with calls coalesced for a short interval and kept under a safe URL length.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.batcherQueue = dispatch_queue_create("com.siddsingh.FinApp.quoteBatcher", DISPATCH_QUEUE_SERIAL);
+        self.symbolWaiters = [[NSMutableDictionary alloc] init];
+        self.pendingSymbols = [[NSMutableOrderedSet alloc] init];
+        self.flushScheduled = NO;
+        self.callsInFlight = 0;
+        self.coalescingInterval = 0.05;
+        self.maxRequestURLLength = 2000;
+        self.requestController = [[FADataController alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Fetching Quotes
+
+// Fetch the current quotes for the given tickers, calling the completion handler on a background queue once they are all in.
+- (void)fetchQuotesForSymbols:(NSArray *)symbols completionHandler:(FAQuotesCompletionHandler)completionHandler
+{
+    if (symbols.count == 0) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            completionHandler(@{}, nil);
+        });
+        return;
+    }
+
+    dispatch_async(self.batcherQueue, ^{
+
+        // Get the unique API symbols, along with the requested tickers each one is for
+        NSMutableDictionary *tickersForSymbol = [[NSMutableDictionary alloc] init];
+        for (NSString *ticker in symbols) {
+            NSString *symbol = [self apiSymbolForTicker:ticker];
+            NSMutableArray *tickers = [tickersForSymbol objectForKey:symbol];
+            if (tickers == nil) {
+                tickers = [[NSMutableArray alloc] init];
+                [tickersForSymbol setObject:tickers forKey:symbol];
+            }
+            [tickers addObject:ticker];
+        }
+
+        // Collect the quotes for this request as they arrive and call the completion handler once the last one is in
+        NSMutableDictionary *quotes = [[NSMutableDictionary alloc] init];
+        __block NSError *firstError = nil;
+        __block NSUInteger symbolsRemaining = tickersForSymbol.count;
+
+        for (NSString *symbol in tickersForSymbol) {
+
+            NSArray *tickers = [tickersForSymbol objectForKey:symbol];
+            FAQuoteWaiter waiter = ^(NSDictionary *quote, NSError *error) {
+                if (quote) {
+                    for (NSString *ticker in tickers) {
+                        [quotes setObject:quote forKey:ticker];
+                    }
+                }
+                if (error && !firstError) {
+                    firstError = error;
+                }
+                if (--symbolsRemaining == 0) {
+                    NSDictionary *quotesFound = [quotes copy];
+                    NSError *quotesError = firstError;
+                    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                        completionHandler(quotesFound, quotesError);
+                    });
+                }
+            };
+
+            // If the symbol is already being fetched, wait on that. Otherwise add it to the next set of calls.
+            NSMutableArray *waiters = [self.symbolWaiters objectForKey:symbol];
+            if (waiters) {
+                [waiters addObject:[waiter copy]];
+            } else {
+                [self.symbolWaiters setObject:[NSMutableArray arrayWithObject:[waiter copy]] forKey:symbol];
+                [self.pendingSymbols addObject:symbol];
+            }
+        }
+
+        // With no calls in flight there's nothing to wait on, so make the calls right away. Otherwise requests coalesce till the calls in flight
+        // come back, or the coalescing interval is up, whichever is first.
+        if (self.pendingSymbols.count > 0) {
+            if (self.callsInFlight == 0) {
+                [self flushPendingSymbols];
+            } else if (!self.flushScheduled) {
+                self.flushScheduled = YES;
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.coalescingInterval * NSEC_PER_SEC)), self.batcherQueue, ^{
+                    [self flushPendingSymbols];
+                });
+            }
+        }
+    });
+}
+
+// Fetch the current quotes for the given tickers and wait for them to come in. The calling thread is parked, not spinning, till then.
+- (NSDictionary *)quotesForSymbols:(NSArray *)symbols error:(NSError **)error
+{
+    NSDictionary __block *quotesFound = nil;
+    NSError __block *quotesError = nil;
+    dispatch_semaphore_t quotesFetched = dispatch_semaphore_create(0);
+
+    [self fetchQuotesForSymbols:symbols completionHandler:^(NSDictionary *quotes, NSError *fetchError) {
+        quotesFound = quotes;
+        quotesError = fetchError;
+        dispatch_semaphore_signal(quotesFetched);
+    }];
+
+    dispatch_semaphore_wait(quotesFetched, DISPATCH_TIME_FOREVER);
+
+    if (error) {
+        *error = quotesError;
+    }
+    return quotesFound;
+}
+
+// Make the calls for all the pending symbols, if there are any. Called on the batcher queue.
+- (void)flushPendingSymbols
+{
+    self.flushScheduled = NO;
+    if (self.pendingSymbols.count == 0) {
+        return;
+    }
+    NSArray *symbols = [self.pendingSymbols array];
+    [self.pendingSymbols removeAllObjects];
+
+    // Chunks are fetched in parallel
+    for (NSArray *chunk in [self chunksForSymbols:symbols]) {
+        self.callsInFlight++;
+        [self fetchQuotesForChunk:chunk];
+    }
+}
+
+// Split the symbols into chunks, each of which fits in a request URL of the max length.
+- (NSArray *)chunksForSymbols:(NSArray *)symbols
+{
+    NSMutableArray *chunks = [[NSMutableArray alloc] init];
+    NSMutableArray *chunk = [[NSMutableArray alloc] init];
+    NSUInteger baseLength = [[self quoteURLStringForSymbols:@[]] length];
+    NSUInteger chunkLength = baseLength;
+
+    for (NSString *symbol in symbols) {
+
+        // Each symbol adds it's escaped length plus a separating comma
+        NSUInteger symbolLength = [[symbol stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLQueryAllowedCharacterSet]] length] + 1;
+        if ((chunk.count > 0)&&((chunkLength + symbolLength) > self.maxRequestURLLength)) {
+            [chunks addObject:chunk];
+            chunk = [[NSMutableArray alloc] init];
+            chunkLength = baseLength;
+        }
+        [chunk addObject:symbol];
+        chunkLength += symbolLength;
+    }
+    if (chunk.count > 0) {
+        [chunks addObject:chunk];
+    }
+
+    return chunks;
+}
+
+// Get the quote API URL for the given symbols
+- (NSString *)quoteURLStringForSymbols:(NSArray *)symbols
+{
+    NSString *symbolsToFetch = [[symbols componentsJoinedByString:@","] stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLQueryAllowedCharacterSet]];
+    return [NSString stringWithFormat:@"%@&symbols=%@%@",FAQuoteEndpointURL,symbolsToFetch,FAQuoteAddtlFields];
+}
+
+// Make a single call for the quotes for a chunk of symbols and hand them to the waiters when they arrive.
+- (void)fetchQuotesForChunk:(NSArray *)chunk
+{
+    NSMutableURLRequest *quotesRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:[self quoteURLStringForSymbols:chunk]]];
+    [self.requestController sendAsynchronousRequest:quotesRequest completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+
+        NSMutableDictionary *quotes = [[NSMutableDictionary alloc] init];
+
+        if ((error == nil)&&(data != nil)) {
+
+            // Pull out the quote for each symbol in the chunk. If the response is an error message, there won't be any results and thus no quotes.
+            NSSet *chunkSymbols = [NSSet setWithArray:chunk];
+            NSError *parseError = nil;
+            FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:data];
+            if (![responseReader enumerateRecordsAtPath:@"results" fields:@[@"symbol",@"mode",@"tradeTimestamp",@"lastPrice",@"netChange",@"percentChange",@"fiftyTwoWkHigh",@"fiftyTwoWkHighDate",@"fiftyTwoWkLow",@"fiftyTwoWkLowDate"] error:&parseError usingBlock:^(NSDictionary *quote, BOOL *stop) {
+                id quoteSymbol = [quote objectForKey:@"symbol"];
+                if ([quoteSymbol isKindOfClass:[NSString class]]) {
+                    NSString *symbol = [self apiSymbolForTicker:quoteSymbol];
+                    if ([chunkSymbols containsObject:symbol]) {
+                        [quotes setObject:quote forKey:symbol];
+                    }
+                }
+            }]) {
+                // Don't hand out quotes from a response that can't be read in full
+                NSLog(@"ERROR: Could not parse the quote API response. Error description: %@",parseError.description);
+                [quotes removeAllObjects];
+                error = parseError;
+            }
+        } else {
+            NSLog(@"ERROR: Could not get quotes from the API Data Source. Error description: %@",error.description);
+        }
+
+        dispatch_async(self.batcherQueue, ^{
+            [self deliverQuotes:quotes error:error forChunk:chunk];
+        });
+    }];
+}
+
+// Hand the quotes for a chunk of symbols to everyone waiting on them. Called on the batcher queue.
+- (void)deliverQuotes:(NSDictionary *)quotes error:(NSError *)error forChunk:(NSArray *)chunk
+{
+    for (NSString *symbol in chunk) {
+
+        // Take the symbol out of the ones being fetched, so that any later request makes a fresh call for it
+        NSArray *waiters = [self.symbolWaiters objectForKey:symbol];
+        [self.symbolWaiters removeObjectForKey:symbol];
+
+        NSDictionary *quote = [quotes objectForKey:symbol];
+        for (FAQuoteWaiter waiter in waiters) {
+            waiter(quote, error);
+        }
+    }
+
+    // Once the last call in flight is back, make the calls for the requests that coalesced while waiting on it
+    self.callsInFlight--;
+    if (self.callsInFlight == 0) {
+        [self flushPendingSymbols];
+    }
+}
+
+#pragma mark - Utility Methods
+
+// Format a ticker the way the quote API expects it e.g. for V.HSR replace with V_HSR. Also used as the key to match quotes to requests.
+- (NSString *)apiSymbolForTicker:(NSString *)ticker
+{
+    return [[ticker stringByReplacingOccurrencesOfString:@"." withString:@"_"] uppercaseString];
+}
+
+@end
@@ -0,0 +1,48 @@
+//
+//  FASearchPipeline.h
+//  FinApp
+//
+//  Class that runs search as you type off the main thread. Keystrokes are debounced and
+//  a search made obsolete by newer text is dropped, whether it's waiting to run or has
+//  already run. Searches run on a private queue context. When the new text extends the
+//  text of the last search, in the same scope, the last results are narrowed in memory
+//  instead of being searched for again in the data store, till the search is cancelled
+//  or the data store changes. The main thread only gets a results controller over the
+//  identities of the matching objects.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+@class NSFetchedResultsController;
+
+// What a search is run against.
+typedef NS_ENUM(NSInteger, FASearchScope) {
+    // Future events, as in searchEventsFor:eventDisplayType:
+    FASearchScopeEvents = 0,
+    // Following future events, as in searchFollowingEventsFor:eventDisplayType:
+    FASearchScopeFollowingEvents = 1,
+    // Companies, as in searchCompaniesFor:
+    FASearchScopeCompanies = 2
+};
+
+// Block called on the main thread with the results of a search that hasn't been made obsolete. The results controller is on the main queue context and
+// has already been fetched. matchedCompanies is YES if the results are companies, either because the scope was companies or because no events matched
+// and the search fell back to companies.
+typedef void (^FASearchCompletionHandler)(NSFetchedResultsController *resultsController, BOOL matchedCompanies);
+
+@interface FASearchPipeline : NSObject
+
+// How long to wait after a keystroke for the next one, before searching. Defaults to 0.2 secs.
+@property (nonatomic) NSTimeInterval debounceInterval;
+
+// Search for the text in the given scope, once typing pauses. Event display type is as for searchEventsFor:eventDisplayType: and is ignored for companies.
+// If no events match and fallBackToCompanies is YES, companies are searched instead. Any earlier search that hasn't completed is dropped. Call on the main thread.
+- (void)searchFor:(NSString *)searchText scope:(FASearchScope)scope eventDisplayType:(NSString *)eventType fallBackToCompanies:(BOOL)fallBackToCompanies completionHandler:(FASearchCompletionHandler)completionHandler;
+
+// Drop any search that hasn't completed, e.g. because the search text was cleared or a search was run directly. The last results are forgotten too,
+// so the next search goes to the data store. Call on the main thread.
+- (void)cancelPendingSearches;
+
+@end
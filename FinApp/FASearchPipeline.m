@@ -0,0 +1,251 @@
+//
+//  FASearchPipeline.m
+//  FinApp
+//
+//  Class that runs search as you type off the main thread. Keystrokes are debounced and
+//  a search made obsolete by newer text is dropped, whether it's waiting to run or has
+//  already run. Searches run on a private queue context. When the new text extends the
+//  text of the last search, in the same scope, the last results are narrowed in memory
+//  instead of being searched for again in the data store, till the search is cancelled
+//  or the data store changes. The main thread only gets a results controller over the
+//  identities of the matching objects.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FASearchPipeline.h"
+#import <CoreData/CoreData.h>
+#import "FADataStore.h"
+#import "FADataController.h"
+
+@interface FASearchPipeline ()
+
+// Private queue context, child of the writer context, that searches are run on.
+@property (strong, nonatomic) NSManagedObjectContext *searchContext;
+
+// Data controller on the search context, used to build the search fetch requests.
+@property (strong, nonatomic) FADataController *searchDataController;
+
+// Incremented for every search and cancel. A search only runs and completes if it's still the latest. Set on the main thread, read on the search context's
+// queue, always under a lock on the pipeline.
+@property (nonatomic) NSUInteger searchGeneration;
+
+// Scope, event display type and fall back of the last search run, text folded for case and diacritics, and it's results, in sort order. Kept to narrow
+// down the results in memory when the next search extends the text. Only used on the search context's queue.
+@property (strong, nonatomic) NSString *lastSearchKey;
+@property (strong, nonatomic) NSString *lastSearchText;
+@property (strong, nonatomic) NSArray *lastResults;
+@property (nonatomic) BOOL lastResultsAreCompanies;
+
+// Start a new search generation, making any earlier search obsolete, and return it. Call on the main thread.
+- (NSUInteger)nextSearchGeneration;
+
+// Is the generation still the latest search. Can be called on any thread.
+- (BOOL)isLatestSearchGeneration:(NSUInteger)generation;
+
+// Forget the last search and it's results, so that the next search goes to the data store. Called when the search is cancelled or the data store changes.
+- (void)clearLastResults;
+
+// When the writer context saves, the last results may be missing new objects or hold deleted ones, so forget them.
+- (void)writerContextDidSave:(NSNotification *)notification;
+
+// When objects are bulk deleted from the store, which doesn't go through the writer context's save, the last results may hold them, so forget them.
+- (void)dataStoreDidBatchDelete:(NSNotification *)notification;
+
+// Run the search, if it's still the latest, and hand the results to the completion handler on the main thread. Called on the search context's queue.
+- (void)runSearchFor:(NSString *)searchText scope:(FASearchScope)scope eventDisplayType:(NSString *)eventType fallBackToCompanies:(BOOL)fallBackToCompanies generation:(NSUInteger)generation completionHandler:(FASearchCompletionHandler)completionHandler;
+
+// Get the matching objects for the fetch request, from the data store, with their values loaded so that they can be narrowed down in memory later. Called on the search context's queue.
+- (NSArray *)fetchResultsForRequest:(NSFetchRequest *)searchRequest;
+
+@end
+
+@implementation FASearchPipeline
+
+// Set up the search context.
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.debounceInterval = 0.2;
+        self.searchContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+        [self.searchContext setParentContext:[[FADataStore sharedStore] writerContext]];
+        self.searchDataController = [[FADataController alloc] init];
+        self.searchDataController.managedObjectContext = self.searchContext;
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(writerContextDidSave:)
+                                                     name:NSManagedObjectContextDidSaveNotification object:[[FADataStore sharedStore] writerContext]];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(dataStoreDidBatchDelete:)
+                                                     name:FADataStoreDidBatchDeleteNotification object:[FADataStore sharedStore]];
+    }
+    return self;
+}
+
+// Stop listening for saves
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Searching
+
+// Search for the text in the given scope, once typing pauses. Any earlier search that hasn't completed is dropped. Call on the main thread.
+- (void)searchFor:(NSString *)searchText scope:(FASearchScope)scope eventDisplayType:(NSString *)eventType fallBackToCompanies:(BOOL)fallBackToCompanies completionHandler:(FASearchCompletionHandler)completionHandler
+{
+    NSUInteger generation = [self nextSearchGeneration];
+    NSString *searchTextCopy = [searchText copy];
+
+    // Only search if no other keystroke has come in by the time the debounce interval is up
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.debounceInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (![self isLatestSearchGeneration:generation]) {
+            return;
+        }
+        [self.searchContext performBlock:^{
+            [self runSearchFor:searchTextCopy scope:scope eventDisplayType:eventType fallBackToCompanies:fallBackToCompanies generation:generation completionHandler:completionHandler];
+        }];
+    });
+}
+
+// Drop any search that hasn't completed. Call on the main thread.
+- (void)cancelPendingSearches
+{
+    [self nextSearchGeneration];
+    
+    // The search text has been cleared or searched for directly, so the next search as you type starts over from the data store
+    [self clearLastResults];
+}
+
+// Start a new search generation, making any earlier search obsolete, and return it. Call on the main thread.
+- (NSUInteger)nextSearchGeneration
+{
+    @synchronized(self) {
+        self.searchGeneration = self.searchGeneration + 1;
+        return self.searchGeneration;
+    }
+}
+
+// Is the generation still the latest search. Can be called on any thread.
+- (BOOL)isLatestSearchGeneration:(NSUInteger)generation
+{
+    @synchronized(self) {
+        return (generation == self.searchGeneration);
+    }
+}
+
+// Forget the last search and it's results, so that the next search goes to the data store. Called when the search is cancelled or the data store changes.
+- (void)clearLastResults
+{
+    [self.searchContext performBlock:^{
+        self.lastSearchKey = nil;
+        self.lastSearchText = nil;
+        self.lastResults = nil;
+        self.lastResultsAreCompanies = NO;
+    }];
+}
+
+// When the writer context saves, the last results may be missing new objects or hold deleted ones, so forget them.
+- (void)writerContextDidSave:(NSNotification *)notification
+{
+    [self clearLastResults];
+}
+
+// When objects are bulk deleted from the store, which doesn't go through the writer context's save, the last results may hold them, so forget them.
+- (void)dataStoreDidBatchDelete:(NSNotification *)notification
+{
+    [self clearLastResults];
+}
+
+// Run the search, if it's still the latest, and hand the results to the completion handler on the main thread. Called on the search context's queue.
+- (void)runSearchFor:(NSString *)searchText scope:(FASearchScope)scope eventDisplayType:(NSString *)eventType fallBackToCompanies:(BOOL)fallBackToCompanies generation:(NSUInteger)generation completionHandler:(FASearchCompletionHandler)completionHandler
+{
+    // If newer text has come in while this was waiting to run, don't bother
+    if (![self isLatestSearchGeneration:generation]) {
+        return;
+    }
+
+    NSString *searchKey = [NSString stringWithFormat:@"%ld_%@_%d",(long)scope,eventType,fallBackToCompanies];
+    NSString *foldedSearchText = [searchText stringByFoldingWithOptions:(NSCaseInsensitiveSearch|NSDiacriticInsensitiveSearch) locale:nil];
+
+    // Get the search requests the same way the data controller search methods do
+    NSFetchRequest *eventsRequest = nil;
+    if (scope == FASearchScopeEvents) {
+        eventsRequest = [self.searchDataController searchEventsFetchRequestFor:searchText eventDisplayType:eventType];
+    }
+    if (scope == FASearchScopeFollowingEvents) {
+        eventsRequest = [self.searchDataController searchFollowingEventsFetchRequestFor:searchText eventDisplayType:eventType];
+    }
+    NSFetchRequest *companiesRequest = [self.searchDataController searchCompaniesFetchRequestFor:searchText];
+
+    // Anything matching text that extends the last search text also matched the last search text, so the results are a subset of the
+    // last results and can be narrowed down in memory. That's also true of the companies fallen back to, since no events could match either.
+    BOOL refineLastResults = (self.lastResults != nil) && [searchKey isEqualToString:self.lastSearchKey] && [foldedSearchText hasPrefix:self.lastSearchText];
+    NSArray *results = nil;
+    BOOL matchedCompanies = NO;
+    if (refineLastResults) {
+        matchedCompanies = self.lastResultsAreCompanies;
+        results = [self.lastResults filteredArrayUsingPredicate:(matchedCompanies ? companiesRequest.predicate : eventsRequest.predicate)];
+    }
+    else {
+        // Start with a clean context so that objects from earlier searches don't build up
+        [self.searchContext reset];
+        if (eventsRequest != nil) {
+            results = [self fetchResultsForRequest:eventsRequest];
+        } else {
+            results = [self fetchResultsForRequest:companiesRequest];
+            matchedCompanies = YES;
+        }
+    }
+    if ((results.count == 0) && !matchedCompanies && fallBackToCompanies) {
+        results = [self fetchResultsForRequest:companiesRequest];
+        matchedCompanies = YES;
+    }
+
+    self.lastSearchKey = searchKey;
+    self.lastSearchText = foldedSearchText;
+    self.lastResults = results;
+    self.lastResultsAreCompanies = matchedCompanies;
+
+    // Hand over the identities of the results, in order, to the main thread and get a results controller over just those, in the same order
+    NSFetchRequest *searchRequest = matchedCompanies ? companiesRequest : eventsRequest;
+    NSString *entityName = searchRequest.entityName;
+    NSArray *sortDescriptors = searchRequest.sortDescriptors;
+    NSArray *resultIDs = [results valueForKey:@"objectID"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+
+        if (![self isLatestSearchGeneration:generation]) {
+            return;
+        }
+
+        NSManagedObjectContext *uiContext = [[FADataStore sharedStore] mainContext];
+        NSFetchRequest *resultsRequest = [[NSFetchRequest alloc] initWithEntityName:entityName];
+        [resultsRequest setPredicate:[NSPredicate predicateWithFormat:@"SELF IN %@", resultIDs]];
+        [resultsRequest setSortDescriptors:sortDescriptors];
+        [resultsRequest setFetchBatchSize:15];
+        NSFetchedResultsController *resultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:resultsRequest
+                                                                                            managedObjectContext:uiContext sectionNameKeyPath:nil
+                                                                                                       cacheName:nil];
+        NSError *error;
+        if (![resultsController performFetch:&error]) {
+            NSLog(@"ERROR: Getting the %ld search results for search text: %@ from data store failed: %@",(long)resultIDs.count,searchText,error.description);
+        }
+
+        completionHandler(resultsController, matchedCompanies);
+    });
+}
+
+// Get the matching objects for the fetch request, from the data store, with their values loaded so that they can be narrowed down in memory later. Called on the search context's queue.
+- (NSArray *)fetchResultsForRequest:(NSFetchRequest *)searchRequest
+{
+    [searchRequest setFetchBatchSize:0];
+    [searchRequest setReturnsObjectsAsFaults:NO];
+    NSError *error;
+    NSArray *results = [self.searchContext executeFetchRequest:searchRequest error:&error];
+    if (error) {
+        NSLog(@"ERROR: Searching for %@ in the background failed: %@",searchRequest.entityName,error.description);
+    }
+    return results ? results : @[];
+}
+
+@end
@@ -21,10 +21,10 @@
 // Returns if that event is a High Impact event or not. Examples of high impact events: 1) High impact product launches like iPhone 8, Naples Chip as these either validate my investment thesis or help form a new one. 2) High impact econ events that help shed light on how the market is likely to play out. e.g. Interest rates are likely to go up. Financials will do well. GDP is a big number stocks will likely do well.3) Big name companies earnings like FANG or Apple whose earnings can impact overall market.
 - (BOOL)isEventHighImpact:(NSString *)eventType eventParent:(NSString *)parentTicker;
 
-/// Get the brand background color for given ticker
+/// Get the brand background color for given ticker, in any case, from the bundled BrandColors.json table. Colors are created once and shared.
 - (UIColor *)getBrandBkgrndColorForCompany:(NSString *)ticker;
 
-// Get the brand text color for given ticker
+// Get the brand text color for given ticker, in any case, from the bundled BrandColors.json table.
 - (UIColor *)getBrandTextColorForCompany:(NSString *)ticker;
 
 @end
@@ -0,0 +1,103 @@
+//
+//  FATrace.h
+//  FinApp
+//
+//  Lightweight tracing of the hot paths i.e. Core Data fetches and saves, API calls, JSON
+//  parsing, cell configuration, search keystrokes and launch. Each of these is timed as a span and
+//  added to a per span log2 histogram, and to a ring buffer of the most recent spans. Counters
+//  keep running totals e.g. of bytes downloaded. Tracing is off by default and while it's off
+//  starting a span or adding to a counter is a single check of a global flag. Turn it on by
+//  launching with -FATraceEnabled YES or by calling setEnabled:. The summary and a compact
+//  binary trace are written out when the app goes into the background.
+//
+//  Usage:
+//  uint64_t spanStart = FATraceBegin();
+//  ... work ...
+//  FATraceEnd(FATraceSpanCoreDataFetch, spanStart);
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <mach/mach_time.h>
+
+// Kinds of spans that are timed
+typedef NS_ENUM(NSUInteger, FATraceSpan) {
+    FATraceSpanCoreDataFetch = 0,
+    FATraceSpanCoreDataSave = 1,
+    FATraceSpanApiCall = 2,
+    FATraceSpanJSONParse = 3,
+    FATraceSpanCellConfiguration = 4,
+    // From a keystroke in the search bar to the results for it being shown
+    FATraceSpanSearchKeystroke = 5,
+    // From the process starting to the first events list being rendered
+    FATraceSpanLaunch = 6,
+    // Number of kinds of spans
+    FATraceSpanCount = 7
+};
+
+// Counters that keep running totals
+typedef NS_ENUM(NSUInteger, FATraceCounter) {
+    FATraceCounterFetchedObjects = 0,
+    // Objects inserted, updated or deleted by saves
+    FATraceCounterSavedObjects = 1,
+    FATraceCounterApiBytes = 2,
+    FATraceCounterApiFailures = 3,
+    FATraceCounterParsedRecords = 4,
+    // Number of counters
+    FATraceCounterCount = 5
+};
+
+// Is tracing on. Read directly by the inline functions below so that they cost a single check when tracing is off. Use setEnabled: to change it.
+extern volatile BOOL FATraceEnabled;
+
+// Record a span that started at the given time, in mach absolute time units, and ended now. Use FATraceEnd instead.
+void FATraceRecordSpan(FATraceSpan span, uint64_t startTime);
+
+// Add to a counter. Use FATraceCount instead.
+void FATraceAddToCounter(FATraceCounter counter, int64_t amount);
+
+// Start a span. Returns the start time to pass to FATraceEnd, or 0 if tracing is off.
+static inline uint64_t FATraceBegin(void)
+{
+    return FATraceEnabled ? mach_absolute_time() : 0;
+}
+
+// End a span started with FATraceBegin. Does nothing if tracing was off when the span started.
+static inline void FATraceEnd(FATraceSpan span, uint64_t startTime)
+{
+    if (startTime != 0) {
+        FATraceRecordSpan(span, startTime);
+    }
+}
+
+// Add to a counter, if tracing is on.
+static inline void FATraceCount(FATraceCounter counter, int64_t amount)
+{
+    if (FATraceEnabled) {
+        FATraceAddToCounter(counter, amount);
+    }
+}
+
+@interface FATrace : NSObject
+
+// Turn tracing on or off. Spans and counters recorded so far are kept.
++ (void)setEnabled:(BOOL)enabled;
+
+// Turn tracing on if the FATraceEnabled user default is set e.g. by launching with -FATraceEnabled YES
++ (void)enableIfRequested;
+
+// Clear all spans and counters recorded so far
++ (void)reset;
+
+// Get a text summary with, for each kind of span, the count, total, mean and max time and the histogram of times and then the counters.
++ (NSString *)summary;
+
+// Get the compact binary trace. See FATrace.m for the format.
++ (NSData *)traceData;
+
+// If tracing is on, log the summary and write the binary trace to FATrace.bin in the caches directory
++ (void)dumpTrace;
+
+@end
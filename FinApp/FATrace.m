@@ -0,0 +1,229 @@
+//
+//  FATrace.m
+//  FinApp
+//
+//  Lightweight tracing of the hot paths i.e. Core Data fetches and saves, API calls, JSON
+//  parsing, cell configuration, search keystrokes and launch. Spans and counters are recorded with
+//  lock free atomic adds, so they can be recorded from any thread.
+//
+//  Binary trace format, in the byte order of the device:
+//  Header, 32 bytes: "FATR", format version, number of kinds of spans, number of histogram
+//  buckets, number of counters, number of span records, then the mach timebase numerator and
+//  denominator that convert record start times to nanoseconds.
+//  For each kind of span: count, total microseconds, max microseconds, then the histogram, all
+//  uint64_t. Bucket 0 counts spans under 1 microsecond and bucket n those from 2^(n-1) to 2^n
+//  microseconds, with the last bucket also counting anything longer.
+//  Counters, int64_t each.
+//  Span records, oldest first, 16 bytes each: start time in mach absolute time units (uint64_t),
+//  duration in microseconds (uint32_t), kind of span (uint16_t), 1 if on the main thread else 0 (uint16_t).
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FATrace.h"
+#import <stdatomic.h>
+#import <pthread.h>
+
+// Format version of the binary trace
+static const uint32_t FATraceFormatVersion = 1;
+
+// Number of log2 buckets in the histogram of each kind of span. The last one goes up to about 18 minutes.
+#define FATraceBucketCount 32
+
+// Number of most recent spans kept in the ring buffer. Must be a power of two.
+#define FATraceRecordCapacity 4096
+
+// A span in the ring buffer
+typedef struct {
+    uint64_t startTime;
+    uint32_t durationMicros;
+    uint16_t span;
+    uint16_t onMainThread;
+} FATraceRecord;
+
+volatile BOOL FATraceEnabled = NO;
+
+// Histogram and totals for each kind of span
+static _Atomic uint64_t FATraceSpanCounts[FATraceSpanCount];
+static _Atomic uint64_t FATraceSpanTotalMicros[FATraceSpanCount];
+static _Atomic uint64_t FATraceSpanMaxMicros[FATraceSpanCount];
+static _Atomic uint64_t FATraceSpanBuckets[FATraceSpanCount][FATraceBucketCount];
+
+// Running totals of the counters
+static _Atomic int64_t FATraceCounterTotals[FATraceCounterCount];
+
+// Ring buffer of the most recent spans and the total number of spans ever written to it
+static FATraceRecord FATraceRecords[FATraceRecordCapacity];
+static _Atomic uint64_t FATraceRecordsWritten;
+
+// Mach timebase, to convert mach absolute time units to nanoseconds. Set before tracing is first turned on.
+static mach_timebase_info_data_t FATraceTimebase;
+
+// Names of the kinds of spans and counters, as shown in the summary
+static NSString * const FATraceSpanNames[FATraceSpanCount] = {@"fetch", @"save", @"api", @"json", @"cell", @"search", @"launch"};
+static NSString * const FATraceCounterNames[FATraceCounterCount] = {@"fetched objects", @"saved objects", @"api bytes", @"api failures", @"parsed records"};
+
+#pragma mark - Recording
+
+// Record a span that started at the given time, in mach absolute time units, and ended now.
+void FATraceRecordSpan(FATraceSpan span, uint64_t startTime)
+{
+    if (span >= FATraceSpanCount) {
+        return;
+    }
+    uint64_t endTime = mach_absolute_time();
+    uint64_t durationMicros = ((endTime - startTime) * FATraceTimebase.numer / FATraceTimebase.denom) / 1000;
+
+    // Bucket 0 is under 1 microsecond, bucket n is from 2^(n-1) to 2^n microseconds
+    NSUInteger bucket = (durationMicros == 0) ? 0 : (64 - __builtin_clzll(durationMicros));
+    if (bucket >= FATraceBucketCount) {
+        bucket = FATraceBucketCount - 1;
+    }
+
+    atomic_fetch_add_explicit(&FATraceSpanCounts[span], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&FATraceSpanTotalMicros[span], durationMicros, memory_order_relaxed);
+    atomic_fetch_add_explicit(&FATraceSpanBuckets[span][bucket], 1, memory_order_relaxed);
+    uint64_t maxMicros = atomic_load_explicit(&FATraceSpanMaxMicros[span], memory_order_relaxed);
+    while ((durationMicros > maxMicros) && !atomic_compare_exchange_weak_explicit(&FATraceSpanMaxMicros[span], &maxMicros, durationMicros, memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    // A record being overwritten while it's read for a dump only garbles that one record, which is fine for diagnostics
+    uint64_t recordNo = atomic_fetch_add_explicit(&FATraceRecordsWritten, 1, memory_order_relaxed);
+    FATraceRecord *record = &FATraceRecords[recordNo & (FATraceRecordCapacity - 1)];
+    record->startTime = startTime;
+    record->durationMicros = (durationMicros > UINT32_MAX) ? UINT32_MAX : (uint32_t)durationMicros;
+    record->span = (uint16_t)span;
+    record->onMainThread = pthread_main_np() ? 1 : 0;
+}
+
+// Add to a counter.
+void FATraceAddToCounter(FATraceCounter counter, int64_t amount)
+{
+    if (counter >= FATraceCounterCount) {
+        return;
+    }
+    atomic_fetch_add_explicit(&FATraceCounterTotals[counter], amount, memory_order_relaxed);
+}
+
+@implementation FATrace
+
+#pragma mark - Turning Tracing On And Off
+
+// Turn tracing on or off. Spans and counters recorded so far are kept.
++ (void)setEnabled:(BOOL)enabled
+{
+    static dispatch_once_t timebaseOnce;
+    dispatch_once(&timebaseOnce, ^{
+        mach_timebase_info(&FATraceTimebase);
+    });
+
+    FATraceEnabled = enabled;
+}
+
+// Turn tracing on if the FATraceEnabled user default is set e.g. by launching with -FATraceEnabled YES
++ (void)enableIfRequested
+{
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"FATraceEnabled"]) {
+        [self setEnabled:YES];
+    }
+}
+
+// Clear all spans and counters recorded so far
++ (void)reset
+{
+    for (NSUInteger span = 0; span < FATraceSpanCount; span++) {
+        atomic_store(&FATraceSpanCounts[span], 0);
+        atomic_store(&FATraceSpanTotalMicros[span], 0);
+        atomic_store(&FATraceSpanMaxMicros[span], 0);
+        for (NSUInteger bucket = 0; bucket < FATraceBucketCount; bucket++) {
+            atomic_store(&FATraceSpanBuckets[span][bucket], 0);
+        }
+    }
+    for (NSUInteger counter = 0; counter < FATraceCounterCount; counter++) {
+        atomic_store(&FATraceCounterTotals[counter], 0);
+    }
+    atomic_store(&FATraceRecordsWritten, 0);
+}
+
+#pragma mark - Reporting
+
+// Get a text summary with, for each kind of span, the count, total, mean and max time and the histogram of times and then the counters.
+// The histogram is shown as upper bound in microseconds:count for each bucket that has any spans e.g. 64:12 is 12 spans from 32 to 64 microseconds.
++ (NSString *)summary
+{
+    NSMutableString *summary = [NSMutableString stringWithString:@"span      count    total ms   mean us    max us  histogram (us:count)\n"];
+
+    for (NSUInteger span = 0; span < FATraceSpanCount; span++) {
+        uint64_t count = atomic_load(&FATraceSpanCounts[span]);
+        uint64_t totalMicros = atomic_load(&FATraceSpanTotalMicros[span]);
+        [summary appendFormat:@"%@ %6llu %11.1f %9llu %9llu ",[FATraceSpanNames[span] stringByPaddingToLength:8 withString:@" " startingAtIndex:0],count,(totalMicros / 1000.0),(count ? (totalMicros / count) : 0),atomic_load(&FATraceSpanMaxMicros[span])];
+        for (NSUInteger bucket = 0; bucket < FATraceBucketCount; bucket++) {
+            uint64_t bucketCount = atomic_load(&FATraceSpanBuckets[span][bucket]);
+            if (bucketCount > 0) {
+                [summary appendFormat:@" %llu:%llu",(1ULL << bucket),bucketCount];
+            }
+        }
+        [summary appendString:@"\n"];
+    }
+
+    for (NSUInteger counter = 0; counter < FATraceCounterCount; counter++) {
+        [summary appendFormat:@"%@: %lld\n",FATraceCounterNames[counter],atomic_load(&FATraceCounterTotals[counter])];
+    }
+
+    return summary;
+}
+
+// Get the compact binary trace. See the top of this file for the format.
++ (NSData *)traceData
+{
+    uint64_t recordsWritten = atomic_load(&FATraceRecordsWritten);
+    uint32_t recordCount = (uint32_t)MIN(recordsWritten, (uint64_t)FATraceRecordCapacity);
+
+    NSMutableData *traceData = [[NSMutableData alloc] init];
+    uint32_t header[8] = {0, FATraceFormatVersion, FATraceSpanCount, FATraceBucketCount, FATraceCounterCount, recordCount, FATraceTimebase.numer, FATraceTimebase.denom};
+    memcpy(&header[0], "FATR", 4);
+    [traceData appendBytes:header length:sizeof(header)];
+
+    for (NSUInteger span = 0; span < FATraceSpanCount; span++) {
+        uint64_t spanTotals[3 + FATraceBucketCount];
+        spanTotals[0] = atomic_load(&FATraceSpanCounts[span]);
+        spanTotals[1] = atomic_load(&FATraceSpanTotalMicros[span]);
+        spanTotals[2] = atomic_load(&FATraceSpanMaxMicros[span]);
+        for (NSUInteger bucket = 0; bucket < FATraceBucketCount; bucket++) {
+            spanTotals[3 + bucket] = atomic_load(&FATraceSpanBuckets[span][bucket]);
+        }
+        [traceData appendBytes:spanTotals length:sizeof(spanTotals)];
+    }
+
+    for (NSUInteger counter = 0; counter < FATraceCounterCount; counter++) {
+        int64_t counterTotal = atomic_load(&FATraceCounterTotals[counter]);
+        [traceData appendBytes:&counterTotal length:sizeof(counterTotal)];
+    }
+
+    // Records, oldest first
+    for (uint64_t recordNo = recordsWritten - recordCount; recordNo < recordsWritten; recordNo++) {
+        [traceData appendBytes:&FATraceRecords[recordNo & (FATraceRecordCapacity - 1)] length:sizeof(FATraceRecord)];
+    }
+
+    return traceData;
+}
+
+// If tracing is on, log the summary and write the binary trace to FATrace.bin in the caches directory
++ (void)dumpTrace
+{
+    if (!FATraceEnabled) {
+        return;
+    }
+
+    NSLog(@"FATrace summary:\n%@",[self summary]);
+
+    NSURL *cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] lastObject];
+    NSURL *traceURL = [cachesURL URLByAppendingPathComponent:@"FATrace.bin"];
+    NSError *error = nil;
+    if (![[self traceData] writeToURL:traceURL options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"ERROR: Writing the binary trace failed: %@",error.description);
+    }
+}
+
+@end
@@ -0,0 +1,18 @@
+//
+//  FATracedManagedObjectContext.h
+//  FinApp
+//
+//  Managed object context that times every fetch and save it does as a FATrace span, so
+//  that all Core Data work, including fetches done by fetched results controllers, shows
+//  up in the trace without each call site having to be instrumented. Costs a single check
+//  of the tracing flag per fetch or save when tracing is off.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <CoreData/CoreData.h>
+
+@interface FATracedManagedObjectContext : NSManagedObjectContext
+
+@end
@@ -0,0 +1,44 @@
+//
+//  FATracedManagedObjectContext.m
+//  FinApp
+//
+//  Managed object context that times every fetch and save it does as a FATrace span. Only
+//  fetching and saving are overridden, and both call straight through to the superclass,
+//  so change tracking and merging are untouched.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FATracedManagedObjectContext.h"
+#import "FATrace.h"
+
+@implementation FATracedManagedObjectContext
+
+// Fetch, timing it as a Core Data fetch span and counting the objects fetched
+- (NSArray *)executeFetchRequest:(NSFetchRequest *)request error:(NSError **)error
+{
+    uint64_t spanStart = FATraceBegin();
+    NSArray *fetchedObjects = [super executeFetchRequest:request error:error];
+    if (spanStart != 0) {
+        FATraceEnd(FATraceSpanCoreDataFetch, spanStart);
+        FATraceCount(FATraceCounterFetchedObjects, (int64_t)fetchedObjects.count);
+    }
+    
+    return fetchedObjects;
+}
+
+// Save, timing it as a Core Data save span and counting the objects inserted, updated or deleted
+- (BOOL)save:(NSError **)error
+{
+    uint64_t spanStart = FATraceBegin();
+    if (spanStart != 0) {
+        FATraceCount(FATraceCounterSavedObjects, (int64_t)(self.insertedObjects.count + self.updatedObjects.count + self.deletedObjects.count));
+    }
+    BOOL saved = [super save:error];
+    FATraceEnd(FATraceSpanCoreDataSave, spanStart);
+    
+    return saved;
+}
+
+@end
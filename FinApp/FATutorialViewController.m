@@ -9,6 +9,7 @@
 //
 
 #import "FATutorialViewController.h"
+#import "FALaunchScheduler.h"
 
 @interface FATutorialViewController ()
 
@@ -21,6 +22,14 @@
     // Do any additional setup after loading the view.
 }
 
+- (void)viewDidAppear:(BOOL)animated {
+    
+    [super viewDidAppear:animated];
+    
+    // Let the launch scheduler know that the tutorial has been shown, so that the work waiting on the first frame can start
+    [[FALaunchScheduler sharedScheduler] firstFrameDidRender];
+}
+
 - (void)didReceiveMemoryWarning {
     [super didReceiveMemoryWarning];
     // Dispose of any resources that can be recreated.
@@ -0,0 +1,541 @@
+//
+//  FABenchmarkTests.m
+//  FinAppTests
+//
+//  Benchmarks for the data layer hot paths, run against a synthetic data store built by
+//  FASyntheticDataGenerator, with the remote data sources stubbed out by FAStubURLProtocol.
+//  The size of the store is set by the FA_BENCHMARK_SCALE environment variable, the number
+//  of events, from 10000 (the default) to 1000000. There is one company and one event history
+//  for every 10 events. Besides Xcode's own measurements, the timings are written, as JSON, to
+//  the path in FA_BENCHMARK_RESULTS_PATH, or FABenchmarkResults.json in the temporary directory,
+//  so that they can be compared across runs to catch regressions before release.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+#import "FASyntheticDataGenerator.h"
+#import "FAStubURLProtocol.h"
+#import "FADataController.h"
+#import "FADataStore.h"
+#import "FACompanySearchIndex.h"
+#import "FAEventsViewController.h"
+#import "FAEventRowViewModel.h"
+#import "FASnapShot.h"
+#import "FALaunchScheduler.h"
+#import "FAJSONStreamReader.h"
+#import "FAPriceBarStore.h"
+#import "FAEventClassification.h"
+#import "FADateCache.h"
+#import <mach/mach.h>
+
+// Number of events in the synthetic data store when FA_BENCHMARK_SCALE isn't set
+static const NSUInteger FABenchmarkDefaultScale = 10000;
+
+// Synthetic data store shared by all the benchmarks, it's size and the results of the benchmarks run so far
+static NSManagedObjectContext *FABenchmarkContext = nil;
+static FASyntheticDataGenerator *FABenchmarkGenerator = nil;
+static NSUInteger FABenchmarkScale = 0;
+static NSMutableArray *FABenchmarkResults = nil;
+
+// Methods, private to their classes, that are benchmarked
+@interface FADataController (FABenchmarks)
+
+- (BOOL)processStockPricesResponse:(NSData *)response forTicker:(NSString *)ticker forEventType:(NSString *)type;
+
+@end
+
+@interface FAEventsViewController (FABenchmarks)
+
+- (FAEventRowViewModel *)rowViewModelForEventType:(NSString *)eventType date:(NSDate *)eventDate relatedDetails:(NSString *)eventRelatedDetails certainty:(NSString *)eventCertainty ticker:(NSString *)companyTicker companyName:(NSString *)companyName priceTypeSelected:(BOOL)priceSelected;
+
+@end
+
+@interface FABenchmarkTests : XCTestCase
+
+// Data controller working on the synthetic data store
+@property (strong, nonatomic) FADataController *dataController;
+
+// Measure the block, the Xcode way, and record the time taken by each run of it in the benchmark results under the given name
+- (void)measureBenchmark:(NSString *)benchmarkName usingBlock:(void (^)(void))block;
+
+// Run the block and get how far the memory footprint of the process rose above where it started, in bytes, while it ran
+- (uint64_t)peakMemoryGrowthRunningBlock:(void (^)(void))block;
+
+@end
+
+// Get the CPU time, user and system, used by the current thread so far, in seconds.
+static double FABenchmarkThreadCPUTime(void)
+{
+    thread_basic_info_data_t threadInfo;
+    mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    mach_port_t thread = mach_thread_self();
+    kern_return_t result = thread_info(thread, THREAD_BASIC_INFO, (thread_info_t)&threadInfo, &count);
+    mach_port_deallocate(mach_task_self(), thread);
+    if (result != KERN_SUCCESS) {
+        return 0;
+    }
+    return (threadInfo.user_time.seconds + threadInfo.system_time.seconds) + ((threadInfo.user_time.microseconds + threadInfo.system_time.microseconds) / 1000000.0);
+}
+
+// Work out the kind of an event from it's type by matching substrings of it, the way each of the events list helpers that format a cell did before
+// FAEventClassification. Only used to compare against it.
+static FAEventKind FABenchmarkLegacyEventKind(NSString *eventType)
+{
+    if ([eventType isEqualToString:@"Quarterly Earnings"]) {
+        return FAEventKindEarnings;
+    }
+    if ([eventType containsString:@"US Fed Meeting"]||[eventType containsString:@"US Jobs Report"]||[eventType containsString:@"US Consumer Confidence"]||[eventType containsString:@"US GDP Release"]||[eventType containsString:@"India GDP Release"]||[eventType containsString:@"US Retail Sales"]||[eventType containsString:@"US Housing Starts"]||[eventType containsString:@"US New Homes Sales"]) {
+        return FAEventKindEcon;
+    }
+    if ([eventType containsString:@"Launch"]||[eventType containsString:@"Conference"]) {
+        return FAEventKindProduct;
+    }
+    if ([eventType containsString:@"% up"]||[eventType containsString:@"% down"]) {
+        if ([eventType containsString:@"today"]) {
+            return FAEventKindDailyMove;
+        }
+        if ([eventType containsString:@"30 days"]) {
+            return FAEventKindThirtyDayMove;
+        }
+        if ([eventType containsString:@"ytd"]) {
+            return FAEventKindYtdMove;
+        }
+    }
+    if ([eventType containsString:@"52 Week High"]||[eventType containsString:@"52 Week Low"]) {
+        return FAEventKind52WeekHighLow;
+    }
+    return FAEventKindUnknown;
+}
+
+@implementation FABenchmarkTests
+
+#pragma mark - Setup
+
+// Build the synthetic data store and stub out the remote data sources, once for all the benchmarks
++ (void)setUp {
+    [super setUp];
+
+    NSString *scaleStr = [[[NSProcessInfo processInfo] environment] objectForKey:@"FA_BENCHMARK_SCALE"];
+    FABenchmarkScale = (scaleStr.integerValue > 0) ? (NSUInteger)scaleStr.integerValue : FABenchmarkDefaultScale;
+    FABenchmarkResults = [[NSMutableArray alloc] init];
+    FABenchmarkGenerator = [[FASyntheticDataGenerator alloc] initWithSeed:20190101];
+
+    FABenchmarkContext = [FASyntheticDataGenerator newBenchmarkContextWithModel:[[FADataStore sharedStore] managedObjectModel]];
+    CFAbsoluteTime populateStart = CFAbsoluteTimeGetCurrent();
+    [FABenchmarkGenerator populateContext:FABenchmarkContext companies:MAX(FABenchmarkScale / 10, 100) events:FABenchmarkScale histories:(FABenchmarkScale / 10) saveObserver:nil];
+    NSLog(@"Built the synthetic benchmark data store with %lu events in %.1f secs",(unsigned long)FABenchmarkScale,(CFAbsoluteTimeGetCurrent() - populateStart));
+
+    // Build the company search index, that searches go through, from just the synthetic companies, not the host app's
+    [[FACompanySearchIndex sharedIndex] rebuildFromContext:FABenchmarkContext];
+
+    // Earnings events from www.quandl.com/api/v3/datasets/ZEA/<TICKER>.json and prices from marketdata.websol.barchart.com/getHistory.json?symbol=<TICKER>
+    [FAStubURLProtocol stubHost:@"www.quandl.com" withResponseProvider:^NSData *(NSURLRequest *request) {
+        return [FABenchmarkGenerator earningsResponseForTicker:[[request.URL lastPathComponent] stringByDeletingPathExtension]];
+    }];
+    [FAStubURLProtocol stubHost:@"marketdata.websol.barchart.com" withResponseProvider:^NSData *(NSURLRequest *request) {
+        return [FABenchmarkGenerator stockPricesResponseForTicker:@"SY0000" days:250];
+    }];
+}
+
+// Put the network back, leave the company search index to be built again from the host app's data store and write out the benchmark results
++ (void)tearDown {
+    [FAStubURLProtocol removeAllStubs];
+    [[FACompanySearchIndex sharedIndex] reset];
+
+    NSString *resultsPath = [[[NSProcessInfo processInfo] environment] objectForKey:@"FA_BENCHMARK_RESULTS_PATH"];
+    if (resultsPath.length == 0) {
+        resultsPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"FABenchmarkResults.json"];
+    }
+    NSDictionary *results = @{@"suite":@"FABenchmarkTests",
+                              @"scale":@(FABenchmarkScale),
+                              @"device":[[UIDevice currentDevice] model],
+                              @"systemVersion":[[UIDevice currentDevice] systemVersion],
+                              @"date":[[NSDate date] description],
+                              @"benchmarks":FABenchmarkResults};
+    NSError *error = nil;
+    NSData *resultsData = [NSJSONSerialization dataWithJSONObject:results options:NSJSONWritingPrettyPrinted error:&error];
+    if (![resultsData writeToFile:resultsPath options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"ERROR: Writing the benchmark results failed: %@",error.description);
+    } else {
+        NSLog(@"Wrote the benchmark results to %@",resultsPath);
+    }
+
+    FABenchmarkContext = nil;
+    [super tearDown];
+}
+
+- (void)setUp {
+    [super setUp];
+
+    self.dataController = [[FADataController alloc] init];
+    self.dataController.managedObjectContext = FABenchmarkContext;
+}
+
+- (void)tearDown {
+    [FABenchmarkContext reset];
+    self.dataController = nil;
+    [super tearDown];
+}
+
+#pragma mark - Benchmarks
+
+// Search as the user would type, for tickers, names and event types, the way the search bar does.
+- (void)testSearchEventsForBenchmark {
+
+    NSArray *searchTexts = @[@"S", @"SY00", @"Apex", @"harbor lab", @"Fed", @"Gadget"];
+
+    [self measureBenchmark:@"searchEventsFor" usingBlock:^{
+        for (NSString *searchText in searchTexts) {
+            NSFetchedResultsController *resultsController = [self.dataController searchEventsFor:searchText eventDisplayType:@"All"];
+            // Touch the first screen of results, as the table would
+            NSArray *foundEvents = resultsController.fetchedObjects;
+            for (NSUInteger i = 0; i < MIN(foundEvents.count, (NSUInteger)15); i++) {
+                [[foundEvents objectAtIndex:i] valueForKey:@"type"];
+            }
+        }
+    }];
+}
+
+// Get all future events, the default events list, and touch the first screen of them.
+- (void)testGetAllFutureEventsBenchmark {
+
+    [self measureBenchmark:@"getAllFutureEvents" usingBlock:^{
+        NSArray *futureEvents = [self.dataController getAllFutureEvents].fetchedObjects;
+        XCTAssertTrue(futureEvents.count > 0);
+        for (NSUInteger i = 0; i < MIN(futureEvents.count, (NSUInteger)15); i++) {
+            [[futureEvents objectAtIndex:i] valueForKey:@"type"];
+        }
+    }];
+}
+
+// Upsert earnings events one at a time, the way the older loaders do, updating existing events.
+- (void)testUpsertEventWithDateBenchmark {
+
+    [self measureBenchmark:@"upsertEventWithDate" usingBlock:^{
+        for (NSUInteger companyNumber = 0; companyNumber < 200; companyNumber++) {
+            NSDate *eventDate = [FABenchmarkGenerator randomEventDate];
+            [self.dataController upsertEventWithDate:eventDate relatedDetails:@"After Market Close" relatedDate:eventDate type:@"Quarterly Earnings" certainty:@"Confirmed" listedCompany:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber] estimatedEps:@1.25 priorEndDate:eventDate actualEpsPrior:@1.1];
+        }
+    }];
+}
+
+// Upsert earnings events in a single batch, the way the sync does, updating existing events.
+- (void)testUpsertEventsWithDetailsBenchmark {
+
+    [self measureBenchmark:@"upsertEventsWithDetails" usingBlock:^{
+        NSMutableArray *eventDetails = [NSMutableArray arrayWithCapacity:1000];
+        for (NSUInteger companyNumber = 0; companyNumber < 1000; companyNumber++) {
+            NSDate *eventDate = [FABenchmarkGenerator randomEventDate];
+            [eventDetails addObject:[self.dataController eventDetailsWithDate:eventDate relatedDetails:@"Before Market Open" relatedDate:eventDate type:@"Quarterly Earnings" certainty:@"Estimated" listedCompany:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber] estimatedEps:@2.5 priorEndDate:eventDate actualEpsPrior:@2.25]];
+        }
+        [self.dataController upsertEventsWithDetails:eventDetails];
+    }];
+}
+
+// Load the bundled economic events, streaming them from the json file.
+- (void)testEconomicEventsFromLocalStorageBenchmark {
+
+    [self measureBenchmark:@"getAllEconomicEventsFromLocalStorage" usingBlock:^{
+        [self.dataController getAllEconomicEventsFromLocalStorage];
+    }];
+}
+
+// Parse the dates of all the instances in the bundled economic events, 100 times over so a run is long enough to time, first the way it was done
+// before, with a new yyyyMMdd date formatter for each date, and then straight from the day numbers they're stored as e.g. 20190130, the way it's done now.
+- (void)testEconomicEventDateParsingBenchmark {
+
+    NSData *eventsData = [NSData dataWithContentsOfFile:[[NSBundle mainBundle] pathForResource:@"EconomicEvents_2019" ofType:@"json"]];
+    NSDictionary *events = eventsData ? [NSJSONSerialization JSONObjectWithData:eventsData options:0 error:nil] : nil;
+    NSMutableArray *eventDates = [NSMutableArray array];
+    for (NSDictionary *eventSet in [events objectForKey:@"eventSets"]) {
+        for (NSDictionary *eventInstance in [eventSet objectForKey:@"instances"]) {
+            [eventDates addObject:[eventInstance objectForKey:@"date"]];
+        }
+    }
+    XCTAssertTrue(eventDates.count > 0);
+
+    [self measureBenchmark:@"economicEventDatesWithNewFormatters" usingBlock:^{
+        for (NSUInteger pass = 0; pass < 100; pass++) {
+            for (NSNumber *eventDateAsNum in eventDates) {
+                NSDateFormatter *eventDateFormatter = [[NSDateFormatter alloc] init];
+                [eventDateFormatter setDateFormat:@"yyyyMMdd"];
+                XCTAssertNotNil([eventDateFormatter dateFromString:[eventDateAsNum stringValue]]);
+            }
+        }
+    }];
+
+    [self measureBenchmark:@"economicEventDatesWithDateCache" usingBlock:^{
+        for (NSUInteger pass = 0; pass < 100; pass++) {
+            for (NSNumber *eventDateAsNum in eventDates) {
+                XCTAssertNotNil([FADateCache dateForDayNumber:[eventDateAsNum intValue]]);
+            }
+        }
+    }];
+}
+
+// Stream the records out of a 5 MB and a 50 MB historical prices response, picking out the fields processStockPricesResponse does. The peak memory used
+// by the read should stay flat as the response grows, unlike reading the whole response with NSJSONSerialization, which is measured for comparison.
+- (void)testStreamReaderLargeResponseBenchmark {
+
+    NSArray *responseSizesMB = @[@5, @50];
+    for (NSNumber *responseSizeMB in responseSizesMB) {
+
+        NSData *pricesResponse = [FABenchmarkGenerator stockPricesResponseForTicker:@"SY0000" ofSize:([responseSizeMB unsignedIntegerValue] * 1024 * 1024)];
+        NSString *benchmarkName = [NSString stringWithFormat:@"streamReader%@MB",responseSizeMB];
+
+        __block NSUInteger barCount = 0;
+        void (^streamRead)(void) = ^{
+            barCount = 0;
+            FAJSONStreamReader *responseReader = [[FAJSONStreamReader alloc] initWithData:pricesResponse];
+            NSError *error = nil;
+            XCTAssertTrue([responseReader enumerateRecordsAtPath:@"results" fields:@[@"tradingDay",@"close"] error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {
+                if ([record objectForKey:@"close"]) {
+                    barCount++;
+                }
+            }]);
+        };
+
+        [self measureBenchmark:benchmarkName usingBlock:streamRead];
+        uint64_t streamPeakGrowth = [self peakMemoryGrowthRunningBlock:streamRead];
+        XCTAssertTrue(barCount > 0);
+        [FABenchmarkResults addObject:@{@"name":[benchmarkName stringByAppendingString:@"PeakMemory"], @"runs":@1, @"peakGrowthMB":@(streamPeakGrowth / (1024.0 * 1024.0))}];
+        NSLog(@"BENCHMARK %@ peak memory growth %.2f MB for %lu bars",benchmarkName,(streamPeakGrowth / (1024.0 * 1024.0)),(unsigned long)barCount);
+    }
+
+    // The whole response materialized into dictionaries and arrays, the way it was read before
+    NSData *pricesResponse = [FABenchmarkGenerator stockPricesResponseForTicker:@"SY0000" ofSize:(50 * 1024 * 1024)];
+    uint64_t serializationPeakGrowth = [self peakMemoryGrowthRunningBlock:^{
+        @autoreleasepool {
+            NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:pricesResponse options:0 error:nil];
+            XCTAssertTrue([[parsedResponse objectForKey:@"results"] count] > 0);
+        }
+    }];
+    [FABenchmarkResults addObject:@{@"name":@"jsonSerialization50MBPeakMemory", @"runs":@1, @"peakGrowthMB":@(serializationPeakGrowth / (1024.0 * 1024.0))}];
+    NSLog(@"BENCHMARK jsonSerialization50MB peak memory growth %.2f MB",(serializationPeakGrowth / (1024.0 * 1024.0)));
+}
+
+// Process a year of daily prices for the earnings events of companies with event histories. The bars stored for the companies are removed before
+// every run, so that each run appends the whole year instead of finding it already stored by an earlier run, and after, to leave the price bar store as it was.
+- (void)testProcessStockPricesResponseBenchmark {
+
+    NSData *pricesResponse = [FABenchmarkGenerator stockPricesResponseForTicker:@"SY0000" days:250];
+    void (^removeBars)(void) = ^{
+        for (NSUInteger companyNumber = 0; companyNumber < 10; companyNumber++) {
+            [[FAPriceBarStore sharedStore] removeBarsForTicker:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber]];
+        }
+    };
+
+    [self measureBenchmark:@"processStockPricesResponse" usingBlock:^{
+        removeBars();
+        for (NSUInteger companyNumber = 0; companyNumber < 10; companyNumber++) {
+            [self.dataController processStockPricesResponse:pricesResponse forTicker:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber] forEventType:@"Quarterly Earnings"];
+        }
+    }];
+    removeBars();
+}
+
+// Look up the closing price on 1000 dates spread over ten years of daily bars, the way the 30 day, year to date and prior earnings prices are
+// answered from the local price bar store. The bars are stored under their own ticker, which is removed at the end.
+- (void)testClosePriceLookupBenchmark {
+
+    NSString *barsTicker = @"SYBARS";
+    FAPriceBarStore *barStore = [FAPriceBarStore sharedStore];
+    [barStore removeBarsForTicker:barsTicker];
+    NSDictionary *pricesResponse = [NSJSONSerialization JSONObjectWithData:[FABenchmarkGenerator stockPricesResponseForTicker:barsTicker days:2500] options:0 error:nil];
+    [barStore appendBars:[pricesResponse objectForKey:@"results"] forTicker:barsTicker];
+    XCTAssertNotNil([barStore lastBarDateForTicker:barsTicker]);
+
+    NSMutableArray *lookupDates = [NSMutableArray arrayWithCapacity:1000];
+    for (NSUInteger dateNumber = 0; dateNumber < 1000; dateNumber++) {
+        [lookupDates addObject:[NSDate dateWithTimeIntervalSinceNow:-(dateNumber * 3.6 * 86400.0)]];
+    }
+
+    [self measureBenchmark:@"closePriceForTickerOnOrBeforeDate" usingBlock:^{
+        for (NSDate *lookupDate in lookupDates) {
+            [barStore closePriceForTicker:barsTicker onOrBeforeDate:lookupDate];
+        }
+    }];
+    [barStore removeBarsForTicker:barsTicker];
+}
+
+// Get earnings events from the stubbed API, with a 50 ms round trip, and record the CPU time the requesting thread used per request alongside the wall
+// time. The thread should be parked for the round trip, so it's CPU time should be well below the wall time, instead of close to it as with a busy wait.
+- (void)testRequestCPUTimeBenchmark {
+
+    [FAStubURLProtocol setResponseDelay:0.05];
+    NSUInteger requestCountStart = [FAStubURLProtocol stubbedRequestCount];
+    double cpuTimeStart = FABenchmarkThreadCPUTime();
+    CFAbsoluteTime wallTimeStart = CFAbsoluteTimeGetCurrent();
+
+    for (NSUInteger companyNumber = 0; companyNumber < 20; companyNumber++) {
+        [self.dataController getAllEventsFromApiWithTicker:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber]];
+    }
+
+    double cpuTime = FABenchmarkThreadCPUTime() - cpuTimeStart;
+    double wallTime = CFAbsoluteTimeGetCurrent() - wallTimeStart;
+    NSUInteger requestCount = [FAStubURLProtocol stubbedRequestCount] - requestCountStart;
+    [FAStubURLProtocol setResponseDelay:0];
+
+    XCTAssertTrue(requestCount > 0);
+    XCTAssertTrue(cpuTime < wallTime);
+    [FABenchmarkResults addObject:@{@"name":@"requestCPUTime", @"runs":@(requestCount), @"cpuMsPerRequest":@((cpuTime * 1000.0) / MAX(requestCount, (NSUInteger)1)), @"wallMsPerRequest":@((wallTime * 1000.0) / MAX(requestCount, (NSUInteger)1))}];
+    NSLog(@"BENCHMARK requestCPUTime %.2f ms of CPU for %.2f ms of wall time per request over %lu requests",((cpuTime * 1000.0) / MAX(requestCount, (NSUInteger)1)),((wallTime * 1000.0) / MAX(requestCount, (NSUInteger)1)),(unsigned long)requestCount);
+}
+
+// Get earnings events from the stubbed API, which covers the request, parsing the response and upserting the event.
+- (void)testGetAllEventsFromApiWithTickerBenchmark {
+
+    [self measureBenchmark:@"getAllEventsFromApiWithTicker" usingBlock:^{
+        for (NSUInteger companyNumber = 0; companyNumber < 20; companyNumber++) {
+            [self.dataController getAllEventsFromApiWithTicker:[FASyntheticDataGenerator tickerForCompanyNumber:companyNumber]];
+        }
+    }];
+    XCTAssertTrue([FAStubURLProtocol stubbedRequestCount] > 0);
+}
+
+// Build the view models for the top rows of the events list, from just the values the rows show, the way the events list precomputes them.
+- (void)testRowViewModelBenchmark {
+
+    NSFetchRequest *eventsRequest = [NSFetchRequest fetchRequestWithEntityName:@"Event"];
+    [eventsRequest setResultType:NSDictionaryResultType];
+    [eventsRequest setPropertiesToFetch:@[@"type", @"date", @"relatedDetails", @"certainty", @"listedCompany.ticker", @"listedCompany.name"]];
+    [eventsRequest setSortDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"date" ascending:YES]]];
+    [eventsRequest setFetchLimit:1000];
+    NSArray *eventRows = [FABenchmarkContext executeFetchRequest:eventsRequest error:nil];
+    XCTAssertTrue(eventRows.count > 0);
+
+    FAEventsViewController *eventsViewController = [[FAEventsViewController alloc] init];
+    eventsViewController.dataSnapShot = [FASnapShot sharedSnapShot];
+
+    [self measureBenchmark:@"rowViewModelForEventType" usingBlock:^{
+        for (NSDictionary *eventRow in eventRows) {
+            [eventsViewController rowViewModelForEventType:[eventRow objectForKey:@"type"] date:[eventRow objectForKey:@"date"] relatedDetails:[eventRow objectForKey:@"relatedDetails"] certainty:[eventRow objectForKey:@"certainty"] ticker:[eventRow objectForKey:@"listedCompany.ticker"] companyName:[eventRow objectForKey:@"listedCompany.name"] priceTypeSelected:NO];
+        }
+    }];
+}
+
+// Work out the kind of the events in the top 1000 rows of the events list, 4 times for each row as the helpers for it's description, color, date
+// and distance each need it, first by matching substrings of the type, the way it was done before, and then through FAEventClassification. With
+// 1000 rows, the time in ms for a run is the time in µs per cell.
+- (void)testEventClassificationBenchmark {
+
+    NSFetchRequest *eventsRequest = [NSFetchRequest fetchRequestWithEntityName:@"Event"];
+    [eventsRequest setResultType:NSDictionaryResultType];
+    [eventsRequest setPropertiesToFetch:@[@"type", @"listedCompany.ticker"]];
+    [eventsRequest setSortDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"date" ascending:YES]]];
+    [eventsRequest setFetchLimit:1000];
+    NSArray *eventRows = [FABenchmarkContext executeFetchRequest:eventsRequest error:nil];
+    XCTAssertTrue(eventRows.count > 0);
+
+    [self measureBenchmark:@"eventKindBySubstrings" usingBlock:^{
+        for (NSDictionary *eventRow in eventRows) {
+            for (NSUInteger lookup = 0; lookup < 4; lookup++) {
+                FABenchmarkLegacyEventKind([eventRow objectForKey:@"type"]);
+            }
+        }
+    }];
+
+    [self measureBenchmark:@"eventKindByClassification" usingBlock:^{
+        for (NSDictionary *eventRow in eventRows) {
+            for (NSUInteger lookup = 0; lookup < 4; lookup++) {
+                [FAEventClassification classificationForType:[eventRow objectForKey:@"type"] ticker:[eventRow objectForKey:@"listedCompany.ticker"]];
+            }
+        }
+    }];
+}
+
+// Build the events list from the storyboard, fetch it's events and lay it out, with the data store already loaded. This isn't a launch: it leaves
+// out process start, app delegate setup and loading the store. For that, also record how long the host app took from the process starting to it's
+// first events list being rendered, if it got that far.
+- (void)testEventsListBuildAndLayoutBenchmark {
+
+    NSTimeInterval hostTimeToFirstEventsList = [[FALaunchScheduler sharedScheduler] timeToFirstEventsList];
+    if (hostTimeToFirstEventsList > 0) {
+        [FABenchmarkResults addObject:@{@"name":@"hostTimeToFirstEventsList", @"runs":@1, @"medianMs":@(hostTimeToFirstEventsList * 1000.0)}];
+        NSLog(@"BENCHMARK hostTimeToFirstEventsList %.2f ms",(hostTimeToFirstEventsList * 1000.0));
+    }
+
+    // Wait for the host app's data store to be loaded, so that the events list is fetched rather than showing it's placeholder
+    [[FADataStore sharedStore] persistentStoreCoordinator];
+
+    UIStoryboard *storyboard = [UIStoryboard storyboardWithName:@"Main" bundle:[NSBundle bundleForClass:[FAEventsViewController class]]];
+
+    [self measureBenchmark:@"eventsListBuildAndLayout" usingBlock:^{
+        UIWindow *window = [[UIWindow alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
+        window.rootViewController = [storyboard instantiateViewControllerWithIdentifier:@"FAEventsNavController"];
+        [window makeKeyAndVisible];
+        [window layoutIfNeeded];
+        window.hidden = YES;
+    }];
+}
+
+#pragma mark - Results
+
+// Measure the block, the Xcode way, and record the time taken by each run of it in the benchmark results under the given name
+- (void)measureBenchmark:(NSString *)benchmarkName usingBlock:(void (^)(void))block
+{
+    NSMutableArray *runTimes = [NSMutableArray array];
+
+    [self measureBlock:^{
+        CFAbsoluteTime runStart = CFAbsoluteTimeGetCurrent();
+        block();
+        [runTimes addObject:@((CFAbsoluteTimeGetCurrent() - runStart) * 1000.0)];
+    }];
+
+    if (runTimes.count == 0) {
+        return;
+    }
+    NSArray *sortedRunTimes = [runTimes sortedArrayUsingSelector:@selector(compare:)];
+    double totalTime = [[runTimes valueForKeyPath:@"@sum.doubleValue"] doubleValue];
+    NSDictionary *result = @{@"name":benchmarkName,
+                             @"runs":@(runTimes.count),
+                             @"minMs":[sortedRunTimes firstObject],
+                             @"medianMs":[sortedRunTimes objectAtIndex:(sortedRunTimes.count / 2)],
+                             @"meanMs":@(totalTime / runTimes.count),
+                             @"maxMs":[sortedRunTimes lastObject]};
+    [FABenchmarkResults addObject:result];
+    NSLog(@"BENCHMARK %@ median %.2f ms over %lu runs",benchmarkName,[[result objectForKey:@"medianMs"] doubleValue],(unsigned long)runTimes.count);
+}
+
+// Get the memory footprint of the process, in bytes, the way the system accounts for it when deciding whether to kill an app for using too much memory.
+static uint64_t FABenchmarkMemoryFootprint(void)
+{
+    task_vm_info_data_t vmInfo;
+    mach_msg_type_number_t vmInfoCount = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&vmInfo, &vmInfoCount) != KERN_SUCCESS) {
+        return 0;
+    }
+    return vmInfo.phys_footprint;
+}
+
+// Run the block and get how far the memory footprint of the process rose above where it started, in bytes, while it ran. The footprint is sampled every
+// millisecond on a separate queue, since the peak resident size the system keeps can't be reset between benchmarks.
+- (uint64_t)peakMemoryGrowthRunningBlock:(void (^)(void))block
+{
+    uint64_t startFootprint = FABenchmarkMemoryFootprint();
+    __block uint64_t peakFootprint = startFootprint;
+
+    dispatch_queue_t samplerQueue = dispatch_queue_create("com.siddsingh.FinApp.benchmarkMemory", DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t sampler = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, samplerQueue);
+    dispatch_source_set_timer(sampler, DISPATCH_TIME_NOW, NSEC_PER_MSEC, 0);
+    dispatch_source_set_event_handler(sampler, ^{
+        peakFootprint = MAX(peakFootprint, FABenchmarkMemoryFootprint());
+    });
+    dispatch_resume(sampler);
+
+    block();
+
+    dispatch_source_cancel(sampler);
+    __block uint64_t peakGrowth = 0;
+    dispatch_sync(samplerQueue, ^{
+        peakFootprint = MAX(peakFootprint, FABenchmarkMemoryFootprint());
+        peakGrowth = (peakFootprint > startFootprint) ? (peakFootprint - startFootprint) : 0;
+    });
+
+    return peakGrowth;
+}
+
+@end
@@ -0,0 +1,30 @@
+//
+//  FALegacyBrandColors.h
+//  FinAppTests
+//
+//  Copy of the if chains FASnapShot used to look up brand colors, and high impact events,
+//  before they moved to BrandColors.json. Only used by tests, to check the table gives
+//  the same results.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@interface FALegacyBrandColors : NSObject
+
+// Get all the tickers the if chains have a brand color for.
++ (NSArray *)coveredTickers;
+
+// Get the brand background color for given ticker, the way FASnapShot used to.
++ (UIColor *)brandBkgrndColorForCompany:(NSString *)ticker;
+
+// Get the brand text color for given ticker, the way FASnapShot used to.
++ (UIColor *)brandTextColorForCompany:(NSString *)ticker;
+
+// Check if the event is high impact, the way FASnapShot used to.
++ (BOOL)isEventHighImpact:(NSString *)eventType eventParent:(NSString *)parentTicker;
+
+@end
@@ -0,0 +1,34 @@
+//
+//  FAStubURLProtocol.h
+//  FinAppTests
+//
+//  URL protocol that stands in for the remote data sources in the benchmarks. Once registered,
+//  requests to stubbed hosts, made through the shared URL session like the app's API calls,
+//  are answered locally with a canned response instead of going out to the network, so the
+//  API bound paths can be timed without the network's latency and variability.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+// Block that returns the response body for a stubbed request e.g. based on the ticker in it's URL
+typedef NSData * (^FAStubResponseProvider)(NSURLRequest *request);
+
+@interface FAStubURLProtocol : NSURLProtocol
+
+// Answer all requests to the host e.g. www.quandl.com with a 200 response whose body comes from the provider
++ (void)stubHost:(NSString *)host withResponseProvider:(FAStubResponseProvider)responseProvider;
+
+// Wait the given number of seconds before answering each request, to stand in for the round trip to the remote data source. 0, the default, answers
+// straight away.
++ (void)setResponseDelay:(NSTimeInterval)responseDelay;
+
+// Stop answering requests to any host, go back to the network and stop delaying responses
++ (void)removeAllStubs;
+
+// Number of requests answered since the stubs were last removed
++ (NSUInteger)stubbedRequestCount;
+
+@end
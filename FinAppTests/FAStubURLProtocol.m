@@ -0,0 +1,136 @@
+//
+//  FAStubURLProtocol.m
+//  FinAppTests
+//
+//  URL protocol that stands in for the remote data sources in the benchmarks. It's registered
+//  for the whole process, so the shared URL session the app uses picks it up, and answers only
+//  the hosts that have been stubbed.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FAStubURLProtocol.h"
+
+// Response providers keyed by lowercased host and the number of requests answered. Access under @synchronized on the class.
+static NSMutableDictionary *FAStubResponseProviders = nil;
+static NSUInteger FAStubRequestCount = 0;
+static NSTimeInterval FAStubResponseDelay = 0;
+
+@interface FAStubURLProtocol ()
+
+// Get the response provider for a request, if it's to a stubbed host
++ (FAStubResponseProvider)responseProviderForRequest:(NSURLRequest *)request;
+
+// Answer the request with the canned response
+- (void)finishLoading;
+
+@end
+
+@implementation FAStubURLProtocol
+
+#pragma mark - Stubbing
+
+// Answer all requests to the host with a 200 response whose body comes from the provider
++ (void)stubHost:(NSString *)host withResponseProvider:(FAStubResponseProvider)responseProvider
+{
+    @synchronized(self) {
+        if (FAStubResponseProviders == nil) {
+            FAStubResponseProviders = [[NSMutableDictionary alloc] init];
+            [NSURLProtocol registerClass:self];
+        }
+        [FAStubResponseProviders setObject:[responseProvider copy] forKey:[host lowercaseString]];
+    }
+}
+
+// Wait the given number of seconds before answering each request, to stand in for the round trip to the remote data source
++ (void)setResponseDelay:(NSTimeInterval)responseDelay
+{
+    @synchronized(self) {
+        FAStubResponseDelay = responseDelay;
+    }
+}
+
+// Stop answering requests to any host, go back to the network and stop delaying responses
++ (void)removeAllStubs
+{
+    @synchronized(self) {
+        if (FAStubResponseProviders != nil) {
+            [NSURLProtocol unregisterClass:self];
+            FAStubResponseProviders = nil;
+        }
+        FAStubRequestCount = 0;
+        FAStubResponseDelay = 0;
+    }
+}
+
+// Number of requests answered since the stubs were last removed
++ (NSUInteger)stubbedRequestCount
+{
+    @synchronized(self) {
+        return FAStubRequestCount;
+    }
+}
+
+// Get the response provider for a request, if it's to a stubbed host
++ (FAStubResponseProvider)responseProviderForRequest:(NSURLRequest *)request
+{
+    @synchronized(self) {
+        return [FAStubResponseProviders objectForKey:[request.URL.host lowercaseString]];
+    }
+}
+
+#pragma mark - URL Protocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return ([self responseProviderForRequest:request] != nil);
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+// Answer the request with the canned response, after the response delay if there is one. The delay is waited out on the loading thread's run loop,
+// so the thread isn't busy in the meantime.
+- (void)startLoading
+{
+    NSTimeInterval responseDelay;
+    @synchronized([FAStubURLProtocol class]) {
+        responseDelay = FAStubResponseDelay;
+    }
+
+    if (responseDelay > 0) {
+        [self performSelector:@selector(finishLoading) withObject:nil afterDelay:responseDelay];
+    } else {
+        [self finishLoading];
+    }
+}
+
+// Answer the request with the canned response
+- (void)finishLoading
+{
+    FAStubResponseProvider responseProvider = [FAStubURLProtocol responseProviderForRequest:self.request];
+    NSData *responseData = responseProvider ? responseProvider(self.request) : nil;
+    if (responseData == nil) {
+        responseData = [NSData data];
+    }
+
+    @synchronized([FAStubURLProtocol class]) {
+        FAStubRequestCount++;
+    }
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:@{@"Content-Type":@"application/json"}];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:responseData];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+// Don't answer the request if it's cancelled while the response is delayed
+- (void)stopLoading
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(finishLoading) object:nil];
+}
+
+@end
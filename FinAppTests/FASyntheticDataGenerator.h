@@ -0,0 +1,47 @@
+//
+//  FASyntheticDataGenerator.h
+//  FinAppTests
+//
+//  Class that generates synthetic, but realistically shaped, data for the benchmarks:
+//  companies, their events of every kind and event histories, written straight into a
+//  data store in batches so that stores of 10k to 1M rows can be built, along with API
+//  responses in the formats the data sources send. The data is deterministic for a given
+//  seed, so runs are comparable.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+
+@interface FASyntheticDataGenerator : NSObject
+
+// Create a generator whose data is determined by the seed
+- (id)initWithSeed:(uint32_t)seed;
+
+// Get the synthetic ticker for a company number e.g. SY0042. The same number always gives the same ticker.
++ (NSString *)tickerForCompanyNumber:(NSUInteger)companyNumber;
+
+// Create a data store, with the app's model, in a new sqlite file in the temporary directory, and return a main queue context directly on it.
++ (NSManagedObjectContext *)newBenchmarkContextWithModel:(NSManagedObjectModel *)model;
+
+// Add the given numbers of companies, events, spread across the companies and kinds of events, and event histories, for the earnings events,
+// to the data store of the context. Saves in batches, resetting the context in between, so memory stays bounded. Must be called on the context's queue.
+// Each save is also handed to the observer block, if any, while still on the context's queue e.g. to keep the company search index up to date.
+- (void)populateContext:(NSManagedObjectContext *)context companies:(NSUInteger)companyCount events:(NSUInteger)eventCount histories:(NSUInteger)historyCount saveObserver:(void (^)(NSNotification *saveNotification))saveObserver;
+
+// Get a date a random number of days, from -30 to 119, from today, for an event
+- (NSDate *)randomEventDate;
+
+// Get an earnings events API response, in the ZEA dataset format, for a ticker
+- (NSData *)earningsResponseForTicker:(NSString *)ticker;
+
+// Get a historical prices API response, in the Barchart getHistory format, with daily bars for the given number of days up to yesterday
+- (NSData *)stockPricesResponseForTicker:(NSString *)ticker days:(NSUInteger)dayCount;
+
+// Get a historical prices API response, in the Barchart getHistory format, of at least the given size in bytes e.g. 50 MB, to see how parsing scales with
+// the size of a response. The trading days cycle through the last few years, so they repeat in responses that are big enough.
+- (NSData *)stockPricesResponseForTicker:(NSString *)ticker ofSize:(NSUInteger)byteCount;
+
+@end
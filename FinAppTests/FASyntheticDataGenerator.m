@@ -0,0 +1,311 @@
+//
+//  FASyntheticDataGenerator.m
+//  FinAppTests
+//
+//  Class that generates synthetic, but realistically shaped, data for the benchmarks.
+//  Companies get word based names so that search text matches a realistic share of them.
+//  Every 100th company is an economic agency, whose events are economic events. Events go
+//  round the companies, one kind of event per round: earnings, product launches, price
+//  moves, 52 week highs and then product conferences.
+//
+//  Created by agent on 10/18/26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "FASyntheticDataGenerator.h"
+#import "Company.h"
+#import "Event.h"
+#import "EventHistory.h"
+#import "FADateCache.h"
+
+// Number of objects inserted between saves
+static const NSUInteger FASyntheticBatchSize = 5000;
+
+@interface FASyntheticDataGenerator ()
+
+// State of the xorshift random number generator
+@property (nonatomic) uint32_t randomState;
+
+// Midnight last night, that event dates are relative to
+@property (strong, nonatomic) NSDate *today;
+
+// Get the next random number
+- (uint32_t)nextRandom;
+
+// Get the name for a company number, made up of words so that searches match some, but not all, companies
+- (NSString *)nameForCompanyNumber:(NSUInteger)companyNumber;
+
+// Get the type of an event, given the company's ticker and the round of events it's in
+- (NSString *)eventTypeForTicker:(NSString *)ticker round:(NSUInteger)round;
+
+@end
+
+@implementation FASyntheticDataGenerator
+
+// Create a generator whose data is determined by the seed
+- (id)initWithSeed:(uint32_t)seed
+{
+    self = [super init];
+    if (self) {
+        _randomState = (seed != 0) ? seed : 2463534242u;
+        _today = [FADateCache dateForEpochDay:[FADateCache localEpochDayForDate:[NSDate date]]];
+    }
+    return self;
+}
+
+#pragma mark - Data Store
+
+// Get the synthetic ticker for a company number e.g. SY0042. Every 100th company is an economic agency e.g. ECONOMY_SY0099.
++ (NSString *)tickerForCompanyNumber:(NSUInteger)companyNumber
+{
+    if ((companyNumber % 100) == 99) {
+        return [NSString stringWithFormat:@"ECONOMY_SY%04lu",(unsigned long)companyNumber];
+    }
+    return [NSString stringWithFormat:@"SY%04lu",(unsigned long)companyNumber];
+}
+
+// Create a data store, with the app's model, in a new sqlite file in the temporary directory, and return a main queue context directly on it.
++ (NSManagedObjectContext *)newBenchmarkContextWithModel:(NSManagedObjectModel *)model
+{
+    NSURL *storeURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FABenchmark-%@.sqlite",[[NSUUID UUID] UUIDString]]]];
+
+    NSPersistentStoreCoordinator *storeCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:model];
+    NSError *error = nil;
+    if (![storeCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:nil error:&error]) {
+        NSLog(@"ERROR: Creating the benchmark data store failed: %@",error.description);
+        return nil;
+    }
+
+    NSManagedObjectContext *context = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+    [context setPersistentStoreCoordinator:storeCoordinator];
+    [context setMergePolicy:NSMergeByPropertyObjectTrumpMergePolicy];
+    [context setUndoManager:nil];
+
+    return context;
+}
+
+// Add the given numbers of companies, events and event histories to the data store of the context, saving in batches.
+- (void)populateContext:(NSManagedObjectContext *)context companies:(NSUInteger)companyCount events:(NSUInteger)eventCount histories:(NSUInteger)historyCount saveObserver:(void (^)(NSNotification *saveNotification))saveObserver
+{
+    if (companyCount == 0) {
+        return;
+    }
+
+    id saveObserverToken = nil;
+    if (saveObserver) {
+        saveObserverToken = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification object:context queue:nil usingBlock:saveObserver];
+    }
+
+    NSError *error = nil;
+
+    // Companies first, keeping their ids, which are permanent once saved, to hook the events up to
+    NSMutableArray *companyIDs = [NSMutableArray arrayWithCapacity:companyCount];
+    NSMutableArray *batchCompanies = [NSMutableArray arrayWithCapacity:FASyntheticBatchSize];
+    for (NSUInteger companyNumber = 0; companyNumber < companyCount; companyNumber++) {
+        @autoreleasepool {
+            Company *company = [NSEntityDescription insertNewObjectForEntityForName:@"Company" inManagedObjectContext:context];
+            company.ticker = [FASyntheticDataGenerator tickerForCompanyNumber:companyNumber];
+            company.name = [self nameForCompanyNumber:companyNumber];
+            [batchCompanies addObject:company];
+
+            if ((batchCompanies.count == FASyntheticBatchSize)||(companyNumber == companyCount - 1)) {
+                if (![context save:&error]) {
+                    NSLog(@"ERROR: Saving synthetic companies failed: %@",error.description);
+                }
+                for (Company *savedCompany in batchCompanies) {
+                    [companyIDs addObject:savedCompany.objectID];
+                }
+                [batchCompanies removeAllObjects];
+                [context reset];
+            }
+        }
+    }
+
+    // Then the events, going round the companies with a different kind of event each round, and histories for the earnings events
+    NSUInteger noOfHistories = 0;
+    NSUInteger batchCount = 0;
+    for (NSUInteger eventNumber = 0; eventNumber < eventCount; eventNumber++) {
+        @autoreleasepool {
+            NSUInteger companyNumber = eventNumber % companyCount;
+            NSUInteger round = eventNumber / companyCount;
+            NSString *ticker = [FASyntheticDataGenerator tickerForCompanyNumber:companyNumber];
+
+            Event *event = [NSEntityDescription insertNewObjectForEntityForName:@"Event" inManagedObjectContext:context];
+            event.listedCompany = (Company *)[context objectWithID:[companyIDs objectAtIndex:companyNumber]];
+            event.type = [self eventTypeForTicker:ticker round:round];
+            event.date = [self randomEventDate];
+            event.relatedDetails = (([self nextRandom] % 2) == 0) ? @"After Market Close" : @"Before Market Open";
+            event.certainty = (([self nextRandom] % 3) == 0) ? @"Estimated" : @"Confirmed";
+            if (round == 0) {
+                event.relatedDate = [FADateCache dateByAddingDays:-30 toDate:event.date];
+                event.priorEndDate = [FADateCache dateByAddingDays:-120 toDate:event.date];
+                event.estimatedEps = @(([self nextRandom] % 500) / 100.0);
+                event.actualEpsPrior = @(([self nextRandom] % 500) / 100.0);
+            }
+            batchCount++;
+
+            if ((round == 0) && (noOfHistories < historyCount)) {
+                EventHistory *history = [NSEntityDescription insertNewObjectForEntityForName:@"EventHistory" inManagedObjectContext:context];
+                history.previous1Date = [FADateCache dateByAddingDays:-91 toDate:event.date];
+                history.previous1Status = @"Confirmed";
+                history.previous1RelatedDate = [FADateCache dateByAddingDays:-121 toDate:event.date];
+                history.currentDate = [FADateCache dateByAddingDays:-1 toDate:self.today];
+                history.previous1Price = @999999.9;
+                history.previous1RelatedPrice = @999999.9;
+                history.currentPrice = @999999.9;
+                history.parentEvent = event;
+                noOfHistories++;
+                batchCount++;
+            }
+
+            if ((batchCount >= FASyntheticBatchSize)||(eventNumber == eventCount - 1)) {
+                if (![context save:&error]) {
+                    NSLog(@"ERROR: Saving synthetic events failed: %@",error.description);
+                }
+                batchCount = 0;
+                [context reset];
+            }
+        }
+    }
+
+    if (saveObserverToken) {
+        [[NSNotificationCenter defaultCenter] removeObserver:saveObserverToken];
+    }
+}
+
+#pragma mark - Values
+
+// Get a date a random number of days, from -30 to 119, from today, for an event
+- (NSDate *)randomEventDate
+{
+    return [FADateCache dateByAddingDays:((int32_t)([self nextRandom] % 150) - 30) toDate:self.today];
+}
+
+// Get the next random number, using xorshift
+- (uint32_t)nextRandom
+{
+    uint32_t state = self.randomState;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    self.randomState = state;
+    return state;
+}
+
+// Get the name for a company number, made up of words so that searches match some, but not all, companies
+- (NSString *)nameForCompanyNumber:(NSUInteger)companyNumber
+{
+    static NSArray *firstWords = nil;
+    static NSArray *lastWords = nil;
+    static dispatch_once_t wordsOnce;
+    dispatch_once(&wordsOnce, ^{
+        firstWords = @[@"Apex", @"Blue", @"Cedar", @"Delta", @"Ember", @"Falcon", @"Granite", @"Harbor", @"Iris", @"Juniper", @"Kestrel", @"Lumen", @"Meridian", @"Nova", @"Orchid", @"Pioneer"];
+        lastWords = @[@"Systems", @"Holdings", @"Labs", @"Energy", @"Foods", @"Networks", @"Bancorp", @"Motors", @"Pharma", @"Retail"];
+    });
+
+    return [NSString stringWithFormat:@"%@ %@ %lu",[firstWords objectAtIndex:(companyNumber % firstWords.count)],[lastWords objectAtIndex:((companyNumber / firstWords.count) % lastWords.count)],(unsigned long)companyNumber];
+}
+
+// Get the type of an event, given the company's ticker and the round of events it's in. Economic agencies only have economic events.
+- (NSString *)eventTypeForTicker:(NSString *)ticker round:(NSUInteger)round
+{
+    if ([ticker hasPrefix:@"ECONOMY_"]) {
+        return [NSString stringWithFormat:@"Round %lu Fed Meeting",(unsigned long)round];
+    }
+
+    switch (round) {
+        case 0:
+            return @"Quarterly Earnings";
+        case 1:
+            return @"Gadget 1 Launch";
+        case 2:
+            return [NSString stringWithFormat:@"+%.2f%% up today $%.2f",(([self nextRandom] % 1000) / 100.0),(([self nextRandom] % 50000) / 100.0)];
+        case 3:
+            return @"52 Week High";
+        default:
+            return [NSString stringWithFormat:@"Developer %lu Conference",(unsigned long)round];
+    }
+}
+
+#pragma mark - API Responses
+
+// Get an earnings events API response, in the ZEA dataset format, for a ticker. The record has the related date, estimated eps, event date,
+// certainty and timing, actual prior eps and prior end date at the positions the app reads them from.
+- (NSData *)earningsResponseForTicker:(NSString *)ticker
+{
+    int32_t eventEpochDay = [FADateCache localEpochDayForDate:self.today] + (int32_t)([self nextRandom] % 60);
+    int32_t eventDay = [FADateCache dayNumberForEpochDay:eventEpochDay];
+    int32_t relatedDay = [FADateCache dayNumberForEpochDay:(eventEpochDay - 30)];
+    int32_t priorEndDay = [FADateCache dayNumberForEpochDay:(eventEpochDay - 120)];
+
+    NSArray *record = @[@"2019-04-09", @20190331.0, @(relatedDay), @(([self nextRandom] % 500) / 100.0), @(eventDay), @20190728.0, @20191019.0, @0.0, @1.0, @1.0,
+                        @(([self nextRandom] % 500) / 100.0), @(priorEndDay), @1.66, @20180331.0];
+    NSDictionary *response = @{@"dataset":@{@"dataset_code":ticker, @"database_code":@"ZEA", @"data":@[record]}};
+
+    return [NSJSONSerialization dataWithJSONObject:response options:0 error:nil];
+}
+
+// Get a historical prices API response, in the Barchart getHistory format, with daily bars for the given number of weekdays up to yesterday, oldest first
+- (NSData *)stockPricesResponseForTicker:(NSString *)ticker days:(NSUInteger)dayCount
+{
+    NSDateFormatter *dayFormatter = [FADateCache gmtFormatterWithFormat:@"yyyy-MM-dd"];
+    int32_t epochDay = [FADateCache gmtEpochDayForDate:[NSDate date]];
+
+    NSMutableArray *bars = [NSMutableArray arrayWithCapacity:dayCount];
+    double close = 50.0 + ([self nextRandom] % 10000) / 100.0;
+    while (bars.count < dayCount) {
+        epochDay--;
+        // 1970-01-01 was a Thursday, so days 2 and 3 of each week are weekends
+        if (((epochDay % 7) == 2)||((epochDay % 7) == 3)) {
+            continue;
+        }
+        close = close * (0.98 + ([self nextRandom] % 400) / 10000.0);
+        NSString *tradingDay = [dayFormatter stringFromDate:[NSDate dateWithTimeIntervalSince1970:(epochDay * 86400.0)]];
+        [bars insertObject:@{@"symbol":ticker, @"timestamp":[NSString stringWithFormat:@"%@T00:00:00-04:00",tradingDay], @"tradingDay":tradingDay,
+                             @"open":@(close), @"high":@(close * 1.01), @"low":@(close * 0.99), @"close":@(close), @"volume":@([self nextRandom] % 50000000)} atIndex:0];
+    }
+
+    NSDictionary *response = @{@"status":@{@"code":@200, @"message":@"Success."}, @"results":bars};
+
+    return [NSJSONSerialization dataWithJSONObject:response options:0 error:nil];
+}
+
+// Get a historical prices API response, in the Barchart getHistory format, of at least the given size in bytes e.g. 50 MB, to see how parsing scales with
+// the size of a response. The trading days cycle through the last few years, so they repeat in responses that are big enough.
+- (NSData *)stockPricesResponseForTicker:(NSString *)ticker ofSize:(NSUInteger)byteCount
+{
+    // Written out directly, instead of through NSJSONSerialization, so that building the response doesn't itself need several times it's size in memory
+    NSDateFormatter *dayFormatter = [FADateCache gmtFormatterWithFormat:@"yyyy-MM-dd"];
+    int32_t epochDay = [FADateCache gmtEpochDayForDate:[NSDate date]];
+    NSMutableArray *tradingDays = [NSMutableArray arrayWithCapacity:1000];
+    while (tradingDays.count < 1000) {
+        epochDay--;
+        // 1970-01-01 was a Thursday, so days 2 and 3 of each week are weekends
+        if (((epochDay % 7) == 2)||((epochDay % 7) == 3)) {
+            continue;
+        }
+        [tradingDays addObject:[dayFormatter stringFromDate:[NSDate dateWithTimeIntervalSince1970:(epochDay * 86400.0)]]];
+    }
+
+    NSMutableData *response = [NSMutableData dataWithCapacity:(byteCount + 1024)];
+    const char *responseStart = "{\"status\":{\"code\":200,\"message\":\"Success.\"},\"results\":[";
+    [response appendBytes:responseStart length:strlen(responseStart)];
+
+    const char *symbol = [ticker UTF8String];
+    double close = 50.0 + ([self nextRandom] % 10000) / 100.0;
+    char bar[512];
+    NSUInteger barNo = 0;
+    while (response.length < byteCount) {
+        close = close * (0.98 + ([self nextRandom] % 400) / 10000.0);
+        const char *tradingDay = [[tradingDays objectAtIndex:(barNo % tradingDays.count)] UTF8String];
+        int barLength = snprintf(bar, sizeof(bar), "%s{\"symbol\":\"%s\",\"timestamp\":\"%sT00:00:00-04:00\",\"tradingDay\":\"%s\",\"open\":%.4f,\"high\":%.4f,\"low\":%.4f,\"close\":%.4f,\"volume\":%u}",
+                                 ((barNo == 0) ? "" : ","), symbol, tradingDay, tradingDay, close, (close * 1.01), (close * 0.99), close, ([self nextRandom] % 50000000));
+        [response appendBytes:bar length:(NSUInteger)barLength];
+        barNo++;
+    }
+    [response appendBytes:"]}" length:2];
+
+    return response;
+}
+
+@end
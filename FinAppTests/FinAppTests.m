@@ -8,6 +8,21 @@
 
 #import <UIKit/UIKit.h>
 #import <XCTest/XCTest.h>
+#import "FASnapShot.h"
+#import "FALegacyBrandColors.h"
+#import "FAPreseedSnapshot.h"
+#import "FADataStore.h"
+#import "FATrace.h"
+#import "FAFollowIndex.h"
+#import "FAEventClassification.h"
+#import "Event.h"
+#import "Company.h"
+#import "Action.h"
+#import "EventHistory.h"
+#import "FALaunchScheduler.h"
+#import "FAJSONStreamReader.h"
+#import "FADataController.h"
+#import "FAPriceBarStore.h"
 
 @interface FinAppTests : XCTestCase
 
@@ -22,6 +37,8 @@
 
 - (void)tearDown {
     // Put teardown code here. This method is called after the invocation of each test method in the class.
+    // Drop any actions tests recorded in the follow index, so it's built again from the data store.
+    [[FAFollowIndex sharedIndex] reset];
     [super tearDown];
 }
 
@@ -30,6 +47,396 @@
     XCTAssert(YES, @"Pass");
 }
 
+// Brand colors from the BrandColors.json table should be the same as the ones the if chains gave, for every ticker the chains cover, in any case.
+- (void)testBrandColorsMatchLegacyChains {
+    
+    FASnapShot *snapShot = [FASnapShot sharedSnapShot];
+    NSMutableArray *tickers = [NSMutableArray array];
+    for (NSString *ticker in [FALegacyBrandColors coveredTickers]) {
+        [tickers addObject:ticker];
+        [tickers addObject:[ticker lowercaseString]];
+    }
+    // Tickers that aren't covered should get the default colors
+    [tickers addObjectsFromArray:@[@"ZZZZ", @"GOOG", @""]];
+    
+    for (NSString *ticker in tickers) {
+        UIColor *legacyColor = [FALegacyBrandColors brandBkgrndColorForCompany:ticker];
+        UIColor *tableColor = [snapShot getBrandBkgrndColorForCompany:ticker];
+        XCTAssertTrue(CGColorEqualToColor(legacyColor.CGColor, tableColor.CGColor), @"Background color for %@ is %@ instead of %@", ticker, tableColor, legacyColor);
+        
+        legacyColor = [FALegacyBrandColors brandTextColorForCompany:ticker];
+        tableColor = [snapShot getBrandTextColorForCompany:ticker];
+        XCTAssertTrue(CGColorEqualToColor(legacyColor.CGColor, tableColor.CGColor), @"Text color for %@ is %@ instead of %@", ticker, tableColor, legacyColor);
+    }
+}
+
+// Brand colors should be created once and shared, across calls and across tickers with the same color.
+- (void)testBrandColorsAreShared {
+    
+    FASnapShot *snapShot = [FASnapShot sharedSnapShot];
+    
+    XCTAssertTrue([snapShot getBrandBkgrndColorForCompany:@"NVDA"] == [snapShot getBrandBkgrndColorForCompany:@"nvda"]);
+    XCTAssertTrue([snapShot getBrandBkgrndColorForCompany:@"AAPL"] == [snapShot getBrandBkgrndColorForCompany:@"NFLX"]);
+    XCTAssertTrue([snapShot getBrandTextColorForCompany:@"AAPL"] == [snapShot getBrandTextColorForCompany:@"ZZZZ"]);
+    XCTAssertTrue([snapShot getBrandBkgrndColorForCompany:@"TWX"] == [snapShot getBrandBkgrndColorForCompany:@"ZZZZ"]);
+}
+
+// The table should give the same high impact events as the old if chains, including for the tickers the commented out earnings chain had.
+- (void)testHighImpactMatchesLegacyChains {
+    
+    FASnapShot *snapShot = [FASnapShot sharedSnapShot];
+    NSArray *eventTypes = @[@"Quarterly Earnings", @"US Fed Meeting", @"US Jobs Report", @"iPhone 8 Launch", @"WWDC Conference"];
+    NSArray *tickers = [[FALegacyBrandColors coveredTickers] arrayByAddingObjectsFromArray:@[@"GS", @"JPM", @"ZZZZ"]];
+    
+    for (NSString *eventType in eventTypes) {
+        for (NSString *ticker in tickers) {
+            XCTAssertEqual([snapShot isEventHighImpact:eventType eventParent:ticker], [FALegacyBrandColors isEventHighImpact:eventType eventParent:ticker], @"%@ for %@", eventType, ticker);
+        }
+    }
+}
+
+// Cold start: Seeding a new, empty, data store from the bundled preseed snapshot, including reading the snapshot, in a single transaction.
+- (void)testPreseedSnapshotImportPerformance {
+    
+    NSManagedObjectModel *model = [[FADataStore sharedStore] managedObjectModel];
+    
+    [self measureBlock:^{
+        FAPreseedSnapshot *snapshot = [FAPreseedSnapshot bundledSnapshot];
+        XCTAssertNotNil(snapshot);
+        XCTAssertTrue(snapshot.companyCount > 0);
+        
+        NSPersistentStoreCoordinator *coordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:model];
+        NSError *error = nil;
+        XCTAssertNotNil([coordinator addPersistentStoreWithType:NSInMemoryStoreType configuration:nil URL:nil options:nil error:&error]);
+        NSManagedObjectContext *context = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+        [context setPersistentStoreCoordinator:coordinator];
+        [context setUndoManager:nil];
+        
+        [context performBlockAndWait:^{
+            NSError *importError = nil;
+            XCTAssertTrue([snapshot importIntoContext:context error:&importError], @"%@", importError);
+            XCTAssertEqual([context countForFetchRequest:[NSFetchRequest fetchRequestWithEntityName:@"Company"] error:nil], snapshot.companyCount);
+            XCTAssertEqual([context countForFetchRequest:[NSFetchRequest fetchRequestWithEntityName:@"User"] error:nil], (NSUInteger)1);
+            
+            // Importing the same snapshot again shouldn't add anything
+            XCTAssertTrue([snapshot importIntoContext:context error:&importError], @"%@", importError);
+            XCTAssertEqual([context countForFetchRequest:[NSFetchRequest fetchRequestWithEntityName:@"Company"] error:nil], snapshot.companyCount);
+        }];
+    }];
+}
+
+// Spans and counters should only be recorded while tracing is on, and the binary trace should hold the header, span totals, counters and records.
+- (void)testTraceRecordsOnlyWhenEnabled {
+    
+    [FATrace setEnabled:NO];
+    [FATrace reset];
+    FATraceEnd(FATraceSpanJSONParse, FATraceBegin());
+    FATraceCount(FATraceCounterApiBytes, 100);
+    NSUInteger emptyTraceLength = [FATrace traceData].length;
+    
+    [FATrace setEnabled:YES];
+    FATraceEnd(FATraceSpanJSONParse, FATraceBegin());
+    FATraceCount(FATraceCounterApiBytes, 100);
+    [FATrace setEnabled:NO];
+    
+    NSData *traceData = [FATrace traceData];
+    XCTAssertEqual(traceData.length, emptyTraceLength + 16);
+    XCTAssertEqual(memcmp(traceData.bytes, "FATR", 4), 0);
+    XCTAssertTrue([[FATrace summary] containsString:@"api bytes: 100\n"]);
+    [FATrace reset];
+}
+
+// Tickers and event types should stay followed, or have a reminder, as long as any of their actions are left, regardless of case.
+- (void)testFollowIndexTracksActions {
+    
+    FAFollowIndex *followIndex = [FAFollowIndex sharedIndex];
+    [followIndex buildIfNeeded];
+    XCTAssertFalse([followIndex isTickerFollowed:@"ZZFOLLOW"]);
+    
+    // Same reminder twice, followed by a price change action, on the same ticker
+    [followIndex addActionOfType:@"OSReminder" eventTicker:@"zzfollow" eventType:@"Quarterly Earnings"];
+    [followIndex addActionOfType:@"OSReminder" eventTicker:@"ZZFOLLOW" eventType:@"Quarterly Earnings"];
+    [followIndex addActionOfType:@"PriceChange" eventTicker:@"ZZFOLLOW" eventType:@"52 Week High $10.00"];
+    XCTAssertTrue([followIndex isTickerFollowed:@"ZZFOLLOW"]);
+    XCTAssertTrue([followIndex hasReminderForEventWithTicker:@"ZZFOLLOW" eventType:@"quarterly earnings"]);
+    XCTAssertFalse([followIndex hasReminderForEventWithTicker:@"ZZFOLLOW" eventType:@"52 Week High $10.00"]);
+    
+    // Still followed till the last action goes
+    [followIndex removeActionOfType:@"OSReminder" eventTicker:@"ZZFOLLOW" eventType:@"Quarterly Earnings"];
+    XCTAssertFalse([followIndex hasReminderForEventWithTicker:@"ZZFOLLOW" eventType:@"Quarterly Earnings"]);
+    XCTAssertTrue([followIndex isTickerFollowed:@"ZZFOLLOW"]);
+    [followIndex removeActionOfType:@"PriceChange" eventTicker:@"ZZFOLLOW" eventType:@"52 Week High $10.00"];
+    XCTAssertFalse([followIndex isTickerFollowed:@"ZZFOLLOW"]);
+    
+    // Econ event types are followed as long as any agency has a reminder for them
+    [followIndex addActionOfType:@"OSReminder" eventTicker:@"ECONOMY_ZZA" eventType:@"Feb ZZ Report"];
+    [followIndex addActionOfType:@"OSReminder" eventTicker:@"ECONOMY_ZZB" eventType:@"Feb ZZ Report"];
+    [followIndex removeActionOfType:@"OSReminder" eventTicker:@"ECONOMY_ZZA" eventType:@"Feb ZZ Report"];
+    XCTAssertTrue([followIndex hasReminderForEventType:@"feb zz report"]);
+    [followIndex removeActionOfType:@"OSReminder" eventTicker:@"ECONOMY_ZZB" eventType:@"Feb ZZ Report"];
+    XCTAssertFalse([followIndex hasReminderForEventType:@"Feb ZZ Report"]);
+}
+
+// Price change event types should parse into their kind, direction, window, percent and price, with NAN for what a type doesn't have.
+- (void)testClassificationParsesPriceMoves {
+    
+    FAEventClassification *dailyMove = [FAEventClassification classificationForType:@"-5.12% down today $30.80" ticker:@"AAPL"];
+    XCTAssertEqual(dailyMove.kind, FAEventKindDailyMove);
+    XCTAssertEqual(dailyMove.direction, FAPriceMoveDirectionDown);
+    XCTAssertEqual(dailyMove.window, FAPriceMoveWindowDay);
+    XCTAssertEqualWithAccuracy(dailyMove.percent, 5.12, 0.0001);
+    XCTAssertEqualWithAccuracy(dailyMove.price, 30.80, 0.0001);
+    
+    FAEventClassification *yearHigh = [FAEventClassification classificationForType:@"52 Week High $123.45" ticker:@"GOOGL"];
+    XCTAssertEqual(yearHigh.kind, FAEventKind52WeekHighLow);
+    XCTAssertEqual(yearHigh.direction, FAPriceMoveDirectionUp);
+    XCTAssertTrue(isnan(yearHigh.percent));
+    XCTAssertEqualWithAccuracy(yearHigh.price, 123.45, 0.0001);
+    
+    FAEventClassification *ytdMove = [FAEventClassification classificationForType:@"30.12% up ytd" ticker:@"MSFT"];
+    XCTAssertEqual(ytdMove.window, FAPriceMoveWindowYearToDate);
+    XCTAssertTrue(isnan(ytdMove.price));
+    XCTAssertTrue(isnan([FAEventClassification classificationForType:@"Quarterly Earnings" ticker:@"MSFT"].price));
+}
+
+// Top price moves should come from the typed price move attributes filled in on save, biggest first, for just the window and direction asked for.
+- (void)testTopPriceMoveEventsSortByPercent {
+    
+    NSPersistentStoreCoordinator *coordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:[[FADataStore sharedStore] managedObjectModel]];
+    XCTAssertNotNil([coordinator addPersistentStoreWithType:NSInMemoryStoreType configuration:nil URL:nil options:nil error:nil]);
+    NSManagedObjectContext *context = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+    [context setPersistentStoreCoordinator:coordinator];
+    
+    NSArray *eventTypes = @[@"+1.25% up today $10.00", @"+5.12% up today $30.12", @"-7.50% down today $8.00", @"30.12% up ytd", @"52 Week High $40.00", @"Quarterly Earnings"];
+    for (NSUInteger typeNumber = 0; typeNumber < eventTypes.count; typeNumber++) {
+        Company *company = [NSEntityDescription insertNewObjectForEntityForName:@"Company" inManagedObjectContext:context];
+        company.ticker = [NSString stringWithFormat:@"ZZMOVE%lu",(unsigned long)typeNumber];
+        company.name = @"ZZ Price Move Inc";
+        Event *event = [NSEntityDescription insertNewObjectForEntityForName:@"Event" inManagedObjectContext:context];
+        event.type = [eventTypes objectAtIndex:typeNumber];
+        event.listedCompany = company;
+    }
+    NSError *error = nil;
+    XCTAssertTrue([context save:&error], @"%@", error);
+    
+    FADataController *moveDataController = [[FADataController alloc] init];
+    moveDataController.managedObjectContext = context;
+    
+    NSArray *dailyUpMoves = [moveDataController getTopPriceMoveEventsForWindow:FAPriceMoveWindowDay direction:FAPriceMoveDirectionUp limit:10].fetchedObjects;
+    XCTAssertEqual(dailyUpMoves.count, (NSUInteger)2);
+    XCTAssertEqualObjects([[dailyUpMoves firstObject] type], @"+5.12% up today $30.12");
+    XCTAssertEqualObjects([[dailyUpMoves lastObject] type], @"+1.25% up today $10.00");
+    
+    NSArray *dailyMoves = [moveDataController getTopPriceMoveEventsForWindow:FAPriceMoveWindowDay direction:FAPriceMoveDirectionNone limit:1].fetchedObjects;
+    XCTAssertEqual(dailyMoves.count, (NSUInteger)1);
+    XCTAssertEqualObjects([[dailyMoves firstObject] type], @"-7.50% down today $8.00");
+    
+    NSArray *ytdMoves = [moveDataController getTopPriceMoveEventsForWindow:FAPriceMoveWindowYearToDate direction:FAPriceMoveDirectionNone limit:10].fetchedObjects;
+    XCTAssertEqual(ytdMoves.count, (NSUInteger)1);
+    XCTAssertEqualWithAccuracy([[[ytdMoves firstObject] priceMovePercent] doubleValue], 30.12, 0.0001);
+}
+
+// Product impact strings should map to their impact regardless of case and spacing, and every impact back to the string for it.
+- (void)testProductImpactRoundTrips {
+    
+    XCTAssertEqual([Event productImpactForString:@"Very High"], FAProductImpactVeryHigh);
+    XCTAssertEqual([Event productImpactForString:@"very high "], FAProductImpactVeryHigh);
+    XCTAssertEqual([Event productImpactForString:@"Medium"], FAProductImpactMedium);
+    XCTAssertEqual([Event productImpactForString:nil], FAProductImpactUnknown);
+    
+    for (int16_t impact = FAProductImpactLow; impact <= FAProductImpactVeryHigh; impact++) {
+        XCTAssertEqual([Event productImpactForString:[Event stringForProductImpact:impact]], impact);
+    }
+    XCTAssertEqualObjects([Event stringForProductImpact:FAProductImpactUnknown], @"Unknown");
+}
+
+// Bulk deleting events should delete their actions and history in the store too, turn the live objects into deletes and unfollow the company.
+- (void)testBatchDeleteCascadesAndMerges {
+    
+    // Bulk deletes only run on a SQLite store, so use a temporary one instead of the app's
+    NSURL *storeURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FinAppTests-%@.sqlite", [[NSUUID UUID] UUIDString]]]];
+    NSPersistentStoreCoordinator *storeCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:[[FADataStore sharedStore] managedObjectModel]];
+    XCTAssertNotNil([storeCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:nil error:nil]);
+    FADataStore *dataStore = [[FADataStore alloc] initWithPersistentStoreCoordinator:storeCoordinator];
+    NSManagedObjectContext *mainContext = [dataStore mainContext];
+    
+    Company *company = [NSEntityDescription insertNewObjectForEntityForName:@"Company" inManagedObjectContext:mainContext];
+    company.ticker = @"ZZBULK";
+    company.name = @"ZZ Bulk Delete Inc";
+    company.isFollowed = [NSNumber numberWithBool:YES];
+    Event *event = [NSEntityDescription insertNewObjectForEntityForName:@"Event" inManagedObjectContext:mainContext];
+    event.type = @"-5.12% down today $30.80";
+    event.listedCompany = company;
+    Action *action = [NSEntityDescription insertNewObjectForEntityForName:@"Action" inManagedObjectContext:mainContext];
+    action.type = @"PriceChange";
+    action.parentEvent = event;
+    EventHistory *history = [NSEntityDescription insertNewObjectForEntityForName:@"EventHistory" inManagedObjectContext:mainContext];
+    history.parentEvent = event;
+    
+    // Pending changes are saved by the bulk delete itself
+    XCTAssertTrue([dataStore batchDeleteObjectsOfEntity:@"Event" matchingPredicate:[NSPredicate predicateWithFormat:@"tickerKey == %@", @"ZZBULK"] fromContext:mainContext]);
+    XCTAssertTrue(event.isDeleted || (event.managedObjectContext == nil));
+    
+    // Nothing for the event is left in the store
+    NSArray *deletedObjectIDs = @[event.objectID, action.objectID, history.objectID];
+    NSManagedObjectContext *checkContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [checkContext setPersistentStoreCoordinator:[dataStore persistentStoreCoordinator]];
+    [checkContext performBlockAndWait:^{
+        for (NSManagedObjectID *deletedObjectID in deletedObjectIDs) {
+            XCTAssertFalse(deletedObjectID.isTemporaryID);
+            XCTAssertNil([checkContext existingObjectWithID:deletedObjectID error:nil]);
+        }
+    }];
+    
+    // The company lost it's only following action
+    XCTAssertFalse([company.isFollowed boolValue]);
+    
+    XCTAssertTrue([dataStore batchDeleteObjectsOfEntity:@"Company" matchingPredicate:[NSPredicate predicateWithFormat:@"tickerKey == %@", @"ZZBULK"] fromContext:mainContext]);
+    XCTAssertTrue(company.isDeleted || (company.managedObjectContext == nil));
+    
+    XCTAssertTrue([storeCoordinator destroyPersistentStoreAtURL:storeURL withType:NSSQLiteStoreType options:nil error:nil]);
+}
+
+// Tasks added after their stage has started should still run, in order, off the main thread.
+- (void)testLaunchTasksRunInOrderAfterFirstFrame {
+    
+    FALaunchScheduler *launchScheduler = [FALaunchScheduler sharedScheduler];
+    [launchScheduler firstFrameDidRender];
+    
+    NSMutableArray *taskOrder = [NSMutableArray array];
+    XCTestExpectation *tasksDone = [self expectationWithDescription:@"After first frame tasks ran"];
+    [launchScheduler addTaskForStage:FALaunchStageAfterFirstFrame named:@"first" usingBlock:^{
+        XCTAssertFalse([NSThread isMainThread]);
+        [taskOrder addObject:@"first"];
+    }];
+    [launchScheduler addTaskForStage:FALaunchStageAfterFirstFrame named:@"second" usingBlock:^{
+        [taskOrder addObject:@"second"];
+        [tasksDone fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqualObjects(taskOrder, (@[@"first", @"second"]));
+}
+
+// An object key that isn't valid UTF8 should fail the read with an error instead of crashing.
+- (void)testStreamReaderFailsOnInvalidKey {
+    
+    const char invalidKeyJSON[] = "{\"meta\":{\"bad\xff\":1},\"results\":[{\"close\":1.5}]}";
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:invalidKeyJSON length:strlen(invalidKeyJSON)]];
+    NSError *error = nil;
+    NSDictionary *foundValues = nil;
+    XCTAssertFalse([reader enumerateRecordsAtPath:@"results" fields:@[@"close"] valuesAtPaths:@[@"meta.total"] foundValues:&foundValues error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {}]);
+    XCTAssertNotNil(error);
+}
+
+// Escapes in strings, including surrogate pairs, should be decoded the same way NSJSONSerialization does.
+- (void)testStreamReaderDecodesEscapes {
+    
+    const char escapedJSON[] = "{\"results\":[{\"name\":\"caf\\u00e9 \\ud83d\\ude00 \\\"q\\\" a\\/b\\n\",\"skipped\":\"\\\"]}\"}]}";
+    NSData *jsonData = [NSData dataWithBytes:escapedJSON length:strlen(escapedJSON)];
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:jsonData];
+    NSMutableArray *records = [NSMutableArray array];
+    XCTAssertTrue([reader enumerateRecordsAtPath:@"results" fields:@[@"name"] error:nil usingBlock:^(NSDictionary *record, BOOL *stop) {
+        [records addObject:record];
+    }]);
+    
+    NSDictionary *parsedResponse = [NSJSONSerialization JSONObjectWithData:jsonData options:kNilOptions error:nil];
+    XCTAssertEqualObjects([[records firstObject] objectForKey:@"name"], @"caf\u00e9 \U0001F600 \"q\" a/b\n");
+    XCTAssertEqualObjects([[records firstObject] objectForKey:@"name"], [[[parsedResponse objectForKey:@"results"] firstObject] objectForKey:@"name"]);
+    XCTAssertNil([[records firstObject] objectForKey:@"skipped"]);
+}
+
+// Array records should give the requested positions, keyed by position, and leave out the rest.
+- (void)testStreamReaderReadsPositionalFields {
+    
+    const char positionalJSON[] = "{\"dataset\":{\"data\":[[\"2016-04-01\",[1,2],109.5,null],[\"2016-03-31\",{\"a\":1},108.25]]}}";
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:positionalJSON length:strlen(positionalJSON)]];
+    NSMutableArray *records = [NSMutableArray array];
+    XCTAssertTrue([reader enumerateRecordsAtPath:@"dataset.data" fields:@[@0,@2,@3] error:nil usingBlock:^(NSDictionary *record, BOOL *stop) {
+        [records addObject:record];
+    }]);
+    
+    XCTAssertEqual(records.count, (NSUInteger)2);
+    XCTAssertEqualObjects([records[0] objectForKey:@0], @"2016-04-01");
+    XCTAssertEqualObjects([records[0] objectForKey:@2], @109.5);
+    XCTAssertNil([records[0] objectForKey:@1]);
+    XCTAssertEqualObjects([records[1] objectForKey:@2], @108.25);
+    XCTAssertNil([records[1] objectForKey:@3]);
+}
+
+// Values outside the records should be picked up in the same pass, and stopping should end the read after the current record.
+- (void)testStreamReaderFindsValuesAndStops {
+    
+    const char pagedJSON[] = "{\"meta\":{\"total_pages\":75,\"query\":\"\"},\"datasets\":[{\"dataset_code\":\"AAPL\"},{\"dataset_code\":\"MSFT\"},{\"dataset_code\":\"IBM\"}]}";
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:pagedJSON length:strlen(pagedJSON)]];
+    NSMutableArray *tickers = [NSMutableArray array];
+    NSDictionary *foundValues = nil;
+    NSError *error = nil;
+    XCTAssertTrue([reader enumerateRecordsAtPath:@"datasets" fields:@[@"dataset_code"] valuesAtPaths:@[@"meta.total_pages",@"meta.missing"] foundValues:&foundValues error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {
+        [tickers addObject:[record objectForKey:@"dataset_code"]];
+        *stop = (tickers.count == 2);
+    }]);
+    
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(tickers, (@[@"AAPL", @"MSFT"]));
+    XCTAssertEqualObjects(foundValues, (@{@"meta.total_pages": @75}));
+    XCTAssertTrue(reader.recordsFound);
+}
+
+// A response without the records, e.g. an error message from the API, should read fine but not report any records found.
+- (void)testStreamReaderReportsMissingRecords {
+    
+    const char errorJSON[] = "{\"status\":{\"code\":500,\"message\":\"Symbol not found\"},\"results\":null}";
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:errorJSON length:strlen(errorJSON)]];
+    __block NSUInteger recordCount = 0;
+    XCTAssertTrue([reader enumerateRecordsAtPath:@"results" fields:@[@"close"] error:nil usingBlock:^(NSDictionary *record, BOOL *stop) {
+        recordCount++;
+    }]);
+    XCTAssertEqual(recordCount, (NSUInteger)0);
+    XCTAssertFalse(reader.recordsFound);
+    
+    const char emptyJSON[] = "{\"results\":[]}";
+    reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:emptyJSON length:strlen(emptyJSON)]];
+    XCTAssertTrue([reader enumerateRecordsAtPath:@"results" fields:@[@"close"] error:nil usingBlock:^(NSDictionary *record, BOOL *stop) {}]);
+    XCTAssertTrue(reader.recordsFound);
+}
+
+// A response cut off partway through should fail the read, after handing out only the records that were complete.
+- (void)testStreamReaderFailsOnTruncatedDocument {
+    
+    const char truncatedJSON[] = "{\"results\":[{\"tradingDay\":\"2016-03-31\",\"close\":108.99},{\"tradingDay\":\"2016-04-01\",\"clo";
+    FAJSONStreamReader *reader = [[FAJSONStreamReader alloc] initWithData:[NSData dataWithBytes:truncatedJSON length:strlen(truncatedJSON)]];
+    NSMutableArray *records = [NSMutableArray array];
+    NSError *error = nil;
+    XCTAssertFalse([reader enumerateRecordsAtPath:@"results" fields:@[@"tradingDay",@"close"] error:&error usingBlock:^(NSDictionary *record, BOOL *stop) {
+        [records addObject:record];
+    }]);
+    XCTAssertNotNil(error);
+    XCTAssertEqual(records.count, (NSUInteger)1);
+}
+
+// Stored closes should only be given for dates the bars reach, and an overlapping fetch with adjusted closes should drop the stored history.
+- (void)testPriceBarStoreDropsAdjustedHistory {
+    
+    FAPriceBarStore *barStore = [FAPriceBarStore sharedStore];
+    [barStore removeBarsForTicker:@"ZZBARS"];
+    
+    XCTAssertTrue([barStore appendBars:@[@{@"tradingDay":@"2016-03-28", @"close":@10.0}, @{@"tradingDay":@"2016-03-29", @"close":@11.0}, @{@"tradingDay":@"2016-03-30", @"close":@12.0}] forTicker:@"ZZBARS"]);
+    XCTAssertEqualObjects([barStore closePriceForTicker:@"ZZBARS" onOrBeforeDate:[FAPriceBarStore dateForDayNumber:20160329]], @11.0);
+    // Bars that end before the last trading day on or before the date don't know it's close
+    XCTAssertNil([barStore closePriceForTicker:@"ZZBARS" onOrBeforeDate:[FAPriceBarStore dateForDayNumber:20160420]]);
+    
+    // Overlapping bars that agree are skipped and the new ones appended
+    XCTAssertTrue([barStore appendBars:@[@{@"tradingDay":@"2016-03-30", @"close":@12.0}, @{@"tradingDay":@"2016-03-31", @"close":@13.0}] forTicker:@"ZZBARS"]);
+    XCTAssertEqualObjects([barStore closePriceForTicker:@"ZZBARS" onOrBeforeDate:[FAPriceBarStore dateForDayNumber:20160331]], @13.0);
+    
+    // Closes halved by a 2 for 1 split drop the stored history, so that it's fetched again
+    XCTAssertFalse([barStore appendBars:@[@{@"tradingDay":@"2016-03-31", @"close":@6.5}, @{@"tradingDay":@"2016-04-01", @"close":@7.0}] forTicker:@"ZZBARS"]);
+    XCTAssertNil([barStore lastBarDateForTicker:@"ZZBARS"]);
+    
+    [barStore removeBarsForTicker:@"ZZBARS"];
+}
+
 - (void)testPerformanceExample {
     // This is an example of a performance test case.
     [self measureBlock:^{
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+#
+#  compile_preseed_snapshot.py
+#  FinApp
+#
+#  Compiles all the data the app's data store is seeded with into one compact, versioned
+#  binary snapshot, read on first launch by FAPreseedSnapshot. Run by the "Compile Preseed
+#  Snapshot" build phase. Sources, all in the FinApp directory:
+#  1. FinApp.sqlite: The preseeded data store i.e. companies synced from the API, placeholder
+#     events and the user's sync state.
+#  2. SeedCompanies.tsv: Newer companies, including ones with product events.
+#  3. ZEA-datasets-codes_20161119.csv: Companies with earnings announcement dates.
+#  4. EconomicEvents_2019.json: Economic events and the agencies that put them out.
+#  Where a company is in more than one source, the first one in this order wins.
+#
+#  Snapshot format, little endian. See FAPreseedSnapshot.h, which must be kept in sync.
+#  Header, 64 bytes: "FAPS", format version, seed version (CRC32 of everything after the header),
+#  then the count and offset of the company, event and user records and the offset and length
+#  of the strings. Strings are referenced by their offset in the strings, 0xFFFFFFFF for none,
+#  and stored once each as a 2 byte length followed by UTF-8 bytes.
+#  Company, 8 bytes: ticker, name.
+#  Event, 56 bytes: ticker, type, certainty, related details, day number e.g. 20190130 of the date
+#  at local midnight or 0 if the date is absolute, estimated eps, actual eps prior, flags, then the
+#  absolute date, related date and prior end date as seconds since 2001-01-01 GMT, NaN for none.
+#  User, 40 bytes: company sync status, event sync status, company page number, company total
+#  pages, company sync date, event sync date.
+#
+#  Created by agent on 10/18/26.
+#  Copyright (c) 2026 agent. All rights reserved.
+#
+
+import argparse
+import json
+import os
+import sqlite3
+import struct
+import sys
+import zlib
+
+FORMAT_VERSION = 1
+HEADER_SIZE = 64
+NO_STRING = 0xFFFFFFFF
+NO_DATE = float('nan')
+
+# Event flags
+EVENT_UPSERT = 1 << 0
+EVENT_HAS_ESTIMATED_EPS = 1 << 1
+EVENT_HAS_ACTUAL_EPS_PRIOR = 1 << 2
+
+# Tickers left out of the snapshot, along with their events, from every source. There are two tickers with the same company name T.BB and
+# BBRY -> Blackberry Ltd, which messes up the app, and BBRY has since changed to BB. The app's one time data migrations delete these from
+# existing stores, and a store seeded from the snapshot must not bring them back.
+EXCLUDED_TICKERS = {'BBRY', 'T.BB'}
+
+
+class StringTable(object):
+    """Strings stored once each, referenced by offset."""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def ref(self, value):
+        if value is None:
+            return NO_STRING
+        if value not in self.offsets:
+            encoded = value.encode('utf-8')
+            if len(encoded) > 0xFFFF:
+                sys.exit('error: string is too long for the preseed snapshot: %s...' % value[:40])
+            self.offsets[value] = len(self.data)
+            self.data += struct.pack('<H', len(encoded)) + encoded
+        return self.offsets[value]
+
+
+def read_store(source_dir):
+    """Companies, events and the user from the preseeded data store."""
+    store = sqlite3.connect(os.path.join(source_dir, 'FinApp.sqlite'))
+    companies = [(ticker, name) for ticker, name in store.execute('SELECT ZTICKER, ZNAME FROM ZCOMPANY ORDER BY Z_PK')]
+    events = []
+    for row in store.execute('SELECT c.ZTICKER, e.ZTYPE, e.ZCERTAINTY, e.ZRELATEDDETAILS, e.ZDATE, e.ZRELATEDDATE, e.ZPRIORENDDATE, '
+                             'e.ZESTIMATEDEPS, e.ZACTUALEPSPRIOR FROM ZEVENT e JOIN ZCOMPANY c ON e.ZLISTEDCOMPANY = c.Z_PK ORDER BY e.Z_PK'):
+        ticker, event_type, certainty, related_details, date, related_date, prior_end_date, estimated_eps, actual_eps_prior = row
+        # Placeholder events are only added if missing, so they never overwrite fresher ones
+        events.append(dict(ticker=ticker, type=event_type, certainty=certainty, relatedDetails=related_details, dayNumber=0,
+                           date=date, relatedDate=related_date, priorEndDate=prior_end_date, estimatedEps=estimated_eps,
+                           actualEpsPrior=actual_eps_prior, flags=0))
+    users = list(store.execute('SELECT ZCOMPANYSYNCSTATUS, ZEVENTSYNCSTATUS, ZCOMPANYPAGENUMBER, ZCOMPANYTOTALPAGES, ZCOMPANYSYNCDATE, '
+                               'ZEVENTSYNCDATE FROM ZUSER ORDER BY Z_PK LIMIT 1'))
+    store.close()
+    return companies, events, users
+
+
+def read_seed_companies(source_dir):
+    """Newer companies, as Ticker<tab>Name lines."""
+    companies = []
+    with open(os.path.join(source_dir, 'SeedCompanies.tsv'), encoding='utf-8') as seed_file:
+        for line in seed_file:
+            line = line.rstrip('\r\n')
+            if not line or line.startswith('#'):
+                continue
+            ticker, name = line.split('\t')[:2]
+            companies.append((ticker, name))
+    return companies
+
+
+def read_zea_companies(source_dir):
+    """Companies from the earnings announcement dates codes, the same way FADataController getAllTickersAndNamesFromLocalStorage did."""
+    companies = []
+    with open(os.path.join(source_dir, 'ZEA-datasets-codes_20161119.csv'), encoding='utf-8') as codes_file:
+        for line in codes_file:
+            line = line.rstrip('\r\n')
+            if not line:
+                continue
+            columns = line.split(',')
+            # Strip out ZEA/ and replace underscore in certain ticker names with . e.g.GRP_U -> GRP.U
+            ticker = columns[0].replace('ZEA/', '').replace('_', '.')
+            # Extract the company name from e.g. Earnings Announcement Dates for Atlas Air Worldwide Holdings (AAWW)
+            name_string = columns[1]
+            name_start = name_string.find('for')
+            name_end = name_string.find('(%s)' % ticker)
+            if name_start < 0 or name_end < 0:
+                continue
+            name = name_string[name_start + 4:name_end - 1]
+            if name.endswith('.'):
+                name = name[:-1]
+            companies.append((ticker, name))
+    return companies
+
+
+def read_economic_events(source_dir):
+    """Economic events, and their agencies as companies, the same way FADataController getAllEconomicEventsFromLocalStorage does."""
+    companies = []
+    events = []
+    with open(os.path.join(source_dir, 'EconomicEvents_2019.json'), encoding='utf-8') as events_file:
+        event_sets = json.load(events_file)['eventSets']
+    for event_set in event_sets:
+        companies.append((event_set['identifier'], event_set['agency']))
+        for instance in event_set['instances']:
+            related_period = instance['relatedPeriod']
+            events.append(dict(ticker=event_set['identifier'], type='%s %s' % (related_period, event_set['name']), certainty=related_period,
+                               relatedDetails=event_set.get('moreInfoUrl'), dayNumber=int(instance['date']), date=None, relatedDate=None,
+                               priorEndDate=None, estimatedEps=None, actualEpsPrior=None, flags=EVENT_UPSERT))
+    return companies, events
+
+
+def compile_snapshot(source_dir):
+    store_companies, store_events, users = read_store(source_dir)
+    econ_companies, econ_events = read_economic_events(source_dir)
+
+    # Companies are unique by ticker, ignoring case
+    companies = []
+    seen_tickers = set()
+    for ticker, name in store_companies + read_seed_companies(source_dir) + read_zea_companies(source_dir) + econ_companies:
+        if ticker is None or ticker.upper() in seen_tickers or ticker.upper() in EXCLUDED_TICKERS:
+            continue
+        seen_tickers.add(ticker.upper())
+        companies.append((ticker, name))
+
+    strings = StringTable()
+    company_records = bytearray()
+    for ticker, name in companies:
+        company_records += struct.pack('<II', strings.ref(ticker), strings.ref(name))
+
+    events = [event for event in store_events + econ_events if event['ticker'] is not None and event['ticker'].upper() not in EXCLUDED_TICKERS]
+    event_records = bytearray()
+    for event in events:
+        flags = event['flags']
+        if event['estimatedEps'] is not None:
+            flags |= EVENT_HAS_ESTIMATED_EPS
+        if event['actualEpsPrior'] is not None:
+            flags |= EVENT_HAS_ACTUAL_EPS_PRIOR
+        event_records += struct.pack('<IIIIiffIddd', strings.ref(event['ticker']), strings.ref(event['type']), strings.ref(event['certainty']),
+                                     strings.ref(event['relatedDetails']), event['dayNumber'], event['estimatedEps'] or 0.0,
+                                     event['actualEpsPrior'] or 0.0, flags,
+                                     NO_DATE if event['date'] is None else event['date'],
+                                     NO_DATE if event['relatedDate'] is None else event['relatedDate'],
+                                     NO_DATE if event['priorEndDate'] is None else event['priorEndDate'])
+
+    user_records = bytearray()
+    for company_status, event_status, page_number, total_pages, company_sync_date, event_sync_date in users:
+        user_records += struct.pack('<IIqqdd', strings.ref(company_status), strings.ref(event_status), page_number or 0, total_pages or 0,
+                                    NO_DATE if company_sync_date is None else company_sync_date,
+                                    NO_DATE if event_sync_date is None else event_sync_date)
+
+    companies_offset = HEADER_SIZE
+    events_offset = companies_offset + len(company_records)
+    users_offset = events_offset + len(event_records)
+    strings_offset = users_offset + len(user_records)
+    body = bytes(company_records + event_records + user_records + strings.data)
+    header = struct.pack('<4sIIIIIIIIII', b'FAPS', FORMAT_VERSION, zlib.crc32(body) & 0xFFFFFFFF,
+                         len(companies), companies_offset, len(events), events_offset,
+                         len(users), users_offset, strings_offset, len(strings.data))
+    header += bytes(HEADER_SIZE - len(header))
+    return header + body, len(companies), len(events)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile the FinApp preseed snapshot.')
+    parser.add_argument('--source', required=True, help='FinApp source directory with the seed data')
+    parser.add_argument('--output', required=True, help='Path of the snapshot to write')
+    args = parser.parse_args()
+
+    snapshot, company_count, event_count = compile_snapshot(args.source)
+    output_dir = os.path.dirname(args.output)
+    if output_dir and not os.path.isdir(output_dir):
+        os.makedirs(output_dir)
+    with open(args.output, 'wb') as output_file:
+        output_file.write(snapshot)
+    print('Compiled preseed snapshot with %d companies and %d events, %d bytes: %s' % (company_count, event_count, len(snapshot), args.output))
+
+
+if __name__ == '__main__':
+    main()